@@ -0,0 +1,222 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: arena.c
+// Summary	: Arena allocator
+// Note		: An arena is a list of chunks, the newest first. Allocations are
+//			  taken from the newest chunk and a full chunk is followed by one
+//			  twice as large, so a table of any size uses a handful of
+//			  chunks. Nothing is freed on its own; a reset keeps the newest
+//			  chunk for the next query and a release frees every chunk. The
+//			  last allocation can grow in place, which keeps a growing
+//			  result array from being copied while its chunk has room.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "customTypes.h"
+#include "arena.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define ARENA_ALIGNMENT		(sizeof(max_align_t))
+#define ARENA_MIN_CHUNK		(4096)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To round a size up to the alignment of every allocation
+//Inputs	: ulSize, the size
+//Outputs	: None
+//Return	: The rounded size, at least one alignment unit
+//Notes		:
+//******************************************************************************
+static uint32 arenaRound(uint32 ulSize)
+{
+	if(ulSize == 0)
+	{
+		ulSize = 1;
+	}
+
+	return (ulSize + ARENA_ALIGNMENT - 1) & ~(uint32)(ARENA_ALIGNMENT - 1);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To start a new chunk
+//Inputs	: pstArena, the arena
+//Inputs	: ulSize, the rounded size that has to fit in the chunk
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, if out of memory
+//Notes		: The next chunk will be twice as large
+//******************************************************************************
+static bool arenaAddChunk(ARENA *pstArena, uint32 ulSize)
+{
+	ARENA_CHUNK *pstChunk = NULL;
+	uint32 ulChunkSize = pstArena->ulChunkSize;
+
+	if(ulChunkSize < ulSize)
+	{
+		ulChunkSize = ulSize;
+	}
+
+	pstChunk = malloc(sizeof(ARENA_CHUNK) + ulChunkSize);
+	if(pstChunk != NULL)
+	{
+		pstChunk->pstNext = pstArena->pstChunks;
+		pstChunk->ulSize = ulChunkSize;
+		pstChunk->ulUsed = 0;
+		pstArena->pstChunks = pstChunk;
+		pstArena->ulChunkSize = ulChunkSize * 2;
+	}
+
+	return (pstChunk != NULL);
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To prepare an empty arena
+//Inputs	: ulChunkSize, size of the first chunk, ARENA_QUERY_SIZE or
+//			  ARENA_TABLE_SIZE
+//Outputs	: pstArena, the arena
+//Return	: None
+//Notes		: No memory is taken before the first allocation
+//******************************************************************************
+void arenaInit(ARENA *pstArena, uint32 ulChunkSize)
+{
+	pstArena->pstChunks = NULL;
+	pstArena->ulChunkSize = (ulChunkSize < ARENA_MIN_CHUNK) ? ARENA_MIN_CHUNK :
+							arenaRound(ulChunkSize);
+	pstArena->ulLast = 0;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To allocate memory from an arena
+//Inputs	: pstArena, the arena
+//Inputs	: ulSize, size of the memory
+//Outputs	: None
+//Return	: The memory, aligned for any type
+//Return	: NULL, if out of memory
+//Notes		: Released with the arena only
+//******************************************************************************
+void *arenaAlloc(ARENA *pstArena, uint32 ulSize)
+{
+	void *pvData = NULL;
+	ARENA_CHUNK *pstChunk = pstArena->pstChunks;
+
+	ulSize = arenaRound(ulSize);
+	if(pstChunk == NULL || pstChunk->ulSize - pstChunk->ulUsed < ulSize)
+	{
+		pstChunk = (arenaAddChunk(pstArena, ulSize) == true) ?
+				   pstArena->pstChunks : NULL;
+	}
+
+	if(pstChunk != NULL)
+	{
+		pvData = (uint8 *)pstChunk->stData + pstChunk->ulUsed;
+		pstArena->ulLast = pstChunk->ulUsed;
+		pstChunk->ulUsed += ulSize;
+	}
+	else
+	{
+		printf("\nUnable to allocate %lu bytes : Out of memory", ulSize);
+	}
+
+	return pvData;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To grow memory taken from an arena
+//Inputs	: pstArena, the arena
+//Inputs	: pvData and ulSize, the memory and its size, NULL and 0 to
+//			  allocate
+//Inputs	: ulNewSize, the size needed
+//Outputs	: None
+//Return	: The grown memory, holding the content of pvData
+//Return	: NULL, if out of memory, pvData is left as it is
+//Notes		: Grown in place when pvData is the last allocation and its
+//			  chunk has room, otherwise copied
+//******************************************************************************
+void *arenaGrow(ARENA *pstArena, void *pvData, uint32 ulSize,
+				uint32 ulNewSize)
+{
+	void *pvGrown = NULL;
+	ARENA_CHUNK *pstChunk = pstArena->pstChunks;
+
+	if(pvData != NULL && pstChunk != NULL &&
+	   pvData == (uint8 *)pstChunk->stData + pstArena->ulLast &&
+	   pstChunk->ulSize - pstArena->ulLast >= arenaRound(ulNewSize))
+	{
+		pstChunk->ulUsed = pstArena->ulLast + arenaRound(ulNewSize);
+		pvGrown = pvData;
+	}
+	else
+	{
+		pvGrown = arenaAlloc(pstArena, ulNewSize);
+		if(pvGrown != NULL && pvData != NULL)
+		{
+			memcpy(pvGrown, pvData, ulSize);
+		}
+	}
+
+	return pvGrown;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To release all the allocations of an arena, keeping its memory
+//Inputs	: pstArena, the arena
+//Outputs	: None
+//Return	: None
+//Notes		: The newest and largest chunk is kept for the next allocations
+//******************************************************************************
+void arenaReset(ARENA *pstArena)
+{
+	ARENA_CHUNK *pstChunk = NULL;
+
+	if(pstArena->pstChunks != NULL)
+	{
+		while(pstArena->pstChunks->pstNext != NULL)
+		{
+			pstChunk = pstArena->pstChunks->pstNext;
+			pstArena->pstChunks->pstNext = pstChunk->pstNext;
+			free(pstChunk);
+		}
+		pstArena->pstChunks->ulUsed = 0;
+	}
+	pstArena->ulLast = 0;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To release all the memory of an arena
+//Inputs	: pstArena, the arena
+//Outputs	: None
+//Return	: None
+//Notes		: The arena is left empty and can be used again
+//******************************************************************************
+void arenaRelease(ARENA *pstArena)
+{
+	ARENA_CHUNK *pstChunk = NULL;
+
+	while(pstArena->pstChunks != NULL)
+	{
+		pstChunk = pstArena->pstChunks;
+		pstArena->pstChunks = pstChunk->pstNext;
+		free(pstChunk);
+	}
+	pstArena->ulLast = 0;
+}
+// EOF
@@ -0,0 +1,53 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Arena allocator
+// Note		: Memory of a query or of a loaded table is taken from large
+//			  chunks by moving a pointer, and all of it is released at once
+//
+//******************************************************************************
+
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include <stddef.h>
+#include "customTypes.h"
+
+//******************************* Global Types *********************************
+typedef struct _ARENA_CHUNK_
+{
+	struct _ARENA_CHUNK_ *pstNext;
+	uint32 ulSize;
+	uint32 ulUsed;
+	max_align_t stData[];
+} ARENA_CHUNK;
+
+typedef struct _ARENA_
+{
+	ARENA_CHUNK *pstChunks;
+	uint32 ulChunkSize;
+	uint32 ulLast;
+} ARENA;
+
+//***************************** Global Constants *******************************
+// First chunk of the arena of one query, its results and its buffers
+#define ARENA_QUERY_SIZE	(65536)
+// First chunk of the arena of a table loaded for a whole command
+#define ARENA_TABLE_SIZE	(1048576)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+void arenaInit(ARENA *pstArena, uint32 ulChunkSize);
+void *arenaAlloc(ARENA *pstArena, uint32 ulSize);
+void *arenaGrow(ARENA *pstArena, void *pvData, uint32 ulSize,
+				uint32 ulNewSize);
+void arenaReset(ARENA *pstArena);
+void arenaRelease(ARENA *pstArena);
+
+#endif // _ARENA_H_
+// EOF
@@ -0,0 +1,612 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: bloom.c
+// Summary	: Persisted Bloom filter of the serials of a data file
+// Note		: Stored in "<data file>.bloom" and read bit by bit with pread,
+//			  so a query costs a few one byte reads. The filter is sized for
+//			  twice its keys at the configured false positive rate and is
+//			  rebuilt from the data file when it gets full or when it does
+//			  not describe the data file any more. Removed serials stay in
+//			  the filter until it is rebuilt, which only adds false
+//			  positives.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "hash.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "bloom.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define READ_COUNT			(1)
+#define FILE_PERMISSIONS	(0644)
+#define BITS_PER_BYTE		(8)
+#define BLOOM_MAX_HASHES	(16)
+#define BLOOM_SECOND_SEED	(0x9E3779B97F4A7C15UL)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To get the bit positions of a key
+//Inputs	: pstHeader, the filter header
+//Inputs	: ulKey, the key
+//Outputs	: pulBits, one bit position per hash function
+//Return	: None
+//Notes		: Double hashing, h1 + i * h2
+//******************************************************************************
+static void bloomPositions(const BLOOM_HEADER *pstHeader, uint32 ulKey,
+						   uint32 *pulBits)
+{
+	uint32 ulFirst = hashMix(ulKey);
+	uint32 ulSecond = hashMix(ulKey ^ BLOOM_SECOND_SEED) | 1;
+	uint32 ulHash = 0;
+
+	for(ulHash = 0; ulHash < pstHeader->ulHashCount; ulHash++)
+	{
+		pulBits[ulHash] = (ulFirst + ulHash * ulSecond) % pstHeader->ulBitCount;
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To size a filter
+//Inputs	: ulKeyCapacity, number of keys the filter is made for
+//Inputs	: ulRatePpm, false positive rate in parts per million
+//Outputs	: pstHeader, number of bits and of hash functions
+//Return	: None
+//Notes		: m = -n ln(p) / ln(2)^2 bits and k = m / n ln(2) hashes
+//******************************************************************************
+static void bloomSize(uint32 ulKeyCapacity, uint32 ulRatePpm,
+					  BLOOM_HEADER *pstHeader)
+{
+	double dRate = (double)ulRatePpm / BLOOM_PPM;
+	double dBits = -(double)ulKeyCapacity * log(dRate) / (M_LN2 * M_LN2);
+	uint32 ulHashCount = (uint32)(dBits / ulKeyCapacity * M_LN2 + 0.5);
+
+	pstHeader->ulKeyCapacity = ulKeyCapacity;
+	pstHeader->ulRatePpm = ulRatePpm;
+	pstHeader->ulBitCount = ((uint32)dBits / BITS_PER_BYTE + 1) * BITS_PER_BYTE;
+	pstHeader->ulHashCount = ulHashCount < 1 ? 1 :
+							 ulHashCount > BLOOM_MAX_HASHES ? BLOOM_MAX_HASHES :
+							 ulHashCount;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write the header of the filter
+//Inputs	: pstBloom, the filter
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool bloomWriteHeader(BLOOM *pstBloom)
+{
+	return (pwrite(pstBloom->lFd, &pstBloom->stHeader, sizeof(BLOOM_HEADER),
+				   0) == sizeof(BLOOM_HEADER));
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To build the filter from its data file
+//Inputs	: pstBloom, the open filter
+//Inputs	: ulKeyCapacity, minimum number of keys the filter is made for
+//Inputs	: ulRatePpm, false positive rate in parts per million
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: One sequential pass over the data file. The query statistics
+//			  are kept.
+//******************************************************************************
+static bool bloomBuild(BLOOM *pstBloom, uint32 ulKeyCapacity, uint32 ulRatePpm)
+{
+	bool blReturn = true;
+	DEVICE_DETAILS DeviceData = {0};
+	FILE *pstFile = NULL;
+	BLOOM_HEADER *pstHeader = &pstBloom->stHeader;
+	uint8 *pucBits = NULL;
+	uint32 pulBits[BLOOM_MAX_HASHES];
+	uint32 ulRecords = 0;
+	uint32 ulHash = 0;
+	size_t ulBytes = 0;
+
+	fileGetIdentity(pstBloom->pucDataPath, &pstHeader->stData);
+	ulRecords = pstHeader->stData.ulSize / sizeof(DEVICE_DETAILS);
+	if(ulKeyCapacity < ulRecords * 2)
+	{
+		ulKeyCapacity = ulRecords * 2;
+	}
+	if(ulKeyCapacity < BLOOM_MIN_KEYS)
+	{
+		ulKeyCapacity = BLOOM_MIN_KEYS;
+	}
+
+	bloomSize(ulKeyCapacity, ulRatePpm, pstHeader);
+	pstHeader->ulMagic = BLOOM_MAGIC;
+	pstHeader->ulKeyCount = 0;
+	ulBytes = pstHeader->ulBitCount / BITS_PER_BYTE;
+	pucBits = calloc(ulBytes, sizeof(uint8));
+	blReturn = (pucBits != NULL);
+
+	if(blReturn == true && ulRecords > 0)
+	{
+		pstFile = fileOpen(pstBloom->pucDataPath, FILE_READ_MODE);
+		blReturn = (pstFile != NULL);
+		while(blReturn == true && pstHeader->ulKeyCount < ulRecords &&
+			  fileRead(&DeviceData, sizeof(DeviceData),
+					   READ_COUNT, pstFile) == true)
+		{
+			bloomPositions(pstHeader, DeviceData.ulDeviceSerial, pulBits);
+			for(ulHash = 0; ulHash < pstHeader->ulHashCount; ulHash++)
+			{
+				pucBits[pulBits[ulHash] / BITS_PER_BYTE] |=
+					1 << (pulBits[ulHash] % BITS_PER_BYTE);
+			}
+			pstHeader->ulKeyCount++;
+		}
+		if(pstFile != NULL)
+		{
+			fileClose(pstFile);
+		}
+	}
+
+	if(blReturn == true)
+	{
+		blReturn = (ftruncate(pstBloom->lFd, sizeof(BLOOM_HEADER) + ulBytes) ==
+					0 &&
+					pwrite(pstBloom->lFd, pucBits, ulBytes,
+						   sizeof(BLOOM_HEADER)) == (ssize_t)ulBytes &&
+					bloomWriteHeader(pstBloom) == true);
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to build the serial filter of %s",
+			   (char *)pstBloom->pucDataPath);
+	}
+	free(pucBits);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open a filter file
+//Inputs	: pucDataPath, name of the data or shard file
+//Inputs	: lFlags, open flags of the filter file
+//Outputs	: pstBloom, the filter with its stored header
+//Return	: True, if the file holds a filter
+//Return	: False, if the file is missing, empty or invalid
+//Notes		: The file is left open whenever it could be opened
+//******************************************************************************
+static bool bloomOpenFile(const uint8 *pucDataPath, int32 lFlags,
+						  BLOOM *pstBloom)
+{
+	bool blReturn = false;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	memset(pstBloom, 0, sizeof(BLOOM));
+	pstBloom->lFd = BLOOM_INVALID_FD;
+	if(fileBuildPath(pucPath, pucDataPath, BLOOM_SUFFIX) == true &&
+	   strlen((char *)pucDataPath) < FILE_PATH_MAX_SIZE)
+	{
+		strcpy((char *)pstBloom->pucDataPath, (char *)pucDataPath);
+		pstBloom->lFd = open((char *)pucPath, lFlags, FILE_PERMISSIONS);
+		if(pstBloom->lFd < 0)
+		{
+			pstBloom->lFd = BLOOM_INVALID_FD;
+		}
+	}
+
+	if(pstBloom->lFd != BLOOM_INVALID_FD)
+	{
+		blReturn = (pread(pstBloom->lFd, &pstBloom->stHeader,
+						  sizeof(BLOOM_HEADER), 0) == sizeof(BLOOM_HEADER) &&
+					pstBloom->stHeader.ulMagic == BLOOM_MAGIC &&
+					pstBloom->stHeader.ulBitCount > 0 &&
+					pstBloom->stHeader.ulHashCount > 0 &&
+					pstBloom->stHeader.ulHashCount <= BLOOM_MAX_HASHES);
+		if(blReturn != true)
+		{
+			memset(&pstBloom->stHeader, 0, sizeof(BLOOM_HEADER));
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open the serial filter of a data file
+//Inputs	: pucDataPath, name of the data or shard file
+//Outputs	: pstBloom, the open filter
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A missing or outdated filter is rebuilt, a new filter gets the
+//			  default false positive rate. The caller has to be the only
+//			  writer of the data file.
+//******************************************************************************
+bool bloomOpen(const uint8 *pucDataPath, BLOOM *pstBloom)
+{
+	bool blReturn = false;
+	FILE_IDENTITY stCurrent = {0};
+
+	if(pucDataPath != NULL && pstBloom != NULL)
+	{
+		blReturn = bloomOpenFile(pucDataPath, O_RDWR | O_CREAT, pstBloom);
+		if(pstBloom->lFd != BLOOM_INVALID_FD)
+		{
+			fileGetIdentity(pucDataPath, &stCurrent);
+			if(blReturn != true)
+			{
+				blReturn = bloomBuild(pstBloom, BLOOM_MIN_KEYS,
+									  BLOOM_DEFAULT_RATE_PPM);
+			}
+			else if(fileSameIdentity(&pstBloom->stHeader.stData,
+									 &stCurrent) != true)
+			{
+				blReturn = bloomBuild(pstBloom, BLOOM_MIN_KEYS,
+									  pstBloom->stHeader.ulRatePpm);
+			}
+
+			if(blReturn != true)
+			{
+				close(pstBloom->lFd);
+				pstBloom->lFd = BLOOM_INVALID_FD;
+			}
+		}
+		else
+		{
+			printf("\nUnable to open the serial filter : Open failed");
+		}
+	}
+	else
+	{
+		printf("\nUnable to open the serial filter : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To check whether a key may be in the filter
+//Inputs	: pstBloom, the filter
+//Inputs	: ulKey, the key
+//Outputs	: None
+//Return	: True, if the key may have been inserted
+//Return	: False, if the key has certainly not been inserted
+//Notes		: A read error answers true, so the caller checks the data
+//******************************************************************************
+bool bloomMayContain(BLOOM *pstBloom, uint32 ulKey)
+{
+	bool blReturn = true;
+	uint32 pulBits[BLOOM_MAX_HASHES];
+	uint32 ulHash = 0;
+	uint8 ucByte = 0;
+
+	if(pstBloom != NULL && pstBloom->lFd != BLOOM_INVALID_FD)
+	{
+		bloomPositions(&pstBloom->stHeader, ulKey, pulBits);
+		for(ulHash = 0; ulHash < pstBloom->stHeader.ulHashCount &&
+			blReturn == true; ulHash++)
+		{
+			if(pread(pstBloom->lFd, &ucByte, sizeof(ucByte),
+					 sizeof(BLOOM_HEADER) +
+					 pulBits[ulHash] / BITS_PER_BYTE) == sizeof(ucByte))
+			{
+				blReturn = ((ucByte >> (pulBits[ulHash] % BITS_PER_BYTE)) & 1);
+			}
+		}
+
+		if(blReturn == true)
+		{
+			pstBloom->stHeader.ulPositives++;
+		}
+		else
+		{
+			pstBloom->stHeader.ulNegatives++;
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To count a key found in the filter but not in the data
+//Inputs	: pstBloom, the filter
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+void bloomFalsePositive(BLOOM *pstBloom)
+{
+	if(pstBloom != NULL)
+	{
+		pstBloom->stHeader.ulFalsePositives++;
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To insert a key into the filter
+//Inputs	: pstBloom, the filter
+//Inputs	: ulKey, the key
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Called once the record is in the data file. A full filter is
+//			  rebuilt twice as large from the data file, which holds the key.
+//******************************************************************************
+bool bloomInsert(BLOOM *pstBloom, uint32 ulKey)
+{
+	bool blReturn = false;
+	uint32 pulBits[BLOOM_MAX_HASHES];
+	uint32 ulHash = 0;
+	uint8 ucByte = 0;
+	off_t lOffset = 0;
+
+	if(pstBloom != NULL && pstBloom->lFd != BLOOM_INVALID_FD)
+	{
+		blReturn = true;
+		if(pstBloom->stHeader.ulKeyCount >= pstBloom->stHeader.ulKeyCapacity)
+		{
+			blReturn = bloomBuild(pstBloom,
+								  pstBloom->stHeader.ulKeyCapacity * 2,
+								  pstBloom->stHeader.ulRatePpm);
+		}
+		else
+		{
+			bloomPositions(&pstBloom->stHeader, ulKey, pulBits);
+			for(ulHash = 0; ulHash < pstBloom->stHeader.ulHashCount &&
+				blReturn == true; ulHash++)
+			{
+				lOffset = sizeof(BLOOM_HEADER) +
+						  pulBits[ulHash] / BITS_PER_BYTE;
+				blReturn = (pread(pstBloom->lFd, &ucByte, sizeof(ucByte),
+								  lOffset) == sizeof(ucByte));
+				if(blReturn == true)
+				{
+					ucByte |= 1 << (pulBits[ulHash] % BITS_PER_BYTE);
+					blReturn = (pwrite(pstBloom->lFd, &ucByte, sizeof(ucByte),
+									   lOffset) == sizeof(ucByte));
+				}
+			}
+			pstBloom->stHeader.ulKeyCount++;
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To rebuild the filter with a new false positive rate
+//Inputs	: pstBloom, the open filter
+//Inputs	: ulRatePpm, false positive rate in parts per million
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool bloomRebuild(BLOOM *pstBloom, uint32 ulRatePpm)
+{
+	bool blReturn = false;
+
+	if(pstBloom != NULL && pstBloom->lFd != BLOOM_INVALID_FD &&
+	   ulRatePpm > 0 && ulRatePpm < BLOOM_PPM)
+	{
+		blReturn = bloomBuild(pstBloom, BLOOM_MIN_KEYS, ulRatePpm);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To mark the filter as describing the current data file
+//Inputs	: pstBloom, the filter
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Called after the data file and the filter have been changed
+//			  consistently
+//******************************************************************************
+bool bloomSync(BLOOM *pstBloom)
+{
+	bool blReturn = false;
+
+	if(pstBloom != NULL && pstBloom->lFd != BLOOM_INVALID_FD)
+	{
+		fileGetIdentity(pstBloom->pucDataPath, &pstBloom->stHeader.stData);
+		blReturn = bloomWriteHeader(pstBloom);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To close the filter
+//Inputs	: pstBloom, the filter
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The query statistics are saved
+//******************************************************************************
+bool bloomClose(BLOOM *pstBloom)
+{
+	bool blReturn = false;
+
+	if(pstBloom != NULL && pstBloom->lFd != BLOOM_INVALID_FD)
+	{
+		blReturn = bloomWriteHeader(pstBloom);
+		if(close(pstBloom->lFd) != 0)
+		{
+			blReturn = false;
+		}
+		pstBloom->lFd = BLOOM_INVALID_FD;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To keep a filter valid over a change removing or updating
+//			  records
+//Inputs	: pucDataPath, name of the data or shard file
+//Inputs	: pstBefore, identity of the data file before the change
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The serials of the changed file are a subset of the filter
+//			  keys, so the filter only has to be tagged with the new
+//			  identity. A filter not matching pstBefore is left as it is.
+//******************************************************************************
+bool bloomRetag(const uint8 *pucDataPath, const FILE_IDENTITY *pstBefore)
+{
+	bool blReturn = true;
+	BLOOM stBloom = {BLOOM_INVALID_FD, "", {0}};
+
+	if(pucDataPath != NULL && pstBefore != NULL &&
+	   bloomOpenFile(pucDataPath, O_RDWR, &stBloom) == true &&
+	   fileSameIdentity(&stBloom.stHeader.stData, pstBefore) == true)
+	{
+		blReturn = bloomSync(&stBloom);
+	}
+
+	if(stBloom.lFd != BLOOM_INVALID_FD)
+	{
+		close(stBloom.lFd);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To set the false positive rate of the filters of all shards
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulRatePpm, false positive rate in parts per million
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Every filter is rebuilt with the new rate
+//******************************************************************************
+bool bloomConfigure(const uint8 *pucFileName, uint32 ulRatePpm)
+{
+	bool blReturn = false;
+	BLOOM stBloom;
+	SHARD_LAYOUT stLayout = {0};
+	SNAPSHOT_WRITER stWriter;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+
+	if(pucFileName != NULL && ulRatePpm > 0 && ulRatePpm < BLOOM_PPM &&
+	   snapshotWriterBegin(pucFileName, &stWriter) == true)
+	{
+		blReturn = shardGetLayout(pucFileName, &stLayout);
+		for(ulShard = 0; ulShard < stLayout.ulShardCount && blReturn == true;
+			ulShard++)
+		{
+			blReturn = (shardGetPath(pucFileName, &stLayout, ulShard,
+									 pucPath) == true &&
+						bloomOpen(pucPath, &stBloom) == true);
+			if(blReturn == true)
+			{
+				blReturn = bloomRebuild(&stBloom, ulRatePpm);
+				bloomClose(&stBloom);
+			}
+		}
+		snapshotWriterEnd(&stWriter);
+	}
+	else
+	{
+		printf("\nUnable to configure the serial filters : Invalid rate");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the state and the statistics of the filters
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The expected false positive rate is the one of the current
+//			  number of keys, (1 - e^(-kn/m))^k
+//******************************************************************************
+bool bloomShow(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	BLOOM stBloom = {BLOOM_INVALID_FD, "", {0}};
+	BLOOM_HEADER *pstHeader = &stBloom.stHeader;
+	FILE_IDENTITY stCurrent = {0};
+	SHARD_LAYOUT stLayout = {0};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+	double dExpected = 0;
+
+	if(pucFileName != NULL)
+	{
+		blReturn = shardGetLayout(pucFileName, &stLayout);
+		printf("\nSerial filters\n");
+		printf("-----------------------------\n");
+		printf("Shard\tKeys\tBits\tHashes\tRate\tExpected\tNegatives\t"
+			   "Positives\tFalse positives\n");
+		for(ulShard = 0; ulShard < stLayout.ulShardCount && blReturn == true;
+			ulShard++)
+		{
+			blReturn = shardGetPath(pucFileName, &stLayout, ulShard, pucPath);
+			if(blReturn == true &&
+			   bloomOpenFile(pucPath, O_RDONLY, &stBloom) == true)
+			{
+				fileGetIdentity(pucPath, &stCurrent);
+				dExpected = pow(1 - exp(-(double)pstHeader->ulHashCount *
+										pstHeader->ulKeyCount /
+										pstHeader->ulBitCount),
+								pstHeader->ulHashCount);
+				printf("%lu\t%lu\t%lu\t%lu\t%.4f\t%.6f\t%lu\t\t%lu\t\t%lu%s\n",
+					   ulShard, pstHeader->ulKeyCount, pstHeader->ulBitCount,
+					   pstHeader->ulHashCount,
+					   (double)pstHeader->ulRatePpm / BLOOM_PPM, dExpected,
+					   pstHeader->ulNegatives, pstHeader->ulPositives,
+					   pstHeader->ulFalsePositives,
+					   fileSameIdentity(&pstHeader->stData, &stCurrent) == true
+					   ? "" : "\t(out of date)");
+			}
+			else if(blReturn == true)
+			{
+				printf("%lu\tnot built\n", ulShard);
+			}
+
+			if(stBloom.lFd != BLOOM_INVALID_FD)
+			{
+				close(stBloom.lFd);
+				stBloom.lFd = BLOOM_INVALID_FD;
+			}
+		}
+	}
+	else
+	{
+		printf("\nUnable to show the serial filters : Missing file name");
+	}
+
+	return blReturn;
+}
+// EOF
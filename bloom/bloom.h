@@ -0,0 +1,66 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Persisted Bloom filter of the serials of a data file
+// Note		: Tells that a serial is certainly not used without reading the
+//			  data file or its index
+//
+//******************************************************************************
+
+#ifndef _BLOOM_H_
+#define _BLOOM_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "file.h"
+
+//******************************* Global Types *********************************
+typedef struct _BLOOM_HEADER_
+{
+	uint32 ulMagic;
+	FILE_IDENTITY stData;
+	uint32 ulBitCount;
+	uint32 ulHashCount;
+	uint32 ulKeyCount;
+	uint32 ulKeyCapacity;
+	uint32 ulRatePpm;
+	uint32 ulNegatives;
+	uint32 ulPositives;
+	uint32 ulFalsePositives;
+} BLOOM_HEADER;
+
+typedef struct _BLOOM_
+{
+	int32 lFd;
+	uint8 pucDataPath[FILE_PATH_MAX_SIZE];
+	BLOOM_HEADER stHeader;
+} BLOOM;
+
+//***************************** Global Constants *******************************
+#define BLOOM_SUFFIX			(".bloom")
+#define BLOOM_MAGIC				(0x4D4F4C42UL)
+#define BLOOM_MIN_KEYS			(1024)
+#define BLOOM_PPM				(1000000UL)
+#define BLOOM_DEFAULT_RATE_PPM	(10000UL)
+#define BLOOM_INVALID_FD		(-1)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool bloomOpen(const uint8 *pucDataPath, BLOOM *pstBloom);
+bool bloomMayContain(BLOOM *pstBloom, uint32 ulKey);
+void bloomFalsePositive(BLOOM *pstBloom);
+bool bloomInsert(BLOOM *pstBloom, uint32 ulKey);
+bool bloomRebuild(BLOOM *pstBloom, uint32 ulRatePpm);
+bool bloomSync(BLOOM *pstBloom);
+bool bloomClose(BLOOM *pstBloom);
+bool bloomRetag(const uint8 *pucDataPath, const FILE_IDENTITY *pstBefore);
+bool bloomConfigure(const uint8 *pucFileName, uint32 ulRatePpm);
+bool bloomShow(const uint8 *pucFileName);
+
+#endif // _BLOOM_H_
+// EOF
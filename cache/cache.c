@@ -0,0 +1,604 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: cache.c
+// Summary	: Shared memory cache of the serial, name and type indexes
+// Note		: The shared memory object is named after the device and inode
+//			  of "<data file>.cache", so every process using the same data
+//			  files finds the same object. It holds a header, the device
+//			  records in shard and file order, an open addressing table of
+//			  serial slots and hash buckets of the names and types, each
+//			  bucket chaining its records in file order. Nothing in it is
+//			  an address, it is mapped read only and used in place. The
+//			  header records the generation, the shard layout and the
+//			  identity of every shard it was built from and it is only used
+//			  while all of them still match. Readers hold a shared lock on
+//			  "<data file>.cache", a process rebuilding the object holds it
+//			  exclusively and never waits for it, a search arriving while
+//			  another process holds the lock reads the data files instead.
+//			  A stale cache is only rebuilt by a search by name or type,
+//			  which would read every record anyway.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "menu.h"
+#include "file.h"
+#include "crc.h"
+#include "hash.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "cache.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define FILE_PERMISSIONS		(0644)
+#define CACHE_NAME_FORMAT		("/devstore.%lx.%lx")
+#define CACHE_EMPTY				(0)
+#define CACHE_MIN_SLOTS			(1024)
+#define CACHE_LOAD_FACTOR		(2)
+#define CACHE_MEGABYTE			(1024.0 * 1024.0)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open the lock file of the cache and name its object
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pstCache, the cache with its lock file and object name
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Nothing is mapped yet, the cache is closed with cacheClose()
+//			  even when this fails
+//******************************************************************************
+static bool cacheOpen(const uint8 *pucFileName, CACHE *pstCache)
+{
+	bool blReturn = false;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	struct stat stStatus;
+
+	memset(pstCache, 0, sizeof(CACHE));
+	pstCache->lLockFd = CACHE_INVALID_FD;
+	if(pucFileName != NULL &&
+	   fileBuildPath(pucPath, pucFileName, CACHE_SUFFIX) == true)
+	{
+		pstCache->lLockFd = open((char *)pucPath, O_RDWR | O_CREAT,
+								 FILE_PERMISSIONS);
+	}
+
+	if(pstCache->lLockFd != CACHE_INVALID_FD &&
+	   fstat(pstCache->lLockFd, &stStatus) == 0)
+	{
+		snprintf((char *)pstCache->pucName, sizeof(pstCache->pucName),
+				 CACHE_NAME_FORMAT, (uint32)stStatus.st_dev,
+				 (uint32)stStatus.st_ino);
+		blReturn = true;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compute the size of a cache object
+//Inputs	: ulRecordCount, number of records
+//Inputs	: ulSlotCount, number of serial slots
+//Inputs	: ulBucketCount, number of name and of type buckets
+//Outputs	: None
+//Return	: The size in bytes
+//Notes		:
+//******************************************************************************
+static uint32 cacheSize(uint32 ulRecordCount, uint32 ulSlotCount,
+						uint32 ulBucketCount)
+{
+	return sizeof(CACHE_HEADER) + ulRecordCount * sizeof(DEVICE_DETAILS) +
+		   (2 * ulRecordCount + ulSlotCount + 2 * ulBucketCount) *
+		   sizeof(uint32);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To point the parts of a cache into its mapping
+//Inputs	: pstCache, the cache with its header mapped
+//Outputs	: pstCache, the records, chains, slots and buckets
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void cacheLocate(CACHE *pstCache)
+{
+	CACHE_HEADER *pstHeader = pstCache->pstHeader;
+
+	pstCache->pstRecords = (DEVICE_DETAILS *)(pstHeader + 1);
+	pstCache->pulNameNext = (uint32 *)(pstCache->pstRecords +
+									   pstHeader->ulRecordCount);
+	pstCache->pulTypeNext = pstCache->pulNameNext + pstHeader->ulRecordCount;
+	pstCache->pulSlots = pstCache->pulTypeNext + pstHeader->ulRecordCount;
+	pstCache->pulNameBuckets = pstCache->pulSlots + pstHeader->ulSlotCount;
+	pstCache->pulTypeBuckets = pstCache->pulNameBuckets +
+							   pstHeader->ulBucketCount;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To map the cache object
+//Inputs	: pstCache, the cache with its object name
+//Inputs	: ulSize, size of the object to be created, 0 to map the existing
+//			  object read only
+//Outputs	: pstCache, the mapping and its header
+//Return	: True, at time of successful execution
+//Return	: False, if there is no object or it cannot be mapped
+//Notes		: A created object is cleared first, so all its slots and
+//			  buckets are empty
+//******************************************************************************
+static bool cacheMap(CACHE *pstCache, uint32 ulSize)
+{
+	bool blReturn = false;
+	bool blCreate = (ulSize > 0);
+	struct stat stStatus;
+	int32 lFd = CACHE_INVALID_FD;
+
+	lFd = shm_open((char *)pstCache->pucName,
+				   (blCreate == true) ? O_RDWR | O_CREAT : O_RDONLY,
+				   FILE_PERMISSIONS);
+	if(lFd != CACHE_INVALID_FD)
+	{
+		if(blCreate == true)
+		{
+			blReturn = (ftruncate(lFd, 0) == 0 && ftruncate(lFd, ulSize) == 0);
+		}
+		else
+		{
+			blReturn = (fstat(lFd, &stStatus) == 0 &&
+						stStatus.st_size >= (off_t)sizeof(CACHE_HEADER));
+			ulSize = stStatus.st_size;
+		}
+
+		if(blReturn == true)
+		{
+			pstCache->pvBase = mmap(NULL, ulSize, (blCreate == true) ?
+									PROT_READ | PROT_WRITE : PROT_READ,
+									MAP_SHARED, lFd, 0);
+			blReturn = (pstCache->pvBase != MAP_FAILED);
+		}
+		close(lFd);
+	}
+
+	if(blReturn == true)
+	{
+		pstCache->ulSize = ulSize;
+		pstCache->pstHeader = pstCache->pvBase;
+	}
+	else
+	{
+		pstCache->pvBase = NULL;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To unmap the cache object
+//Inputs	: pstCache, the cache
+//Outputs	: None
+//Return	: None
+//Notes		: The lock is kept
+//******************************************************************************
+static void cacheUnmap(CACHE *pstCache)
+{
+	if(pstCache->pvBase != NULL)
+	{
+		munmap(pstCache->pvBase, pstCache->ulSize);
+	}
+	pstCache->pvBase = NULL;
+	pstCache->pstHeader = NULL;
+	pstCache->ulSize = 0;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To unmap the cache object and release its lock
+//Inputs	: pstCache, the cache
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void cacheClose(CACHE *pstCache)
+{
+	cacheUnmap(pstCache);
+	if(pstCache->lLockFd != CACHE_INVALID_FD)
+	{
+		close(pstCache->lLockFd);
+	}
+	pstCache->lLockFd = CACHE_INVALID_FD;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To tell whether a mapped cache describes the device data
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstCache, the mapped cache
+//Outputs	: pstCache, its parts located when it is current
+//Return	: True, if the generation, the layout and every shard match
+//Return	: False, otherwise
+//Notes		: The generation is read last, a change published after it is
+//			  ordered after the search
+//******************************************************************************
+static bool cacheIsCurrent(const uint8 *pucFileName, CACHE *pstCache)
+{
+	bool blReturn = false;
+	CACHE_HEADER *pstHeader = pstCache->pstHeader;
+	SHARD_LAYOUT stLayout = {0};
+	FILE_IDENTITY stIdentity = {0};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulGeneration = 0;
+	uint32 ulShard = 0;
+
+	blReturn = (pstHeader != NULL && pstHeader->ulMagic == CACHE_MAGIC &&
+				pstHeader->ulSize == pstCache->ulSize &&
+				pstHeader->ulSize == cacheSize(pstHeader->ulRecordCount,
+											   pstHeader->ulSlotCount,
+											   pstHeader->ulBucketCount) &&
+				pstHeader->ulSlotCount >= pstHeader->ulRecordCount *
+										  CACHE_LOAD_FACTOR &&
+				(pstHeader->ulSlotCount & (pstHeader->ulSlotCount - 1)) == 0 &&
+				pstHeader->ulBucketCount > 0 &&
+				shardGetLayout(pucFileName, &stLayout) == true &&
+				stLayout.ulShardCount == pstHeader->stLayout.ulShardCount &&
+				stLayout.blSharded == pstHeader->stLayout.blSharded);
+
+	for(ulShard = 0; ulShard < stLayout.ulShardCount && blReturn == true;
+		ulShard++)
+	{
+		blReturn = shardGetPath(pucFileName, &stLayout, ulShard, pucPath);
+		fileGetIdentity(pucPath, &stIdentity);
+		blReturn = (blReturn == true &&
+					memcmp(&stIdentity, &pstHeader->pstShards[ulShard],
+						   sizeof(FILE_IDENTITY)) == 0);
+	}
+
+	if(blReturn == true)
+	{
+		blReturn = (snapshotGetGeneration(pucFileName, &ulGeneration) == true &&
+					ulGeneration == pstHeader->ulGeneration);
+	}
+	if(blReturn == true)
+	{
+		cacheLocate(pstCache);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To hash a name or a type
+//Inputs	: pucString, the string, at most STR_MAX_SIZE bytes
+//Outputs	: None
+//Return	: The hash
+//Notes		:
+//******************************************************************************
+static uint32 cacheHashString(const uint8 *pucString)
+{
+	return crc32c(CRC_INITIAL, pucString, strnlen((char *)pucString,
+												  STR_MAX_SIZE));
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To rebuild the cache object from a snapshot of the device data
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstCache, the cache, its lock held exclusively
+//Outputs	: pstCache, the object mapped
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The magic number is written last, an object left half built
+//			  is never used
+//******************************************************************************
+static bool cacheBuild(const uint8 *pucFileName, CACHE *pstCache)
+{
+	bool blReturn = false;
+	CACHE_HEADER *pstHeader = NULL;
+	SNAPSHOT stSnapshot;
+	SHARD_LAYOUT stLayout = {0};
+	uint32 ulRecordCount = 0;
+	uint32 ulSlotCount = CACHE_MIN_SLOTS;
+	uint32 ulRecord = 0;
+	uint32 ulSlot = 0;
+	uint32 ulBucket = 0;
+	uint32 ulShard = 0;
+
+	if(shardAcquireSnapshot(pucFileName, &stSnapshot, &stLayout) != true)
+	{
+		return false;
+	}
+
+	for(ulShard = 0; ulShard < stSnapshot.ulFileCount; ulShard++)
+	{
+		ulRecordCount += stSnapshot.pulRecordCounts[ulShard];
+	}
+	while(ulSlotCount < ulRecordCount * CACHE_LOAD_FACTOR)
+	{
+		ulSlotCount *= 2;
+	}
+
+	blReturn = cacheMap(pstCache, cacheSize(ulRecordCount, ulSlotCount,
+											ulSlotCount / CACHE_LOAD_FACTOR));
+	if(blReturn == true)
+	{
+		pstHeader = pstCache->pstHeader;
+		pstHeader->ulGeneration = stSnapshot.ulGeneration;
+		pstHeader->stLayout = stLayout;
+		pstHeader->ulRecordCount = ulRecordCount;
+		pstHeader->ulSlotCount = ulSlotCount;
+		pstHeader->ulBucketCount = ulSlotCount / CACHE_LOAD_FACTOR;
+		pstHeader->ulSize = pstCache->ulSize;
+		cacheLocate(pstCache);
+	}
+
+	for(ulShard = 0; ulShard < stSnapshot.ulFileCount && blReturn == true;
+		ulShard++)
+	{
+		fileGetOpenIdentity(stSnapshot.pstFiles[ulShard],
+							&pstHeader->pstShards[ulShard]);
+		while(ulRecord < ulRecordCount &&
+			  snapshotRead(&stSnapshot, ulShard,
+						   &pstCache->pstRecords[ulRecord]) == true)
+		{
+			ulRecord++;
+		}
+	}
+	blReturn = (blReturn == true && ulRecord == ulRecordCount);
+
+	// Walking backwards leaves every chain in file order
+	for(ulRecord = ulRecordCount; ulRecord > 0 && blReturn == true;
+		ulRecord--)
+	{
+		ulSlot = hashMix(pstCache->pstRecords[ulRecord - 1].ulDeviceSerial) &
+				 (ulSlotCount - 1);
+		while(pstCache->pulSlots[ulSlot] != CACHE_EMPTY)
+		{
+			ulSlot = (ulSlot + 1) & (ulSlotCount - 1);
+		}
+		pstCache->pulSlots[ulSlot] = ulRecord;
+
+		ulBucket = cacheHashString(
+					pstCache->pstRecords[ulRecord - 1].pucDeviceName) %
+				   pstHeader->ulBucketCount;
+		pstCache->pulNameNext[ulRecord - 1] =
+			pstCache->pulNameBuckets[ulBucket];
+		pstCache->pulNameBuckets[ulBucket] = ulRecord;
+
+		ulBucket = cacheHashString(
+					pstCache->pstRecords[ulRecord - 1].pucDeviceType) %
+				   pstHeader->ulBucketCount;
+		pstCache->pulTypeNext[ulRecord - 1] =
+			pstCache->pulTypeBuckets[ulBucket];
+		pstCache->pulTypeBuckets[ulBucket] = ulRecord;
+	}
+	snapshotRelease(&stSnapshot);
+
+	if(blReturn == true)
+	{
+		pstHeader->ulMagic = CACHE_MAGIC;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To collect the matching devices from a current cache
+//Inputs	: pstCache, the current cache
+//Inputs	: pstCriteria, a search by serial, name or type
+//Outputs	: pstResult, the matching devices appended in file order
+//Return	: True, at time of successful execution
+//Return	: False, when out of memory
+//Notes		: The records of a bucket or slot run are matched in full, equal
+//			  hashes are not taken for equal values
+//******************************************************************************
+static bool cacheAnswer(const CACHE *pstCache,
+						const DEVICE_CRITERIA *pstCriteria,
+						SHARD_RESULT *pstResult)
+{
+	bool blReturn = true;
+	const uint32 *pulNext = NULL;
+	uint32 ulMask = pstCache->pstHeader->ulSlotCount - 1;
+	uint32 ulSlot = 0;
+	uint32 ulRecord = 0;
+
+	if(pstCriteria->ulChoice == SEARCH_BY_SERIAL)
+	{
+		for(ulSlot = hashMix(pstCriteria->ulValue) & ulMask;
+			pstCache->pulSlots[ulSlot] != CACHE_EMPTY && blReturn == true;
+			ulSlot = (ulSlot + 1) & ulMask)
+		{
+			ulRecord = pstCache->pulSlots[ulSlot];
+			if(deviceMatchCriteria(&pstCache->pstRecords[ulRecord - 1],
+								   pstCriteria) == true)
+			{
+				blReturn = shardResultAppend(pstResult,
+										&pstCache->pstRecords[ulRecord - 1]);
+			}
+		}
+	}
+	else
+	{
+		ulRecord = cacheHashString(pstCriteria->pucString) %
+				   pstCache->pstHeader->ulBucketCount;
+		if(pstCriteria->ulChoice == SEARCH_BY_NAME)
+		{
+			pulNext = pstCache->pulNameNext;
+			ulRecord = pstCache->pulNameBuckets[ulRecord];
+		}
+		else
+		{
+			pulNext = pstCache->pulTypeNext;
+			ulRecord = pstCache->pulTypeBuckets[ulRecord];
+		}
+
+		for(; ulRecord != CACHE_EMPTY && blReturn == true;
+			ulRecord = pulNext[ulRecord - 1])
+		{
+			if(deviceMatchCriteria(&pstCache->pstRecords[ulRecord - 1],
+								   pstCriteria) == true)
+			{
+				blReturn = shardResultAppend(pstResult,
+										&pstCache->pstRecords[ulRecord - 1]);
+			}
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To search the devices through the shared cache
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstCriteria, the search criteria
+//Outputs	: pstResult, the matching devices appended in shard and file
+//			  order
+//Return	: True, if the search has been answered by the cache
+//Return	: False, if the data files have to be searched instead, nothing
+//			  is appended
+//Notes		: Only searches by serial, name or type are answered. A missing
+//			  or stale cache is rebuilt by a search by name or type when no
+//			  other process holds its lock.
+//******************************************************************************
+bool cacheCollect(const uint8 *pucFileName, const DEVICE_CRITERIA *pstCriteria,
+				  SHARD_RESULT *pstResult)
+{
+	bool blReturn = false;
+	CACHE stCache;
+	uint32 ulCount = 0;
+
+	if(pstCriteria == NULL || pstResult == NULL ||
+	   (pstCriteria->ulChoice != SEARCH_BY_SERIAL &&
+		pstCriteria->ulChoice != SEARCH_BY_NAME &&
+		pstCriteria->ulChoice != SEARCH_BY_TYPE))
+	{
+		return false;
+	}
+
+	ulCount = pstResult->ulCount;
+	if(cacheOpen(pucFileName, &stCache) == true &&
+	   flock(stCache.lLockFd, LOCK_SH | LOCK_NB) == 0)
+	{
+		blReturn = (cacheMap(&stCache, 0) == true &&
+					cacheIsCurrent(pucFileName, &stCache) == true);
+		if(blReturn != true && pstCriteria->ulChoice != SEARCH_BY_SERIAL &&
+		   flock(stCache.lLockFd, LOCK_EX | LOCK_NB) == 0)
+		{
+			cacheUnmap(&stCache);
+			blReturn = (cacheMap(&stCache, 0) == true &&
+						cacheIsCurrent(pucFileName, &stCache) == true);
+			if(blReturn != true)
+			{
+				cacheUnmap(&stCache);
+				blReturn = cacheBuild(pucFileName, &stCache);
+			}
+		}
+
+		blReturn = (blReturn == true &&
+					cacheAnswer(&stCache, pstCriteria, pstResult) == true);
+	}
+	cacheClose(&stCache);
+
+	if(blReturn != true)
+	{
+		pstResult->ulCount = ulCount;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the state of the shared cache
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool cacheShow(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	CACHE stCache;
+
+	if(cacheOpen(pucFileName, &stCache) == true &&
+	   flock(stCache.lLockFd, LOCK_SH) == 0)
+	{
+		blReturn = true;
+		if(cacheMap(&stCache, 0) == true &&
+		   stCache.pstHeader->ulMagic == CACHE_MAGIC)
+		{
+			printf("\n Cache %s : %lu device(s) of generation %lu, %.1f MB, "
+				   "%s\n", (char *)stCache.pucName,
+				   stCache.pstHeader->ulRecordCount,
+				   stCache.pstHeader->ulGeneration,
+				   stCache.ulSize / CACHE_MEGABYTE,
+				   (cacheIsCurrent(pucFileName, &stCache) == true) ?
+				   "current" : "stale");
+		}
+		else
+		{
+			printf("\n Cache %s : not built\n", (char *)stCache.pucName);
+		}
+	}
+	else
+	{
+		printf("\nUnable to read the cache : Invalid parameters");
+	}
+	cacheClose(&stCache);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the shared cache
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Waits for the processes reading it, the next search by name or
+//			  type builds a new one
+//******************************************************************************
+bool cacheDrop(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	CACHE stCache;
+
+	if(cacheOpen(pucFileName, &stCache) == true &&
+	   flock(stCache.lLockFd, LOCK_EX) == 0)
+	{
+		blReturn = (shm_unlink((char *)stCache.pucName) == 0 ||
+					errno == ENOENT);
+		if(blReturn != true)
+		{
+			printf("\nUnable to remove the cache %s",
+				   (char *)stCache.pucName);
+		}
+	}
+	else
+	{
+		printf("\nUnable to remove the cache : Invalid parameters");
+	}
+	cacheClose(&stCache);
+
+	return blReturn;
+}
+// EOF
@@ -0,0 +1,68 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Shared memory cache of the serial, name and type indexes
+// Note		: Built by the first process finding it missing or out of date,
+//			  then read in place by every process on the host until the
+//			  generation of the device data moves on
+//
+//******************************************************************************
+
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "shard.h"
+
+//******************************* Global Types *********************************
+// Followed by ulRecordCount records, the name and type chains linking
+// them, ulSlotCount serial slots and ulBucketCount name and type buckets
+typedef struct _CACHE_HEADER_
+{
+	uint32 ulMagic;
+	uint32 ulGeneration;
+	SHARD_LAYOUT stLayout;
+	FILE_IDENTITY pstShards[SHARD_MAX_COUNT];
+	uint32 ulRecordCount;
+	uint32 ulSlotCount;
+	uint32 ulBucketCount;
+	uint32 ulSize;
+} CACHE_HEADER;
+
+typedef struct _CACHE_
+{
+	int32 lLockFd;
+	uint8 pucName[FILE_PATH_MAX_SIZE];
+	void *pvBase;
+	uint32 ulSize;
+	CACHE_HEADER *pstHeader;
+	DEVICE_DETAILS *pstRecords;
+	uint32 *pulNameNext;
+	uint32 *pulTypeNext;
+	uint32 *pulSlots;
+	uint32 *pulNameBuckets;
+	uint32 *pulTypeBuckets;
+} CACHE;
+
+//***************************** Global Constants *******************************
+#define CACHE_SUFFIX		(".cache")
+#define CACHE_MAGIC			(0x45484341UL)
+#define CACHE_INVALID_FD	(-1)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool cacheCollect(const uint8 *pucFileName, const DEVICE_CRITERIA *pstCriteria,
+				  SHARD_RESULT *pstResult);
+bool cacheShow(const uint8 *pucFileName);
+bool cacheDrop(const uint8 *pucFileName);
+
+#endif // _CACHE_H_
+// EOF
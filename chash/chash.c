@@ -0,0 +1,773 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: chash.c
+// Summary	: Concurrent hash index of the devices by serial
+// Note		: Open addressing with linear probing over atomic slots. A
+//			  reader publishes the epoch it entered on its own cache line,
+//			  probes and copies the device out, then goes idle again. A
+//			  writer holds the resize lock shared and the lock of the stripe
+//			  of its serial, claims a free slot with a compare and swap and
+//			  swaps in a new immutable version of the device. Replaced
+//			  versions and tables are retired with the epoch they left at,
+//			  the epoch moves on once every busy reader has seen it and
+//			  what was retired two epochs before is freed.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "hash.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "chash.h"
+
+//******************************* Local Types **********************************
+typedef struct _CHASH_WORKER_
+{
+	CHASH *pstMap;
+	const uint32 *pulSerials;
+	uint32 ulSerialCount;
+	uint32 ulReader;
+	uint32 ulSeed;
+	uint32 ulFound;
+	bool blStatus;
+} CHASH_WORKER;
+
+//***************************** Local Constants ********************************
+#define CHASH_MIN_CAPACITY		(16)
+#define CHASH_LOAD_NUMERATOR	(1)
+#define CHASH_LOAD_DENOMINATOR	(2)
+#define CHASH_GROWTH			(4)
+#define CHASH_RECLAIM_BATCH		(64)
+#define CHASH_SAFE_EPOCHS		(2)
+#define CHASH_BENCH_OPERATIONS	(2000000)
+// One operation in CHASH_BENCH_WRITE_RATIO replaces the device it read
+#define CHASH_BENCH_WRITE_RATIO	(100)
+#define CHASH_NANOSECONDS		(1e9)
+#define CHASH_MILLISECONDS		(1e3)
+#define CHASH_MILLION			(1e6)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To allocate a table with all its slots free
+//Inputs	: ulCapacity, number of slots, a power of two
+//Outputs	: None
+//Return	: The table, NULL when out of memory
+//Notes		:
+//******************************************************************************
+static CHASH_TABLE *chashAllocate(uint32 ulCapacity)
+{
+	CHASH_TABLE *pstTable = NULL;
+	uint32 ulSlot = 0;
+
+	pstTable = malloc(sizeof(CHASH_TABLE) + ulCapacity * sizeof(CHASH_SLOT));
+	if(pstTable != NULL)
+	{
+		pstTable->ulCapacity = ulCapacity;
+		for(ulSlot = 0; ulSlot < ulCapacity; ulSlot++)
+		{
+			atomic_init(&pstTable->pstSlots[ulSlot].ulKey, CHASH_EMPTY);
+			atomic_init(&pstTable->pstSlots[ulSlot].pstDevice, NULL);
+		}
+	}
+
+	return pstTable;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To move the epoch on and to free what no reader can hold
+//Inputs	: pstMap, the index, with its retire lock held
+//Outputs	: None
+//Return	: None
+//Notes		: A reader busy in an older epoch keeps the epoch where it is
+//******************************************************************************
+static void chashReclaim(CHASH *pstMap)
+{
+	bool blAdvance = true;
+	uint32 ulEpoch = atomic_load(&pstMap->ulEpoch);
+	uint32 ulReaderCount = atomic_load(&pstMap->ulReaderCount);
+	uint32 ulReaderEpoch = 0;
+	uint32 ulIndex = 0;
+	uint32 ulKept = 0;
+
+	for(ulIndex = 0; ulIndex < ulReaderCount && blAdvance == true; ulIndex++)
+	{
+		ulReaderEpoch = atomic_load(&pstMap->pstReaders[ulIndex].ulEpoch);
+		blAdvance = (ulReaderEpoch == CHASH_IDLE || ulReaderEpoch == ulEpoch);
+	}
+	if(blAdvance == true)
+	{
+		atomic_store(&pstMap->ulEpoch, ++ulEpoch);
+	}
+
+	for(ulIndex = 0; ulIndex < pstMap->ulRetiredCount; ulIndex++)
+	{
+		if(pstMap->pstRetired[ulIndex].ulEpoch + CHASH_SAFE_EPOCHS <= ulEpoch)
+		{
+			free(pstMap->pstRetired[ulIndex].pvMemory);
+		}
+		else
+		{
+			pstMap->pstRetired[ulKept++] = pstMap->pstRetired[ulIndex];
+		}
+	}
+	pstMap->ulRetiredCount = ulKept;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To free memory once no reader can hold it any more
+//Inputs	: pstMap, the index
+//Inputs	: pvMemory, a device version or a table no longer reachable
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, when out of memory, the memory is then never freed
+//Notes		:
+//******************************************************************************
+static bool chashRetire(CHASH *pstMap, void *pvMemory)
+{
+	bool blReturn = true;
+	CHASH_RETIRED *pstGrown = NULL;
+	uint32 ulCapacity = 0;
+
+	pthread_mutex_lock(&pstMap->stRetireLock);
+	if(pstMap->ulRetiredCount == pstMap->ulRetiredCapacity)
+	{
+		ulCapacity = pstMap->ulRetiredCapacity * 2 + CHASH_RECLAIM_BATCH;
+		pstGrown = realloc(pstMap->pstRetired,
+						   ulCapacity * sizeof(CHASH_RETIRED));
+		blReturn = (pstGrown != NULL);
+		if(blReturn == true)
+		{
+			pstMap->pstRetired = pstGrown;
+			pstMap->ulRetiredCapacity = ulCapacity;
+		}
+	}
+
+	if(blReturn == true)
+	{
+		pstMap->pstRetired[pstMap->ulRetiredCount].pvMemory = pvMemory;
+		pstMap->pstRetired[pstMap->ulRetiredCount].ulEpoch =
+			atomic_load(&pstMap->ulEpoch);
+		pstMap->ulRetiredCount++;
+		if(pstMap->ulRetiredCount % CHASH_RECLAIM_BATCH == 0)
+		{
+			chashReclaim(pstMap);
+		}
+	}
+	pthread_mutex_unlock(&pstMap->stRetireLock);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To move the devices to a larger table, without the removed ones
+//Inputs	: pstMap, the index
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Waits for the writers, never for the readers, which go on
+//			  probing the old table until it is freed
+//******************************************************************************
+static bool chashGrow(CHASH *pstMap)
+{
+	bool blReturn = true;
+	CHASH_TABLE *pstTable = NULL;
+	CHASH_TABLE *pstNewTable = NULL;
+	DEVICE_DETAILS *pstDevice = NULL;
+	uint32 ulCapacity = 0;
+	uint32 ulMask = 0;
+	uint32 ulSlot = 0;
+	uint32 ulNewSlot = 0;
+
+	pthread_rwlock_wrlock(&pstMap->stResizeLock);
+	pstTable = atomic_load(&pstMap->pstTable);
+	if(atomic_load(&pstMap->ulUsed) * CHASH_LOAD_DENOMINATOR >=
+	   pstTable->ulCapacity * CHASH_LOAD_NUMERATOR)
+	{
+		ulCapacity = pstTable->ulCapacity;
+		while(atomic_load(&pstMap->ulCount) * CHASH_GROWTH > ulCapacity)
+		{
+			ulCapacity *= 2;
+		}
+		pstNewTable = chashAllocate(ulCapacity);
+		blReturn = (pstNewTable != NULL);
+	}
+
+	if(pstNewTable != NULL)
+	{
+		ulMask = ulCapacity - 1;
+		for(ulSlot = 0; ulSlot < pstTable->ulCapacity; ulSlot++)
+		{
+			pstDevice = atomic_load(&pstTable->pstSlots[ulSlot].pstDevice);
+			if(pstDevice != NULL)
+			{
+				ulNewSlot = hashMix(pstDevice->ulDeviceSerial) & ulMask;
+				while(atomic_load_explicit(
+						&pstNewTable->pstSlots[ulNewSlot].ulKey,
+						memory_order_relaxed) != CHASH_EMPTY)
+				{
+					ulNewSlot = (ulNewSlot + 1) & ulMask;
+				}
+				atomic_store_explicit(&pstNewTable->pstSlots[ulNewSlot].ulKey,
+									  pstDevice->ulDeviceSerial,
+									  memory_order_relaxed);
+				atomic_store_explicit(
+					&pstNewTable->pstSlots[ulNewSlot].pstDevice, pstDevice,
+					memory_order_relaxed);
+			}
+		}
+		atomic_store(&pstMap->ulUsed, atomic_load(&pstMap->ulCount));
+		atomic_store(&pstMap->pstTable, pstNewTable);
+		chashRetire(pstMap, pstTable);
+	}
+	pthread_rwlock_unlock(&pstMap->stResizeLock);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To replace or to remove the device of a serial
+//Inputs	: pstMap, the index
+//Inputs	: ulSerial, the serial
+//Inputs	: pstDevice, the new version, NULL to remove the device
+//Outputs	: pblFound, whether the serial had a device
+//Return	: True, at time of successful execution
+//Return	: False, when the table is full
+//Notes		: A serial never seen gets a slot only when a device is given
+//******************************************************************************
+static bool chashStore(CHASH *pstMap, uint32 ulSerial,
+					   DEVICE_DETAILS *pstDevice, bool *pblFound)
+{
+	bool blReturn = false;
+	bool blDone = false;
+	CHASH_TABLE *pstTable = NULL;
+	DEVICE_DETAILS *pstOld = NULL;
+	pthread_mutex_t *pstStripe = NULL;
+	uint32 ulCapacity = 0;
+	uint32 ulMask = 0;
+	uint32 ulSlot = 0;
+	uint32 ulProbes = 0;
+	uint32 ulKey = 0;
+
+	*pblFound = false;
+	pstStripe = &pstMap->pstStripes[hashMix(ulSerial) % CHASH_STRIPES];
+	pthread_rwlock_rdlock(&pstMap->stResizeLock);
+	pthread_mutex_lock(pstStripe);
+	pstTable = atomic_load(&pstMap->pstTable);
+	ulMask = pstTable->ulCapacity - 1;
+	ulSlot = hashMix(ulSerial) & ulMask;
+	for(ulProbes = 0; ulProbes < pstTable->ulCapacity && blDone != true;
+		ulProbes++)
+	{
+		ulKey = atomic_load(&pstTable->pstSlots[ulSlot].ulKey);
+		if(ulKey == CHASH_EMPTY && pstDevice != NULL)
+		{
+			// Writers of other stripes may claim the slot first
+			blDone = atomic_compare_exchange_strong(
+						&pstTable->pstSlots[ulSlot].ulKey, &ulKey, ulSerial);
+			if(blDone == true)
+			{
+				atomic_fetch_add(&pstMap->ulUsed, 1);
+			}
+		}
+		else if(ulKey == CHASH_EMPTY)
+		{
+			break;
+		}
+		blDone = (blDone == true || ulKey == ulSerial);
+
+		if(blDone == true)
+		{
+			pstOld = atomic_exchange(&pstTable->pstSlots[ulSlot].pstDevice,
+									 pstDevice);
+			*pblFound = (pstOld != NULL);
+			if(pstOld == NULL && pstDevice != NULL)
+			{
+				atomic_fetch_add(&pstMap->ulCount, 1);
+			}
+			else if(pstOld != NULL && pstDevice == NULL)
+			{
+				atomic_fetch_sub(&pstMap->ulCount, 1);
+			}
+		}
+		else
+		{
+			ulSlot = (ulSlot + 1) & ulMask;
+		}
+	}
+	blReturn = (blDone == true || pstDevice == NULL);
+	ulCapacity = pstTable->ulCapacity;
+	pthread_mutex_unlock(pstStripe);
+	pthread_rwlock_unlock(&pstMap->stResizeLock);
+
+	if(pstOld != NULL)
+	{
+		chashRetire(pstMap, pstOld);
+	}
+
+	// A table failing to grow still takes devices until it is full
+	if(blReturn == true && atomic_load(&pstMap->ulUsed) *
+	   CHASH_LOAD_DENOMINATOR >= ulCapacity * CHASH_LOAD_NUMERATOR)
+	{
+		chashGrow(pstMap);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To run the lookups and replacements of a benchmark thread
+//Inputs	: pvWorker, the CHASH_WORKER of the thread
+//Outputs	: None
+//Return	: NULL
+//Notes		:
+//******************************************************************************
+static void *chashWork(void *pvWorker)
+{
+	CHASH_WORKER *pstWorker = pvWorker;
+	DEVICE_DETAILS DeviceData = {0};
+	uint32 ulRandom = pstWorker->ulSeed;
+	uint32 ulSerial = 0;
+	uint32 ulIndex = 0;
+
+	pstWorker->blStatus = true;
+	pstWorker->ulFound = 0;
+	for(ulIndex = 0; ulIndex < CHASH_BENCH_OPERATIONS &&
+		pstWorker->blStatus == true; ulIndex++)
+	{
+		ulRandom ^= ulRandom << 13;
+		ulRandom ^= ulRandom >> 7;
+		ulRandom ^= ulRandom << 17;
+		ulSerial = pstWorker->pulSerials[ulRandom % pstWorker->ulSerialCount];
+		if(chashFind(pstWorker->pstMap, pstWorker->ulReader, ulSerial,
+					 &DeviceData) == true)
+		{
+			pstWorker->ulFound++;
+			if(ulRandom % CHASH_BENCH_WRITE_RATIO == 0)
+			{
+				pstWorker->blStatus = chashInsert(pstWorker->pstMap,
+												  &DeviceData);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To create an empty concurrent index
+//Inputs	: ulExpectedCount, number of devices expected
+//Outputs	: pstMap, the index
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool chashCreate(CHASH *pstMap, uint32 ulExpectedCount)
+{
+	bool blReturn = false;
+	CHASH_TABLE *pstTable = NULL;
+	uint32 ulCapacity = CHASH_MIN_CAPACITY;
+	uint32 ulIndex = 0;
+
+	if(pstMap != NULL)
+	{
+		memset(pstMap, 0, sizeof(CHASH));
+		while(ulExpectedCount * CHASH_GROWTH > ulCapacity)
+		{
+			ulCapacity *= 2;
+		}
+		pstTable = chashAllocate(ulCapacity);
+		blReturn = (pstTable != NULL);
+	}
+
+	if(blReturn == true)
+	{
+		atomic_init(&pstMap->pstTable, pstTable);
+		atomic_init(&pstMap->ulEpoch, 0);
+		atomic_init(&pstMap->ulReaderCount, 0);
+		atomic_init(&pstMap->ulUsed, 0);
+		atomic_init(&pstMap->ulCount, 0);
+		for(ulIndex = 0; ulIndex < CHASH_MAX_READERS; ulIndex++)
+		{
+			atomic_init(&pstMap->pstReaders[ulIndex].ulEpoch, CHASH_IDLE);
+		}
+		for(ulIndex = 0; ulIndex < CHASH_STRIPES; ulIndex++)
+		{
+			pthread_mutex_init(&pstMap->pstStripes[ulIndex], NULL);
+		}
+		pthread_rwlock_init(&pstMap->stResizeLock, NULL);
+		pthread_mutex_init(&pstMap->stRetireLock, NULL);
+	}
+	else
+	{
+		printf("\nUnable to create the concurrent index");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To register a thread looking devices up
+//Inputs	: pstMap, the index
+//Outputs	: pulReader, the reader of the thread, for chashFind()
+//Return	: True, at time of successful execution
+//Return	: False, when CHASH_MAX_READERS are registered already
+//Notes		: Each thread needs its own reader, writers need none
+//******************************************************************************
+bool chashAttach(CHASH *pstMap, uint32 *pulReader)
+{
+	bool blReturn = false;
+
+	if(pstMap != NULL && pulReader != NULL)
+	{
+		*pulReader = atomic_fetch_add(&pstMap->ulReaderCount, 1);
+		blReturn = (*pulReader < CHASH_MAX_READERS);
+		if(blReturn != true)
+		{
+			atomic_fetch_sub(&pstMap->ulReaderCount, 1);
+			printf("\nUnable to attach : Up to %d readers",
+				   CHASH_MAX_READERS);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To look a device up by serial
+//Inputs	: pstMap, the index
+//Inputs	: ulReader, the reader of the calling thread
+//Inputs	: ulSerial, the serial
+//Outputs	: pstDeviceData, a copy of the device
+//Return	: True, when the device is found
+//Return	: False, otherwise
+//Notes		: Lock free, the copy is taken before the reader goes idle
+//******************************************************************************
+bool chashFind(CHASH *pstMap, uint32 ulReader, uint32 ulSerial,
+			   DEVICE_DETAILS *pstDeviceData)
+{
+	bool blReturn = false;
+	CHASH_TABLE *pstTable = NULL;
+	DEVICE_DETAILS *pstDevice = NULL;
+	CHASH_READER *pstReader = NULL;
+	uint32 ulMask = 0;
+	uint32 ulSlot = 0;
+	uint32 ulProbes = 0;
+	uint32 ulKey = 0;
+
+	if(pstMap != NULL && pstDeviceData != NULL &&
+	   ulReader < CHASH_MAX_READERS &&
+	   ulReader < atomic_load(&pstMap->ulReaderCount))
+	{
+		pstReader = &pstMap->pstReaders[ulReader];
+		// Sequentially consistent, the table is read after the epoch is seen
+		atomic_store(&pstReader->ulEpoch, atomic_load(&pstMap->ulEpoch));
+		pstTable = atomic_load(&pstMap->pstTable);
+		ulMask = pstTable->ulCapacity - 1;
+		ulSlot = hashMix(ulSerial) & ulMask;
+		for(ulProbes = 0; ulProbes < pstTable->ulCapacity; ulProbes++)
+		{
+			ulKey = atomic_load_explicit(&pstTable->pstSlots[ulSlot].ulKey,
+										 memory_order_acquire);
+			if(ulKey == ulSerial)
+			{
+				pstDevice = atomic_load_explicit(
+								&pstTable->pstSlots[ulSlot].pstDevice,
+								memory_order_acquire);
+				if(pstDevice != NULL)
+				{
+					*pstDeviceData = *pstDevice;
+					blReturn = true;
+				}
+				break;
+			}
+			if(ulKey == CHASH_EMPTY)
+			{
+				break;
+			}
+			ulSlot = (ulSlot + 1) & ulMask;
+		}
+		atomic_store_explicit(&pstReader->ulEpoch, CHASH_IDLE,
+							  memory_order_release);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To insert a device or to replace the one of its serial
+//Inputs	: pstMap, the index
+//Inputs	: pstDeviceData, the device
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Readers see the old version or the new one, never a mix
+//******************************************************************************
+bool chashInsert(CHASH *pstMap, const DEVICE_DETAILS *pstDeviceData)
+{
+	bool blReturn = false;
+	bool blFound = false;
+	DEVICE_DETAILS *pstDevice = NULL;
+
+	if(pstMap != NULL && pstDeviceData != NULL &&
+	   pstDeviceData->ulDeviceSerial != CHASH_EMPTY)
+	{
+		pstDevice = malloc(sizeof(DEVICE_DETAILS));
+		if(pstDevice != NULL)
+		{
+			*pstDevice = *pstDeviceData;
+			blReturn = chashStore(pstMap, pstDevice->ulDeviceSerial,
+								  pstDevice, &blFound);
+		}
+	}
+
+	if(blReturn != true)
+	{
+		free(pstDevice);
+		printf("\nUnable to insert in the concurrent index");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the device of a serial
+//Inputs	: pstMap, the index
+//Inputs	: ulSerial, the serial
+//Outputs	: None
+//Return	: True, when a device was removed
+//Return	: False, otherwise
+//Notes		: The slot stays with the serial until the table grows
+//******************************************************************************
+bool chashRemove(CHASH *pstMap, uint32 ulSerial)
+{
+	bool blFound = false;
+
+	if(pstMap != NULL)
+	{
+		chashStore(pstMap, ulSerial, NULL, &blFound);
+	}
+
+	return blFound;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To insert all the devices of the data
+//Inputs	: pstMap, the index
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pulGeneration, the generation of the devices inserted
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The devices of one snapshot are inserted
+//******************************************************************************
+bool chashLoad(CHASH *pstMap, const uint8 *pucFileName, uint32 *pulGeneration)
+{
+	bool blReturn = false;
+	SNAPSHOT stSnapshot;
+	SHARD_LAYOUT stLayout = {0};
+	DEVICE_DETAILS DeviceData = {0};
+	uint32 ulShard = 0;
+
+	if(pstMap != NULL && pucFileName != NULL && pulGeneration != NULL &&
+	   shardAcquireSnapshot(pucFileName, &stSnapshot, &stLayout) == true)
+	{
+		*pulGeneration = stSnapshot.ulGeneration;
+		blReturn = true;
+		for(ulShard = 0; ulShard < stSnapshot.ulFileCount; ulShard++)
+		{
+			while(blReturn == true &&
+				  snapshotRead(&stSnapshot, ulShard, &DeviceData) == true)
+			{
+				blReturn = chashInsert(pstMap, &DeviceData);
+			}
+		}
+		snapshotRelease(&stSnapshot);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To free a concurrent index
+//Inputs	: pstMap, the index, no longer used by any thread
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+void chashDestroy(CHASH *pstMap)
+{
+	CHASH_TABLE *pstTable = NULL;
+	uint32 ulIndex = 0;
+
+	if(pstMap != NULL && (pstTable = atomic_load(&pstMap->pstTable)) != NULL)
+	{
+		for(ulIndex = 0; ulIndex < pstTable->ulCapacity; ulIndex++)
+		{
+			free(atomic_load(&pstTable->pstSlots[ulIndex].pstDevice));
+		}
+		free(pstTable);
+		for(ulIndex = 0; ulIndex < pstMap->ulRetiredCount; ulIndex++)
+		{
+			free(pstMap->pstRetired[ulIndex].pvMemory);
+		}
+		free(pstMap->pstRetired);
+		for(ulIndex = 0; ulIndex < CHASH_STRIPES; ulIndex++)
+		{
+			pthread_mutex_destroy(&pstMap->pstStripes[ulIndex]);
+		}
+		pthread_rwlock_destroy(&pstMap->stResizeLock);
+		pthread_mutex_destroy(&pstMap->stRetireLock);
+		memset(pstMap, 0, sizeof(CHASH));
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To measure the lookups of the concurrent index
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulThreadCount, largest number of threads
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The devices are loaded, then 1, 2, 4 and so on up to
+//			  ulThreadCount threads look random serials up, one lookup in
+//			  CHASH_BENCH_WRITE_RATIO being followed by a replacement
+//******************************************************************************
+bool chashBenchmark(const uint8 *pucFileName, uint32 ulThreadCount)
+{
+	bool blReturn = false;
+	CHASH *pstMap = NULL;
+	CHASH_TABLE *pstTable = NULL;
+	CHASH_WORKER pstWorkers[CHASH_MAX_READERS];
+	pthread_t pstThreads[CHASH_MAX_READERS];
+	bool pblStarted[CHASH_MAX_READERS] = {false};
+	uint32 *pulSerials = NULL;
+	struct timespec stStart;
+	struct timespec stEnd;
+	double dSeconds = 0;
+	double dRate = 0;
+	double dSingleRate = 0;
+	uint32 ulCount = 0;
+	uint32 ulThreads = 0;
+	uint32 ulIndex = 0;
+	uint32 ulGeneration = 0;
+
+	if(pucFileName == NULL || ulThreadCount == 0 ||
+	   ulThreadCount > CHASH_MAX_READERS)
+	{
+		printf("\nUnable to measure : Between 1 and %d threads",
+			   CHASH_MAX_READERS);
+		return false;
+	}
+
+	pstMap = malloc(sizeof(CHASH));
+	clock_gettime(CLOCK_MONOTONIC, &stStart);
+	blReturn = (pstMap != NULL && chashCreate(pstMap, 0) == true &&
+				chashLoad(pstMap, pucFileName, &ulGeneration) == true);
+	clock_gettime(CLOCK_MONOTONIC, &stEnd);
+	if(blReturn == true)
+	{
+		pstTable = atomic_load(&pstMap->pstTable);
+		ulCount = atomic_load(&pstMap->ulCount);
+		pulSerials = malloc((ulCount + 1) * sizeof(uint32));
+		blReturn = (pulSerials != NULL && ulCount > 0);
+	}
+	for(ulIndex = 0, ulCount = 0; blReturn == true &&
+		ulIndex < pstTable->ulCapacity; ulIndex++)
+	{
+		if(atomic_load(&pstTable->pstSlots[ulIndex].pstDevice) != NULL)
+		{
+			pulSerials[ulCount++] =
+				atomic_load(&pstTable->pstSlots[ulIndex].ulKey);
+		}
+	}
+	for(ulIndex = 0; ulIndex < ulThreadCount && blReturn == true; ulIndex++)
+	{
+		pstWorkers[ulIndex].pstMap = pstMap;
+		pstWorkers[ulIndex].pulSerials = pulSerials;
+		pstWorkers[ulIndex].ulSerialCount = ulCount;
+		pstWorkers[ulIndex].ulSeed = ulIndex * 2654435761UL + 1;
+		blReturn = chashAttach(pstMap, &pstWorkers[ulIndex].ulReader);
+	}
+
+	if(blReturn == true)
+	{
+		printf("Loaded %lu device(s) in %.1f ms\n", ulCount,
+			   ((stEnd.tv_sec - stStart.tv_sec) +
+				(stEnd.tv_nsec - stStart.tv_nsec) / CHASH_NANOSECONDS) *
+			   CHASH_MILLISECONDS);
+		printf("Threads\t\tLookups/s\tPer thread\tScaling\n");
+	}
+
+	for(ulThreads = 1; ulThreads <= ulThreadCount && blReturn == true;
+		ulThreads = (ulThreads * 2 > ulThreadCount &&
+					 ulThreads < ulThreadCount) ? ulThreadCount :
+					ulThreads * 2)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &stStart);
+		for(ulIndex = 0; ulIndex < ulThreads; ulIndex++)
+		{
+			pblStarted[ulIndex] = (pthread_create(&pstThreads[ulIndex], NULL,
+												  chashWork,
+												  &pstWorkers[ulIndex]) == 0);
+			if(pblStarted[ulIndex] != true)
+			{
+				chashWork(&pstWorkers[ulIndex]);
+			}
+		}
+		for(ulIndex = 0; ulIndex < ulThreads; ulIndex++)
+		{
+			if(pblStarted[ulIndex] == true)
+			{
+				pthread_join(pstThreads[ulIndex], NULL);
+			}
+			blReturn = (blReturn == true &&
+						pstWorkers[ulIndex].blStatus == true);
+		}
+		clock_gettime(CLOCK_MONOTONIC, &stEnd);
+
+		dSeconds = (stEnd.tv_sec - stStart.tv_sec) +
+				   (stEnd.tv_nsec - stStart.tv_nsec) / CHASH_NANOSECONDS;
+		dRate = (double)ulThreads * CHASH_BENCH_OPERATIONS / dSeconds;
+		dSingleRate = (ulThreads == 1) ? dRate : dSingleRate;
+		printf("%lu\t\t%.2fM\t\t%.2fM\t\t%.2fx\n", ulThreads,
+			   dRate / CHASH_MILLION, dRate / ulThreads / CHASH_MILLION,
+			   dRate / dSingleRate);
+	}
+
+	if(pstMap != NULL)
+	{
+		chashDestroy(pstMap);
+	}
+	free(pstMap);
+	free(pulSerials);
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to measure the concurrent index");
+	}
+
+	return blReturn;
+}
+// EOF
@@ -0,0 +1,87 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Concurrent hash index of the devices by serial
+// Note		: Lookups take no lock, writers lock a stripe of the serials.
+//			  Versions and tables replaced while readers may hold them are
+//			  freed once every reader has moved on to a later epoch.
+//
+//******************************************************************************
+
+#ifndef _CHASH_H_
+#define _CHASH_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+
+//***************************** Global Constants *******************************
+#define CHASH_MAX_READERS		(64)
+#define CHASH_STRIPES			(64)
+#define CHASH_LINE_SIZE			(64)
+#define CHASH_EMPTY				((uint32)-1)
+#define CHASH_IDLE				((uint32)-1)
+
+//******************************* Global Types *********************************
+// A serial once inserted keeps its slot, a NULL device marks its removal
+typedef struct _CHASH_SLOT_
+{
+	_Atomic uint32 ulKey;
+	_Atomic(DEVICE_DETAILS *) pstDevice;
+} CHASH_SLOT;
+
+typedef struct _CHASH_TABLE_
+{
+	uint32 ulCapacity;
+	CHASH_SLOT pstSlots[];
+} CHASH_TABLE;
+
+// Epoch a reader entered, alone on its cache line
+typedef struct _CHASH_READER_
+{
+	_Alignas(CHASH_LINE_SIZE) _Atomic uint32 ulEpoch;
+} CHASH_READER;
+
+typedef struct _CHASH_RETIRED_
+{
+	void *pvMemory;
+	uint32 ulEpoch;
+} CHASH_RETIRED;
+
+typedef struct _CHASH_
+{
+	_Atomic(CHASH_TABLE *) pstTable;
+	_Atomic uint32 ulEpoch;
+	_Atomic uint32 ulReaderCount;
+	_Atomic uint32 ulUsed;
+	_Atomic uint32 ulCount;
+	CHASH_READER pstReaders[CHASH_MAX_READERS];
+	pthread_rwlock_t stResizeLock;
+	pthread_mutex_t pstStripes[CHASH_STRIPES];
+	pthread_mutex_t stRetireLock;
+	CHASH_RETIRED *pstRetired;
+	uint32 ulRetiredCount;
+	uint32 ulRetiredCapacity;
+} CHASH;
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool chashCreate(CHASH *pstMap, uint32 ulExpectedCount);
+bool chashAttach(CHASH *pstMap, uint32 *pulReader);
+bool chashFind(CHASH *pstMap, uint32 ulReader, uint32 ulSerial,
+			   DEVICE_DETAILS *pstDeviceData);
+bool chashInsert(CHASH *pstMap, const DEVICE_DETAILS *pstDeviceData);
+bool chashRemove(CHASH *pstMap, uint32 ulSerial);
+bool chashLoad(CHASH *pstMap, const uint8 *pucFileName, uint32 *pulGeneration);
+void chashDestroy(CHASH *pstMap);
+bool chashBenchmark(const uint8 *pucFileName, uint32 ulThreadCount);
+
+#endif // _CHASH_H_
+// EOF
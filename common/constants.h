@@ -17,6 +17,7 @@
 
 //***************************** Global Constants *******************************
 #define STR_MAX_SIZE	(32)
+#define FILE_PATH_MAX_SIZE	(256)
 
 //***************************** Global Variables *******************************
 
@@ -0,0 +1,172 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: crc.c
+// Summary	: CRC32C checksums
+// Note		: The SSE4.2 crc32 instruction handles eight bytes per step.
+//			  Other processors use a byte wise table, built on first use.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include "customTypes.h"
+#include "crc.h"
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define CRC_POLYNOMIAL	(0x82F63B78U)
+#define CRC_TABLE_SIZE	(256)
+#define CRC_BYTE_BITS	(8)
+#define CRC_MASK		(0xFFFFFFFFU)
+
+//***************************** Local Variables ********************************
+static unsigned int puiCrcTable[CRC_TABLE_SIZE];
+static bool blCrcHardware = false;
+static pthread_once_t stCrcOnce = PTHREAD_ONCE_INIT;
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To prepare the checksum computation
+//Inputs	: None
+//Outputs	: None
+//Return	: None
+//Notes		: Run once, detects the crc32 instruction and builds the table
+//******************************************************************************
+static void crcSetup(void)
+{
+	unsigned int uiCrc = 0;
+	unsigned int uiByte = 0;
+	unsigned int uiBit = 0;
+
+#if defined(__x86_64__)
+	blCrcHardware = __builtin_cpu_supports("sse4.2");
+#endif
+
+	for(uiByte = 0; uiByte < CRC_TABLE_SIZE; uiByte++)
+	{
+		uiCrc = uiByte;
+		for(uiBit = 0; uiBit < CRC_BYTE_BITS; uiBit++)
+		{
+			uiCrc = (uiCrc & 1) ? (uiCrc >> 1) ^ CRC_POLYNOMIAL : uiCrc >> 1;
+		}
+		puiCrcTable[uiByte] = uiCrc;
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compute a checksum with the byte wise table
+//Inputs	: uiCrc, the running checksum, inverted
+//Inputs	: pucData and ulSize, the data
+//Outputs	: None
+//Return	: The running checksum, inverted
+//Notes		:
+//******************************************************************************
+static unsigned int crcSoftware(unsigned int uiCrc, const uint8 *pucData,
+								size_t ulSize)
+{
+	while(ulSize > 0)
+	{
+		uiCrc = puiCrcTable[(uiCrc ^ *pucData) & 0xFF] ^ (uiCrc >> CRC_BYTE_BITS);
+		pucData++;
+		ulSize--;
+	}
+
+	return uiCrc;
+}
+
+#if defined(__x86_64__)
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compute a checksum with the crc32 instruction
+//Inputs	: uiCrc, the running checksum, inverted
+//Inputs	: pucData and ulSize, the data
+//Outputs	: None
+//Return	: The running checksum, inverted
+//Notes		: Only called when the processor supports SSE4.2
+//******************************************************************************
+__attribute__((target("sse4.2")))
+static unsigned int crcHardwareUpdate(unsigned int uiCrc, const uint8 *pucData,
+									  size_t ulSize)
+{
+	unsigned long long ullCrc = uiCrc;
+	unsigned long long ullWord = 0;
+
+	while(ulSize >= sizeof(ullWord))
+	{
+		memcpy(&ullWord, pucData, sizeof(ullWord));
+		ullCrc = _mm_crc32_u64(ullCrc, ullWord);
+		pucData += sizeof(ullWord);
+		ulSize -= sizeof(ullWord);
+	}
+
+	uiCrc = (unsigned int)ullCrc;
+	while(ulSize > 0)
+	{
+		uiCrc = _mm_crc32_u8(uiCrc, *pucData);
+		pucData++;
+		ulSize--;
+	}
+
+	return uiCrc;
+}
+#endif
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compute the CRC32C of some data
+//Inputs	: ulCrc, checksum of the preceding data, CRC_INITIAL to start
+//Inputs	: pvData and ulSize, the data
+//Outputs	: None
+//Return	: The checksum of the preceding data and pvData
+//Notes		:
+//******************************************************************************
+uint32 crc32c(uint32 ulCrc, const void *pvData, size_t ulSize)
+{
+	unsigned int uiCrc = ~(unsigned int)ulCrc;
+
+	pthread_once(&stCrcOnce, crcSetup);
+
+#if defined(__x86_64__)
+	if(blCrcHardware == true)
+	{
+		uiCrc = crcHardwareUpdate(uiCrc, pvData, ulSize);
+	}
+	else
+#endif
+	{
+		uiCrc = crcSoftware(uiCrc, pvData, ulSize);
+	}
+
+	return ~uiCrc & CRC_MASK;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To tell whether the checksums are computed by the processor
+//Inputs	: None
+//Outputs	: None
+//Return	: True, if the SSE4.2 crc32 instruction is used
+//Return	: False, if the table is used
+//Notes		:
+//******************************************************************************
+bool crcHardware(void)
+{
+	pthread_once(&stCrcOnce, crcSetup);
+
+	return blCrcHardware;
+}
+// EOF
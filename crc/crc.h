@@ -0,0 +1,32 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: CRC32C checksums
+// Note		: Castagnoli polynomial, computed with the SSE4.2 crc32
+//			  instruction when the processor has it
+//
+//******************************************************************************
+
+#ifndef _CRC_H_
+#define _CRC_H_
+
+//******************************* Include Files ********************************
+#include <stddef.h>
+#include <stdbool.h>
+#include "customTypes.h"
+
+//******************************* Global Types *********************************
+
+//***************************** Global Constants *******************************
+#define CRC_INITIAL		(0)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+uint32 crc32c(uint32 ulCrc, const void *pvData, size_t ulSize);
+bool crcHardware(void);
+
+#endif // _CRC_H_
+// EOF
@@ -17,13 +17,64 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "device.h"
 #include "customTypes.h"
 #include "file.h"
 #include "menu.h"
 #include "constants.h"
+#include "hash.h"
+#include "index.h"
+#include "bloom.h"
+#include "arena.h"
+#include "crc.h"
+#include "segment.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "stats.h"
+#include "feed.h"
+#include "workload.h"
+#include "trigram.h"
+#include "keys.h"
+#include "history.h"
+#include "diff.h"
+#include "txn.h"
+#include "pool.h"
+#include "chash.h"
+#include "cache.h"
+#include "trace.h"
 
 //******************************* Local Types **********************************
+// Differences found by a comparison and the pending changes applying them
+typedef struct _DEVICE_DIFF_
+{
+	const uint8 *pucFileName;
+	bool blApply;
+	bool blStatus;
+	uint32 ulPrinted;
+	uint32 ulApplied;
+	uint32 ulSerialCount;
+	uint32 ulUpdateCount;
+	uint32 pulSerials[DIFF_APPLY_BATCH];
+	DEVICE_UPDATE pstUpdates[DIFF_APPLY_BATCH];
+	bool pblUpdated[DIFF_APPLY_BATCH];
+} DEVICE_DIFF;
+
+// A command of a batch file and its outcome
+typedef struct _DEVICE_BATCH_ITEM_
+{
+	const uint8 *pucFileName;
+	uint32 ulLine;
+	bool blRead;
+	DEVICE_CRITERIA stCriteria;
+	TXN_OPERATION stOperation;
+	SHARD_RESULT stResult;
+	CHASH *pstMap;
+	bool blChanged;
+	bool blStatus;
+} DEVICE_BATCH_ITEM;
 
 //***************************** Local Constants ********************************
 #define PRINT_ERROR  (-1)
@@ -38,7 +89,15 @@
 #define STRINGS_EQUAL (0)
 #define PRINT_ENABLED (1)
 #define PRINT_DISABLED (0)
-#define TEMPORARY_FILE_NAME ("temporary.dat")
+#define NUMBER_BASE    (10)
+#define LIST_MIN_SIZE  (64)
+#define LINE_MAX_SIZE  (256)
+#define HEX_BASE       (16)
+#define SLOT_NONE      ((uint32)-1)
+#define FIELD_SEPARATOR ('=')
+#define TOKEN_DELIMITERS (" \t\r\n")
+#define DEVICE_FIELD_ALL (DEVICE_FIELD_NAME | DEVICE_FIELD_TYPE | \
+						  DEVICE_FIELD_ID | DEVICE_FIELD_VENDOR)
 
 //***************************** Local Variables ********************************
 
@@ -48,34 +107,30 @@
 //Purpose	: Check whether the Serial number is already exist in device data
 //Inputs	: uint32 *pulSerial, the Serial value to be checked whether it 
 //				already used
+//Inputs	: BLOOM *pstBloom, serial filter of the shard the serial routes to
+//Inputs	: INDEX *pstIndex, serial index of the same shard
 //Outputs	: None
 //Return	: True, if the Serial number has not already been used
 //Return	: False, if the Serial number has already been used
-//Notes		: 
+//Notes		: The filter answers most new serials, the index is only read
+//			  when the filter cannot rule the serial out
 //******************************************************************************
-static bool deviceCheckSerialAvailable(uint32 pulSerial,
-										const uint8 *pucFileName)
+static bool deviceCheckSerialAvailable(uint32 pulSerial, BLOOM *pstBloom,
+										INDEX *pstIndex)
 {
 	bool blReturn = true;
-	DEVICE_DETAILS DeviceData = {0};
-	FILE *pstFile = NULL;
+	uint32 ulSlot = 0;
 
-	if (pucFileName != NULL)
+	if(bloomMayContain(pstBloom, pulSerial) == true)
 	{
-		pstFile = fileOpen(pucFileName, FILE_READ_MODE);
-		
-		if(pstFile != NULL)
+		if(indexFind(pstIndex, pulSerial, &ulSlot) == true)
 		{
-			while(fileRead(&DeviceData, sizeof(DeviceData),
-							READ_COUNT, pstFile) == SUCCESS)
-			{
-				if(DeviceData.ulDeviceSerial == pulSerial)
-				{
-					printf("\nThe Serial number has already been used");
-					blReturn = false;
-				}
-				
-			}
+			printf("\nThe Serial number has already been used");
+			blReturn = false;
+		}
+		else
+		{
+			bloomFalsePositive(pstBloom);
 		}
 	}
 
@@ -120,6 +175,23 @@ static bool devicePrintData(DEVICE_DETAILS *pDeviceData)
 	return blReturn;
 }
 
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To discard the rest of the input line
+//Inputs	: None
+//Outputs	: None
+//Return	: None
+//Notes		: Kept here so the device functions do not need the menu
+//******************************************************************************
+static void deviceFlushInput(void)
+{
+	int iInput = 0;
+
+	while((iInput = getchar()) != '\n' && iInput != EOF)
+	{
+		//NOP
+	}
+}
+
 //******************************.FUNCTION_HEADER.*******************************
 //Purpose	: To read value to a variable
 //Inputs	: const uint8 *pucStringInformation, string that describes
@@ -189,7 +261,7 @@ static bool deviceReadString(const uint8 *pucStringInformation,
 			int str_len = strlen((char *)pucString);
 			// printf("\n str len : %d max limit: %d\n", str_len, STR_MAX_SIZE);
 
-			if(strlen((char *)pucString) >= STR_MAX_SIZE)
+			if(strlen((char *)pucString) >= ulSize)
 			{
 				//pucString[STR_MAX_SIZE] = '\0';
 				printf("\nUnable to read the string :\
@@ -255,52 +327,108 @@ static bool deviceReadData(DEVICE_DETAILS *pstDeviceData,
 
 	if(blReturn == SUCCESS)
 	{
-		deviceReadValue("Enter the device Serial : ",
-						&pstDeviceData->ulDeviceSerial, 
-						READ_NON_HEX);
-		
-		blReturn = deviceCheckSerialAvailable(pstDeviceData->ulDeviceSerial,
-												pucFileName);
+		blReturn = deviceReadValue("Enter the device Serial : ",
+									&pstDeviceData->ulDeviceSerial, 
+									READ_NON_HEX);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the records of a search result
+//Inputs	: SHARD_RESULT *pstResult, the records to be printed
+//Outputs	: None
+//Return	: True, if at least one record has been printed
+//Return	: False, if the result is empty
+//Notes		: 
+//******************************************************************************
+static bool devicePrintResult(SHARD_RESULT *pstResult)
+{
+	bool blReturn = false;
+	uint32 ulIndex = 0;
+
+	TRACE_SPAN("device", "devicePrintResult");
+
+	if(pstResult->ulCount > 0)
+	{
+		printf("Name\t\tType\t\tId\t\tVendor\t\tSerial\n");
+		for(ulIndex = 0; ulIndex < pstResult->ulCount; ulIndex++)
+		{
+			devicePrintData(&pstResult->pstRecords[ulIndex]);
+		}
+		blReturn = SUCCESS;
 	}
 
 	return blReturn;
 }
 
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To tell whether a segment block may hold a device matching the
+//			  search criteria
+//Inputs	: const SEGMENT_BLOCK *pstBlock, the block with its value ranges
+//Inputs	: const void *pvContext, the DEVICE_CRITERIA to be matched
+//Outputs	: None
+//Return	: True, if the block has to be read
+//Return	: False, if no device of the block can match
+//Notes		: Blocks are only skipped on Id, Vendor and Serial
+//******************************************************************************
+static bool deviceZoneMatch(const SEGMENT_BLOCK *pstBlock,
+							const void *pvContext)
+{
+	const DEVICE_CRITERIA *pstCriteria = pvContext;
+	const SEGMENT_ZONE *pstZone = NULL;
+
+	if(pstCriteria->ulChoice == SEARCH_BY_ID)
+	{
+		pstZone = &pstBlock->stId;
+	}
+	else if(pstCriteria->ulChoice == SEARCH_BY_VENDOR)
+	{
+		pstZone = &pstBlock->stVendor;
+	}
+	else if(pstCriteria->ulChoice == SEARCH_BY_SERIAL)
+	{
+		pstZone = &pstBlock->stSerial;
+	}
+
+	return (pstZone == NULL || (pstCriteria->ulValue >= pstZone->ulMin &&
+								pstCriteria->ulValue <= pstZone->ulMax));
+}
+
 //******************************.FUNCTION_HEADER.*******************************
 //Purpose	: To search device with matching string
-//Inputs	: DEVICE_DETAILS DeviceData, the variable for the device of which 
-//			  the details to be printed
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: DEVICE_CRITERIA *pstCriteria, the name or type to be searched
 //Outputs	: None
 //Return	: True, at time of successful execution
 //Return	: False, in case of an error
-//Notes		: 
+//Notes		: A name matching no device is taken for a typo and the closest
+//			  names are printed
 //******************************************************************************
-static bool deviceCheckStringMatch(FILE *pstFile,
-									uint32 ucChoice,
-									const uint8 *pucStringToSearch)
+static bool deviceCheckStringMatch(const uint8 *pucFileName,
+									const DEVICE_CRITERIA *pstCriteria)
 {
 	bool blReturn = false;
-	DEVICE_DETAILS DeviceData = {0};
+	ARENA stArena;
+	SHARD_RESULT stResult = {0};
 	
-	while(fileRead(&DeviceData, sizeof(DeviceData),
-				  READ_COUNT, pstFile) == SUCCESS)
+	arenaInit(&stArena, ARENA_QUERY_SIZE);
+	stResult.pstArena = &stArena;
+	if(deviceCollectCriteria(pucFileName, pstCriteria, &stResult) == SUCCESS)
 	{
-		if(((ucChoice == SEARCH_BY_NAME) && 
-			(strcmp((char*)DeviceData.pucDeviceName,
-			pucStringToSearch) == STRINGS_EQUAL)) ||
-			((ucChoice == SEARCH_BY_TYPE) && 
-			(strcmp((char*)DeviceData.pucDeviceType,
-			pucStringToSearch) == STRINGS_EQUAL)))
-		{
-			printf("Name\t\tType\t\tId\t\tVendor\t\tSerial\n");
-			devicePrintData(&DeviceData);			
-			blReturn = SUCCESS;
-		}
+		blReturn = devicePrintResult(&stResult);
 	}
+	arenaRelease(&stArena);
 	
 	if(blReturn != SUCCESS)
 	{
 		printf("No matching string found\n");
+		if(pstCriteria->ulChoice == SEARCH_BY_NAME)
+		{
+			deviceSearchClosest(pucFileName, pstCriteria->pucString,
+								TRIGRAM_DEFAULT_MATCHES);
+		}
 	}
 
 	return blReturn;
@@ -308,36 +436,29 @@ static bool deviceCheckStringMatch(FILE *pstFile,
 
 //******************************.FUNCTION_HEADER.*******************************
 //Purpose	: To search device with matching value
-//Inputs	: DEVICE_DETAILS DeviceData, the variable for the device of which 
-//			  the details to be printed
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: DEVICE_CRITERIA *pstCriteria, the Id, vendor or serial to be
+//			  searched
 //Outputs	: None
 //Return	: True, at time of successful execution
 //Return	: False, in case of an error
-//Notes		: 
+//Notes		:
 //******************************************************************************
-static bool deviceCheckValueMatch(FILE *pstFile,
-									uint32 ucChoice,
-									uint32 ulValueToSearch)
+static bool deviceCheckValueMatch(const uint8 *pucFileName,
+									const DEVICE_CRITERIA *pstCriteria)
 {
 	bool blReturn = false;
-	DEVICE_DETAILS DeviceData = {0};
+	ARENA stArena;
+	SHARD_RESULT stResult = {0};
 	
-	while(fileRead(&DeviceData, sizeof(DeviceData),
-				  READ_COUNT, pstFile) == SUCCESS)
+	arenaInit(&stArena, ARENA_QUERY_SIZE);
+	stResult.pstArena = &stArena;
+	if(deviceCollectCriteria(pucFileName, pstCriteria, &stResult) == SUCCESS)
 	{
-		if(((ucChoice == SEARCH_BY_ID) &&
-			(DeviceData.ulDeviceId == ulValueToSearch)) ||
-			((ucChoice == SEARCH_BY_VENDOR) &&
-			(DeviceData.ulDeviceVendor == ulValueToSearch)) ||
-			((ucChoice == SEARCH_BY_SERIAL) &&
-			(DeviceData.ulDeviceSerial == ulValueToSearch)))
-		{
-			
-			printf("Name\t\tType\t\tId\t\tVendor\t\tSerial\n");
-			devicePrintData(&DeviceData);
-			blReturn = SUCCESS;
-		}
+		blReturn = devicePrintResult(&stResult);
 	}
+	arenaRelease(&stArena);
+
 	if(blReturn != SUCCESS)
 	{
 		printf("No matching value found");
@@ -388,77 +509,79 @@ static bool deviceCheckMatch(FILE *pstFile,
 	return blReturn;
 }
 
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the search or removal criteria entered by the user
+//Inputs	: uint32 ucChoice, the field selected by the user
+//Outputs	: DEVICE_CRITERIA *pstCriteria, the criteria to be matched
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: 
+//******************************************************************************
+static bool deviceReadCriteria(uint32 ucChoice, DEVICE_CRITERIA *pstCriteria)
+{
+	bool blReturn = false;
+
+	memset(pstCriteria, 0, sizeof(DEVICE_CRITERIA));
+	pstCriteria->ulChoice = ucChoice;
+
+	if(ucChoice == SEARCH_BY_NAME || ucChoice == SEARCH_BY_NAME_FOLDED)
+	{
+		blReturn = deviceReadString("Enter Name: ",
+									pstCriteria->pucString, STR_MAX_SIZE);
+	}
+	else if(ucChoice == SEARCH_BY_TYPE || ucChoice == SEARCH_BY_TYPE_FOLDED)
+	{
+		blReturn = deviceReadString("Enter Type: ",
+									pstCriteria->pucString, STR_MAX_SIZE);
+	}
+	else if(ucChoice == SEARCH_BY_ID)
+	{
+		blReturn = deviceReadValue("Enter Id: ",
+									&pstCriteria->ulValue, READ_HEX);
+	}
+	else if(ucChoice == SEARCH_BY_VENDOR)
+	{
+		blReturn = deviceReadValue("Enter Vendor: ",
+									&pstCriteria->ulValue, READ_HEX);
+	}
+	else if(ucChoice == SEARCH_BY_SERIAL)
+	{
+		blReturn = deviceReadValue("Enter Serial: ",
+									&pstCriteria->ulValue, READ_NON_HEX);
+	}
+	else
+	{
+		printf("\nUnable to search : Invalid search criteria");
+	}
+
+	return blReturn;
+}
+
 //******************************.FUNCTION_HEADER.*******************************
 //Purpose	: To search device data based on criteria
-//Inputs	: DEVICE_DETAILS DeviceData, the variable for the device of which 
-//			  the details to be printed
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: uint32 ucChoice, the field to be searched
 //Outputs	: None
 //Return	: True, at time of successful execution
 //Return	: False, in case of an error
 //Notes		: 
 //******************************************************************************
-static bool deviceSearchByCriteria(FILE *pstFile,
+static bool deviceSearchByCriteria(const uint8 *pucFileName,
 								   uint32 ucChoice )
 {
 	bool blReturn = false;
-	DEVICE_DETAILS DeviceData = {0};
-	uint8 ucStringToSearch[STR_MAX_SIZE] = "";
-	uint32 ulValueToSearch = 0;
-	
+	DEVICE_CRITERIA stCriteria = {0};
 
-	if(pstFile != NULL && 
+	if(pucFileName != NULL && 
 		(ucChoice >= 0 && ucChoice <= SEARCH_CRITERIA_MAXIMUM_OPTIONS))
 	{
-		//getchar();
-
-		if(ucChoice == SEARCH_BY_NAME || ucChoice == SEARCH_BY_TYPE)
-		{
-			if(ucChoice == SEARCH_BY_NAME)
-			{
-				blReturn = deviceReadString("Enter Name: ",
-										ucStringToSearch, STR_MAX_SIZE);
-			}
-			else
-			{
-				blReturn = deviceReadString("Enter Type: ",
-										ucStringToSearch, STR_MAX_SIZE);			
-			}
-
-			if(blReturn == SUCCESS)
-			{
-				deviceCheckStringMatch(pstFile, ucChoice, ucStringToSearch);
-			}
-		}
-		else if(ucChoice == SEARCH_BY_ID || ucChoice == SEARCH_BY_VENDOR ||
-				ucChoice == SEARCH_BY_SERIAL)
-		{
-			if(ucChoice == SEARCH_BY_ID)
-			{
-				blReturn = deviceReadValue("Enter Id: ",
-										&ulValueToSearch, READ_HEX);
-
-			}
-			else if(ucChoice == SEARCH_BY_SERIAL)
-			{
-				blReturn = deviceReadValue("Enter Serial: ",
-										&ulValueToSearch, READ_NON_HEX);
+		blReturn = deviceReadCriteria(ucChoice, &stCriteria);
 
-			}
-			else
-			{
-				blReturn = deviceReadValue("Enter Vendor: ",
-										&ulValueToSearch, READ_HEX);
-			}
-			
-			if(blReturn == SUCCESS)
-			{
-				deviceCheckValueMatch(pstFile, ucChoice, ulValueToSearch);
-			}
-			
-		}
-		else
+		if(blReturn == SUCCESS)
 		{
-			printf("\nUnable to search : Invalid search criteria");
+			workloadRecord(pucFileName, WORKLOAD_SEARCH, &stCriteria,
+						   sizeof(stCriteria));
+			deviceSearchCriteria(pucFileName, &stCriteria);
 		}
 	}
 	else
@@ -469,103 +592,89 @@ static bool deviceSearchByCriteria(FILE *pstFile,
 	return blReturn;
 }
 
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the devices matching a predicate
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: SHARD_MATCH pfnMatch, the predicate selecting the devices
+//Inputs	: const void *pvContext, argument passed to the predicate
+//Outputs	: uint32 *pulRemoved, number of removed devices
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The removed devices are counted out of the device counters
+//******************************************************************************
+static bool deviceRemoveMatching(const uint8 *pucFileName, SHARD_MATCH pfnMatch,
+								 const void *pvContext, uint32 *pulRemoved)
+{
+	bool blReturn = false;
+	SNAPSHOT_WRITER stWriter;
+	ARENA stArena;
+	SHARD_RESULT stRemoved = {0};
+	uint32 ulGeneration = 0;
+
+	arenaInit(&stArena, ARENA_QUERY_SIZE);
+	stRemoved.pstArena = &stArena;
+	if(snapshotWriterBegin(pucFileName, &stWriter) == SUCCESS)
+	{
+		ulGeneration = stWriter.ulGeneration;
+		blReturn = shardRemove(&stWriter, pucFileName, pfnMatch, pvContext,
+							   pulRemoved, &stRemoved);
+
+		if(blReturn == SUCCESS && *pulRemoved > 0)
+		{
+			statsUpdate(pucFileName, ulGeneration, stWriter.ulGeneration,
+						stRemoved.pstRecords, stRemoved.ulCount, NULL, 0);
+			feedAppend(pucFileName, FEED_REMOVE, stRemoved.pstRecords,
+					   stRemoved.ulCount);
+			historyAppend(pucFileName, stRemoved.pstRecords, NULL,
+						  stRemoved.ulCount);
+		}
+		snapshotWriterEnd(&stWriter);
+	}
+	arenaRelease(&stArena);
+
+	return blReturn;
+}
+
 //******************************.FUNCTION_HEADER.*******************************
 //Purpose	: To remove device data based on criteria
-//Inputs	: DEVICE_DETAILS DeviceData, the variable for the device of which 
-//			  the data to be removed
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: uint32 ucChoice, the field to be matched for removal
 //Outputs	: None
 //Return	: True, at time of successful execution
 //Return	: False, in case of an error
-//Notes		: 
+//Notes		: Only the shards holding a matching device are rewritten
 //******************************************************************************
-static bool deviceRemoveByCriteria(FILE *pstFile,
+static bool deviceRemoveByCriteria(const uint8 *pucFileName,
 								   uint32 ucChoice )
 {
 	bool blReturn = false;
-	DEVICE_DETAILS DeviceData = {0};
-	uint8 ucStringToSearch[STR_MAX_SIZE] = "";
-	uint32 ulValueToSearch = 0;
-	FILE *pstTemporaryFile = NULL;
-	uint8 ucRemoveData = 0;
-	uint8 ucKeepData = SUCCESS;
-	
+	DEVICE_CRITERIA stCriteria = {0};
+	uint32 ulRemoved = 0;
 
-	if(pstFile != NULL && 
-		(ucChoice >= 0 && ucChoice <= SEARCH_CRITERIA_MAXIMUM_OPTIONS))
+	if(pucFileName != NULL && 
+		(ucChoice >= 0 && ucChoice <= REMOVE_CRITERIA_MAXIMUM_OPTIONS))
 	{
-		//getchar();
-
-		if(ucChoice == SEARCH_BY_NAME)
-		{
-			blReturn = deviceReadString("Enter Name: ",
-										ucStringToSearch, STR_MAX_SIZE);
-			deviceCheckStringMatch(pstFile, ucChoice, ucStringToSearch);
-		}
-		else if(ucChoice == SEARCH_BY_TYPE)
-		{
-			blReturn = deviceReadString("Enter Type: ",
-										ucStringToSearch, STR_MAX_SIZE);
-		}
-		else if(ucChoice == SEARCH_BY_ID)
-		{
-			blReturn = deviceReadValue("Enter Id: ",
-										&ulValueToSearch, READ_HEX);
-			
-		}
-		else if(ucChoice == SEARCH_BY_VENDOR)
-		{
-			blReturn = deviceReadValue("Enter Vendor: ",
-										&ulValueToSearch, READ_HEX);
-		}
-		else
-		{
-			printf("\nUnable to search : Invalid search criteria");
-		}
+		blReturn = deviceReadCriteria(ucChoice, &stCriteria);
 
 		if(blReturn == SUCCESS)
 		{
-			pstTemporaryFile = fileOpen(TEMPORARY_FILE_NAME, FILE_WRITE_MODE);
-
-			while(fileRead(&DeviceData, sizeof(DeviceData),
-				READ_COUNT, pstFile) == SUCCESS)
-			{
-				if(((ucChoice == SEARCH_BY_NAME) && 
-					(strcmp((char*)DeviceData.pucDeviceName,
-					ucStringToSearch) == STRINGS_EQUAL)) ||
-					((ucChoice == SEARCH_BY_TYPE) && 
-					(strcmp((char*)DeviceData.pucDeviceType,
-					ucStringToSearch) == STRINGS_EQUAL)) ||
-					((ucChoice == SEARCH_BY_ID) && 
-					(DeviceData.ulDeviceId == ulValueToSearch) ) ||
-					((ucChoice == SEARCH_BY_VENDOR) && 
-					(DeviceData.ulDeviceVendor == ulValueToSearch) ))
-				{
-					//printf("\n Match found");
-					ucKeepData = 0;
-					ucRemoveData = SUCCESS;
-				}
+			workloadRecord(pucFileName, WORKLOAD_REMOVE, &stCriteria,
+						   sizeof(stCriteria));
+			blReturn = deviceRemoveCriteria(pucFileName, &stCriteria,
+											&ulRemoved);
 
-				if(ucKeepData == SUCCESS)
-				{
-					fileWrite(&DeviceData, sizeof(DeviceData),WRITE_COUNT,
-								pstTemporaryFile);
-				}
-			}
-			fileClose(pstTemporaryFile);
-			//fileClose(pstFile);
-			
-			if(ucRemoveData == SUCCESS)
+			if(blReturn == SUCCESS && ulRemoved > 0)
 			{
-				remove(FILE_NAME);
-				rename(TEMPORARY_FILE_NAME,FILE_NAME);
 				printf("\n Removed the item\n");
 			}
-			else
+			else if(blReturn == SUCCESS)
 			{
-				remove(TEMPORARY_FILE_NAME);
 				printf("No match found to remove.\n");
 			}
-
+			else
+			{
+				printf("\nUnable to remove the item\n");
+			}
 		}
 	}
 	else
@@ -577,213 +686,679 @@ static bool deviceRemoveByCriteria(FILE *pstFile,
 }
 
 //******************************.FUNCTION_HEADER.*******************************
-//Purpose	: To add a new device to the entry
-//Inputs	: const uint8 *pucFileName, pointer to file to which device data is
-//				updated
+//Purpose	: To remove the device with a serial read from the user
+//Inputs	: const uint8 *pucFileName, the file with device details
 //Outputs	: None
 //Return	: True, at time of successful execution
 //Return	: False, in case of an error
-//Notes		: File opened in append mode
+//Notes		: 
 //******************************************************************************
-bool deviceAdd(const uint8 *pucFileName)
+static bool deviceRemoveBySerial(const uint8 *pucFileName)
 {
 	bool blReturn = false;
-	DEVICE_DETAILS DeviceData = {0};
-	FILE *pstFile = NULL;
-	uint32 ulLen = 0;
-	uint8 ucNameLen = 0;
-	uint8 ucTypeLen = 0;
+	bool blRemoved = false;
+	uint32 ulSerial = 0;
 
-	if (pucFileName != NULL)
-	{
-		pstFile = fileOpen(pucFileName, FILE_APPEND_MODE);
-		
-		if(pstFile != NULL)
-		{
-			printf("\nAdd device\n");
-			printf("-----------------------------\n");
-			//getchar();
-			blReturn = deviceReadData(&DeviceData, FILE_NAME);
+	blReturn = deviceReadValue("Enter Serial: ", &ulSerial, READ_NON_HEX);
 
-			if(blReturn == SUCCESS)
-			{
-				blReturn = fileWrite(&DeviceData, sizeof(DeviceData),
-									WRITE_COUNT, pstFile);
-			}
+	if(blReturn == SUCCESS)
+	{
+		workloadRecord(pucFileName, WORKLOAD_REMOVE_SERIAL, &ulSerial,
+					   sizeof(ulSerial));
+		blReturn = deviceRemoveSerial(pucFileName, ulSerial, &blRemoved);
 
-			if(blReturn == SUCCESS)
-			{
-				printf("\n Device details updated successfully");
-			}
-
-			// blReturn = deviceReadString("Enter the device name : ", 
-			// 				DeviceData.pucDeviceName, STR_MAX_SIZE);
-			// if(blReturn == SUCCESS)
-			// {
-			// 	blReturn =  deviceReadString("Enter the device type : ",
-			// 									DeviceData.pucDeviceType,
-			// 									STR_MAX_SIZE);
-			// }
-				
-			// if(blReturn == SUCCESS)
-			// {
-			// 	blReturn = deviceReadValue("Enter the device Id : ",
-			// 								&DeviceData.ulDeviceId,
-			// 								READ_HEX);
-			// }
-
-			// if(blReturn == SUCCESS)
-			// {
-			// 	blReturn = deviceReadValue("Enter the device vendor : ",
-			// 								&DeviceData.ulDeviceVendor,
-			// 								READ_HEX);
-			// }
-
-			// if(blReturn == SUCCESS)
-			// {
-			// 	deviceReadValue("Enter the device Serial : ",
-			// 					&DeviceData.ulDeviceSerial, 
-			// 					READ_NON_HEX);
-				
-			// 	blReturn = deviceCheckSerialAvailable(DeviceData.ulDeviceSerial,
-			// 											pucFileName);
-			// }
-
-			blReturn = fileClose(pstFile);
+		if(blReturn == SUCCESS && blRemoved == true)
+		{
+			printf("\n Removed the item\n");
+		}
+		else if(blReturn == SUCCESS)
+		{
+			printf("No match found to remove.\n");
 		}
 		else
 		{
-			printf("\nUnable to add a new device : Failed to open the file");
+			printf("\nUnable to remove the item\n");
 		}
 	}
-	else
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To check whether the serial of a device is in a set of serials
+//Inputs	: const DEVICE_DETAILS *pstDeviceData, the device to be checked
+//Inputs	: const void *pvContext, HASH_TABLE of serials to their number of
+//			  removed devices
+//Outputs	: None
+//Return	: True, if the serial is in the set
+//Return	: False, if the serial is not in the set
+//Notes		: Counts the match in the set. Shards hold disjoint serials, so
+//			  the parallel shard removals never update the same entry.
+//******************************************************************************
+static bool deviceMatchSerialSet(const DEVICE_DETAILS *pstDeviceData,
+								 const void *pvContext)
+{
+	bool blReturn = false;
+	uint32 *pulRemoved = NULL;
+
+	pulRemoved = hashLookup(pvContext, pstDeviceData->ulDeviceSerial);
+	if(pulRemoved != NULL)
 	{
-		printf("\nUnable to add a new device : Missing file name");
+		(*pulRemoved)++;
+		blReturn = true;
 	}
 
 	return blReturn;
 }
 
 //******************************.FUNCTION_HEADER.*******************************
-//Purpose	: To list devices in file
-//Inputs	: File name with device details
-//Outputs	: None
+//Purpose	: To read a list of serial numbers, one per line
+//Inputs	: const uint8 *pucListName, name of the text file with the list
+//Inputs	: ARENA *pstArena, the arena holding the list
+//Outputs	: uint32 **ppulSerials, the serials in list order
+//Outputs	: uint32 *pulCount, number of serials read
 //Return	: True, at time of successful execution
 //Return	: False, in case of an error
-//Notes		: File opened in read mode
+//Notes		: Empty lines are skipped, invalid lines are reported and skipped
 //******************************************************************************
-bool deviceList(const uint8 *pucFileName)
+static bool deviceReadSerialList(const uint8 *pucListName, ARENA *pstArena,
+								 uint32 **ppulSerials, uint32 *pulCount)
 {
 	bool blReturn = false;
-	DEVICE_DETAILS DeviceData = {0};
 	FILE *pstFile = NULL;
-	uint32 ulLen = 0;
-	uint8 ucNameLen = 0;
-	uint8 ucTypeLen = 0;
-	
-	if (pucFileName != NULL)
+	char pcLine[LINE_MAX_SIZE] = "";
+	char *pcEnd = NULL;
+	uint32 *pulSerials = NULL;
+	uint32 ulCapacity = 0;
+	uint32 ulSerial = 0;
+
+	*ppulSerials = NULL;
+	*pulCount = 0;
+
+	pstFile = fileOpen(pucListName, FILE_READ_TEXT_MODE);
+	if(pstFile != NULL)
 	{
-		pstFile = fileOpen(pucFileName, FILE_READ_MODE);
-		if (pstFile != NULL)
+		blReturn = true;
+		while(blReturn == SUCCESS &&
+			  fgets(pcLine, sizeof(pcLine), pstFile) != NULL)
 		{
-			printf("\nList device\n");
-			printf("-----------------------------\n");
-			printf("Name\t\tType\t\tId\t\tVendor\t\tSerial\n");
-			while(fileRead(&DeviceData, sizeof(DeviceData),
-				  READ_COUNT, pstFile) == SUCCESS)
+			pcLine[strcspn(pcLine, "\r\n")] = '\0';
+			if(pcLine[0] != '\0')
 			{
-				blReturn = devicePrintData(&DeviceData);
+				ulSerial = strtoul(pcLine, &pcEnd, NUMBER_BASE);
+				if(*pcEnd != '\0')
+				{
+					printf("%s\t\tInvalid serial, skipped\n", pcLine);
+				}
+				else
+				{
+					if(*pulCount == ulCapacity)
+					{
+						ulCapacity = (ulCapacity == 0) ? LIST_MIN_SIZE :
+									 ulCapacity * 2;
+						pulSerials = arenaGrow(pstArena, *ppulSerials,
+											   *pulCount * sizeof(uint32),
+											   ulCapacity * sizeof(uint32));
+						blReturn = (pulSerials != NULL);
+						if(blReturn == SUCCESS)
+						{
+							*ppulSerials = pulSerials;
+						}
+						else
+						{
+							printf("\nUnable to read the list : Out of memory");
+						}
+					}
+
+					if(blReturn == SUCCESS)
+					{
+						(*ppulSerials)[*pulCount] = ulSerial;
+						(*pulCount)++;
+					}
+				}
 			}
 		}
-		else
-		{
-			printf("\nUnable to list devices : Failed to open the file");
-		}
+		fileClose(pstFile);
 	}
-	else
+
+	if(blReturn != SUCCESS)
 	{
-		printf("\nUnable to list the devices : Missing file name");
+		*ppulSerials = NULL;
+		*pulCount = 0;
 	}
 
 	return blReturn;
 }
 
 //******************************.FUNCTION_HEADER.*******************************
-//Purpose	: To search an item in device list
-//Inputs	: const uint8 *pucFileName,
-//			  the file with device details and device Id to be searched
-//Inputs	: uint32 ucChoice,
-//			  the choice based on which the device is searched
-//Outputs	: 
+//Purpose	: To apply the updates of one shard
+//Inputs	: SNAPSHOT_WRITER *pstWriter, the writer state
+//Inputs	: const uint8 *pucPath, the shard file
+//Inputs	: const DEVICE_UPDATE *pstUpdates, all the updates of the batch
+//Inputs	: const uint32 *pulShards, shard of each update
+//Inputs	: uint32 ulShard, the shard to be updated
+//Inputs	: uint32 ulCount, number of updates
+//Outputs	: bool *pblUpdated, set for every update applied
+//Outputs	: SHARD_RESULT *pstOldData, the devices before the update
+//Outputs	: SHARD_RESULT *pstNewData, the devices after the update
 //Return	: True, at time of successful execution
 //Return	: False, in case of an error
-//Notes		: 
+//Notes		: Each record is found through the serial index and overwritten
+//			  in place through the page pool
 //******************************************************************************
-bool deviceSearch(const uint8 *pucFileName, uint32 ucChoice)
+static bool deviceUpdateShard(SNAPSHOT_WRITER *pstWriter,
+							  const uint8 *pucPath,
+							  const DEVICE_UPDATE *pstUpdates,
+							  const uint32 *pulShards, uint32 ulShard,
+							  uint32 ulCount, bool *pblUpdated,
+							  SHARD_RESULT *pstOldData,
+							  SHARD_RESULT *pstNewData)
 {
-	bool bReturn = false;
-	FILE *pstFile = NULL;
-
-	if(pucFileName != NULL && 
-	   (ucChoice >= 0 && ucChoice <= SEARCH_CRITERIA_MAXIMUM_OPTIONS))
+	bool blReturn = false;
+	bool blFound = false;
+	bool blKeys = false;
+	HASH_TABLE stSlots = {0};
+	INDEX stIndex = {INDEX_INVALID_FD, {0}};
+	KEYS stKeys;
+	FILE_IDENTITY stBefore = {0};
+	SNAPSHOT_PATCH stPatch;
+	DEVICE_DETAILS DeviceData = {0};
+	uint32 *pulSlot = NULL;
+	uint32 ulIndex = 0;
+	uint32 ulSlot = 0;
+	uint32 ulUpdated = pstNewData->ulCount;
+	off_t lOffset = 0;
+
+	blReturn = (hashCreate(&stSlots, ulCount) == SUCCESS &&
+				indexOpen(pucPath, &stIndex) == SUCCESS);
+	for(ulIndex = 0; ulIndex < ulCount && blReturn == SUCCESS; ulIndex++)
 	{
-		if(ucChoice != BACK_TO_MAIN_MENU)
+		if(pulShards[ulIndex] == ulShard)
+		{
+			if(indexFind(&stIndex, pstUpdates[ulIndex].stValues.ulDeviceSerial,
+						 &ulSlot) != true)
+			{
+				ulSlot = SLOT_NONE;
+			}
+			blReturn = hashInsert(&stSlots,
+								  pstUpdates[ulIndex].stValues.ulDeviceSerial,
+								  ulSlot);
+		}
+	}
+
+	for(ulIndex = 0; ulIndex < ulCount && blReturn == SUCCESS; ulIndex++)
+	{
+		pulSlot = hashLookup(&stSlots,
+							 pstUpdates[ulIndex].stValues.ulDeviceSerial);
+		if(pulShards[ulIndex] == ulShard && pulSlot != NULL &&
+		   *pulSlot != SLOT_NONE)
+		{
+			blFound = true;
+		}
+	}
+
+	if(blReturn == SUCCESS && blFound == true)
+	{
+		fileGetIdentity(pucPath, &stBefore);
+		blReturn = snapshotPatchBegin(pstWriter, pucPath, &stPatch);
+		for(ulIndex = 0; ulIndex < ulCount && blReturn == SUCCESS; ulIndex++)
+		{
+			pulSlot = hashLookup(&stSlots,
+								 pstUpdates[ulIndex].stValues.ulDeviceSerial);
+			if(pulShards[ulIndex] == ulShard && pulSlot != NULL &&
+			   *pulSlot != SLOT_NONE)
+			{
+				lOffset = (off_t)*pulSlot * sizeof(DEVICE_DETAILS);
+				blReturn = filePageRead(stPatch.lFd, &DeviceData,
+										sizeof(DeviceData), lOffset);
+				if(blReturn == SUCCESS)
+				{
+					blReturn = shardResultAppend(pstOldData, &DeviceData);
+				}
+				if(blReturn == SUCCESS)
+				{
+					deviceApplyUpdate(&pstUpdates[ulIndex], &DeviceData);
+					deviceSealRecord(&DeviceData);
+					blReturn = (filePageWrite(stPatch.lFd, &DeviceData,
+											  sizeof(DeviceData),
+											  lOffset) == true &&
+								shardResultAppend(pstNewData,
+												  &DeviceData) == SUCCESS);
+				}
+				pblUpdated[ulIndex] = blReturn;
+			}
+		}
+
+		if(stPatch.lFd != SNAPSHOT_INVALID_FD &&
+		   snapshotPatchEnd(pstWriter, &stPatch, blReturn) != SUCCESS)
+		{
+			blReturn = false;
+		}
+
+		if(blReturn == SUCCESS)
+		{
+			blReturn = (indexSync(&stIndex, pucPath) == SUCCESS &&
+						bloomRetag(pucPath, &stBefore) == SUCCESS);
+		}
+
+		// The updated devices were appended to pstNewData in batch order
+		if(blReturn == SUCCESS &&
+		   keysOpen(pucPath, &stBefore, &stKeys) == true)
 		{
-			pstFile = fileOpen(pucFileName, FILE_READ_MODE);
-			
-			if (pstFile != NULL)
+			blKeys = true;
+			for(ulIndex = 0; ulIndex < ulCount && blKeys == true; ulIndex++)
 			{
-				
-				deviceSearchByCriteria(pstFile, ucChoice);
-				fileClose(pstFile);
+				pulSlot = hashLookup(&stSlots,
+									pstUpdates[ulIndex].stValues.ulDeviceSerial);
+				if(pulShards[ulIndex] == ulShard && pulSlot != NULL &&
+				   *pulSlot != SLOT_NONE)
+				{
+					blKeys = keysPut(&stKeys, *pulSlot,
+									 &pstNewData->pstRecords[ulUpdated++]);
+				}
+			}
+			if(blKeys == true)
+			{
+				keysSync(&stKeys, pucPath);
+			}
+			keysClose(&stKeys);
+		}
+	}
+	indexClose(&stIndex);
+	hashDestroy(&stSlots);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To parse one line of an update batch
+//Inputs	: char *pcLine, "<serial> <field>=<value> ...", the fields being
+//			  name, type, id and vendor, id and vendor in hex
+//Outputs	: DEVICE_UPDATE *pstUpdate, the parsed update
+//Return	: True, if the line is a valid update
+//Return	: False, if the line is invalid
+//Notes		: The line is modified while parsing
+//******************************************************************************
+static bool deviceParseUpdate(char *pcLine, DEVICE_UPDATE *pstUpdate)
+{
+	bool blReturn = false;
+	char *pcToken = NULL;
+	char *pcValue = NULL;
+	char *pcEnd = NULL;
+	char *pcSave = NULL;
+
+	memset(pstUpdate, 0, sizeof(DEVICE_UPDATE));
+	pcToken = strtok_r(pcLine, TOKEN_DELIMITERS, &pcSave);
+	if(pcToken != NULL)
+	{
+		pstUpdate->stValues.ulDeviceSerial = strtoul(pcToken, &pcEnd,
+													 NUMBER_BASE);
+		blReturn = (*pcEnd == '\0');
+	}
+
+	while(blReturn == SUCCESS &&
+		  (pcToken = strtok_r(NULL, TOKEN_DELIMITERS, &pcSave)) != NULL)
+	{
+		pcValue = strchr(pcToken, FIELD_SEPARATOR);
+		blReturn = (pcValue != NULL && strlen(pcValue + 1) < STR_MAX_SIZE);
+		if(blReturn == SUCCESS)
+		{
+			*pcValue++ = '\0';
+			if(strcmp(pcToken, "name") == STRINGS_EQUAL)
+			{
+				strcpy((char *)pstUpdate->stValues.pucDeviceName, pcValue);
+				pstUpdate->ulFieldMask |= DEVICE_FIELD_NAME;
+			}
+			else if(strcmp(pcToken, "type") == STRINGS_EQUAL)
+			{
+				strcpy((char *)pstUpdate->stValues.pucDeviceType, pcValue);
+				pstUpdate->ulFieldMask |= DEVICE_FIELD_TYPE;
+			}
+			else if(strcmp(pcToken, "id") == STRINGS_EQUAL)
+			{
+				pstUpdate->stValues.ulDeviceId = strtoul(pcValue, &pcEnd,
+														 HEX_BASE);
+				pstUpdate->ulFieldMask |= DEVICE_FIELD_ID;
+				blReturn = (*pcValue != '\0' && *pcEnd == '\0');
+			}
+			else if(strcmp(pcToken, "vendor") == STRINGS_EQUAL)
+			{
+				pstUpdate->stValues.ulDeviceVendor = strtoul(pcValue, &pcEnd,
+															 HEX_BASE);
+				pstUpdate->ulFieldMask |= DEVICE_FIELD_VENDOR;
+				blReturn = (*pcValue != '\0' && *pcEnd == '\0');
 			}
 			else
 			{
-				printf("\nUnable to search devices : Failed to open the file");
-			}		
-			
+				blReturn = false;
+			}
+		}
+	}
+
+	return (blReturn == SUCCESS && pstUpdate->ulFieldMask != 0);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To parse a line of a transaction file
+//Inputs	: char *pcLine, "add <serial> <field>=<value> ...",
+//			  "remove <serial>" or "update <serial> <field>=<value> ..."
+//Outputs	: TXN_OPERATION *pstOperation, the operation
+//Return	: True, when the line holds a valid operation
+//Return	: False, otherwise
+//Notes		: An addition has to set all the fields
+//******************************************************************************
+static bool deviceParseOperation(char *pcLine, TXN_OPERATION *pstOperation)
+{
+	bool blReturn = false;
+	char *pcToken = NULL;
+	char *pcRest = NULL;
+	char *pcEnd = NULL;
+
+	memset(pstOperation, 0, sizeof(TXN_OPERATION));
+	pcToken = pcLine + strspn(pcLine, TOKEN_DELIMITERS);
+	pcRest = pcToken + strcspn(pcToken, TOKEN_DELIMITERS);
+	if(*pcRest != '\0')
+	{
+		*pcRest++ = '\0';
+	}
+
+	if(strcmp(pcToken, "add") == STRINGS_EQUAL)
+	{
+		pstOperation->ulOperation = TXN_ADD;
+		blReturn = (deviceParseUpdate(pcRest, &pstOperation->stUpdate) ==
+					SUCCESS &&
+					pstOperation->stUpdate.ulFieldMask == DEVICE_FIELD_ALL);
+	}
+	else if(strcmp(pcToken, "update") == STRINGS_EQUAL)
+	{
+		pstOperation->ulOperation = TXN_UPDATE;
+		blReturn = deviceParseUpdate(pcRest, &pstOperation->stUpdate);
+	}
+	else if(strcmp(pcToken, "remove") == STRINGS_EQUAL)
+	{
+		pstOperation->ulOperation = TXN_REMOVE;
+		pcRest[strcspn(pcRest, TOKEN_DELIMITERS)] = '\0';
+		pstOperation->stUpdate.stValues.ulDeviceSerial = strtoul(pcRest,
+																 &pcEnd,
+																 NUMBER_BASE);
+		blReturn = (*pcRest != '\0' && *pcEnd == '\0');
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read a new value of a hex field, an empty input keeps it
+//Inputs	: const uint8 *pucStringInformation, string that describes
+//			  expected input data
+//Inputs	: uint32 ulField, the DEVICE_FIELD_ flag of the field
+//Outputs	: uint32 *pulValue, the new value
+//Outputs	: uint32 *pulFieldMask, the flag is set when a value is entered
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: 
+//******************************************************************************
+static bool deviceReadOptionalHex(const uint8 *pucStringInformation,
+								  uint32 ulField, uint32 *pulValue,
+								  uint32 *pulFieldMask)
+{
+	bool blReturn = false;
+	uint8 pucString[STR_MAX_SIZE] = "";
+	char *pcEnd = NULL;
+
+	blReturn = deviceReadString(pucStringInformation, pucString,
+								STR_MAX_SIZE);
+	if(blReturn == SUCCESS && pucString[0] != '\0')
+	{
+		*pulValue = strtoul((char *)pucString, &pcEnd, HEX_BASE);
+		blReturn = (*pcEnd == '\0');
+		if(blReturn == SUCCESS)
+		{
+			*pulFieldMask |= ulField;
+		}
+		else
+		{
+			printf("\n Unable to read the value : Invalid input");
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To add a new device to the entry
+//Inputs	: const uint8 *pucFileName, pointer to file to which device data is
+//				updated
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The details are read from the user
+//******************************************************************************
+bool deviceAdd(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	DEVICE_DETAILS DeviceData = {0};
+
+	if (pucFileName != NULL)
+	{
+		printf("\nAdd device\n");
+		printf("-----------------------------\n");
+		blReturn = deviceReadData(&DeviceData, pucFileName);
+
+		if(blReturn == SUCCESS)
+		{
+			workloadRecord(pucFileName, WORKLOAD_ADD, &DeviceData,
+						   sizeof(DeviceData));
+			blReturn = deviceAddRecord(pucFileName, &DeviceData);
+		}
+
+		if(blReturn == SUCCESS)
+		{
+			printf("\n Device details updated successfully");
 		}
-		
 	}
 	else
 	{
-		printf("\nUnable to search : Invalid search parameters");
+		printf("\nUnable to add a new device : Missing file name");
 	}
 
-	return bReturn;
+	return blReturn;
 }
 
 //******************************.FUNCTION_HEADER.*******************************
-//Purpose	: To remove an item from the device list
-//Inputs	: The file with device details and device Id to be removed
+//Purpose	: To add a device to the device data
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: DEVICE_DETAILS *pstDeviceData, the device to be added
+//Outputs	: DEVICE_DETAILS *pstDeviceData, the device with its checksum
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The serial check and the append run as the only writer, the
+//			  appended record is published as a new generation, added to
+//			  the serial index and filter of its shard and counted in the
+//			  counters
+//******************************************************************************
+bool deviceAddRecord(const uint8 *pucFileName, DEVICE_DETAILS *pstDeviceData)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	INDEX stIndex = {INDEX_INVALID_FD, {0}};
+	BLOOM stBloom = {BLOOM_INVALID_FD, "", {0}};
+	KEYS stKeys;
+	SNAPSHOT_WRITER stWriter;
+	FILE_IDENTITY stBefore = {0};
+	uint8 pucShardPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulGeneration = 0;
+	long lEnd = 0;
+
+	TRACE_SPAN("device", "deviceAddRecord");
+
+	if(pucFileName != NULL && pstDeviceData != NULL)
+	{
+		blReturn = snapshotWriterBegin(pucFileName, &stWriter);
+
+		if(blReturn == SUCCESS)
+		{
+			blReturn = (shardGetSerialPath(pucFileName,
+										   pstDeviceData->ulDeviceSerial,
+										   pucShardPath) == SUCCESS &&
+						bloomOpen(pucShardPath, &stBloom) == SUCCESS &&
+						indexOpen(pucShardPath, &stIndex) == SUCCESS);
+
+			if(blReturn == SUCCESS)
+			{
+				blReturn = deviceCheckSerialAvailable(
+												pstDeviceData->ulDeviceSerial,
+												&stBloom, &stIndex);
+			}
+
+			if(blReturn == SUCCESS)
+			{
+				fileGetIdentity(pucShardPath, &stBefore);
+				pstFile = fileOpen(pucShardPath, FILE_APPEND_MODE);
+			}
+
+			if(pstFile != NULL && snapshotCommitBegin(&stWriter) == SUCCESS)
+			{
+				ulGeneration = stWriter.ulGeneration;
+				deviceSealRecord(pstDeviceData);
+				blReturn = fileWrite(pstDeviceData, sizeof(DEVICE_DETAILS),
+									WRITE_COUNT, pstFile);
+				lEnd = ftell(pstFile);
+
+				if(fileClose(pstFile) != SUCCESS ||
+				   snapshotCommitEnd(&stWriter) != SUCCESS)
+				{
+					blReturn = false;
+				}
+
+				if(blReturn == SUCCESS)
+				{
+					statsUpdate(pucFileName, ulGeneration,
+								stWriter.ulGeneration, NULL, 0,
+								pstDeviceData, 1);
+					feedAppend(pucFileName, FEED_ADD, pstDeviceData, 1);
+					historyAppend(pucFileName, NULL, pstDeviceData, 1);
+				}
+
+				// The new record is the last one of the shard
+				if(blReturn == SUCCESS && lEnd > 0)
+				{
+					blReturn = (indexInsert(&stIndex,
+											pstDeviceData->ulDeviceSerial,
+											lEnd / sizeof(DEVICE_DETAILS) -
+											1) == SUCCESS &&
+								indexSync(&stIndex, pucShardPath) == SUCCESS &&
+								bloomInsert(&stBloom,
+											pstDeviceData->ulDeviceSerial) ==
+								SUCCESS &&
+								bloomSync(&stBloom) == SUCCESS);
+				}
+
+				// Keys not describing the shard before the append are left
+				// to be rebuilt by the next search
+				if(blReturn == SUCCESS && lEnd > 0 &&
+				   keysOpen(pucShardPath, &stBefore, &stKeys) == true)
+				{
+					if(keysPut(&stKeys, lEnd / sizeof(DEVICE_DETAILS) - 1,
+							   pstDeviceData) == true)
+					{
+						keysSync(&stKeys, pucShardPath);
+					}
+					keysClose(&stKeys);
+				}
+
+			}
+			else if(blReturn == SUCCESS)
+			{
+				printf("\nUnable to add a new device : Failed to open the file");
+				blReturn = false;
+			}
+			indexClose(&stIndex);
+			bloomClose(&stBloom);
+			snapshotWriterEnd(&stWriter);
+		}
+	}
+	else
+	{
+		printf("\nUnable to add a new device : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To list devices in file
+//Inputs	: File name with device details
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Lists a snapshot, so removals running meanwhile are either
+//			  fully visible or not at all
+//******************************************************************************
+bool deviceList(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	DEVICE_DETAILS DeviceData = {0};
+	SNAPSHOT stSnapshot;
+	SHARD_LAYOUT stLayout = {0};
+	uint32 ulShard = 0;
+	
+	TRACE_SPAN("device", "deviceList");
+
+	if (pucFileName != NULL)
+	{
+		workloadRecord(pucFileName, WORKLOAD_LIST, NULL, 0);
+		if(shardAcquireSnapshot(pucFileName, &stSnapshot,
+								&stLayout) == SUCCESS)
+		{
+			printf("\nList device\n");
+			printf("-----------------------------\n");
+			printf("Name\t\tType\t\tId\t\tVendor\t\tSerial\n");
+
+			for(ulShard = 0; ulShard < stSnapshot.ulFileCount; ulShard++)
+			{
+				while(snapshotRead(&stSnapshot, ulShard,
+								   &DeviceData) == SUCCESS)
+				{
+					blReturn = devicePrintData(&DeviceData);
+				}
+			}
+			snapshotRelease(&stSnapshot);
+		}
+		else
+		{
+			printf("\nUnable to list devices : Failed to open the file");
+		}
+	}
+	else
+	{
+		printf("\nUnable to list the devices : Missing file name");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To search an item in device list
+//Inputs	: const uint8 *pucFileName,
+//			  the file with device details and device Id to be searched
+//Inputs	: uint32 ucChoice,
+//			  the choice based on which the device is searched
 //Outputs	: 
-//Return	: True, at time of successfull execution
+//Return	: True, at time of successful execution
 //Return	: False, in case of an error
 //Notes		: 
 //******************************************************************************
-bool deviceRemove(const uint8 *pucFileName, uint32 ucChoice)
+bool deviceSearch(const uint8 *pucFileName, uint32 ucChoice)
 {
 	bool bReturn = false;
-	FILE *pstFile = NULL;
 
 	if(pucFileName != NULL && 
-	   (ucChoice >= 0 && ucChoice <= REMOVE_CRITERIA_MAXIMUM_OPTIONS))
+	   (ucChoice >= 0 && ucChoice <= SEARCH_CRITERIA_MAXIMUM_OPTIONS))
 	{
 		if(ucChoice != BACK_TO_MAIN_MENU)
 		{
-			pstFile = fileOpen(pucFileName, FILE_READ_MODE);
-			
-			if (pstFile != NULL)
-			{
-				
-				deviceRemoveByCriteria(pstFile, ucChoice);
-				fileClose(pstFile);
-			}
-			else
-			{
-				printf("\nUnable to search devices : Failed to open the file");
-			}		
-			
+			bReturn = deviceSearchByCriteria(pucFileName, ucChoice);
 		}
 		
 	}
@@ -794,4 +1369,1640 @@ bool deviceRemove(const uint8 *pucFileName, uint32 ucChoice)
 
 	return bReturn;
 }
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the devices matching search criteria
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: const DEVICE_CRITERIA *pstCriteria, the criteria to be matched
+//Outputs	: None
+//Return	: True, if at least one device matches
+//Return	: False, if no device matches or in case of an error
+//Notes		: 
+//******************************************************************************
+bool deviceSearchCriteria(const uint8 *pucFileName,
+						  const DEVICE_CRITERIA *pstCriteria)
+{
+	bool blReturn = false;
+
+	TRACE_SPAN("device", "deviceSearchCriteria");
+
+	if(pucFileName != NULL && pstCriteria != NULL)
+	{
+		if(pstCriteria->ulChoice == SEARCH_BY_NAME ||
+		   pstCriteria->ulChoice == SEARCH_BY_TYPE ||
+		   pstCriteria->ulChoice == SEARCH_BY_NAME_FOLDED ||
+		   pstCriteria->ulChoice == SEARCH_BY_TYPE_FOLDED)
+		{
+			blReturn = deviceCheckStringMatch(pucFileName, pstCriteria);
+		}
+		else
+		{
+			blReturn = deviceCheckValueMatch(pucFileName, pstCriteria);
+		}
+	}
+	else
+	{
+		printf("\nUnable to search : Invalid search parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To collect the devices matching search criteria
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: const DEVICE_CRITERIA *pstCriteria, the criteria to be matched
+//Outputs	: SHARD_RESULT *pstResult, the matching devices appended
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Searches by serial, name or type are answered by the shared
+//			  cache while it is current. Otherwise all the shards are
+//			  searched in parallel, through their segments when up to date,
+//			  skipping the blocks whose value ranges exclude the searched
+//			  value. A serial search only reads the shard holding the
+//			  serial. Searches ignoring case and blanks compare the
+//			  normalized keys instead.
+//******************************************************************************
+bool deviceCollectCriteria(const uint8 *pucFileName,
+						   const DEVICE_CRITERIA *pstCriteria,
+						   SHARD_RESULT *pstResult)
+{
+	bool blReturn = false;
+
+	TRACE_SPAN("device", "deviceCollectCriteria");
+
+	if(pucFileName != NULL && pstCriteria != NULL && pstResult != NULL)
+	{
+		if(cacheCollect(pucFileName, pstCriteria, pstResult) == true)
+		{
+			blReturn = true;
+		}
+		else if(pstCriteria->ulChoice == SEARCH_BY_NAME_FOLDED ||
+		   pstCriteria->ulChoice == SEARCH_BY_TYPE_FOLDED)
+		{
+			blReturn = keysSearch(pucFileName,
+								  (pstCriteria->ulChoice ==
+								   SEARCH_BY_NAME_FOLDED) ?
+								  KEYS_FIELD_NAME : KEYS_FIELD_TYPE,
+								  pstCriteria->pucString, pstResult);
+		}
+		else if(pstCriteria->ulChoice == SEARCH_BY_SERIAL)
+		{
+			blReturn = shardScanSerial(pucFileName, pstCriteria->ulValue,
+									   deviceMatchCriteria, deviceZoneMatch,
+									   pstCriteria, pstResult);
+		}
+		else
+		{
+			blReturn = shardScan(pucFileName, deviceMatchCriteria,
+								 deviceZoneMatch, pstCriteria, pstResult);
+		}
+	}
+	else
+	{
+		printf("\nUnable to search : Invalid search parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the devices whose names are closest to a name
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: const uint8 *pucName, the name, possibly mistyped
+//Inputs	: uint32 ulCount, number of devices wanted
+//Outputs	: None
+//Return	: True, if at least one device is close enough
+//Return	: False, if none is or in case of an error
+//Notes		: Names further than a third of the name length of edits away
+//			  are not printed
+//******************************************************************************
+bool deviceSearchClosest(const uint8 *pucFileName, const uint8 *pucName,
+						 uint32 ulCount)
+{
+	bool blReturn = false;
+	TRIGRAM_MATCH pstMatches[TRIGRAM_MAX_MATCHES];
+	uint32 ulFound = 0;
+	uint32 ulIndex = 0;
+
+	TRACE_SPAN("device", "deviceSearchClosest");
+
+	if(trigramSearch(pucFileName, pucName, ulCount, pstMatches,
+					 &ulFound) == SUCCESS)
+	{
+		if(ulFound > 0)
+		{
+			printf("Closest names:\n");
+			printf("Edits\tName\t\tType\t\tId\t\tVendor\t\tSerial\n");
+			for(ulIndex = 0; ulIndex < ulFound; ulIndex++)
+			{
+				printf("%lu\t", pstMatches[ulIndex].ulDistance);
+				devicePrintData(&pstMatches[ulIndex].stDevice);
+			}
+			blReturn = SUCCESS;
+		}
+		else
+		{
+			printf("No close name found\n");
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print a history entry
+//Inputs	: const HISTORY_ENTRY *pstEntry, the entry
+//Inputs	: void *pvContext, count of the printed entries
+//Outputs	: None
+//Return	: True, to go on with the next entry
+//Notes		:
+//******************************************************************************
+static bool devicePrintHistory(const HISTORY_ENTRY *pstEntry, void *pvContext)
+{
+	DEVICE_DETAILS DeviceData = pstEntry->stDevice;
+	uint8 pucTime[HISTORY_TIME_SIZE] = "";
+
+	if(*(uint32 *)pvContext == 0)
+	{
+		printf("Time			Change		Name		Type		Id		Vendor		"
+			   "Serial\n");
+	}
+	(*(uint32 *)pvContext)++;
+	historyFormatTime(pstEntry->ulTime, pucTime);
+	printf("%s\t%-8s\t", pucTime,
+		   pstEntry->ulOperation == HISTORY_INSERT ? "inserted" : "removed");
+	devicePrintData(&DeviceData);
+
+	return true;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the devices existing at a time
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: uint32 ulTime, the time
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool deviceHistoryAsOf(const uint8 *pucFileName, uint32 ulTime)
+{
+	bool blReturn = false;
+	ARENA stArena;
+	SHARD_RESULT stResult = {0};
+	uint8 pucTime[HISTORY_TIME_SIZE] = "";
+
+	TRACE_SPAN("device", "deviceHistoryAsOf");
+
+	arenaInit(&stArena, ARENA_QUERY_SIZE);
+	stResult.pstArena = &stArena;
+	blReturn = historyAsOf(pucFileName, ulTime, &stResult);
+	if(blReturn == SUCCESS)
+	{
+		historyFormatTime(ulTime, pucTime);
+		printf("\n%lu device(s) as of %s\n", stResult.ulCount, pucTime);
+		devicePrintResult(&stResult);
+	}
+	arenaRelease(&stArena);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the changes made within a time range
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: uint32 ulFrom and ulTo, the range, ulTo excluded
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: An update shows as the removal of a version and the insertion
+//			  of the next one
+//******************************************************************************
+bool deviceHistoryChanges(const uint8 *pucFileName, uint32 ulFrom, uint32 ulTo)
+{
+	bool blReturn = false;
+	uint32 ulCount = 0;
+
+	TRACE_SPAN("device", "deviceHistoryChanges");
+
+	blReturn = historyRange(pucFileName, ulFrom, ulTo, devicePrintHistory,
+							&ulCount);
+	if(blReturn == SUCCESS && ulCount == 0)
+	{
+		printf("\nNo change in the range\n");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To apply the pending removals and updates of a comparison
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: DEVICE_DIFF *pstDiff, the pending changes
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Recorded as a remove-list and an update-batch operation
+//******************************************************************************
+static bool deviceFlushDiff(const uint8 *pucFileName, DEVICE_DIFF *pstDiff)
+{
+	bool blReturn = true;
+	uint32 ulIndex = 0;
+
+	if(pstDiff->ulSerialCount > 0)
+	{
+		workloadRecord(pucFileName, WORKLOAD_REMOVE_LIST, pstDiff->pulSerials,
+					   pstDiff->ulSerialCount * sizeof(uint32));
+		blReturn = deviceRemoveSerials(pucFileName, pstDiff->pulSerials,
+									   pstDiff->ulSerialCount);
+		pstDiff->ulApplied += pstDiff->ulSerialCount;
+		pstDiff->ulSerialCount = 0;
+	}
+
+	if(blReturn == SUCCESS && pstDiff->ulUpdateCount > 0)
+	{
+		workloadRecord(pucFileName, WORKLOAD_UPDATE_BATCH, pstDiff->pstUpdates,
+					   pstDiff->ulUpdateCount * sizeof(DEVICE_UPDATE));
+		blReturn = deviceUpdateRecords(pucFileName, pstDiff->pstUpdates,
+									   pstDiff->ulUpdateCount,
+									   pstDiff->pblUpdated);
+		for(ulIndex = 0; ulIndex < pstDiff->ulUpdateCount; ulIndex++)
+		{
+			pstDiff->ulApplied += (pstDiff->pblUpdated[ulIndex] == true);
+		}
+		pstDiff->ulUpdateCount = 0;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print a difference and to apply it when asked to
+//Inputs	: const DIFF_ENTRY *pstEntry, the difference
+//Inputs	: void *pvContext, the DEVICE_DIFF of the comparison
+//Outputs	: None
+//Return	: True, to go on with the next difference
+//Return	: False, when applying failed
+//Notes		: Removals and updates are applied by batches, additions one by
+//			  one
+//******************************************************************************
+static bool devicePrintDiff(const DIFF_ENTRY *pstEntry, void *pvContext)
+{
+	DEVICE_DIFF *pstDiff = pvContext;
+	DEVICE_DETAILS DeviceData = {0};
+	DEVICE_UPDATE *pstUpdate = NULL;
+
+	if(pstDiff->ulPrinted == 0)
+	{
+		printf("Change		Name		Type		Id		Vendor		Serial\n");
+	}
+	pstDiff->ulPrinted++;
+
+	if(pstEntry->ulOperation != DIFF_ADDED)
+	{
+		DeviceData = pstEntry->stOurs;
+		printf("%-8s\t", pstEntry->ulOperation == DIFF_REMOVED ? "removed" :
+			   "old");
+		devicePrintData(&DeviceData);
+	}
+	if(pstEntry->ulOperation != DIFF_REMOVED)
+	{
+		DeviceData = pstEntry->stOther;
+		printf("%-8s\t", pstEntry->ulOperation == DIFF_ADDED ? "added" :
+			   "new");
+		devicePrintData(&DeviceData);
+	}
+
+	if(pstDiff->blApply != true)
+	{
+		return true;
+	}
+
+	if(pstEntry->ulOperation == DIFF_ADDED)
+	{
+		DeviceData = pstEntry->stOther;
+		workloadRecord(pstDiff->pucFileName, WORKLOAD_ADD, &DeviceData,
+					   sizeof(DEVICE_DETAILS));
+		pstDiff->blStatus = deviceAddRecord(pstDiff->pucFileName,
+											&DeviceData);
+		pstDiff->ulApplied += (pstDiff->blStatus == SUCCESS);
+	}
+	else if(pstEntry->ulOperation == DIFF_REMOVED)
+	{
+		pstDiff->pulSerials[pstDiff->ulSerialCount++] =
+			pstEntry->stOurs.ulDeviceSerial;
+	}
+	else
+	{
+		pstUpdate = &pstDiff->pstUpdates[pstDiff->ulUpdateCount++];
+		pstUpdate->ulFieldMask = DEVICE_FIELD_NAME | DEVICE_FIELD_TYPE |
+								 DEVICE_FIELD_ID | DEVICE_FIELD_VENDOR;
+		pstUpdate->stValues = pstEntry->stOther;
+	}
+
+	if(pstDiff->blStatus == SUCCESS &&
+	   (pstDiff->ulSerialCount == DIFF_APPLY_BATCH ||
+		pstDiff->ulUpdateCount == DIFF_APPLY_BATCH))
+	{
+		pstDiff->blStatus = deviceFlushDiff(pstDiff->pucFileName, pstDiff);
+	}
+
+	return pstDiff->blStatus;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compare the device data with another device file
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: const uint8 *pucOtherPath, the other device file
+//Inputs	: bool blApply, true to turn the data into the other file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The differences are applied once the comparison is over,
+//			  through the usual add, remove and update paths, and recorded
+//			  as these operations
+//******************************************************************************
+bool deviceDiff(const uint8 *pucFileName, const uint8 *pucOtherPath,
+				bool blApply)
+{
+	bool blReturn = false;
+	DEVICE_DIFF *pstDiff = NULL;
+	DIFF_REPORT stReport = {0};
+
+	TRACE_SPAN("device", "deviceDiff");
+
+	pstDiff = calloc(1, sizeof(DEVICE_DIFF));
+	if(pucFileName != NULL && pucOtherPath != NULL && pstDiff != NULL)
+	{
+		pstDiff->pucFileName = pucFileName;
+		pstDiff->blApply = blApply;
+		pstDiff->blStatus = SUCCESS;
+		blReturn = diffFiles(pucFileName, pucOtherPath, devicePrintDiff,
+							 pstDiff, &stReport);
+		if(blReturn == SUCCESS && blApply == true)
+		{
+			blReturn = (pstDiff->blStatus == SUCCESS &&
+						deviceFlushDiff(pucFileName, pstDiff) == SUCCESS);
+		}
+
+		if(blReturn == SUCCESS)
+		{
+			printf("\n %lu added, %lu removed, %lu changed of %lu and %lu "
+				   "device(s), %lu corrupt record(s) skipped\n",
+				   stReport.ulAddedCount, stReport.ulRemovedCount,
+				   stReport.ulChangedCount, stReport.ulOurCount,
+				   stReport.ulOtherCount, stReport.ulSkippedCount);
+			printf(" Compared in %.1f ms, %lu partition(s) on %lu thread(s)\n",
+				   stReport.dMilliseconds, stReport.ulPartitionCount,
+				   stReport.ulThreadCount);
+			if(blApply == true)
+			{
+				printf(" Applied %lu change(s)\n", pstDiff->ulApplied);
+			}
+		}
+		else if(blApply == true)
+		{
+			printf("\nUnable to apply the differences, %lu applied\n",
+				   pstDiff->ulApplied);
+		}
+	}
+	else
+	{
+		printf("\nUnable to compare : Invalid parameters");
+	}
+	free(pstDiff);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove an item from the device list
+//Inputs	: The file with device details and device Id to be removed
+//Outputs	: 
+//Return	: True, at time of successfull execution
+//Return	: False, in case of an error
+//Notes		: Removal by serial goes straight to the one record through the
+//			  serial index
+//******************************************************************************
+bool deviceRemove(const uint8 *pucFileName, uint32 ucChoice)
+{
+	bool bReturn = false;
+
+	if(pucFileName != NULL && 
+	   (ucChoice >= 0 && ucChoice <= REMOVE_CRITERIA_MAXIMUM_OPTIONS))
+	{
+		if(ucChoice == REMOVE_BY_SERIAL)
+		{
+			bReturn = deviceRemoveBySerial(pucFileName);
+		}
+		else if(ucChoice != BACK_TO_MAIN_MENU)
+		{
+			bReturn = deviceRemoveByCriteria(pucFileName, ucChoice);
+		}
+		
+	}
+	else
+	{
+		printf("\nUnable to search : Invalid search parameters");
+	}
+
+	return bReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the devices matching criteria
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: const DEVICE_CRITERIA *pstCriteria, the criteria to be matched
+//Outputs	: uint32 *pulRemoved, number of removed devices
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Only the shards holding a matching device are rewritten. A
+//			  name or type ignoring case and blanks is normalized once here.
+//******************************************************************************
+bool deviceRemoveCriteria(const uint8 *pucFileName,
+						  const DEVICE_CRITERIA *pstCriteria,
+						  uint32 *pulRemoved)
+{
+	bool blReturn = false;
+	DEVICE_CRITERIA stCriteria;
+
+	TRACE_SPAN("device", "deviceRemoveCriteria");
+
+	if(pucFileName != NULL && pstCriteria != NULL && pulRemoved != NULL)
+	{
+		*pulRemoved = 0;
+		stCriteria = *pstCriteria;
+		if(stCriteria.ulChoice == SEARCH_BY_NAME_FOLDED ||
+		   stCriteria.ulChoice == SEARCH_BY_TYPE_FOLDED)
+		{
+			keysNormalize(pstCriteria->pucString, stCriteria.pucString);
+		}
+		blReturn = deviceRemoveMatching(pucFileName, deviceMatchCriteria,
+										&stCriteria, pulRemoved);
+	}
+	else
+	{
+		printf("\nUnable to remove by criteria : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the device with a given serial
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: uint32 ulSerial, serial of the device to be removed
+//Outputs	: bool *pblRemoved, whether a device has been removed
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The serial index gives the slot of the record, the last record
+//			  of the shard is moved into it and the shard is truncated by one
+//			  record. Constant time, but the order of the records changes.
+//******************************************************************************
+bool deviceRemoveSerial(const uint8 *pucFileName, uint32 ulSerial,
+						bool *pblRemoved)
+{
+	bool blReturn = false;
+	DEVICE_DETAILS DeviceData = {0};
+	DEVICE_DETAILS LastData = {0};
+	INDEX stIndex = {INDEX_INVALID_FD, {0}};
+	KEYS stKeys;
+	SNAPSHOT_WRITER stWriter;
+	SNAPSHOT_PATCH stPatch;
+	struct stat stStatus;
+	uint8 pucShardPath[FILE_PATH_MAX_SIZE] = "";
+	FILE_IDENTITY stBefore = {0};
+	uint32 ulSlot = 0;
+	uint32 ulLast = 0;
+	uint32 ulGeneration = 0;
+
+	TRACE_SPAN("device", "deviceRemoveSerial");
+
+	if(pucFileName != NULL && pblRemoved != NULL &&
+	   snapshotWriterBegin(pucFileName, &stWriter) == SUCCESS)
+	{
+		*pblRemoved = false;
+		blReturn = (shardGetSerialPath(pucFileName, ulSerial,
+									   pucShardPath) == SUCCESS &&
+					indexOpen(pucShardPath, &stIndex) == SUCCESS);
+
+		if(blReturn == SUCCESS &&
+		   indexFind(&stIndex, ulSerial, &ulSlot) == true)
+		{
+			ulGeneration = stWriter.ulGeneration;
+			fileGetIdentity(pucShardPath, &stBefore);
+			blReturn = snapshotPatchBegin(&stWriter, pucShardPath, &stPatch);
+
+			if(blReturn == SUCCESS)
+			{
+				blReturn = (fstat(stPatch.lFd, &stStatus) == 0 &&
+							stStatus.st_size >= (off_t)sizeof(DEVICE_DETAILS) &&
+							filePageRead(stPatch.lFd, &DeviceData,
+										 sizeof(DeviceData),
+										 ulSlot * sizeof(DEVICE_DETAILS)) ==
+							true &&
+							DeviceData.ulDeviceSerial == ulSerial);
+				ulLast = stStatus.st_size / sizeof(DEVICE_DETAILS) - 1;
+			}
+
+			if(blReturn == SUCCESS && ulSlot != ulLast)
+			{
+				blReturn = (filePageRead(stPatch.lFd, &LastData,
+										 sizeof(LastData),
+										 ulLast * sizeof(DEVICE_DETAILS)) ==
+							true &&
+							filePageWrite(stPatch.lFd, &LastData,
+										  sizeof(LastData),
+										  ulSlot * sizeof(DEVICE_DETAILS)) ==
+							true);
+			}
+
+			if(blReturn == SUCCESS)
+			{
+				blReturn = filePageTruncate(stPatch.lFd,
+											ulLast * sizeof(DEVICE_DETAILS));
+			}
+
+			if(stPatch.lFd != SNAPSHOT_INVALID_FD &&
+			   snapshotPatchEnd(&stWriter, &stPatch, blReturn) != SUCCESS)
+			{
+				blReturn = false;
+			}
+
+			// A failure leaves the index describing an older file, it is
+			// then rebuilt by the next writer
+			if(blReturn == SUCCESS)
+			{
+				*pblRemoved = true;
+				statsUpdate(pucFileName, ulGeneration, stWriter.ulGeneration,
+							&DeviceData, 1, NULL, 0);
+				feedAppend(pucFileName, FEED_REMOVE, &DeviceData, 1);
+				historyAppend(pucFileName, &DeviceData, NULL, 1);
+				blReturn = (indexRemove(&stIndex, ulSerial) == SUCCESS &&
+							(ulSlot == ulLast ||
+							 indexInsert(&stIndex, LastData.ulDeviceSerial,
+										 ulSlot) == SUCCESS) &&
+							indexSync(&stIndex, pucShardPath) == SUCCESS &&
+							bloomRetag(pucShardPath, &stBefore) == SUCCESS);
+
+				if(keysOpen(pucShardPath, &stBefore, &stKeys) == true)
+				{
+					if((ulSlot == ulLast ||
+						keysMove(&stKeys, ulLast, ulSlot) == true) &&
+					   keysTruncate(&stKeys, ulLast) == true)
+					{
+						keysSync(&stKeys, pucShardPath);
+					}
+					keysClose(&stKeys);
+				}
+			}
+			else
+			{
+				printf("\nUnable to remove the serial %lu : Serial index out"
+					   " of date", ulSerial);
+			}
+		}
+		indexClose(&stIndex);
+		snapshotWriterEnd(&stWriter);
+	}
+	else
+	{
+		printf("\nUnable to remove by serial : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To check whether a device matches a search criteria
+//Inputs	: const DEVICE_DETAILS *pstDeviceData, the device to be checked
+//Inputs	: const void *pvContext, the DEVICE_CRITERIA to be matched
+//Outputs	: None
+//Return	: True, if the device matches the criteria
+//Return	: False, if the device does not match the criteria
+//Notes		: Used as the predicate of shard scans and removals. A name or
+//			  type ignoring case and blanks has to be normalized already.
+//******************************************************************************
+bool deviceMatchCriteria(const DEVICE_DETAILS *pstDeviceData,
+						 const void *pvContext)
+{
+	const DEVICE_CRITERIA *pstCriteria = pvContext;
+	bool blReturn = false;
+	uint8 pucKey[STR_MAX_SIZE];
+
+	if(pstDeviceData != NULL && pstCriteria != NULL &&
+	   (pstCriteria->ulChoice == SEARCH_BY_NAME_FOLDED ||
+		pstCriteria->ulChoice == SEARCH_BY_TYPE_FOLDED))
+	{
+		keysNormalize((pstCriteria->ulChoice == SEARCH_BY_NAME_FOLDED) ?
+					  pstDeviceData->pucDeviceName :
+					  pstDeviceData->pucDeviceType, pucKey);
+		blReturn = (strncmp((char *)pucKey, (char *)pstCriteria->pucString,
+							STR_MAX_SIZE) == STRINGS_EQUAL);
+	}
+	else if(pstDeviceData != NULL && pstCriteria != NULL)
+	{
+		blReturn = (((pstCriteria->ulChoice == SEARCH_BY_NAME) &&
+					(strcmp((char *)pstDeviceData->pucDeviceName,
+					(char *)pstCriteria->pucString) == STRINGS_EQUAL)) ||
+					((pstCriteria->ulChoice == SEARCH_BY_TYPE) &&
+					(strcmp((char *)pstDeviceData->pucDeviceType,
+					(char *)pstCriteria->pucString) == STRINGS_EQUAL)) ||
+					((pstCriteria->ulChoice == SEARCH_BY_ID) &&
+					(pstDeviceData->ulDeviceId == pstCriteria->ulValue)) ||
+					((pstCriteria->ulChoice == SEARCH_BY_VENDOR) &&
+					(pstDeviceData->ulDeviceVendor == pstCriteria->ulValue)) ||
+					((pstCriteria->ulChoice == SEARCH_BY_SERIAL) &&
+					(pstDeviceData->ulDeviceSerial == pstCriteria->ulValue)));
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove all the devices whose serial is in a list
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: const uint8 *pucListName, text file with one serial per line
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: 
+//******************************************************************************
+bool deviceRemoveSerialList(const uint8 *pucFileName,
+							const uint8 *pucListName)
+{
+	bool blReturn = false;
+	ARENA stArena;
+	uint32 *pulSerials = NULL;
+	uint32 ulCount = 0;
+
+	if(pucFileName != NULL && pucListName != NULL)
+	{
+		arenaInit(&stArena, ARENA_TABLE_SIZE);
+		blReturn = deviceReadSerialList(pucListName, &stArena, &pulSerials,
+										&ulCount);
+
+		if(blReturn == SUCCESS)
+		{
+			workloadRecord(pucFileName, WORKLOAD_REMOVE_LIST, pulSerials,
+						   ulCount * sizeof(uint32));
+			blReturn = deviceRemoveSerials(pucFileName, pulSerials, ulCount);
+		}
+		else
+		{
+			printf("\nUnable to remove the listed devices\n");
+		}
+		arenaRelease(&stArena);
+	}
+	else
+	{
+		printf("\nUnable to remove the listed devices : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove all the devices whose serial is in a list
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: const uint32 *pulSerials, the serials
+//Inputs	: uint32 ulCount, number of serials
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The serials are loaded into a hash set and every shard is
+//			  rewritten at most once, whatever the length of the list. The
+//			  outcome of every serial is printed in list order.
+//******************************************************************************
+bool deviceRemoveSerials(const uint8 *pucFileName, const uint32 *pulSerials,
+						 uint32 ulCount)
+{
+	bool blReturn = false;
+	HASH_TABLE stSerials = {0};
+	uint32 *pulRemoved = NULL;
+	uint32 ulIndex = 0;
+	uint32 ulRemoved = 0;
+	uint32 ulNotFound = 0;
+
+	TRACE_SPAN("device", "deviceRemoveSerials");
+
+	if(pucFileName != NULL && (pulSerials != NULL || ulCount == 0))
+	{
+		blReturn = hashCreate(&stSerials, ulCount);
+
+		for(ulIndex = 0; ulIndex < ulCount && blReturn == SUCCESS; ulIndex++)
+		{
+			blReturn = hashInsert(&stSerials, pulSerials[ulIndex], 0);
+		}
+
+		if(blReturn == SUCCESS && ulCount > 0)
+		{
+			blReturn = deviceRemoveMatching(pucFileName, deviceMatchSerialSet,
+											&stSerials, &ulRemoved);
+		}
+
+		if(blReturn == SUCCESS)
+		{
+			printf("Serial\t\tOutcome\n");
+			for(ulIndex = 0; ulIndex < ulCount; ulIndex++)
+			{
+				pulRemoved = hashLookup(&stSerials, pulSerials[ulIndex]);
+				if(pulRemoved == NULL)
+				{
+					printf("%lu\t\tDuplicate in list\n", pulSerials[ulIndex]);
+				}
+				else if(*pulRemoved > 0)
+				{
+					printf("%lu\t\tRemoved\n", pulSerials[ulIndex]);
+				}
+				else
+				{
+					printf("%lu\t\tNot found\n", pulSerials[ulIndex]);
+					ulNotFound++;
+				}
+
+				// Later occurrences of the serial are duplicates
+				hashRemove(&stSerials, pulSerials[ulIndex]);
+			}
+			printf("\n Removed %lu device(s), %lu serial(s) not found\n",
+				   ulRemoved, ulNotFound);
+		}
+		else
+		{
+			printf("\nUnable to remove the listed devices\n");
+		}
+
+		hashDestroy(&stSerials);
+	}
+	else
+	{
+		printf("\nUnable to remove the listed devices : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the devices listed in a file named by the user
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: 
+//******************************************************************************
+bool deviceBulkRemove(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	uint8 pucListName[FILE_PATH_MAX_SIZE] = "";
+
+	if(pucFileName != NULL)
+	{
+		printf("\nBulk remove devices\n");
+		printf("-----------------------------\n");
+		blReturn = deviceReadString("Enter the serial list file : ",
+									pucListName, FILE_PATH_MAX_SIZE);
+		if(blReturn == SUCCESS)
+		{
+			blReturn = deviceRemoveSerialList(pucFileName, pucListName);
+		}
+	}
+	else
+	{
+		printf("\nUnable to remove the listed devices : Missing file name");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To update devices in place, keyed by their serial
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: const DEVICE_UPDATE *pstUpdates, the updates to be applied
+//Inputs	: uint32 ulCount, number of updates
+//Outputs	: bool *pblUpdated, true for every update applied
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Only the changed fixed size records are overwritten. Updates
+//			  of the same serial are applied in order. Each shard is
+//			  published as it is updated.
+//******************************************************************************
+bool deviceUpdateRecords(const uint8 *pucFileName,
+						 const DEVICE_UPDATE *pstUpdates, uint32 ulCount,
+						 bool *pblUpdated)
+{
+	bool blReturn = false;
+	SNAPSHOT_WRITER stWriter;
+	SHARD_LAYOUT stLayout = {0};
+	ARENA stArena;
+	SHARD_RESULT stOldData = {0};
+	SHARD_RESULT stNewData = {0};
+	uint8 pucShardPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 *pulShards = NULL;
+	uint32 ulIndex = 0;
+	uint32 ulShard = 0;
+	uint32 ulGeneration = 0;
+
+	TRACE_SPAN("device", "deviceUpdateRecords");
+
+	if(pucFileName != NULL && pstUpdates != NULL && pblUpdated != NULL)
+	{
+		arenaInit(&stArena, ARENA_QUERY_SIZE);
+		stOldData.pstArena = &stArena;
+		stNewData.pstArena = &stArena;
+		pulShards = arenaAlloc(&stArena, ulCount * sizeof(uint32));
+		if(pulShards != NULL &&
+		   snapshotWriterBegin(pucFileName, &stWriter) == SUCCESS)
+		{
+			ulGeneration = stWriter.ulGeneration;
+			blReturn = shardGetLayout(pucFileName, &stLayout);
+			for(ulIndex = 0; ulIndex < ulCount; ulIndex++)
+			{
+				pblUpdated[ulIndex] = false;
+				pulShards[ulIndex] = shardRoute(
+								pstUpdates[ulIndex].stValues.ulDeviceSerial,
+								stLayout.ulShardCount);
+			}
+
+			for(ulShard = 0; ulShard < stLayout.ulShardCount &&
+				blReturn == SUCCESS; ulShard++)
+			{
+				blReturn = (shardGetPath(pucFileName, &stLayout, ulShard,
+										 pucShardPath) == SUCCESS &&
+							deviceUpdateShard(&stWriter, pucShardPath,
+											  pstUpdates, pulShards, ulShard,
+											  ulCount, pblUpdated, &stOldData,
+											  &stNewData) == SUCCESS);
+			}
+
+			// Counts the type and vendor changes and logs the new records
+			// along with the versions they replace
+			if(blReturn == SUCCESS && stOldData.ulCount > 0)
+			{
+				statsUpdate(pucFileName, ulGeneration, stWriter.ulGeneration,
+							stOldData.pstRecords, stOldData.ulCount,
+							stNewData.pstRecords, stNewData.ulCount);
+				feedAppend(pucFileName, FEED_UPDATE, stNewData.pstRecords,
+						   stNewData.ulCount);
+				historyAppend(pucFileName, stOldData.pstRecords,
+							  stNewData.pstRecords, stNewData.ulCount);
+			}
+			snapshotWriterEnd(&stWriter);
+		}
+		arenaRelease(&stArena);
+	}
+	else
+	{
+		printf("\nUnable to update the devices : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To apply a batch of updates read from a file
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: const uint8 *pucBatchName, text file with one update per line,
+//			  "<serial> <field>=<value> ..."
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The outcome of every line is printed in batch order
+//******************************************************************************
+bool deviceUpdateBatch(const uint8 *pucFileName, const uint8 *pucBatchName)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	char pcLine[LINE_MAX_SIZE] = "";
+	ARENA stArena;
+	DEVICE_UPDATE *pstUpdates = NULL;
+	DEVICE_UPDATE *pstGrown = NULL;
+	bool *pblUpdated = NULL;
+	uint32 ulCapacity = 0;
+	uint32 ulCount = 0;
+	uint32 ulIndex = 0;
+	uint32 ulUpdated = 0;
+
+	TRACE_SPAN("device", "deviceUpdateBatch");
+
+	if(pucFileName != NULL && pucBatchName != NULL)
+	{
+		arenaInit(&stArena, ARENA_TABLE_SIZE);
+		pstFile = fileOpen(pucBatchName, FILE_READ_TEXT_MODE);
+		blReturn = (pstFile != NULL);
+		while(blReturn == SUCCESS &&
+			  fgets(pcLine, sizeof(pcLine), pstFile) != NULL)
+		{
+			if(ulCount == ulCapacity)
+			{
+				ulCapacity = (ulCapacity == 0) ? LIST_MIN_SIZE : ulCapacity * 2;
+				pstGrown = arenaGrow(&stArena, pstUpdates,
+									 ulCount * sizeof(DEVICE_UPDATE),
+									 ulCapacity * sizeof(DEVICE_UPDATE));
+				blReturn = (pstGrown != NULL);
+				if(blReturn == SUCCESS)
+				{
+					pstUpdates = pstGrown;
+				}
+			}
+
+			if(blReturn == SUCCESS && pcLine[strspn(pcLine, TOKEN_DELIMITERS)]
+			   != '\0')
+			{
+				if(deviceParseUpdate(pcLine, &pstUpdates[ulCount]) == SUCCESS)
+				{
+					ulCount++;
+				}
+				else
+				{
+					printf("Invalid update line skipped\n");
+				}
+			}
+		}
+		if(pstFile != NULL)
+		{
+			fileClose(pstFile);
+		}
+
+		if(blReturn == SUCCESS)
+		{
+			workloadRecord(pucFileName, WORKLOAD_UPDATE_BATCH, pstUpdates,
+						   ulCount * sizeof(DEVICE_UPDATE));
+			pblUpdated = arenaAlloc(&stArena, ulCount * sizeof(bool));
+			blReturn = (pblUpdated != NULL &&
+						deviceUpdateRecords(pucFileName, pstUpdates, ulCount,
+											pblUpdated) == SUCCESS);
+		}
+
+		if(blReturn == SUCCESS)
+		{
+			printf("Serial\t\tOutcome\n");
+			for(ulIndex = 0; ulIndex < ulCount; ulIndex++)
+			{
+				printf("%lu\t\t%s\n", pstUpdates[ulIndex].stValues.ulDeviceSerial,
+					   pblUpdated[ulIndex] == true ? "Updated" : "Not found");
+				ulUpdated += (pblUpdated[ulIndex] == true);
+			}
+			printf("\n Applied %lu of %lu update(s)\n", ulUpdated, ulCount);
+		}
+		else
+		{
+			printf("\nUnable to apply the update batch\n");
+		}
+
+		arenaRelease(&stArena);
+	}
+	else
+	{
+		printf("\nUnable to apply the update batch : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To apply a transaction read from a file
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: const uint8 *pucTransactionName, text file with one operation
+//			  per line, "add <serial> <field>=<value> ...", "remove <serial>"
+//			  or "update <serial> <field>=<value> ..."
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Either every operation is applied or none of them, an invalid
+//			  line fails the whole transaction. A committed transaction is
+//			  recorded as a whole.
+//******************************************************************************
+bool deviceTransaction(const uint8 *pucFileName,
+					   const uint8 *pucTransactionName)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	char pcLine[LINE_MAX_SIZE] = "";
+	ARENA stArena;
+	TXN_OPERATION *pstOperations = NULL;
+	TXN_OPERATION *pstGrown = NULL;
+	TXN_REPORT stReport = {0};
+	uint32 ulCapacity = 0;
+	uint32 ulCount = 0;
+	uint32 ulLine = 0;
+
+	TRACE_SPAN("device", "deviceTransaction");
+
+	if(pucFileName != NULL && pucTransactionName != NULL)
+	{
+		arenaInit(&stArena, ARENA_TABLE_SIZE);
+		pstFile = fileOpen(pucTransactionName, FILE_READ_TEXT_MODE);
+		blReturn = (pstFile != NULL);
+		while(blReturn == SUCCESS &&
+			  fgets(pcLine, sizeof(pcLine), pstFile) != NULL)
+		{
+			ulLine++;
+			if(ulCount == ulCapacity)
+			{
+				ulCapacity = (ulCapacity == 0) ? LIST_MIN_SIZE : ulCapacity * 2;
+				pstGrown = arenaGrow(&stArena, pstOperations,
+									 ulCount * sizeof(TXN_OPERATION),
+									 ulCapacity * sizeof(TXN_OPERATION));
+				blReturn = (pstGrown != NULL);
+				if(blReturn == SUCCESS)
+				{
+					pstOperations = pstGrown;
+				}
+			}
+
+			if(blReturn == SUCCESS && pcLine[strspn(pcLine, TOKEN_DELIMITERS)]
+			   != '\0')
+			{
+				blReturn = deviceParseOperation(pcLine,
+												&pstOperations[ulCount]);
+				ulCount += (blReturn == SUCCESS);
+				if(blReturn != SUCCESS)
+				{
+					printf("\nUnable to commit the transaction : Invalid "
+						   "line %lu\n", ulLine);
+				}
+			}
+		}
+		if(pstFile != NULL)
+		{
+			fileClose(pstFile);
+		}
+
+		if(blReturn == SUCCESS)
+		{
+			blReturn = txnCommit(pucFileName, pstOperations, ulCount,
+								 &stReport);
+		}
+
+		if(blReturn == SUCCESS)
+		{
+			workloadRecord(pucFileName, WORKLOAD_TRANSACTION, pstOperations,
+						   ulCount * sizeof(TXN_OPERATION));
+			printf("\n Committed %lu operation(s), %lu added, %lu removed, "
+				   "%lu updated, %lu shard(s) rewritten\n", ulCount,
+				   stReport.ulAddedCount, stReport.ulRemovedCount,
+				   stReport.ulUpdatedCount, stReport.ulShardCount);
+		}
+		else
+		{
+			printf("\n Nothing was changed\n");
+		}
+
+		arenaRelease(&stArena);
+	}
+	else
+	{
+		printf("\nUnable to commit the transaction : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To parse a line of a batch file
+//Inputs	: char *pcLine, "get <serial>", "name <name>", "type <type>" or
+//			  an operation of a transaction
+//Outputs	: DEVICE_BATCH_ITEM *pstItem, the command of the line
+//Return	: True, when the line holds a valid command
+//Return	: False, otherwise
+//Notes		: The line is modified while parsing
+//******************************************************************************
+static bool deviceParseBatchLine(char *pcLine, DEVICE_BATCH_ITEM *pstItem)
+{
+	bool blReturn = false;
+	char *pcToken = NULL;
+	char *pcRest = NULL;
+	char *pcEnd = NULL;
+	uint32 ulLength = 0;
+
+	pcToken = pcLine + strspn(pcLine, TOKEN_DELIMITERS);
+	ulLength = strcspn(pcToken, TOKEN_DELIMITERS);
+	pcRest = pcToken + ulLength;
+	pcRest += strspn(pcRest, TOKEN_DELIMITERS);
+	pcEnd = pcRest + strlen(pcRest);
+	while(pcEnd > pcRest && strchr(TOKEN_DELIMITERS, pcEnd[-1]) != NULL)
+	{
+		pcEnd--;
+	}
+
+	if(ulLength == strlen("get") &&
+	   strncmp(pcToken, "get", ulLength) == STRINGS_EQUAL)
+	{
+		pstItem->blRead = true;
+		pstItem->stCriteria.ulChoice = SEARCH_BY_SERIAL;
+		pstItem->stCriteria.ulValue = strtoul(pcRest, &pcEnd, NUMBER_BASE);
+		blReturn = (*pcRest != '\0' &&
+					pcEnd[strspn(pcEnd, TOKEN_DELIMITERS)] == '\0');
+	}
+	else if(ulLength == strlen("name") &&
+			(strncmp(pcToken, "name", ulLength) == STRINGS_EQUAL ||
+			 strncmp(pcToken, "type", ulLength) == STRINGS_EQUAL))
+	{
+		*pcEnd = '\0';
+		pstItem->blRead = true;
+		pstItem->stCriteria.ulChoice = (*pcToken == 'n') ? SEARCH_BY_NAME :
+									   SEARCH_BY_TYPE;
+		blReturn = (*pcRest != '\0' && strlen(pcRest) < STR_MAX_SIZE);
+		if(blReturn == SUCCESS)
+		{
+			strcpy((char *)pstItem->stCriteria.pucString, pcRest);
+		}
+	}
+	else
+	{
+		blReturn = deviceParseOperation(pcLine, &pstItem->stOperation);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To load the serial map read by the lookups of a batch file
+//Inputs	: pucFileName, the file with device details
+//Outputs	: None
+//Return	: The map, with a reader for each worker of the pool and one for
+//			  the submitting thread
+//Return	: NULL, when the lookups read the data files instead
+//Notes		:
+//******************************************************************************
+static CHASH *deviceLoadBatchMap(const uint8 *pucFileName)
+{
+	bool blLoaded = false;
+	CHASH *pstMap = NULL;
+	uint32 ulGeneration = 0;
+	uint32 ulReader = 0;
+	uint32 ulReaders = 0;
+
+	pstMap = malloc(sizeof(CHASH));
+	blLoaded = (pstMap != NULL && chashCreate(pstMap, 0) == SUCCESS &&
+				chashLoad(pstMap, pucFileName, &ulGeneration) == SUCCESS &&
+				poolGetWorkerCount() < CHASH_MAX_READERS);
+	for(ulReaders = 0; ulReaders <= poolGetWorkerCount() &&
+		blLoaded == SUCCESS; ulReaders++)
+	{
+		blLoaded = chashAttach(pstMap, &ulReader);
+	}
+
+	if(blLoaded != SUCCESS && pstMap != NULL)
+	{
+		chashDestroy(pstMap);
+		free(pstMap);
+		pstMap = NULL;
+	}
+
+	return pstMap;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To carry the change of a batch command into the serial map
+//Inputs	: DEVICE_BATCH_ITEM *pstItem, the command once run
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The commands of a serial run one at a time, so the device read
+//			  back for an update is not changed meanwhile
+//******************************************************************************
+static bool deviceMapBatchChange(DEVICE_BATCH_ITEM *pstItem)
+{
+	bool blReturn = true;
+	DEVICE_DETAILS DeviceData = {0};
+	DEVICE_UPDATE *pstUpdate = &pstItem->stOperation.stUpdate;
+
+	if(pstItem->pstMap == NULL || pstItem->blChanged != true)
+	{
+		blReturn = true;
+	}
+	else if(pstItem->stOperation.ulOperation == TXN_ADD)
+	{
+		blReturn = chashInsert(pstItem->pstMap, &pstUpdate->stValues);
+	}
+	else if(pstItem->stOperation.ulOperation == TXN_REMOVE)
+	{
+		chashRemove(pstItem->pstMap, pstUpdate->stValues.ulDeviceSerial);
+	}
+	else if(chashFind(pstItem->pstMap, poolGetWorkerIndex(),
+					  pstUpdate->stValues.ulDeviceSerial, &DeviceData) ==
+			SUCCESS)
+	{
+		deviceApplyUpdate(pstUpdate, &DeviceData);
+		deviceSealRecord(&DeviceData);
+		blReturn = chashInsert(pstItem->pstMap, &DeviceData);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To run a command of a batch file
+//Inputs	: void *pvItem, the DEVICE_BATCH_ITEM of the command
+//Outputs	: The outcome in the item
+//Return	: NULL
+//Notes		: Runs as a pool task. The command is recorded with the type of
+//			  the matching menu operation, marked WORKLOAD_FROM_BATCH. A get
+//			  by serial reads the map of the item when there is one.
+//******************************************************************************
+static void *deviceRunBatchItem(void *pvItem)
+{
+	DEVICE_BATCH_ITEM *pstItem = pvItem;
+	DEVICE_UPDATE *pstUpdate = &pstItem->stOperation.stUpdate;
+	DEVICE_DETAILS DeviceData = {0};
+
+	TRACE_SPAN("device", "deviceRunBatchItem");
+
+	if(pstItem->blRead == true)
+	{
+		workloadRecord(pstItem->pucFileName,
+					   WORKLOAD_SEARCH | WORKLOAD_FROM_BATCH,
+					   &pstItem->stCriteria, sizeof(DEVICE_CRITERIA));
+		if(pstItem->pstMap != NULL &&
+		   pstItem->stCriteria.ulChoice == SEARCH_BY_SERIAL)
+		{
+			pstItem->blStatus = true;
+			if(chashFind(pstItem->pstMap, poolGetWorkerIndex(),
+						 pstItem->stCriteria.ulValue, &DeviceData) == SUCCESS)
+			{
+				pstItem->blStatus = shardResultAppend(&pstItem->stResult,
+													  &DeviceData);
+			}
+		}
+		else
+		{
+			pstItem->blStatus = deviceCollectCriteria(pstItem->pucFileName,
+													  &pstItem->stCriteria,
+													  &pstItem->stResult);
+		}
+	}
+	else if(pstItem->stOperation.ulOperation == TXN_ADD)
+	{
+		workloadRecord(pstItem->pucFileName,
+					   WORKLOAD_ADD | WORKLOAD_FROM_BATCH,
+					   &pstUpdate->stValues, sizeof(DEVICE_DETAILS));
+		pstItem->blChanged = deviceAddRecord(pstItem->pucFileName,
+									&pstItem->stOperation.stUpdate.stValues);
+		pstItem->blStatus = true;
+	}
+	else if(pstItem->stOperation.ulOperation == TXN_REMOVE)
+	{
+		workloadRecord(pstItem->pucFileName,
+					   WORKLOAD_REMOVE_SERIAL | WORKLOAD_FROM_BATCH,
+					   &pstUpdate->stValues.ulDeviceSerial, sizeof(uint32));
+		pstItem->blStatus = deviceRemoveSerial(pstItem->pucFileName,
+						pstItem->stOperation.stUpdate.stValues.ulDeviceSerial,
+						&pstItem->blChanged);
+	}
+	else
+	{
+		workloadRecord(pstItem->pucFileName,
+					   WORKLOAD_UPDATE | WORKLOAD_FROM_BATCH,
+					   pstUpdate, sizeof(DEVICE_UPDATE));
+		pstItem->blStatus = deviceUpdateRecords(pstItem->pucFileName,
+												&pstItem->stOperation.stUpdate,
+												VALUE_ONE,
+												&pstItem->blChanged);
+	}
+
+	if(pstItem->blRead != true && pstItem->blStatus == SUCCESS)
+	{
+		pstItem->blStatus = deviceMapBatchChange(pstItem);
+	}
+
+	return NULL;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the outcome of a command of a batch file
+//Inputs	: DEVICE_BATCH_ITEM *pstItem, the command run
+//Outputs	: None
+//Return	: None
+//Notes		: The devices read are printed in full
+//******************************************************************************
+static void devicePrintBatchItem(DEVICE_BATCH_ITEM *pstItem)
+{
+	const char *pcOutcome = "updated";
+
+	printf("\n Line %lu : ", pstItem->ulLine);
+	if(pstItem->blStatus != SUCCESS)
+	{
+		printf("Failed\n");
+	}
+	else if(pstItem->blRead == true)
+	{
+		printf("%lu device(s)\n", pstItem->stResult.ulCount);
+		devicePrintResult(&pstItem->stResult);
+	}
+	else
+	{
+		if(pstItem->stOperation.ulOperation == TXN_ADD)
+		{
+			pcOutcome = (pstItem->blChanged == true) ? "added" :
+						"already used";
+		}
+		else if(pstItem->blChanged != true)
+		{
+			pcOutcome = "not found";
+		}
+		else if(pstItem->stOperation.ulOperation == TXN_REMOVE)
+		{
+			pcOutcome = "removed";
+		}
+		printf("Serial %lu %s\n",
+			   pstItem->stOperation.stUpdate.stValues.ulDeviceSerial,
+			   pcOutcome);
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To run the commands of a batch file on the shared pool
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Inputs	: const uint8 *pucBatchName, text file with one command per line,
+//			  "get <serial>", "name <name>", "type <type>", "add <serial>
+//			  <field>=<value> ...", "remove <serial>" or "update <serial>
+//			  <field>=<value> ..."
+//Outputs	: None
+//Return	: True, when every command has run
+//Return	: False, in case of an error
+//Notes		: Searches by name or type run in parallel with everything else.
+//			  The commands naming a serial run in the order of the file for
+//			  that serial, those of different serials in parallel. Each
+//			  command stands alone, the outcomes are printed in the order of
+//			  the file once all have run. Each command is recorded as it
+//			  starts. Gets by serial read a map loaded at the start of the
+//			  batch and kept current by the commands of the batch.
+//******************************************************************************
+bool deviceBatch(const uint8 *pucFileName, const uint8 *pucBatchName)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	char pcLine[LINE_MAX_SIZE] = "";
+	ARENA stArena;
+	DEVICE_BATCH_ITEM *pstItems = NULL;
+	DEVICE_BATCH_ITEM *pstGrown = NULL;
+	CHASH *pstMap = NULL;
+	POOL_GROUP stGroup = {0};
+	uint32 ulCapacity = 0;
+	uint32 ulCount = 0;
+	uint32 ulLine = 0;
+	uint32 ulItem = 0;
+	uint32 ulKey = 0;
+	uint32 ulFailed = 0;
+
+	TRACE_SPAN("device", "deviceBatch");
+
+	if(pucFileName != NULL && pucBatchName != NULL)
+	{
+		arenaInit(&stArena, ARENA_TABLE_SIZE);
+		pstFile = fileOpen(pucBatchName, FILE_READ_TEXT_MODE);
+		blReturn = (pstFile != NULL);
+		while(blReturn == SUCCESS &&
+			  fgets(pcLine, sizeof(pcLine), pstFile) != NULL)
+		{
+			ulLine++;
+			if(ulCount == ulCapacity)
+			{
+				ulCapacity = (ulCapacity == 0) ? LIST_MIN_SIZE : ulCapacity * 2;
+				pstGrown = arenaGrow(&stArena, pstItems,
+									 ulCount * sizeof(DEVICE_BATCH_ITEM),
+									 ulCapacity * sizeof(DEVICE_BATCH_ITEM));
+				blReturn = (pstGrown != NULL);
+				if(blReturn == SUCCESS)
+				{
+					pstItems = pstGrown;
+				}
+			}
+
+			if(blReturn == SUCCESS && pcLine[strspn(pcLine, TOKEN_DELIMITERS)]
+			   != '\0')
+			{
+				memset(&pstItems[ulCount], 0, sizeof(DEVICE_BATCH_ITEM));
+				pstItems[ulCount].pucFileName = pucFileName;
+				pstItems[ulCount].ulLine = ulLine;
+				blReturn = deviceParseBatchLine(pcLine, &pstItems[ulCount]);
+				ulCount += (blReturn == SUCCESS);
+				if(blReturn != SUCCESS)
+				{
+					printf("\nUnable to run the batch : Invalid line %lu\n",
+						   ulLine);
+				}
+			}
+		}
+		if(pstFile != NULL)
+		{
+			fileClose(pstFile);
+		}
+
+		for(ulItem = 0; ulItem < ulCount && pstMap == NULL &&
+			blReturn == SUCCESS; ulItem++)
+		{
+			if(pstItems[ulItem].blRead == true &&
+			   pstItems[ulItem].stCriteria.ulChoice == SEARCH_BY_SERIAL)
+			{
+				pstMap = deviceLoadBatchMap(pucFileName);
+			}
+		}
+
+		// The items are only submitted once the array has stopped growing
+		for(ulItem = 0; ulItem < ulCount && blReturn == SUCCESS; ulItem++)
+		{
+			pstItems[ulItem].pstMap = pstMap;
+			ulKey = (pstItems[ulItem].blRead == true) ?
+					pstItems[ulItem].stCriteria.ulValue :
+					pstItems[ulItem].stOperation.stUpdate.stValues.
+					ulDeviceSerial;
+			if(pstItems[ulItem].blRead == true &&
+			   pstItems[ulItem].stCriteria.ulChoice != SEARCH_BY_SERIAL)
+			{
+				poolSubmit(&stGroup, deviceRunBatchItem, &pstItems[ulItem]);
+			}
+			else if(poolSubmitOrdered(&stGroup, ulKey, deviceRunBatchItem,
+									  &pstItems[ulItem]) != SUCCESS)
+			{
+				pstItems[ulItem].blStatus = false;
+			}
+		}
+		poolWait(&stGroup);
+
+		for(ulItem = 0; ulItem < ulCount && blReturn == SUCCESS; ulItem++)
+		{
+			devicePrintBatchItem(&pstItems[ulItem]);
+			ulFailed += (pstItems[ulItem].blStatus != SUCCESS);
+			shardResultFree(&pstItems[ulItem].stResult);
+		}
+
+		if(pstMap != NULL)
+		{
+			chashDestroy(pstMap);
+			free(pstMap);
+		}
+
+		if(blReturn == SUCCESS)
+		{
+			printf("\n Ran %lu command(s) on %lu worker(s), %lu failed\n",
+				   ulCount, poolGetWorkerCount(), ulFailed);
+			blReturn = (ulFailed == 0);
+		}
+		else
+		{
+			printf("\n Nothing was run\n");
+		}
+
+		arenaRelease(&stArena);
+	}
+	else
+	{
+		printf("\nUnable to run the batch : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To update the details of a device selected by its serial
+//Inputs	: const uint8 *pucFileName, the file with device details
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Fields left empty keep their value
+//******************************************************************************
+bool deviceUpdate(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	bool blUpdated = false;
+	DEVICE_UPDATE stUpdate;
+
+	if(pucFileName != NULL)
+	{
+		memset(&stUpdate, 0, sizeof(stUpdate));
+		printf("\nUpdate device\n");
+		printf("-----------------------------\n");
+		blReturn = deviceReadValue("Enter the device Serial : ",
+								   &stUpdate.stValues.ulDeviceSerial,
+								   READ_NON_HEX);
+		deviceFlushInput();
+
+		if(blReturn == SUCCESS)
+		{
+			printf("Leave a field empty to keep its value\n");
+			blReturn = deviceReadString("Enter the new device name : ",
+										stUpdate.stValues.pucDeviceName,
+										STR_MAX_SIZE);
+			if(stUpdate.stValues.pucDeviceName[0] != '\0')
+			{
+				stUpdate.ulFieldMask |= DEVICE_FIELD_NAME;
+			}
+		}
+
+		if(blReturn == SUCCESS)
+		{
+			blReturn = deviceReadString("Enter the new device type : ",
+										stUpdate.stValues.pucDeviceType,
+										STR_MAX_SIZE);
+			if(stUpdate.stValues.pucDeviceType[0] != '\0')
+			{
+				stUpdate.ulFieldMask |= DEVICE_FIELD_TYPE;
+			}
+		}
+
+		if(blReturn == SUCCESS)
+		{
+			blReturn = deviceReadOptionalHex("Enter the new device Id : ",
+											 DEVICE_FIELD_ID,
+											 &stUpdate.stValues.ulDeviceId,
+											 &stUpdate.ulFieldMask);
+		}
+
+		if(blReturn == SUCCESS)
+		{
+			blReturn = deviceReadOptionalHex("Enter the new device vendor : ",
+											 DEVICE_FIELD_VENDOR,
+											 &stUpdate.stValues.ulDeviceVendor,
+											 &stUpdate.ulFieldMask);
+		}
+
+		if(blReturn == SUCCESS && stUpdate.ulFieldMask == 0)
+		{
+			printf("\n Nothing to update\n");
+		}
+		else if(blReturn == SUCCESS)
+		{
+			workloadRecord(pucFileName, WORKLOAD_UPDATE, &stUpdate,
+						   sizeof(stUpdate));
+			blReturn = deviceUpdateRecords(pucFileName, &stUpdate, 1,
+										   &blUpdated);
+			if(blReturn == SUCCESS && blUpdated == true)
+			{
+				printf("\n Device details updated successfully\n");
+			}
+			else if(blReturn == SUCCESS)
+			{
+				printf("\n No device found with the serial\n");
+			}
+		}
+	}
+	else
+	{
+		printf("\nUnable to update the device : Missing file name");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To apply the changed fields of an update to a device
+//Inputs	: const DEVICE_UPDATE *pstUpdate, the update
+//Outputs	: DEVICE_DETAILS *pstDeviceData, the updated device
+//Return	: None
+//Notes		: 
+//******************************************************************************
+void deviceApplyUpdate(const DEVICE_UPDATE *pstUpdate,
+					   DEVICE_DETAILS *pstDeviceData)
+{
+	if((pstUpdate->ulFieldMask & DEVICE_FIELD_NAME) != 0)
+	{
+		memcpy(pstDeviceData->pucDeviceName,
+			   pstUpdate->stValues.pucDeviceName, STR_MAX_SIZE);
+	}
+	if((pstUpdate->ulFieldMask & DEVICE_FIELD_TYPE) != 0)
+	{
+		memcpy(pstDeviceData->pucDeviceType,
+			   pstUpdate->stValues.pucDeviceType, STR_MAX_SIZE);
+	}
+	if((pstUpdate->ulFieldMask & DEVICE_FIELD_ID) != 0)
+	{
+		pstDeviceData->ulDeviceId = pstUpdate->stValues.ulDeviceId;
+	}
+	if((pstUpdate->ulFieldMask & DEVICE_FIELD_VENDOR) != 0)
+	{
+		pstDeviceData->ulDeviceVendor = pstUpdate->stValues.ulDeviceVendor;
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To set the checksum of a device record
+//Inputs	: DEVICE_DETAILS *pstDeviceData, the record to be written
+//Outputs	: DEVICE_DETAILS *pstDeviceData, the record with its checksum
+//Return	: None
+//Notes		: CRC32C of all the fields before the checksum. Every record
+//			  written with new content has to be sealed.
+//******************************************************************************
+void deviceSealRecord(DEVICE_DETAILS *pstDeviceData)
+{
+	pstDeviceData->ulChecksum = crc32c(CRC_INITIAL, pstDeviceData,
+									   offsetof(DEVICE_DETAILS, ulChecksum));
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To check the checksum of a device record
+//Inputs	: const DEVICE_DETAILS *pstDeviceData, the record read
+//Outputs	: None
+//Return	: True, if the record is intact
+//Return	: False, if the record is corrupted
+//Notes		: 
+//******************************************************************************
+bool deviceCheckRecord(const DEVICE_DETAILS *pstDeviceData)
+{
+	return (pstDeviceData->ulChecksum ==
+			crc32c(CRC_INITIAL, pstDeviceData,
+				   offsetof(DEVICE_DETAILS, ulChecksum)));
+}
 // EOF
\ No newline at end of file
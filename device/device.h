@@ -25,19 +25,78 @@ typedef struct _DEVICE_DETAILS_
 	uint32 ulDeviceId;
 	uint32 ulDeviceVendor;
 	uint32 ulDeviceSerial;
+	uint32 ulChecksum;
 } DEVICE_DETAILS;
 
+typedef struct _DEVICE_CRITERIA_
+{
+	uint32 ulChoice;
+	uint8 pucString[STR_MAX_SIZE];
+	uint32 ulValue;
+} DEVICE_CRITERIA;
+
+typedef struct _DEVICE_UPDATE_
+{
+	uint32 ulFieldMask;
+	DEVICE_DETAILS stValues;
+} DEVICE_UPDATE;
+
+// Defined in shard.h, which needs the types above
+typedef struct _SHARD_RESULT_ SHARD_RESULT;
+
 //***************************** Global Constants *******************************
 #define FILE_NAME		("devices.dat")
 #define SUCCESS			(1)
 
+// Fields changed by a DEVICE_UPDATE, the serial is the key of the update
+#define DEVICE_FIELD_NAME	(0x01)
+#define DEVICE_FIELD_TYPE	(0x02)
+#define DEVICE_FIELD_ID		(0x04)
+#define DEVICE_FIELD_VENDOR	(0x08)
+
 //***************************** Global Variables *******************************
 
 //**************************** Forward Declarations ****************************
 bool deviceAdd(const uint8 *pucFileName);
+bool deviceAddRecord(const uint8 *pucFileName, DEVICE_DETAILS *pstDeviceData);
 bool deviceList(const uint8 *pucFileName);
 bool deviceSearch(const uint8 *pucFileName, uint32 ucChoice);
+bool deviceSearchCriteria(const uint8 *pucFileName,
+						  const DEVICE_CRITERIA *pstCriteria);
+bool deviceCollectCriteria(const uint8 *pucFileName,
+						   const DEVICE_CRITERIA *pstCriteria,
+						   SHARD_RESULT *pstResult);
+bool deviceSearchClosest(const uint8 *pucFileName, const uint8 *pucName,
+						 uint32 ulCount);
+bool deviceHistoryAsOf(const uint8 *pucFileName, uint32 ulTime);
+bool deviceHistoryChanges(const uint8 *pucFileName, uint32 ulFrom, uint32 ulTo);
+bool deviceDiff(const uint8 *pucFileName, const uint8 *pucOtherPath,
+				bool blApply);
 bool deviceRemove(const uint8 *pucFileName, uint32 ucId);
+bool deviceRemoveCriteria(const uint8 *pucFileName,
+						  const DEVICE_CRITERIA *pstCriteria,
+						  uint32 *pulRemoved);
+bool deviceRemoveSerial(const uint8 *pucFileName, uint32 ulSerial,
+						bool *pblRemoved);
+bool deviceRemoveSerialList(const uint8 *pucFileName,
+							const uint8 *pucListName);
+bool deviceRemoveSerials(const uint8 *pucFileName, const uint32 *pulSerials,
+						 uint32 ulCount);
+bool deviceBulkRemove(const uint8 *pucFileName);
+bool deviceUpdateRecords(const uint8 *pucFileName,
+						 const DEVICE_UPDATE *pstUpdates, uint32 ulCount,
+						 bool *pblUpdated);
+bool deviceUpdateBatch(const uint8 *pucFileName, const uint8 *pucBatchName);
+bool deviceTransaction(const uint8 *pucFileName,
+					   const uint8 *pucTransactionName);
+bool deviceBatch(const uint8 *pucFileName, const uint8 *pucBatchName);
+bool deviceUpdate(const uint8 *pucFileName);
+bool deviceMatchCriteria(const DEVICE_DETAILS *pstDeviceData,
+						 const void *pvContext);
+void deviceApplyUpdate(const DEVICE_UPDATE *pstUpdate,
+					   DEVICE_DETAILS *pstDeviceData);
+void deviceSealRecord(DEVICE_DETAILS *pstDeviceData);
+bool deviceCheckRecord(const DEVICE_DETAILS *pstDeviceData);
 
 
 #endif // DEVICE_H
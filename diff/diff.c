@@ -0,0 +1,690 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: diff.c
+// Summary	: Comparison of the device data with another device file
+// Note		: The devices of a snapshot of the data and the records of the
+//			  other file are written to "<data file>.diff.a<n>" and
+//			  "<data file>.diff.b<n>", partition n of a serial. There are
+//			  enough partitions for the smaller side of each to fit in the
+//			  share of the memory budget of a thread. Each thread joins its
+//			  partitions in turn, loading the smaller side in a hash table
+//			  and streaming the other one, and writes what differs to its
+//			  own "<data file>.diff.d<n>". The differences are then passed
+//			  on thread after thread and all the files are removed.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "hash.h"
+#include "pool.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "diff.h"
+
+//******************************* Local Types **********************************
+typedef struct _DIFF_TASK_
+{
+	const uint8 *pucFileName;
+	uint32 ulTask;
+	uint32 ulTaskCount;
+	uint32 ulPartitionCount;
+	uint32 ulAddedCount;
+	uint32 ulRemovedCount;
+	uint32 ulChangedCount;
+	bool blStatus;
+} DIFF_TASK;
+
+//***************************** Local Constants ********************************
+#define WRITE_COUNT				(1)
+#define DIFF_SIDE_OURS			('a')
+#define DIFF_SIDE_OTHER			('b')
+#define DIFF_SIDE_DELTA			('d')
+#define DIFF_SUFFIX_SIZE		(32)
+#define DIFF_MAX_PARTITIONS		(512)
+#define DIFF_BATCH_RECORDS		(1024)
+// Bytes of memory per record of a loaded partition, with its hash entry
+#define DIFF_RECORD_COST		(192)
+#define DIFF_MEMORY_BUDGET		(268435456UL)
+#define DIFF_NANOSECONDS		(1e9)
+#define DIFF_MILLISECONDS		(1e3)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To build the name of a work file of a comparison
+//Inputs	: pucFileName, name of the data file
+//Inputs	: cSide, DIFF_SIDE_OURS, DIFF_SIDE_OTHER or DIFF_SIDE_DELTA
+//Inputs	: ulIndex, the partition or the thread
+//Outputs	: pucPath, "<data file>.diff.<side><index>"
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool diffGetPath(const uint8 *pucFileName, uint8 cSide, uint32 ulIndex,
+						uint8 *pucPath)
+{
+	uint8 pucSuffix[DIFF_SUFFIX_SIZE] = "";
+
+	return (snprintf((char *)pucSuffix, sizeof(pucSuffix), "%s.%c%lu",
+					 DIFF_SUFFIX, cSide, ulIndex) > 0 &&
+			fileBuildPath(pucPath, pucFileName, pucSuffix) == true);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open or to close the partition files of a side
+//Inputs	: pucFileName, name of the data file
+//Inputs	: cSide, the side
+//Inputs	: ulPartitionCount, number of partitions
+//Inputs	: blOpen, true to create the files, false to close them
+//Outputs	: ppstFiles, the files
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool diffSetPartitions(const uint8 *pucFileName, uint8 cSide,
+							  uint32 ulPartitionCount, bool blOpen,
+							  FILE **ppstFiles)
+{
+	bool blReturn = true;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulPartition = 0;
+
+	for(ulPartition = 0; ulPartition < ulPartitionCount; ulPartition++)
+	{
+		if(blOpen == true)
+		{
+			ppstFiles[ulPartition] = NULL;
+			if(blReturn == true &&
+			   diffGetPath(pucFileName, cSide, ulPartition, pucPath) == true)
+			{
+				ppstFiles[ulPartition] = fopen((char *)pucPath,
+											   FILE_WRITE_MODE);
+			}
+			blReturn = (ppstFiles[ulPartition] != NULL);
+		}
+		else if(ppstFiles[ulPartition] != NULL)
+		{
+			blReturn = (fclose(ppstFiles[ulPartition]) == 0 &&
+						blReturn == true);
+			ppstFiles[ulPartition] = NULL;
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write a record to the partition of its serial
+//Inputs	: ppstFiles and ulPartitionCount, the partition files
+//Inputs	: pstDeviceData, the record
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool diffRoute(FILE **ppstFiles, uint32 ulPartitionCount,
+					  const DEVICE_DETAILS *pstDeviceData)
+{
+	return (fwrite(pstDeviceData, sizeof(DEVICE_DETAILS), WRITE_COUNT,
+				   ppstFiles[hashMix(pstDeviceData->ulDeviceSerial) %
+							 ulPartitionCount]) == WRITE_COUNT);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To split the records of the other file into partitions
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pucOtherPath, name of the other file
+//Inputs	: ulPartitionCount, number of partitions
+//Outputs	: pulSkipped, number of corrupt records left out
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool diffSplitOther(const uint8 *pucFileName, const uint8 *pucOtherPath,
+						   uint32 ulPartitionCount, uint32 *pulSkipped)
+{
+	bool blReturn = false;
+	FILE *ppstFiles[DIFF_MAX_PARTITIONS];
+	FILE *pstOther = NULL;
+	DEVICE_DETAILS *pstRecords = NULL;
+	uint32 ulRead = 0;
+	uint32 ulIndex = 0;
+
+	pstOther = fopen((char *)pucOtherPath, FILE_READ_MODE);
+	pstRecords = malloc(DIFF_BATCH_RECORDS * sizeof(DEVICE_DETAILS));
+	if(pstOther != NULL && pstRecords != NULL)
+	{
+		blReturn = diffSetPartitions(pucFileName, DIFF_SIDE_OTHER,
+									 ulPartitionCount, true, ppstFiles);
+		ulRead = DIFF_BATCH_RECORDS;
+		while(blReturn == true && ulRead == DIFF_BATCH_RECORDS)
+		{
+			ulRead = fread(pstRecords, sizeof(DEVICE_DETAILS),
+						   DIFF_BATCH_RECORDS, pstOther);
+			for(ulIndex = 0; ulIndex < ulRead && blReturn == true; ulIndex++)
+			{
+				if(deviceCheckRecord(&pstRecords[ulIndex]) == true)
+				{
+					blReturn = diffRoute(ppstFiles, ulPartitionCount,
+										 &pstRecords[ulIndex]);
+				}
+				else
+				{
+					(*pulSkipped)++;
+				}
+			}
+		}
+		blReturn = (ferror(pstOther) == 0 &&
+					diffSetPartitions(pucFileName, DIFF_SIDE_OTHER,
+									  ulPartitionCount, false,
+									  ppstFiles) == true &&
+					blReturn == true);
+	}
+
+	if(pstOther != NULL)
+	{
+		fclose(pstOther);
+	}
+	free(pstRecords);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read a whole partition file
+//Inputs	: pucPath, name of the partition file
+//Outputs	: ppstRecords, the records, to be released with free()
+//Outputs	: pulCount, number of records
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool diffLoad(const uint8 *pucPath, DEVICE_DETAILS **ppstRecords,
+					 uint32 *pulCount)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	FILE_IDENTITY stIdentity = {0};
+
+	fileGetIdentity(pucPath, &stIdentity);
+	*pulCount = stIdentity.ulSize / sizeof(DEVICE_DETAILS);
+	*ppstRecords = malloc(*pulCount * sizeof(DEVICE_DETAILS) + 1);
+	pstFile = fopen((char *)pucPath, FILE_READ_MODE);
+	if(pstFile != NULL && *ppstRecords != NULL)
+	{
+		blReturn = (fread(*ppstRecords, sizeof(DEVICE_DETAILS), *pulCount,
+						  pstFile) == *pulCount);
+	}
+
+	if(pstFile != NULL)
+	{
+		fclose(pstFile);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To check whether two records of a serial hold the same details
+//Inputs	: pstFirst and pstSecond, the records
+//Outputs	: None
+//Return	: True, when the name, type, id and vendor are the same
+//Return	: False, otherwise
+//Notes		: Bytes after the end of the strings are not compared
+//******************************************************************************
+static bool diffSameDevice(const DEVICE_DETAILS *pstFirst,
+						   const DEVICE_DETAILS *pstSecond)
+{
+	return (strncmp((char *)pstFirst->pucDeviceName,
+					(char *)pstSecond->pucDeviceName, STR_MAX_SIZE) == 0 &&
+			strncmp((char *)pstFirst->pucDeviceType,
+					(char *)pstSecond->pucDeviceType, STR_MAX_SIZE) == 0 &&
+			pstFirst->ulDeviceId == pstSecond->ulDeviceId &&
+			pstFirst->ulDeviceVendor == pstSecond->ulDeviceVendor);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write a difference
+//Inputs	: pstDelta, the differences of the thread
+//Inputs	: ulOperation, the operation turning the data into the other file
+//Inputs	: pstOurs and pstOther, the two versions, NULL when missing
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool diffEmit(FILE *pstDelta, uint32 ulOperation,
+					 const DEVICE_DETAILS *pstOurs,
+					 const DEVICE_DETAILS *pstOther)
+{
+	DIFF_ENTRY stEntry;
+
+	memset(&stEntry, 0, sizeof(DIFF_ENTRY));
+	stEntry.ulOperation = ulOperation;
+	if(pstOurs != NULL)
+	{
+		stEntry.stOurs = *pstOurs;
+	}
+	if(pstOther != NULL)
+	{
+		stEntry.stOther = *pstOther;
+	}
+
+	return (fwrite(&stEntry, sizeof(DIFF_ENTRY), WRITE_COUNT, pstDelta) ==
+			WRITE_COUNT);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To join the two sides of a partition
+//Inputs	: pstTask, the task of the thread
+//Inputs	: ulPartition, the partition
+//Inputs	: pstDelta, the differences of the thread
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The smaller side is loaded, the other one streamed
+//******************************************************************************
+static bool diffJoinPartition(DIFF_TASK *pstTask, uint32 ulPartition,
+							  FILE *pstDelta)
+{
+	bool blReturn = false;
+	bool blOursLoaded = false;
+	FILE *pstStream = NULL;
+	DEVICE_DETAILS *pstLoaded = NULL;
+	DEVICE_DETAILS *pstRecords = NULL;
+	bool *pblMatched = NULL;
+	HASH_TABLE stTable = {0};
+	FILE_IDENTITY stOurs = {0};
+	FILE_IDENTITY stOther = {0};
+	uint8 pucOursPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucOtherPath[FILE_PATH_MAX_SIZE] = "";
+	const DEVICE_DETAILS *pstOurRecord = NULL;
+	const DEVICE_DETAILS *pstOtherRecord = NULL;
+	uint32 *pulPosition = NULL;
+	uint32 ulCount = 0;
+	uint32 ulRead = 0;
+	uint32 ulIndex = 0;
+
+	if(diffGetPath(pstTask->pucFileName, DIFF_SIDE_OURS, ulPartition,
+				   pucOursPath) != true ||
+	   diffGetPath(pstTask->pucFileName, DIFF_SIDE_OTHER, ulPartition,
+				   pucOtherPath) != true)
+	{
+		return false;
+	}
+
+	fileGetIdentity(pucOursPath, &stOurs);
+	fileGetIdentity(pucOtherPath, &stOther);
+	blOursLoaded = (stOurs.ulSize <= stOther.ulSize);
+	pstRecords = malloc(DIFF_BATCH_RECORDS * sizeof(DEVICE_DETAILS));
+	blReturn = (pstRecords != NULL &&
+				diffLoad(blOursLoaded == true ? pucOursPath : pucOtherPath,
+						 &pstLoaded, &ulCount) == true &&
+				hashCreate(&stTable, ulCount) == true);
+	if(blReturn == true)
+	{
+		pblMatched = calloc(ulCount + 1, sizeof(bool));
+		pstStream = fopen((char *)(blOursLoaded == true ? pucOtherPath :
+								   pucOursPath), FILE_READ_MODE);
+		blReturn = (pblMatched != NULL && pstStream != NULL);
+	}
+	for(ulIndex = 0; ulIndex < ulCount && blReturn == true; ulIndex++)
+	{
+		blReturn = hashInsert(&stTable, pstLoaded[ulIndex].ulDeviceSerial,
+							  ulIndex);
+	}
+
+	ulRead = DIFF_BATCH_RECORDS;
+	while(blReturn == true && ulRead == DIFF_BATCH_RECORDS)
+	{
+		ulRead = fread(pstRecords, sizeof(DEVICE_DETAILS), DIFF_BATCH_RECORDS,
+					   pstStream);
+		for(ulIndex = 0; ulIndex < ulRead && blReturn == true; ulIndex++)
+		{
+			pulPosition = hashLookup(&stTable,
+									 pstRecords[ulIndex].ulDeviceSerial);
+			pstOurRecord = blOursLoaded == true ? NULL : &pstRecords[ulIndex];
+			pstOtherRecord = blOursLoaded == true ? &pstRecords[ulIndex] :
+							 NULL;
+			if(pulPosition == NULL)
+			{
+				blReturn = diffEmit(pstDelta, blOursLoaded == true ?
+									DIFF_ADDED : DIFF_REMOVED, pstOurRecord,
+									pstOtherRecord);
+				pstTask->ulAddedCount += (blOursLoaded == true);
+				pstTask->ulRemovedCount += (blOursLoaded != true);
+				continue;
+			}
+
+			pblMatched[*pulPosition] = true;
+			if(diffSameDevice(&pstLoaded[*pulPosition],
+							  &pstRecords[ulIndex]) != true)
+			{
+				pstOurRecord = blOursLoaded == true ?
+							   &pstLoaded[*pulPosition] : &pstRecords[ulIndex];
+				pstOtherRecord = blOursLoaded == true ?
+								 &pstRecords[ulIndex] :
+								 &pstLoaded[*pulPosition];
+				blReturn = diffEmit(pstDelta, DIFF_CHANGED, pstOurRecord,
+									pstOtherRecord);
+				pstTask->ulChangedCount++;
+			}
+		}
+	}
+
+	// What was loaded and never met is only on the loaded side
+	for(ulIndex = 0; ulIndex < ulCount && blReturn == true; ulIndex++)
+	{
+		if(pblMatched[ulIndex] != true)
+		{
+			blReturn = diffEmit(pstDelta, blOursLoaded == true ?
+								DIFF_REMOVED : DIFF_ADDED,
+								blOursLoaded == true ? &pstLoaded[ulIndex] :
+								NULL,
+								blOursLoaded == true ? NULL :
+								&pstLoaded[ulIndex]);
+			pstTask->ulRemovedCount += (blOursLoaded == true);
+			pstTask->ulAddedCount += (blOursLoaded != true);
+		}
+	}
+
+	if(pstStream != NULL)
+	{
+		blReturn = (ferror(pstStream) == 0 && blReturn == true);
+		fclose(pstStream);
+	}
+	hashDestroy(&stTable);
+	free(pblMatched);
+	free(pstLoaded);
+	free(pstRecords);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To join the partitions of a thread
+//Inputs	: pvTask, the DIFF_TASK of the thread
+//Outputs	: None
+//Return	: NULL
+//Notes		: The thread takes every ulTaskCount-th partition
+//******************************************************************************
+static void *diffJoin(void *pvTask)
+{
+	DIFF_TASK *pstTask = pvTask;
+	FILE *pstDelta = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulPartition = 0;
+
+	if(diffGetPath(pstTask->pucFileName, DIFF_SIDE_DELTA, pstTask->ulTask,
+				   pucPath) == true)
+	{
+		pstDelta = fopen((char *)pucPath, FILE_WRITE_MODE);
+	}
+
+	pstTask->blStatus = (pstDelta != NULL);
+	for(ulPartition = pstTask->ulTask; ulPartition <
+		pstTask->ulPartitionCount && pstTask->blStatus == true;
+		ulPartition += pstTask->ulTaskCount)
+	{
+		pstTask->blStatus = diffJoinPartition(pstTask, ulPartition,
+											  pstDelta);
+	}
+
+	if(pstDelta != NULL)
+	{
+		pstTask->blStatus = (fclose(pstDelta) == 0 &&
+							 pstTask->blStatus == true);
+	}
+
+	return NULL;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To pass on the differences found by the threads
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulTaskCount, number of threads
+//Inputs	: pfnVisit and pvContext, called with every difference
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool diffVisit(const uint8 *pucFileName, uint32 ulTaskCount,
+					  DIFF_VISIT pfnVisit, void *pvContext)
+{
+	bool blReturn = true;
+	bool blContinue = true;
+	FILE *pstDelta = NULL;
+	DIFF_ENTRY *pstEntries = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulTask = 0;
+	uint32 ulRead = 0;
+	uint32 ulIndex = 0;
+
+	pstEntries = malloc(DIFF_BATCH_RECORDS * sizeof(DIFF_ENTRY));
+	blReturn = (pstEntries != NULL);
+	for(ulTask = 0; ulTask < ulTaskCount && blReturn == true &&
+		blContinue == true; ulTask++)
+	{
+		pstDelta = NULL;
+		if(diffGetPath(pucFileName, DIFF_SIDE_DELTA, ulTask, pucPath) == true)
+		{
+			pstDelta = fopen((char *)pucPath, FILE_READ_MODE);
+		}
+		blReturn = (pstDelta != NULL);
+
+		ulRead = DIFF_BATCH_RECORDS;
+		while(blReturn == true && blContinue == true &&
+			  ulRead == DIFF_BATCH_RECORDS)
+		{
+			ulRead = fread(pstEntries, sizeof(DIFF_ENTRY), DIFF_BATCH_RECORDS,
+						   pstDelta);
+			for(ulIndex = 0; ulIndex < ulRead && blContinue == true;
+				ulIndex++)
+			{
+				blContinue = pfnVisit(&pstEntries[ulIndex], pvContext);
+			}
+		}
+
+		if(pstDelta != NULL)
+		{
+			blReturn = (ferror(pstDelta) == 0 && blReturn == true);
+			fclose(pstDelta);
+		}
+	}
+	free(pstEntries);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the work files of a comparison
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulPartitionCount and ulTaskCount, numbers of work files
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void diffCleanUp(const uint8 *pucFileName, uint32 ulPartitionCount,
+						uint32 ulTaskCount)
+{
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulIndex = 0;
+
+	for(ulIndex = 0; ulIndex < ulPartitionCount; ulIndex++)
+	{
+		if(diffGetPath(pucFileName, DIFF_SIDE_OURS, ulIndex, pucPath) == true)
+		{
+			remove((char *)pucPath);
+		}
+		if(diffGetPath(pucFileName, DIFF_SIDE_OTHER, ulIndex,
+					   pucPath) == true)
+		{
+			remove((char *)pucPath);
+		}
+	}
+	for(ulIndex = 0; ulIndex < ulTaskCount; ulIndex++)
+	{
+		if(diffGetPath(pucFileName, DIFF_SIDE_DELTA, ulIndex,
+					   pucPath) == true)
+		{
+			remove((char *)pucPath);
+		}
+	}
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compare the device data with another device file
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pucOtherPath, name of the other file, a plain device file
+//Inputs	: pfnVisit and pvContext, called with every difference, by
+//			  partition
+//Outputs	: pstReport, the counts of the comparison
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The data is compared as of a snapshot. Corrupt records of the
+//			  other file are left out. The memory used stays within the
+//			  budget unless the partitions would outnumber
+//			  DIFF_MAX_PARTITIONS.
+//******************************************************************************
+bool diffFiles(const uint8 *pucFileName, const uint8 *pucOtherPath,
+			   DIFF_VISIT pfnVisit, void *pvContext, DIFF_REPORT *pstReport)
+{
+	bool blReturn = false;
+	FILE *ppstFiles[DIFF_MAX_PARTITIONS];
+	DIFF_TASK pstTasks[DIFF_MAX_THREADS];
+	DEVICE_DETAILS DeviceData = {0};
+	SNAPSHOT stSnapshot;
+	SHARD_LAYOUT stLayout = {0};
+	FILE_IDENTITY stOther = {0};
+	struct timespec stStart;
+	struct timespec stEnd;
+	uint32 ulSmaller = 0;
+	uint32 ulShard = 0;
+	uint32 ulTask = 0;
+	long lProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if(pucFileName == NULL || pucOtherPath == NULL || pfnVisit == NULL ||
+	   pstReport == NULL || fileExists(pucOtherPath) != true)
+	{
+		printf("\nUnable to compare : Invalid parameters or missing file");
+		return false;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &stStart);
+	memset(pstReport, 0, sizeof(DIFF_REPORT));
+	memset(pstTasks, 0, sizeof(pstTasks));
+	if(shardAcquireSnapshot(pucFileName, &stSnapshot, &stLayout) == true)
+	{
+		for(ulShard = 0; ulShard < stSnapshot.ulFileCount; ulShard++)
+		{
+			pstReport->ulOurCount += stSnapshot.pulRecordCounts[ulShard];
+		}
+		fileGetIdentity(pucOtherPath, &stOther);
+		pstReport->ulOtherCount = stOther.ulSize / sizeof(DEVICE_DETAILS);
+
+		pstReport->ulThreadCount = lProcessors > 0 ? lProcessors : 1;
+		if(pstReport->ulThreadCount > DIFF_MAX_THREADS)
+		{
+			pstReport->ulThreadCount = DIFF_MAX_THREADS;
+		}
+		ulSmaller = pstReport->ulOurCount < pstReport->ulOtherCount ?
+					pstReport->ulOurCount : pstReport->ulOtherCount;
+		pstReport->ulPartitionCount = ulSmaller / (DIFF_MEMORY_BUDGET /
+									  pstReport->ulThreadCount /
+									  DIFF_RECORD_COST) + 1;
+		if(pstReport->ulPartitionCount < pstReport->ulThreadCount)
+		{
+			pstReport->ulPartitionCount = pstReport->ulThreadCount;
+		}
+		if(pstReport->ulPartitionCount > DIFF_MAX_PARTITIONS)
+		{
+			pstReport->ulPartitionCount = DIFF_MAX_PARTITIONS;
+		}
+
+		blReturn = diffSetPartitions(pucFileName, DIFF_SIDE_OURS,
+									 pstReport->ulPartitionCount, true,
+									 ppstFiles);
+		for(ulShard = 0; ulShard < stSnapshot.ulFileCount; ulShard++)
+		{
+			while(blReturn == true &&
+				  snapshotRead(&stSnapshot, ulShard, &DeviceData) == true)
+			{
+				blReturn = diffRoute(ppstFiles, pstReport->ulPartitionCount,
+									 &DeviceData);
+			}
+		}
+		snapshotRelease(&stSnapshot);
+		blReturn = (diffSetPartitions(pucFileName, DIFF_SIDE_OURS,
+									  pstReport->ulPartitionCount, false,
+									  ppstFiles) == true &&
+					blReturn == true);
+	}
+
+	blReturn = (blReturn == true &&
+				diffSplitOther(pucFileName, pucOtherPath,
+							   pstReport->ulPartitionCount,
+							   &pstReport->ulSkippedCount) == true);
+
+	for(ulTask = 0; ulTask < pstReport->ulThreadCount && blReturn == true;
+		ulTask++)
+	{
+		pstTasks[ulTask].pucFileName = pucFileName;
+		pstTasks[ulTask].ulTask = ulTask;
+		pstTasks[ulTask].ulTaskCount = pstReport->ulThreadCount;
+		pstTasks[ulTask].ulPartitionCount = pstReport->ulPartitionCount;
+	}
+	if(blReturn == true)
+	{
+		poolRun(diffJoin, pstTasks, sizeof(DIFF_TASK),
+				pstReport->ulThreadCount);
+	}
+
+	for(ulTask = 0; ulTask < pstReport->ulThreadCount && blReturn == true;
+		ulTask++)
+	{
+		pstReport->ulAddedCount += pstTasks[ulTask].ulAddedCount;
+		pstReport->ulRemovedCount += pstTasks[ulTask].ulRemovedCount;
+		pstReport->ulChangedCount += pstTasks[ulTask].ulChangedCount;
+		blReturn = (pstTasks[ulTask].blStatus == true);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &stEnd);
+	pstReport->dMilliseconds = ((stEnd.tv_sec - stStart.tv_sec) +
+								(stEnd.tv_nsec - stStart.tv_nsec) /
+								DIFF_NANOSECONDS) * DIFF_MILLISECONDS;
+	blReturn = (blReturn == true &&
+				diffVisit(pucFileName, pstReport->ulThreadCount, pfnVisit,
+						  pvContext) == true);
+	diffCleanUp(pucFileName, pstReport->ulPartitionCount,
+				pstReport->ulThreadCount);
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to compare with %s", (char *)pucOtherPath);
+	}
+
+	return blReturn;
+}
+// EOF
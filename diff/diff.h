@@ -0,0 +1,65 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Comparison of the device data with another device file
+// Note		: Both sides are split into partition files by serial and the
+//			  partitions are joined in parallel, each within a share of a
+//			  fixed memory budget
+//
+//******************************************************************************
+
+#ifndef _DIFF_H_
+#define _DIFF_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+
+//******************************* Global Types *********************************
+// The device as in the data and as in the other file, zero when missing
+typedef struct _DIFF_ENTRY_
+{
+	uint32 ulOperation;
+	DEVICE_DETAILS stOurs;
+	DEVICE_DETAILS stOther;
+} DIFF_ENTRY;
+
+typedef struct _DIFF_REPORT_
+{
+	uint32 ulOurCount;
+	uint32 ulOtherCount;
+	uint32 ulSkippedCount;
+	uint32 ulAddedCount;
+	uint32 ulRemovedCount;
+	uint32 ulChangedCount;
+	uint32 ulPartitionCount;
+	uint32 ulThreadCount;
+	double dMilliseconds;
+} DIFF_REPORT;
+
+// Returns false to stop the enumeration
+typedef bool (*DIFF_VISIT)(const DIFF_ENTRY *pstEntry, void *pvContext);
+
+//***************************** Global Constants *******************************
+#define DIFF_SUFFIX			(".diff")
+#define DIFF_MAX_THREADS	(64)
+// Removals or updates applied at a time when applying the differences
+#define DIFF_APPLY_BATCH	(256)
+
+// Operations turning the data into the other file
+#define DIFF_ADDED			(1)
+#define DIFF_REMOVED		(2)
+#define DIFF_CHANGED		(3)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool diffFiles(const uint8 *pucFileName, const uint8 *pucOtherPath,
+			   DIFF_VISIT pfnVisit, void *pvContext, DIFF_REPORT *pstReport);
+
+#endif // _DIFF_H_
+// EOF
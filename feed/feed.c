@@ -0,0 +1,542 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: feed.c
+// Summary	: Change feed of the device data and its replication
+// Note		: "<data file>.feed" holds fixed size entries, the entry of
+//			  sequence n at offset (n - 1) * entry size. Writers append
+//			  while they hold the writer lock, so sequences follow the
+//			  commit order; a torn entry at the tail is cut off by the next
+//			  append and ends a replay. A replica is a plain data file with
+//			  its own serial index, "<replica>.seq" holding the last
+//			  sequence applied to it. Applying an entry is idempotent, so a
+//			  replay may start at an earlier sequence.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "crc.h"
+#include "index.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "feed.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define READ_COUNT			(1)
+#define WRITE_COUNT			(1)
+#define FILE_PERMISSIONS	(0644)
+#define FEED_BATCH_ENTRIES	(1024)
+#define FEED_NANOSECONDS	(1e9)
+#define FEED_MILLISECONDS	(1e3)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compute the checksum of a feed entry
+//Inputs	: pstEntry, the entry
+//Outputs	: None
+//Return	: The checksum of every field before ulChecksum
+//Notes		:
+//******************************************************************************
+static uint32 feedChecksum(const FEED_ENTRY *pstEntry)
+{
+	return crc32c(CRC_INITIAL, pstEntry, offsetof(FEED_ENTRY, ulChecksum));
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the last sequence applied to a replica
+//Inputs	: pucReplicaPath, name of the replica file
+//Outputs	: pulSequence, the last applied sequence
+//Return	: True, if the replica has a sequence file
+//Return	: False, if the replica was never bootstrapped
+//Notes		:
+//******************************************************************************
+static bool feedReadReplicaSequence(const uint8 *pucReplicaPath,
+									uint32 *pulSequence)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(fileBuildPath(pucPath, pucReplicaPath, FEED_REPLICA_SUFFIX) == true)
+	{
+		pstFile = fopen((char *)pucPath, "rb");
+	}
+
+	if(pstFile != NULL)
+	{
+		blReturn = (fread(pulSequence, sizeof(uint32), READ_COUNT,
+						  pstFile) == READ_COUNT);
+		fclose(pstFile);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To record the last sequence applied to a replica
+//Inputs	: pucReplicaPath, name of the replica file
+//Inputs	: ulSequence, the last applied sequence
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Written to a temporary file and renamed over the old one
+//******************************************************************************
+static bool feedWriteReplicaSequence(const uint8 *pucReplicaPath,
+									 uint32 ulSequence)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(fileBuildPath(pucPath, pucReplicaPath, FEED_REPLICA_SUFFIX) == true &&
+	   fileBuildPath(pucTemporaryPath, pucPath,
+					 SNAPSHOT_TEMPORARY_SUFFIX) == true)
+	{
+		pstFile = fopen((char *)pucTemporaryPath, "wb");
+	}
+
+	if(pstFile != NULL)
+	{
+		blReturn = (fwrite(&ulSequence, sizeof(ulSequence), WRITE_COUNT,
+						   pstFile) == WRITE_COUNT);
+		blReturn = (fclose(pstFile) == 0 && blReturn == true &&
+					rename((char *)pucTemporaryPath, (char *)pucPath) == 0);
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to record the replica sequence");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To copy the current device data into a new replica
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pucReplicaPath, name of the replica file
+//Outputs	: pulSequence, the last sequence contained in the copy
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Holds the writer lock, so the copy and the sequence match
+//******************************************************************************
+static bool feedBootstrap(const uint8 *pucFileName,
+						  const uint8 *pucReplicaPath, uint32 *pulSequence)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	DEVICE_DETAILS DeviceData = {0};
+	SNAPSHOT stSnapshot;
+	SNAPSHOT_WRITER stWriter;
+	SHARD_LAYOUT stLayout = {0};
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+	uint32 ulCount = 0;
+
+	if(fileBuildPath(pucTemporaryPath, pucReplicaPath,
+					 SNAPSHOT_TEMPORARY_SUFFIX) == true &&
+	   snapshotWriterBegin(pucFileName, &stWriter) == true)
+	{
+		pstFile = fopen((char *)pucTemporaryPath, "wb");
+		if(pstFile != NULL &&
+		   shardAcquireSnapshot(pucFileName, &stSnapshot, &stLayout) == true)
+		{
+			blReturn = feedGetLastSequence(pucFileName, pulSequence);
+			for(ulShard = 0; ulShard < stSnapshot.ulFileCount; ulShard++)
+			{
+				while(blReturn == true &&
+					  snapshotRead(&stSnapshot, ulShard, &DeviceData) == true)
+				{
+					blReturn = (fwrite(&DeviceData, sizeof(DEVICE_DETAILS),
+									   WRITE_COUNT, pstFile) == WRITE_COUNT);
+					ulCount++;
+				}
+			}
+			snapshotRelease(&stSnapshot);
+		}
+
+		if(pstFile != NULL)
+		{
+			blReturn = (fclose(pstFile) == 0 && blReturn == true &&
+						rename((char *)pucTemporaryPath,
+							   (char *)pucReplicaPath) == 0);
+		}
+		snapshotWriterEnd(&stWriter);
+	}
+
+	if(blReturn == true)
+	{
+		printf("Bootstrapped %s with %lu device(s) at sequence %lu\n",
+			   (char *)pucReplicaPath, ulCount, *pulSequence);
+	}
+	else
+	{
+		printf("\nUnable to bootstrap the replica");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To apply one feed entry to a replica
+//Inputs	: lFd, the replica file, open for reading and writing
+//Inputs	: pstIndex, serial index of the replica
+//Inputs	: pulRecordCount, number of records in the replica
+//Inputs	: pstEntry, the entry
+//Outputs	: pulRecordCount, the updated number of records
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: An add or update of an indexed serial overwrites its record,
+//			  a removal of a missing serial is skipped, so entries applied
+//			  twice leave the replica as it was. A removed record is
+//			  replaced by the last one and the file is cut.
+//******************************************************************************
+static bool feedApply(int32 lFd, INDEX *pstIndex, uint32 *pulRecordCount,
+					  const FEED_ENTRY *pstEntry)
+{
+	bool blReturn = true;
+	DEVICE_DETAILS LastData = {0};
+	uint32 ulSerial = pstEntry->stDevice.ulDeviceSerial;
+	uint32 ulSlot = 0;
+	uint32 ulLast = 0;
+
+	if(pstEntry->ulOperation == FEED_REMOVE)
+	{
+		if(indexFind(pstIndex, ulSerial, &ulSlot) == true)
+		{
+			ulLast = *pulRecordCount - 1;
+			if(ulSlot != ulLast)
+			{
+				blReturn = (pread(lFd, &LastData, sizeof(DEVICE_DETAILS),
+								  ulLast * sizeof(DEVICE_DETAILS)) ==
+							sizeof(DEVICE_DETAILS) &&
+							pwrite(lFd, &LastData, sizeof(DEVICE_DETAILS),
+								   ulSlot * sizeof(DEVICE_DETAILS)) ==
+							sizeof(DEVICE_DETAILS) &&
+							indexInsert(pstIndex, LastData.ulDeviceSerial,
+										ulSlot) == true);
+			}
+			blReturn = (blReturn == true &&
+						ftruncate(lFd, ulLast * sizeof(DEVICE_DETAILS)) == 0 &&
+						indexRemove(pstIndex, ulSerial) == true);
+			if(blReturn == true)
+			{
+				*pulRecordCount = ulLast;
+			}
+		}
+	}
+	else if(pstEntry->ulOperation == FEED_ADD ||
+			pstEntry->ulOperation == FEED_UPDATE)
+	{
+		if(indexFind(pstIndex, ulSerial, &ulSlot) != true)
+		{
+			ulSlot = *pulRecordCount;
+			blReturn = indexInsert(pstIndex, ulSerial, ulSlot);
+			if(blReturn == true)
+			{
+				(*pulRecordCount)++;
+			}
+		}
+		blReturn = (blReturn == true &&
+					pwrite(lFd, &pstEntry->stDevice, sizeof(DEVICE_DETAILS),
+						   ulSlot * sizeof(DEVICE_DETAILS)) ==
+					sizeof(DEVICE_DETAILS));
+	}
+	else
+	{
+		blReturn = false;
+	}
+
+	return blReturn;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To log changes of the device data
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulOperation, FEED_ADD, FEED_REMOVE or FEED_UPDATE
+//Inputs	: pstDevices and ulCount, the changed devices
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The caller has to be the only writer, once its changes are
+//			  committed. Each device gets the next sequence.
+//******************************************************************************
+bool feedAppend(const uint8 *pucFileName, uint32 ulOperation,
+				const DEVICE_DETAILS *pstDevices, uint32 ulCount)
+{
+	bool blReturn = false;
+	FEED_ENTRY pstEntries[FEED_BATCH_ENTRIES];
+	struct stat stStat;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	int32 lFd = -1;
+	uint32 ulSequence = 0;
+	uint32 ulIndex = 0;
+	uint32 ulBatch = 0;
+	uint32 ulSize = 0;
+
+	if(pucFileName != NULL && (pstDevices != NULL || ulCount == 0) &&
+	   fileBuildPath(pucPath, pucFileName, FEED_SUFFIX) == true)
+	{
+		lFd = open((char *)pucPath, O_RDWR | O_CREAT, FILE_PERMISSIONS);
+	}
+
+	if(lFd >= 0 && fstat(lFd, &stStat) == 0)
+	{
+		ulSequence = stStat.st_size / sizeof(FEED_ENTRY);
+		blReturn = (stStat.st_size % sizeof(FEED_ENTRY) == 0 ||
+					ftruncate(lFd, ulSequence * sizeof(FEED_ENTRY)) == 0);
+
+		while(blReturn == true && ulIndex < ulCount)
+		{
+			for(ulBatch = 0; ulBatch < FEED_BATCH_ENTRIES && ulIndex < ulCount;
+				ulBatch++, ulIndex++)
+			{
+				ulSequence++;
+				memset(&pstEntries[ulBatch], 0, sizeof(FEED_ENTRY));
+				pstEntries[ulBatch].ulSequence = ulSequence;
+				pstEntries[ulBatch].ulOperation = ulOperation;
+				pstEntries[ulBatch].stDevice = pstDevices[ulIndex];
+				pstEntries[ulBatch].ulChecksum =
+					feedChecksum(&pstEntries[ulBatch]);
+			}
+
+			ulSize = ulBatch * sizeof(FEED_ENTRY);
+			blReturn = (pwrite(lFd, pstEntries, ulSize,
+							   (ulSequence - ulBatch) * sizeof(FEED_ENTRY)) ==
+						(ssize_t)ulSize);
+		}
+	}
+
+	if(lFd >= 0)
+	{
+		close(lFd);
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to log the change to the feed");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the last sequence of the change feed
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pulSequence, the last complete sequence, 0 if none
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A missing feed has no sequences
+//******************************************************************************
+bool feedGetLastSequence(const uint8 *pucFileName, uint32 *pulSequence)
+{
+	bool blReturn = false;
+	struct stat stStat;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(pucFileName != NULL && pulSequence != NULL &&
+	   fileBuildPath(pucPath, pucFileName, FEED_SUFFIX) == true)
+	{
+		*pulSequence = 0;
+		if(stat((char *)pucPath, &stStat) == 0)
+		{
+			*pulSequence = stStat.st_size / sizeof(FEED_ENTRY);
+		}
+		blReturn = true;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read consecutive entries of the change feed
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulFromSequence, sequence of the first entry
+//Inputs	: ulMaxCount, number of entries pstEntries can hold
+//Outputs	: pstEntries, the entries read
+//Outputs	: pulCount, number of entries read
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Stops at the end of the feed or at the first incomplete or
+//			  corrupt entry, a missing feed has no entries
+//******************************************************************************
+bool feedRead(const uint8 *pucFileName, uint32 ulFromSequence,
+			  FEED_ENTRY *pstEntries, uint32 ulMaxCount, uint32 *pulCount)
+{
+	bool blReturn = false;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	int32 lFd = -1;
+	uint32 ulRead = 0;
+	ssize_t lRead = 0;
+
+	if(pucFileName != NULL && pstEntries != NULL && pulCount != NULL &&
+	   ulFromSequence >= FEED_FIRST_SEQUENCE &&
+	   fileBuildPath(pucPath, pucFileName, FEED_SUFFIX) == true)
+	{
+		*pulCount = 0;
+		blReturn = true;
+		if(fileExists(pucPath) == true)
+		{
+			lFd = open((char *)pucPath, O_RDONLY);
+			blReturn = (lFd >= 0);
+		}
+	}
+
+	if(lFd >= 0)
+	{
+		lRead = pread(lFd, pstEntries, ulMaxCount * sizeof(FEED_ENTRY),
+					  (ulFromSequence - 1) * sizeof(FEED_ENTRY));
+		ulRead = lRead > 0 ? lRead / sizeof(FEED_ENTRY) : 0;
+		while(*pulCount < ulRead &&
+			  pstEntries[*pulCount].ulSequence == ulFromSequence + *pulCount &&
+			  pstEntries[*pulCount].ulChecksum ==
+			  feedChecksum(&pstEntries[*pulCount]))
+		{
+			(*pulCount)++;
+		}
+		blReturn = (lRead >= 0);
+		close(lFd);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To bring a replica file up to date with the change feed
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pucReplicaPath, name of the replica file
+//Inputs	: ulFromSequence, first sequence to apply, 0 to continue after
+//			  the last one applied
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A replica without a sequence file is first bootstrapped with
+//			  a copy of the device data. Stops at the first incomplete or
+//			  corrupt entry. Only one replicate may run on a replica at a
+//			  time.
+//******************************************************************************
+bool feedReplicate(const uint8 *pucFileName, const uint8 *pucReplicaPath,
+				   uint32 ulFromSequence)
+{
+	bool blReturn = false;
+	FEED_ENTRY pstEntries[FEED_BATCH_ENTRIES];
+	INDEX stIndex;
+	struct stat stStat;
+	struct timespec stStart;
+	struct timespec stEnd;
+	int32 lReplicaFd = -1;
+	uint32 ulApplied = 0;
+	uint32 ulSequence = 0;
+	uint32 ulRecordCount = 0;
+	uint32 ulBatch = 0;
+	uint32 ulIndex = 0;
+	double dSeconds = 0;
+
+	if(pucFileName == NULL || pucReplicaPath == NULL)
+	{
+		printf("\nUnable to replicate : Invalid parameters");
+		return false;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &stStart);
+	blReturn = feedReadReplicaSequence(pucReplicaPath, &ulApplied);
+	if(blReturn != true)
+	{
+		blReturn = (feedBootstrap(pucFileName, pucReplicaPath,
+								  &ulApplied) == true &&
+					feedWriteReplicaSequence(pucReplicaPath,
+											 ulApplied) == true);
+	}
+	if(ulFromSequence == 0)
+	{
+		ulFromSequence = ulApplied + 1;
+	}
+
+	if(blReturn == true)
+	{
+		lReplicaFd = open((char *)pucReplicaPath, O_RDWR | O_CREAT,
+						  FILE_PERMISSIONS);
+		blReturn = (lReplicaFd >= 0 && fstat(lReplicaFd, &stStat) == 0 &&
+					indexOpen(pucReplicaPath, &stIndex) == true);
+		if(blReturn == true)
+		{
+			ulRecordCount = stStat.st_size / sizeof(DEVICE_DETAILS);
+			ulSequence = ulFromSequence;
+			ulApplied = 0;
+			ulBatch = FEED_BATCH_ENTRIES;
+			while(blReturn == true && ulBatch == FEED_BATCH_ENTRIES)
+			{
+				blReturn = feedRead(pucFileName, ulSequence, pstEntries,
+									FEED_BATCH_ENTRIES, &ulBatch);
+				for(ulIndex = 0; ulIndex < ulBatch && blReturn == true;
+					ulIndex++)
+				{
+					blReturn = feedApply(lReplicaFd, &stIndex, &ulRecordCount,
+										 &pstEntries[ulIndex]);
+					if(blReturn == true)
+					{
+						ulSequence++;
+						ulApplied++;
+					}
+				}
+			}
+
+			blReturn = (indexSync(&stIndex, pucReplicaPath) == true &&
+						blReturn == true);
+			indexClose(&stIndex);
+		}
+		if(lReplicaFd >= 0)
+		{
+			close(lReplicaFd);
+		}
+
+		if(blReturn == true && ulApplied > 0)
+		{
+			blReturn = feedWriteReplicaSequence(pucReplicaPath,
+												ulSequence - 1);
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &stEnd);
+	dSeconds = (stEnd.tv_sec - stStart.tv_sec) +
+			   (stEnd.tv_nsec - stStart.tv_nsec) / FEED_NANOSECONDS;
+	if(blReturn == true)
+	{
+		printf("Applied %lu change(s), %s is at sequence %lu (%.3f ms)\n",
+			   ulApplied, (char *)pucReplicaPath, ulSequence - 1,
+			   dSeconds * FEED_MILLISECONDS);
+	}
+	else
+	{
+		printf("\nUnable to replicate to %s", (char *)pucReplicaPath);
+	}
+
+	return blReturn;
+}
+// EOF
@@ -0,0 +1,52 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Change feed of the device data and its replication
+// Note		: Every add, remove and update is logged with a sequence number,
+//			  a replica file catches up by applying the changes it misses
+//
+//******************************************************************************
+
+#ifndef _FEED_H_
+#define _FEED_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+
+//******************************* Global Types *********************************
+typedef struct _FEED_ENTRY_
+{
+	uint32 ulSequence;
+	uint32 ulOperation;
+	DEVICE_DETAILS stDevice;
+	uint32 ulChecksum;
+} FEED_ENTRY;
+
+//***************************** Global Constants *******************************
+#define FEED_SUFFIX				(".feed")
+#define FEED_REPLICA_SUFFIX		(".seq")
+#define FEED_FIRST_SEQUENCE		(1)
+
+// Operations of the entries, the device serial is the key
+#define FEED_ADD				(1)
+#define FEED_REMOVE				(2)
+#define FEED_UPDATE				(3)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool feedAppend(const uint8 *pucFileName, uint32 ulOperation,
+				const DEVICE_DETAILS *pstDevices, uint32 ulCount);
+bool feedGetLastSequence(const uint8 *pucFileName, uint32 *pulSequence);
+bool feedRead(const uint8 *pucFileName, uint32 ulFromSequence,
+			  FEED_ENTRY *pstEntries, uint32 ulMaxCount, uint32 *pulCount);
+bool feedReplicate(const uint8 *pucFileName, const uint8 *pucReplicaPath,
+				   uint32 ulFromSequence);
+
+#endif // _FEED_H_
+// EOF
@@ -15,163 +15,1734 @@
 //******************************* Include Files ********************************
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
 #include "customTypes.h"
+#include "file.h"
+#include "trace.h"
 //******************************* Local Types **********************************
+// A frame of the page pool, holding a page of the file of its epoch
+typedef struct _FILE_FRAME_
+{
+	uint32 ulEpoch;
+	uint32 ulPage;
+	uint32 ulSize;
+	uint32 ulPins;
+	uint32 ulNext;
+	int32 lFd;
+	bool blReferenced;
+	bool blDirty;
+	bool blLoading;
+} FILE_FRAME;
+
+// A file known to the page pool. Its epoch changes with its content, the
+// pages of an older epoch are never found again.
+typedef struct _FILE_PAGE_FILE_
+{
+	uint32 ulDevice;
+	FILE_IDENTITY stIdentity;
+	uint32 ulEpoch;
+	uint32 ulAttached;
+} FILE_PAGE_FILE;
+
+// The file attached to a descriptor, ulFile being its index plus one
+typedef struct _FILE_PAGE_FD_
+{
+	uint32 ulFile;
+	uint32 ulCount;
+} FILE_PAGE_FD;
+
+//***************************** Local Constants ********************************
+#define NANOSECONDS	(1000000000UL)
+#define READ_COUNT				(1)
+#define WRITE_COUNT				(1)
+#define FILE_FRAME_NONE			((uint32)-1)
+#define FILE_PAGE_NO_EPOCH		(0)
+#define FILE_PAGE_MAX_FILES		(256)
+#define FILE_PAGE_MAX_FDS		(1024)
+#define FILE_PAGE_RUN			(32)
+#define FILE_PAGE_HASH			(0x9E3779B97F4A7C15UL)
+#define FILE_PAGE_HASH_SHIFT	(32)
+
+//***************************** Local Variables ********************************
+static pthread_mutex_t stFilePageLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t stFilePageChanged = PTHREAD_COND_INITIALIZER;
+static uint8 *pucFilePageData = NULL;
+static FILE_FRAME *pstFilePageFrames = NULL;
+static uint32 *pulFilePageBuckets = NULL;
+static uint32 ulFilePageFrameCount = 0;
+static uint32 ulFilePageBucketCount = 0;
+static uint32 ulFilePageHand = 0;
+static uint32 ulFilePageBudget = FILE_PAGE_DEFAULT_BUDGET;
+static uint32 ulFilePageEpoch = FILE_PAGE_NO_EPOCH;
+static FILE_PAGE_FILE pstFilePageFiles[FILE_PAGE_MAX_FILES];
+static uint32 ulFilePageFileHand = 0;
+static FILE_PAGE_FD pstFilePageFds[FILE_PAGE_MAX_FDS];
+static FILE_PAGE_STATS stFilePageStats;
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To take the identity of a file from its status
+//Inputs	: pstStatus, the status of the file
+//Outputs	: pstIdentity, inode, size and modification time of the file
+//Return	: None
+//Notes		: 
+//******************************************************************************
+static void fileFillIdentity(const struct stat *pstStatus,
+							 FILE_IDENTITY *pstIdentity)
+{
+	pstIdentity->ulInode = pstStatus->st_ino;
+	pstIdentity->ulSize = pstStatus->st_size;
+	pstIdentity->ulModified = pstStatus->st_mtim.tv_sec * NANOSECONDS +
+							  pstStatus->st_mtim.tv_nsec;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To allocate the frames of the page pool
+//Inputs	: None
+//Outputs	: None
+//Return	: True, if the pool has frames
+//Return	: False, if they cannot be allocated
+//Notes		: Called with the pool locked, the frames are allocated at the
+//			  first attach after the budget is set
+//******************************************************************************
+static bool filePageSetup(void)
+{
+	if(pstFilePageFrames == NULL)
+	{
+		ulFilePageFrameCount = ulFilePageBudget / FILE_PAGE_SIZE;
+		ulFilePageBucketCount = 1;
+		while(ulFilePageBucketCount < ulFilePageFrameCount * 2)
+		{
+			ulFilePageBucketCount *= 2;
+		}
+
+		pucFilePageData = aligned_alloc(FILE_PAGE_SIZE, ulFilePageFrameCount *
+										FILE_PAGE_SIZE);
+		pstFilePageFrames = calloc(ulFilePageFrameCount, sizeof(FILE_FRAME));
+		pulFilePageBuckets = malloc(ulFilePageBucketCount * sizeof(uint32));
+		if(pucFilePageData == NULL || pstFilePageFrames == NULL ||
+		   pulFilePageBuckets == NULL)
+		{
+			free(pucFilePageData);
+			free(pstFilePageFrames);
+			free(pulFilePageBuckets);
+			pucFilePageData = NULL;
+			pstFilePageFrames = NULL;
+			pulFilePageBuckets = NULL;
+			ulFilePageFrameCount = 0;
+			printf("\nUnable to set up the page pool : Out of memory");
+		}
+		else
+		{
+			// All bits set, FILE_FRAME_NONE
+			memset(pulFilePageBuckets, 0xFF,
+				   ulFilePageBucketCount * sizeof(uint32));
+			ulFilePageHand = 0;
+		}
+	}
+
+	return (pstFilePageFrames != NULL);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To get the hash bucket of a page
+//Inputs	: ulEpoch, epoch of the file
+//Inputs	: ulPage, number of the page in the file
+//Outputs	: None
+//Return	: Index of the bucket
+//Notes		:
+//******************************************************************************
+static uint32 filePageBucket(uint32 ulEpoch, uint32 ulPage)
+{
+	return (((ulEpoch << FILE_PAGE_HASH_SHIFT) ^ ulPage) * FILE_PAGE_HASH >>
+			FILE_PAGE_HASH_SHIFT) & (ulFilePageBucketCount - 1);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the frame of a page
+//Inputs	: ulEpoch, epoch of the file
+//Inputs	: ulPage, number of the page in the file
+//Outputs	: None
+//Return	: Index of the frame, FILE_FRAME_NONE if the page is not cached
+//Notes		: Called with the pool locked
+//******************************************************************************
+static uint32 filePageFind(uint32 ulEpoch, uint32 ulPage)
+{
+	uint32 ulFrame = pulFilePageBuckets[filePageBucket(ulEpoch, ulPage)];
+
+	while(ulFrame != FILE_FRAME_NONE &&
+		  (pstFilePageFrames[ulFrame].ulEpoch != ulEpoch ||
+		   pstFilePageFrames[ulFrame].ulPage != ulPage))
+	{
+		ulFrame = pstFilePageFrames[ulFrame].ulNext;
+	}
+
+	return ulFrame;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To give a free frame to a page
+//Inputs	: ulFrame, the frame
+//Inputs	: ulEpoch, epoch of the file
+//Inputs	: ulPage, number of the page in the file
+//Outputs	: None
+//Return	: None
+//Notes		: Called with the pool locked
+//******************************************************************************
+static void filePageLink(uint32 ulFrame, uint32 ulEpoch, uint32 ulPage)
+{
+	FILE_FRAME *pstFrame = &pstFilePageFrames[ulFrame];
+	uint32 ulBucket = filePageBucket(ulEpoch, ulPage);
+
+	pstFrame->ulEpoch = ulEpoch;
+	pstFrame->ulPage = ulPage;
+	pstFrame->ulSize = 0;
+	pstFrame->ulNext = pulFilePageBuckets[ulBucket];
+	pulFilePageBuckets[ulBucket] = ulFrame;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To free a frame
+//Inputs	: ulFrame, the frame, holding a page
+//Outputs	: None
+//Return	: None
+//Notes		: Called with the pool locked, a dirty page is lost
+//******************************************************************************
+static void filePageUnlink(uint32 ulFrame)
+{
+	FILE_FRAME *pstFrame = &pstFilePageFrames[ulFrame];
+	uint32 *pulLink = NULL;
+
+	pulLink = &pulFilePageBuckets[filePageBucket(pstFrame->ulEpoch,
+												 pstFrame->ulPage)];
+	while(*pulLink != ulFrame)
+	{
+		pulLink = &pstFilePageFrames[*pulLink].ulNext;
+	}
+	*pulLink = pstFrame->ulNext;
+
+	pstFrame->ulEpoch = FILE_PAGE_NO_EPOCH;
+	pstFrame->ulSize = 0;
+	pstFrame->blReferenced = false;
+	pstFrame->blDirty = false;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To get the epoch of the file attached to a descriptor
+//Inputs	: lFd, the descriptor
+//Outputs	: None
+//Return	: The epoch, FILE_PAGE_NO_EPOCH if the descriptor is not attached
+//Notes		: Called with the pool locked
+//******************************************************************************
+static uint32 filePageGetEpoch(int32 lFd)
+{
+	uint32 ulEpoch = FILE_PAGE_NO_EPOCH;
+
+	if(lFd >= 0 && lFd < FILE_PAGE_MAX_FDS &&
+	   pstFilePageFds[lFd].ulCount > 0 && pstFilePageFrames != NULL)
+	{
+		ulEpoch = pstFilePageFiles[pstFilePageFds[lFd].ulFile - 1].ulEpoch;
+	}
+
+	return ulEpoch;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To record the identity of a file after the pool wrote to it
+//Inputs	: lFd, a descriptor of the file
+//Outputs	: None
+//Return	: None
+//Notes		: Called with the pool locked, so the pages written stay valid
+//			  although the file changed
+//******************************************************************************
+static void filePageStamp(int32 lFd)
+{
+	struct stat stStatus;
+
+	if(lFd >= 0 && lFd < FILE_PAGE_MAX_FDS &&
+	   pstFilePageFds[lFd].ulCount > 0 && fstat(lFd, &stStatus) == 0)
+	{
+		fileFillIdentity(&stStatus,
+						 &pstFilePageFiles[pstFilePageFds[lFd].ulFile - 1].
+						 stIdentity);
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write a dirty page back to its file
+//Inputs	: ulFrame, the frame of the page
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error, the page stays dirty
+//Notes		: Called with the pool locked
+//******************************************************************************
+static bool filePageWriteBack(uint32 ulFrame)
+{
+	bool blReturn = false;
+	FILE_FRAME *pstFrame = &pstFilePageFrames[ulFrame];
+
+	blReturn = (pwrite(pstFrame->lFd, pucFilePageData +
+					   (size_t)ulFrame * FILE_PAGE_SIZE, pstFrame->ulSize,
+					   (off_t)pstFrame->ulPage * FILE_PAGE_SIZE) ==
+				(ssize_t)pstFrame->ulSize);
+	if(blReturn == true)
+	{
+		pstFrame->blDirty = false;
+		stFilePageStats.ulWriteBacks++;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To take a frame for a new page
+//Inputs	: None
+//Outputs	: None
+//Return	: Index of the frame, FILE_FRAME_NONE if every frame is pinned
+//Notes		: Called with the pool locked. CLOCK: the hand passes over the
+//			  pinned frames and clears the reference bit of the others until
+//			  it meets a frame not referenced since its last pass. A dirty
+//			  page is written back before its frame is reused.
+//******************************************************************************
+static uint32 filePageEvict(void)
+{
+	FILE_FRAME *pstFrame = NULL;
+	uint32 ulFrame = FILE_FRAME_NONE;
+	uint32 ulCandidate = 0;
+	uint32 ulStep = 0;
+	bool blDirty = false;
+
+	for(ulStep = 0; ulStep < ulFilePageFrameCount * 2 &&
+		ulFrame == FILE_FRAME_NONE; ulStep++)
+	{
+		ulCandidate = ulFilePageHand;
+		pstFrame = &pstFilePageFrames[ulCandidate];
+		ulFilePageHand = (ulFilePageHand + 1) % ulFilePageFrameCount;
+
+		if(pstFrame->ulPins > 0 || pstFrame->blLoading == true)
+		{
+			continue;
+		}
+
+		blDirty = pstFrame->blDirty;
+		if(pstFrame->ulEpoch == FILE_PAGE_NO_EPOCH)
+		{
+			ulFrame = ulCandidate;
+		}
+		else if(pstFrame->blReferenced == true)
+		{
+			pstFrame->blReferenced = false;
+		}
+		else if(blDirty != true || filePageWriteBack(ulCandidate) == true)
+		{
+			if(blDirty == true)
+			{
+				filePageStamp(pstFrame->lFd);
+			}
+			filePageUnlink(ulCandidate);
+			stFilePageStats.ulEvictions++;
+			ulFrame = ulCandidate;
+		}
+	}
+
+	return ulFrame;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To free the frames of an epoch no longer current
+//Inputs	: ulEpoch, the epoch
+//Outputs	: None
+//Return	: None
+//Notes		: Called with the pool locked when the file changed behind the
+//			  pool. Pinned frames are left to the CLOCK.
+//******************************************************************************
+static void filePageDrop(uint32 ulEpoch)
+{
+	uint32 ulFrame = 0;
+
+	for(ulFrame = 0; ulFrame < ulFilePageFrameCount; ulFrame++)
+	{
+		if(pstFilePageFrames[ulFrame].ulEpoch == ulEpoch)
+		{
+			pstFilePageFrames[ulFrame].blDirty = false;
+			if(pstFilePageFrames[ulFrame].ulPins == 0)
+			{
+				filePageUnlink(ulFrame);
+			}
+		}
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the pool entry of a file, or to make one
+//Inputs	: ulDevice, device of the file
+//Inputs	: pstIdentity, current identity of the file
+//Outputs	: None
+//Return	: Index of the entry plus one, 0 if every entry is attached
+//Notes		: Called with the pool locked. A file whose identity changed
+//			  gets a new epoch. An entry no longer attached is reused for a
+//			  new file.
+//******************************************************************************
+static uint32 filePageTrack(uint32 ulDevice, const FILE_IDENTITY *pstIdentity)
+{
+	FILE_PAGE_FILE *pstFile = NULL;
+	uint32 ulFile = 0;
+	uint32 ulIndex = 0;
+
+	for(ulIndex = 0; ulIndex < FILE_PAGE_MAX_FILES && ulFile == 0; ulIndex++)
+	{
+		pstFile = &pstFilePageFiles[ulIndex];
+		if(pstFile->ulEpoch != FILE_PAGE_NO_EPOCH &&
+		   pstFile->ulDevice == ulDevice &&
+		   pstFile->stIdentity.ulInode == pstIdentity->ulInode)
+		{
+			ulFile = ulIndex + 1;
+			if(fileSameIdentity(&pstFile->stIdentity, pstIdentity) != true)
+			{
+				filePageDrop(pstFile->ulEpoch);
+				pstFile->stIdentity = *pstIdentity;
+				pstFile->ulEpoch = ++ulFilePageEpoch;
+			}
+		}
+	}
+
+	for(ulIndex = 0; ulIndex < FILE_PAGE_MAX_FILES && ulFile == 0; ulIndex++)
+	{
+		pstFile = &pstFilePageFiles[ulFilePageFileHand];
+		ulFilePageFileHand = (ulFilePageFileHand + 1) % FILE_PAGE_MAX_FILES;
+		if(pstFile->ulAttached == 0)
+		{
+			ulFile = (pstFile - pstFilePageFiles) + 1;
+			pstFile->ulDevice = ulDevice;
+			pstFile->stIdentity = *pstIdentity;
+			pstFile->ulEpoch = ++ulFilePageEpoch;
+		}
+	}
+
+	return ulFile;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To count the pages of a scan that are not cached
+//Inputs	: lFd, the descriptor
+//Inputs	: ulFirst, the first page
+//Inputs	: ulCount, number of pages
+//Outputs	: None
+//Return	: Number of consecutive pages from the first neither cached nor
+//			  being read, ulCount if the descriptor is not attached
+//Notes		: A scan reads these pages directly, so it neither evicts the
+//			  hot pages nor copies its pages twice
+//******************************************************************************
+static uint32 filePageCountMissing(int32 lFd, uint32 ulFirst, uint32 ulCount)
+{
+	uint32 ulEpoch = FILE_PAGE_NO_EPOCH;
+	uint32 ulMissing = 0;
+
+	pthread_mutex_lock(&stFilePageLock);
+	ulEpoch = filePageGetEpoch(lFd);
+	if(ulEpoch == FILE_PAGE_NO_EPOCH)
+	{
+		ulMissing = ulCount;
+	}
+	while(ulMissing < ulCount &&
+		  filePageFind(ulEpoch, ulFirst + ulMissing) == FILE_FRAME_NONE)
+	{
+		ulMissing++;
+	}
+	if(ulEpoch != FILE_PAGE_NO_EPOCH)
+	{
+		stFilePageStats.ulMisses += ulMissing;
+	}
+	pthread_mutex_unlock(&stFilePageLock);
+
+	return ulMissing;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To pin consecutive pages of a file, reading those not cached
+//Inputs	: lFd, the descriptor, attached
+//Inputs	: ulFirst, the first page
+//Inputs	: ulCount, number of pages, at most FILE_PAGE_RUN
+//Inputs	: blScan, true for a sequential scan, the run then stops before
+//			  the first page not cached and the pages are not referenced
+//Outputs	: pulFrames, the frames of the pinned pages
+//Return	: Number of pages pinned from the first, 0 if the descriptor is
+//			  not attached or the first page cannot be read
+//Notes		: The pages missing are read together with one preadv() outside
+//			  the lock. A caller only waits, for a page being read by another
+//			  thread or for a frame to be unpinned, while it pins nothing.
+//******************************************************************************
+static uint32 filePagePinRun(int32 lFd, uint32 ulFirst, uint32 ulCount,
+							 bool blScan, uint32 *pulFrames)
+{
+	bool pblLoad[FILE_PAGE_RUN] = {false};
+	bool blError = false;
+	struct iovec pstVectors[FILE_PAGE_RUN];
+	FILE_FRAME *pstFrame = NULL;
+	uint32 ulEpoch = FILE_PAGE_NO_EPOCH;
+	uint32 ulPinned = 0;
+	uint32 ulFrame = 0;
+	uint32 ulStart = 0;
+	uint32 ulIndex = 0;
+	uint32 ulVector = 0;
+	ssize_t lRead = 0;
+
+	pthread_mutex_lock(&stFilePageLock);
+	ulEpoch = filePageGetEpoch(lFd);
+	while(ulEpoch != FILE_PAGE_NO_EPOCH && ulPinned < ulCount)
+	{
+		ulFrame = filePageFind(ulEpoch, ulFirst + ulPinned);
+		if(ulFrame == FILE_FRAME_NONE && (blScan != true || ulPinned == 0))
+		{
+			ulFrame = filePageEvict();
+			if(ulFrame != FILE_FRAME_NONE)
+			{
+				filePageLink(ulFrame, ulEpoch, ulFirst + ulPinned);
+				pstFilePageFrames[ulFrame].blLoading = true;
+				pblLoad[ulPinned] = true;
+				stFilePageStats.ulMisses++;
+			}
+		}
+		else if(ulFrame != FILE_FRAME_NONE &&
+				pstFilePageFrames[ulFrame].blLoading != true)
+		{
+			stFilePageStats.ulHits++;
+		}
+		else
+		{
+			ulFrame = FILE_FRAME_NONE;
+		}
+
+		if(ulFrame != FILE_FRAME_NONE)
+		{
+			pstFilePageFrames[ulFrame].ulPins++;
+			pstFilePageFrames[ulFrame].blReferenced = (blScan != true ||
+									pstFilePageFrames[ulFrame].blReferenced);
+			pulFrames[ulPinned++] = ulFrame;
+		}
+		else if(ulPinned == 0)
+		{
+			pthread_cond_wait(&stFilePageChanged, &stFilePageLock);
+			ulEpoch = filePageGetEpoch(lFd);
+		}
+		else
+		{
+			break;
+		}
+	}
+	pthread_mutex_unlock(&stFilePageLock);
+
+	for(ulIndex = 0; ulIndex < ulPinned; ulIndex++)
+	{
+		if(pblLoad[ulIndex] != true)
+		{
+			continue;
+		}
+
+		for(ulStart = ulIndex; ulIndex < ulPinned && pblLoad[ulIndex] == true;
+			ulIndex++)
+		{
+			pstVectors[ulIndex - ulStart].iov_base = pucFilePageData +
+				(size_t)pulFrames[ulIndex] * FILE_PAGE_SIZE;
+			pstVectors[ulIndex - ulStart].iov_len = FILE_PAGE_SIZE;
+		}
+		lRead = preadv(lFd, pstVectors, ulIndex - ulStart,
+					   (off_t)(ulFirst + ulStart) * FILE_PAGE_SIZE);
+		blError = (blError == true || lRead < 0);
+
+		// A page past the end of the file is cached as empty
+		for(ulVector = 0; ulVector < ulIndex - ulStart; ulVector++)
+		{
+			pstFrame = &pstFilePageFrames[pulFrames[ulStart + ulVector]];
+			pstFrame->ulSize = 0;
+			if(lRead > (ssize_t)(ulVector * FILE_PAGE_SIZE))
+			{
+				pstFrame->ulSize = lRead - ulVector * FILE_PAGE_SIZE;
+				if(pstFrame->ulSize > FILE_PAGE_SIZE)
+				{
+					pstFrame->ulSize = FILE_PAGE_SIZE;
+				}
+			}
+			memset((uint8 *)pstVectors[ulVector].iov_base + pstFrame->ulSize,
+				   0, FILE_PAGE_SIZE - pstFrame->ulSize);
+		}
+	}
+
+	pthread_mutex_lock(&stFilePageLock);
+	for(ulIndex = 0; ulIndex < ulPinned; ulIndex++)
+	{
+		pstFrame = &pstFilePageFrames[pulFrames[ulIndex]];
+		if(pblLoad[ulIndex] == true)
+		{
+			pstFrame->blLoading = false;
+			pstFrame->lFd = lFd;
+		}
+		if(blError == true)
+		{
+			pstFrame->ulPins--;
+			if(pblLoad[ulIndex] == true)
+			{
+				filePageUnlink(pulFrames[ulIndex]);
+			}
+		}
+	}
+	pthread_cond_broadcast(&stFilePageChanged);
+	pthread_mutex_unlock(&stFilePageLock);
+
+	return (blError == true) ? 0 : ulPinned;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To unpin pages
+//Inputs	: pulFrames, the frames of the pages
+//Inputs	: ulCount, number of frames
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void filePageRelease(const uint32 *pulFrames, uint32 ulCount)
+{
+	uint32 ulIndex = 0;
+
+	pthread_mutex_lock(&stFilePageLock);
+	for(ulIndex = 0; ulIndex < ulCount; ulIndex++)
+	{
+		pstFilePageFrames[pulFrames[ulIndex]].ulPins--;
+	}
+	pthread_cond_broadcast(&stFilePageChanged);
+	pthread_mutex_unlock(&stFilePageLock);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To copy a byte range of a file through the page pool
+//Inputs	: lFd, the descriptor
+//Inputs	: ulSize and ulOffset, the byte range
+//Inputs	: blScan, true for a sequential scan
+//Outputs	: pvData, the bytes read
+//Return	: Number of bytes read, less than ulSize at the end of the file or
+//			  in case of an error
+//Notes		: A descriptor not attached, and the pages of a scan that are not
+//			  cached, are read directly
+//******************************************************************************
+static uint32 filePageCopy(int32 lFd, void *pvData, uint32 ulSize,
+						   uint32 ulOffset, bool blScan)
+{
+	const FILE_FRAME *pstFrame = NULL;
+	uint32 pulFrames[FILE_PAGE_RUN];
+	uint32 ulDone = 0;
+	uint32 ulPinned = 0;
+	uint32 ulMissing = 0;
+	uint32 ulCount = 0;
+	uint32 ulIndex = 0;
+	uint32 ulStart = 0;
+	uint32 ulLength = 0;
+	ssize_t lRead = 0;
+	bool blEnd = false;
+
+	while(ulDone < ulSize && blEnd != true)
+	{
+		ulStart = (ulOffset + ulDone) / FILE_PAGE_SIZE;
+		ulCount = (ulOffset + ulSize - 1) / FILE_PAGE_SIZE - ulStart + 1;
+		ulMissing = (blScan == true) ?
+					filePageCountMissing(lFd, ulStart, ulCount) : 0;
+		ulCount = (ulCount > FILE_PAGE_RUN) ? FILE_PAGE_RUN : ulCount;
+		ulPinned = 0;
+		if(ulMissing == 0)
+		{
+			ulPinned = filePagePinRun(lFd, ulStart, ulCount, blScan,
+									  pulFrames);
+		}
+
+		if(ulPinned == 0)
+		{
+			ulLength = ulSize - ulDone;
+			if(ulMissing > 0 &&
+			   (ulStart + ulMissing) * FILE_PAGE_SIZE < ulOffset + ulSize)
+			{
+				ulLength = (ulStart + ulMissing) * FILE_PAGE_SIZE -
+						   (ulOffset + ulDone);
+			}
+			lRead = pread(lFd, (uint8 *)pvData + ulDone, ulLength,
+						  ulOffset + ulDone);
+			ulDone += (lRead > 0) ? (uint32)lRead : 0;
+			blEnd = (lRead != (ssize_t)ulLength);
+		}
+
+		for(ulIndex = 0; ulIndex < ulPinned && blEnd != true; ulIndex++)
+		{
+			pstFrame = &pstFilePageFrames[pulFrames[ulIndex]];
+			ulStart = (ulOffset + ulDone) % FILE_PAGE_SIZE;
+			ulLength = FILE_PAGE_SIZE - ulStart;
+			ulLength = (ulLength > ulSize - ulDone) ? ulSize - ulDone :
+													  ulLength;
+			if(pstFrame->ulSize < ulStart + ulLength)
+			{
+				ulLength = (pstFrame->ulSize > ulStart) ?
+						   pstFrame->ulSize - ulStart : 0;
+				blEnd = true;
+			}
+			memcpy((uint8 *)pvData + ulDone, pucFilePageData +
+				   (size_t)pulFrames[ulIndex] * FILE_PAGE_SIZE + ulStart,
+				   ulLength);
+			ulDone += ulLength;
+		}
+		filePageRelease(pulFrames, ulPinned);
+	}
+
+	return ulDone;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the next buffer of a read ahead pipeline
+//Inputs	: pstReader, the reader, ulNext having been moved past the range
+//Inputs	: pstBuffer, the buffer to fill
+//Inputs	: ulOffset and ulSize, the byte range to read
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, if the range cannot be read completely
+//Notes		: Read through the page pool as a scan, hints the kernel to start
+//			  reading the buffers that follow
+//******************************************************************************
+static bool fileReaderFill(FILE_READER *pstReader, FILE_BUFFER *pstBuffer,
+						   uint32 ulOffset, uint32 ulSize)
+{
+	uint32 ulDone = 0;
+
+	TRACE_SPAN("file", "fileReaderFill");
+
+	posix_fadvise(pstReader->lFd, ulOffset + ulSize,
+				  pstReader->ulBufferSize * pstReader->ulDepth,
+				  POSIX_FADV_WILLNEED);
+	ulDone = filePageCopy(pstReader->lFd, pstBuffer->pucData, ulSize,
+						  ulOffset, true);
+	pstBuffer->ulSize = ulDone;
+
+	return (ulDone == ulSize);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To fill the buffers of a read ahead pipeline ahead of the
+//			  consumer
+//Inputs	: pvReader, the FILE_READER
+//Outputs	: None
+//Return	: NULL
+//Notes		: Runs as a thread entry, waits while every buffer is full and
+//			  stops at the end of the range, on error or when closed
+//******************************************************************************
+static void *fileReaderRun(void *pvReader)
+{
+	FILE_READER *pstReader = pvReader;
+	FILE_BUFFER *pstBuffer = NULL;
+	uint32 ulOffset = 0;
+	uint32 ulSize = 0;
+	bool blRead = true;
+
+	pthread_mutex_lock(&pstReader->stMutex);
+	while(pstReader->blStop != true && blRead == true &&
+		  pstReader->ulNext < pstReader->ulEnd)
+	{
+		pstBuffer = &pstReader->pstBuffers[pstReader->ulFill];
+		while(pstReader->blStop != true && pstBuffer->blFull == true)
+		{
+			pthread_cond_wait(&pstReader->stEmptied, &pstReader->stMutex);
+		}
+
+		if(pstReader->blStop != true)
+		{
+			ulOffset = pstReader->ulNext;
+			ulSize = pstReader->ulEnd - ulOffset;
+			if(ulSize > pstReader->ulBufferSize)
+			{
+				ulSize = pstReader->ulBufferSize;
+			}
+			pstReader->ulNext += ulSize;
+
+			// The buffer belongs to this thread until marked full
+			pthread_mutex_unlock(&pstReader->stMutex);
+			blRead = fileReaderFill(pstReader, pstBuffer, ulOffset, ulSize);
+			pthread_mutex_lock(&pstReader->stMutex);
+
+			pstReader->blError = (blRead != true);
+			pstBuffer->blFull = true;
+			pstReader->ulFill = (pstReader->ulFill + 1) % pstReader->ulDepth;
+			pthread_cond_signal(&pstReader->stFilled);
+		}
+	}
+	pstReader->blDone = true;
+	pthread_cond_signal(&pstReader->stFilled);
+	pthread_mutex_unlock(&pstReader->stMutex);
+
+	return NULL;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: Opens the file
+//Inputs	: Mode and name of the file to be opned
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: 
+//******************************************************************************
+FILE* fileOpen(const uint8 *pucFileName, const uint8 *pucMode)
+{
+	FILE *pstFile = NULL;
+
+	TRACE_SPAN("file", "fileOpen");
+
+	if(pucFileName != NULL)
+	{
+		if(pucMode != NULL)
+		{
+			pstFile = fopen((const char *)pucFileName, (const char *)pucMode);
+			if(pstFile == NULL)
+			{
+				printf("\n Unable to open the file");
+			}
+		}
+		else
+		{
+			printf("\n File mode missing, file not opened");
+		}
+	}
+	else
+	{
+		printf("\n File name missing, file not opened");
+	}
+	return pstFile;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: Close the file
+//Inputs	: Pointer to the file to be closed
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: 
+//******************************************************************************
+bool fileClose(FILE *pstFile)
+{
+	bool blReturn = false;
+	int8 cResult = 0;
+
+	TRACE_SPAN("file", "fileClose");
+
+	if(pstFile != NULL)
+	{
+		cResult = fclose(pstFile);
+		if(cResult == 0)
+		{
+			blReturn = true;
+		}
+		else
+		{
+			printf("\nFailed to close the file");
+		}
+	}
+	else
+	{
+		printf("\nUnable to close the file : Invalid file");
+	}
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write data to the file
+//Inputs	: pData, pointer to the data which is to be written to the file
+//Inputs	: ulDataSize, size of the data to be written to the file
+//Inputs	: ulDataCount, number of elements to be written to the file
+//Inputs	: pstFile, pointer to the file to which the data is written
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: 
+//******************************************************************************
+bool fileWrite(const void *pData, uint32 ulDataSize, uint32 ulDataCount,
+				FILE *pstFile)
+{
+	bool blReturn = false;
+	uint32 ucResult = 0;
+
+	TRACE_SPAN("file", "fileWrite");
+
+	if(pData != NULL)
+	{
+		if(ulDataSize !=0 && ulDataCount !=0)
+		{
+			ucResult = fwrite(pData,ulDataSize,ulDataCount,pstFile);
+			if(ucResult == ulDataCount)
+			{
+				blReturn = true;
+			}
+			else
+			{
+				printf("\nUnable to write to the file : Write error");
+			}
+		}
+		else
+		{
+			printf("\nUnable to write to the file : Invalid data parameters");
+		}
+
+	}
+	else
+	{
+		printf("\nUnable to write to the file : Invalid data");
+	}
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read data from the file
+//Inputs	: pData, pointer to the data in which the readed data is stored
+//Inputs	: ulDataSize, size of the data to be read from the file
+//Inputs	: ulDataCount, number of elements to be read from the file
+//Inputs	: pstFile, pointer to the file to which the data is written
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: 
+//******************************************************************************
+bool fileRead(void *pData, uint32 ulDataSize, uint32 ulDataCount,
+				FILE *pstFile)
+{
+	bool blReturn = false;
+	uint32 ucResult = 0;
+
+	TRACE_SPAN("file", "fileRead");
+
+	if(pData != NULL)
+	{
+		if(ulDataSize !=0 && ulDataCount !=0)
+		{
+			ucResult = fread(pData,ulDataSize,ulDataCount,pstFile);
+			
+			if(ucResult == ulDataCount)
+			{
+				blReturn = true;
+			}
+		}
+		else
+		{
+			printf("\nUnable to read from the file : Invalid data parameters");
+		}
+
+	}
+	else
+	{
+		printf("\nUnable to read from the file : Invalid data");
+	}
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To build the name of a file derived from a base file name
+//Inputs	: pucPath, buffer of FILE_PATH_MAX_SIZE bytes for the result
+//Inputs	: pucBaseName, name of the base file
+//Inputs	: pucSuffix, suffix appended to the base file name
+//Outputs	: pucPath, the derived file name
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Used for shard, index and other side files of the data file
+//******************************************************************************
+bool fileBuildPath(uint8 *pucPath, const uint8 *pucBaseName,
+					const uint8 *pucSuffix)
+{
+	bool blReturn = false;
+	int32 lResult = 0;
+
+	if(pucPath != NULL && pucBaseName != NULL && pucSuffix != NULL)
+	{
+		lResult = snprintf((char *)pucPath, FILE_PATH_MAX_SIZE, "%s%s",
+							(const char *)pucBaseName,
+							(const char *)pucSuffix);
+		if(lResult > 0 && lResult < FILE_PATH_MAX_SIZE)
+		{
+			blReturn = true;
+		}
+		else
+		{
+			printf("\nUnable to build the file name : Name too long");
+		}
+	}
+	else
+	{
+		printf("\nUnable to build the file name : Invalid parameters");
+	}
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To check whether a file exists
+//Inputs	: pucFileName, name of the file to be checked
+//Outputs	: None
+//Return	: True, if the file exists
+//Return	: False, if the file does not exist
+//Notes		: 
+//******************************************************************************
+bool fileExists(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+
+	if(pucFileName != NULL)
+	{
+		blReturn = (access((const char *)pucFileName, F_OK) == 0);
+	}
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the identity of a file
+//Inputs	: pucFileName, name of the file
+//Outputs	: pstIdentity, inode, size and modification time of the file
+//Return	: None
+//Notes		: A missing file has an all zero identity
+//******************************************************************************
+void fileGetIdentity(const uint8 *pucFileName, FILE_IDENTITY *pstIdentity)
+{
+	struct stat stStatus;
+
+	memset(pstIdentity, 0, sizeof(FILE_IDENTITY));
+	if(pucFileName != NULL && stat((const char *)pucFileName, &stStatus) == 0)
+	{
+		fileFillIdentity(&stStatus, pstIdentity);
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the identity of an open file
+//Inputs	: pstFile, the open file
+//Outputs	: pstIdentity, inode, size and modification time of the file
+//Return	: None
+//Notes		: Still the identity of the opened file after its name has been
+//			  given to a new file
+//******************************************************************************
+void fileGetOpenIdentity(FILE *pstFile, FILE_IDENTITY *pstIdentity)
+{
+	struct stat stStatus;
+
+	memset(pstIdentity, 0, sizeof(FILE_IDENTITY));
+	if(pstFile != NULL && fstat(fileno(pstFile), &stStatus) == 0)
+	{
+		fileFillIdentity(&stStatus, pstIdentity);
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compare two file identities
+//Inputs	: pstFirst and pstSecond, the identities
+//Outputs	: None
+//Return	: True, if the identities are the same
+//Return	: False, if the identities differ
+//Notes		: 
+//******************************************************************************
+bool fileSameIdentity(const FILE_IDENTITY *pstFirst,
+					  const FILE_IDENTITY *pstSecond)
+{
+	return (pstFirst->ulInode == pstSecond->ulInode &&
+			pstFirst->ulSize == pstSecond->ulSize &&
+			pstFirst->ulModified == pstSecond->ulModified);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To start reading a byte range through a read ahead pipeline
+//Inputs	: lFd, the open file
+//Inputs	: ulStart and ulEnd, the byte range
+//Inputs	: ulBufferSize, size of a buffer, a multiple of the record size
+//			  keeps records whole within a buffer
+//Inputs	: ulDepth, number of buffers, 2 to read one buffer while the
+//			  other is consumed
+//Outputs	: pstReader, the reader, to be closed with fileReaderClose()
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A range held by a single buffer is read by the consumer itself,
+//			  as is every buffer when no thread can be started
+//******************************************************************************
+bool fileReaderOpen(FILE_READER *pstReader, int32 lFd, uint32 ulStart,
+					uint32 ulEnd, uint32 ulBufferSize, uint32 ulDepth)
+{
+	bool blReturn = false;
+	uint32 ulBuffer = 0;
+
+	if(pstReader != NULL && ulBufferSize > 0 && ulStart <= ulEnd)
+	{
+		memset(pstReader, 0, sizeof(FILE_READER));
+		pstReader->lFd = lFd;
+		pstReader->ulNext = ulStart;
+		pstReader->ulEnd = ulEnd;
+		pstReader->ulBufferSize = ulBufferSize;
+		pstReader->ulDepth = (ulDepth < 1) ? 1 :
+							 (ulDepth > FILE_READER_MAX_DEPTH) ?
+							 FILE_READER_MAX_DEPTH : ulDepth;
+		if(ulEnd - ulStart <= ulBufferSize)
+		{
+			pstReader->ulDepth = 1;
+		}
+
+		pstReader->pstBuffers = calloc(pstReader->ulDepth,
+									   sizeof(FILE_BUFFER));
+		blReturn = (pstReader->pstBuffers != NULL);
+		for(ulBuffer = 0; ulBuffer < pstReader->ulDepth && blReturn == true;
+			ulBuffer++)
+		{
+			pstReader->pstBuffers[ulBuffer].pucData = malloc(ulBufferSize);
+			blReturn = (pstReader->pstBuffers[ulBuffer].pucData != NULL);
+		}
+
+		if(blReturn == true)
+		{
+			pstReader->blPaged = filePageAttach(lFd);
+			posix_fadvise(lFd, ulStart, ulEnd - ulStart,
+						  POSIX_FADV_SEQUENTIAL);
+			pthread_mutex_init(&pstReader->stMutex, NULL);
+			pthread_cond_init(&pstReader->stFilled, NULL);
+			pthread_cond_init(&pstReader->stEmptied, NULL);
+			pstReader->blThread = (pstReader->ulDepth > 1 &&
+								   pthread_create(&pstReader->stThread, NULL,
+												  fileReaderRun,
+												  pstReader) == 0);
+		}
+		else
+		{
+			for(ulBuffer = 0; pstReader->pstBuffers != NULL &&
+				ulBuffer < pstReader->ulDepth; ulBuffer++)
+			{
+				free(pstReader->pstBuffers[ulBuffer].pucData);
+			}
+			free(pstReader->pstBuffers);
+			pstReader->pstBuffers = NULL;
+			printf("\nUnable to start reading ahead : Out of memory");
+		}
+	}
+	else
+	{
+		printf("\nUnable to start reading ahead : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To take the next buffer of a read ahead pipeline
+//Inputs	: pstReader, the reader
+//Outputs	: ppucData and pulSize, the content of the buffer, valid until the
+//			  next call
+//Return	: True, if a buffer has been taken
+//Return	: False, at the end of the range or after a read error
+//Notes		: Gives the previous buffer back to the reading thread first
+//******************************************************************************
+bool fileReaderNext(FILE_READER *pstReader, const uint8 **ppucData,
+					uint32 *pulSize)
+{
+	bool blReturn = false;
+	FILE_BUFFER *pstBuffer = NULL;
+	uint32 ulSize = 0;
+
+	if(pstReader != NULL && pstReader->pstBuffers != NULL &&
+	   ppucData != NULL && pulSize != NULL)
+	{
+		pthread_mutex_lock(&pstReader->stMutex);
+		if(pstReader->blHolding == true)
+		{
+			pstReader->pstBuffers[pstReader->ulConsume].blFull = false;
+			pstReader->ulConsume = (pstReader->ulConsume + 1) %
+								   pstReader->ulDepth;
+			pstReader->blHolding = false;
+			pthread_cond_signal(&pstReader->stEmptied);
+		}
+
+		pstBuffer = &pstReader->pstBuffers[pstReader->ulConsume];
+		if(pstReader->blThread == true)
+		{
+			while(pstBuffer->blFull != true && pstReader->blDone != true)
+			{
+				pthread_cond_wait(&pstReader->stFilled, &pstReader->stMutex);
+			}
+		}
+		else if(pstReader->blError != true &&
+				pstReader->ulNext < pstReader->ulEnd)
+		{
+			ulSize = pstReader->ulEnd - pstReader->ulNext;
+			if(ulSize > pstReader->ulBufferSize)
+			{
+				ulSize = pstReader->ulBufferSize;
+			}
+			pstReader->blError = (fileReaderFill(pstReader, pstBuffer,
+												 pstReader->ulNext,
+												 ulSize) != true);
+			pstReader->ulNext += ulSize;
+			pstBuffer->blFull = true;
+		}
 
-//***************************** Local Constants ********************************
+		// A buffer that failed to fill ends the range
+		if(pstBuffer->blFull == true && pstBuffer->ulSize > 0)
+		{
+			*ppucData = pstBuffer->pucData;
+			*pulSize = pstBuffer->ulSize;
+			pstReader->blHolding = true;
+			blReturn = true;
+		}
+		pthread_mutex_unlock(&pstReader->stMutex);
+	}
 
-//***************************** Local Variables ********************************
+	return blReturn;
+}
 
-//****************************** Local Functions *******************************
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To stop a read ahead pipeline and release its buffers
+//Inputs	: pstReader, the reader
+//Outputs	: None
+//Return	: True, if every read succeeded
+//Return	: False, after a read error
+//Notes		: The file stays open, detached from the page pool
+//******************************************************************************
+bool fileReaderClose(FILE_READER *pstReader)
+{
+	bool blReturn = false;
+	uint32 ulBuffer = 0;
+
+	if(pstReader != NULL && pstReader->pstBuffers != NULL)
+	{
+		if(pstReader->blThread == true)
+		{
+			pthread_mutex_lock(&pstReader->stMutex);
+			pstReader->blStop = true;
+			pthread_cond_signal(&pstReader->stEmptied);
+			pthread_mutex_unlock(&pstReader->stMutex);
+			pthread_join(pstReader->stThread, NULL);
+		}
+		pthread_mutex_destroy(&pstReader->stMutex);
+		pthread_cond_destroy(&pstReader->stFilled);
+		pthread_cond_destroy(&pstReader->stEmptied);
+
+		for(ulBuffer = 0; ulBuffer < pstReader->ulDepth; ulBuffer++)
+		{
+			free(pstReader->pstBuffers[ulBuffer].pucData);
+		}
+		free(pstReader->pstBuffers);
+		pstReader->pstBuffers = NULL;
+		if(pstReader->blPaged == true)
+		{
+			filePageDetach(pstReader->lFd);
+		}
+		blReturn = (pstReader->blError != true);
+	}
+
+	return blReturn;
+}
 
 //******************************.FUNCTION_HEADER.*******************************
-//Purpose	: Opens the file
-//Inputs	: Mode and name of the file to be opned
+//Purpose	: To set the memory budget of the page pool of the process
+//Inputs	: ulBudget, bytes of page frames
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, if the budget is out of range or a page is pinned
+//Notes		: The dirty pages are written back and the cached pages dropped,
+//			  the frames are allocated again at the next attach
+//******************************************************************************
+bool filePageConfigure(uint32 ulBudget)
+{
+	bool blReturn = false;
+	uint32 ulFrame = 0;
+
+	pthread_mutex_lock(&stFilePageLock);
+	blReturn = (ulBudget >= FILE_PAGE_MIN_BUDGET &&
+				ulBudget <= FILE_PAGE_MAX_BUDGET);
+	for(ulFrame = 0; ulFrame < ulFilePageFrameCount && blReturn == true &&
+		ulBudget != ulFilePageBudget; ulFrame++)
+	{
+		blReturn = (pstFilePageFrames[ulFrame].ulPins == 0 &&
+					(pstFilePageFrames[ulFrame].blDirty != true ||
+					 filePageWriteBack(ulFrame) == true));
+	}
+
+	if(blReturn == true && ulBudget != ulFilePageBudget)
+	{
+		free(pucFilePageData);
+		free(pstFilePageFrames);
+		free(pulFilePageBuckets);
+		pucFilePageData = NULL;
+		pstFilePageFrames = NULL;
+		pulFilePageBuckets = NULL;
+		ulFilePageFrameCount = 0;
+		ulFilePageBudget = ulBudget;
+	}
+	pthread_mutex_unlock(&stFilePageLock);
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to set the page pool budget to %lu bytes", ulBudget);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the page pool budget of the device data
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: Bytes of page frames of the processes using the data
+//Notes		: FILE_PAGE_DEFAULT_BUDGET unless set by filePageSetBudget()
+//******************************************************************************
+uint32 filePageGetBudget(const uint8 *pucFileName)
+{
+	uint32 ulBudget = 0;
+	FILE *pstFile = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(fileBuildPath(pucPath, pucFileName, FILE_PAGE_SUFFIX) == true &&
+	   fileExists(pucPath) == true)
+	{
+		pstFile = fileOpen(pucPath, FILE_READ_MODE);
+	}
+
+	if(pstFile == NULL ||
+	   fileRead(&ulBudget, sizeof(ulBudget), READ_COUNT, pstFile) != true ||
+	   ulBudget < FILE_PAGE_MIN_BUDGET || ulBudget > FILE_PAGE_MAX_BUDGET)
+	{
+		ulBudget = FILE_PAGE_DEFAULT_BUDGET;
+	}
+
+	if(pstFile != NULL)
+	{
+		fileClose(pstFile);
+	}
+
+	return ulBudget;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To set the page pool budget of the device data
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulBudget, bytes of page frames
 //Outputs	: None
 //Return	: True, at time of successful execution
 //Return	: False, in case of an error
-//Notes		: 
+//Notes		: Used by the processes started afterwards
 //******************************************************************************
-FILE* fileOpen(const uint8 *pucFileName, const uint8 *pucMode)
+bool filePageSetBudget(const uint8 *pucFileName, uint32 ulBudget)
 {
+	bool blReturn = false;
 	FILE *pstFile = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
 
-	if(pucFileName != NULL)
+	if(pucFileName != NULL && ulBudget >= FILE_PAGE_MIN_BUDGET &&
+	   ulBudget <= FILE_PAGE_MAX_BUDGET &&
+	   fileBuildPath(pucPath, pucFileName, FILE_PAGE_SUFFIX) == true)
 	{
-		if(pucMode != NULL)
+		pstFile = fileOpen(pucPath, FILE_WRITE_MODE);
+		if(pstFile != NULL)
 		{
-			pstFile = fopen((const char *)pucFileName, (const char *)pucMode);
-			if(pstFile == NULL)
+			blReturn = fileWrite(&ulBudget, sizeof(ulBudget), WRITE_COUNT,
+								 pstFile);
+			if(fileClose(pstFile) != true)
 			{
-				printf("\n Unable to open the file");
+				blReturn = false;
 			}
 		}
-		else
-		{
-			printf("\n File mode missing, file not opened");
-		}
 	}
-	else
+
+	if(blReturn != true)
 	{
-		printf("\n File name missing, file not opened");
+		printf("\nUnable to set the page pool budget to %lu bytes, expected"
+			   " between %d and %lu", ulBudget, FILE_PAGE_MIN_BUDGET,
+			   FILE_PAGE_MAX_BUDGET);
 	}
-	return pstFile;
+
+	return blReturn;
 }
 
 //******************************.FUNCTION_HEADER.*******************************
-//Purpose	: Close the file
-//Inputs	: Pointer to the file to be closed
+//Purpose	: To read a file through the page pool
+//Inputs	: lFd, an open descriptor of the file
 //Outputs	: None
-//Return	: True, at time of successful execution
-//Return	: False, in case of an error
-//Notes		: 
+//Return	: True, if the descriptor is attached
+//Return	: False, if the file cannot be cached, it is then read directly
+//Notes		: The pages cached are dropped when the file changed since they
+//			  were read. Every attach is followed by a filePageDetach() or a
+//			  filePageClose() before the descriptor is closed.
 //******************************************************************************
-bool fileClose(FILE *pstFile)
+bool filePageAttach(int32 lFd)
 {
 	bool blReturn = false;
-	int8 cResult = 0;
+	struct stat stStatus;
+	FILE_IDENTITY stIdentity = {0};
+	uint32 ulFile = 0;
 
-	if(pstFile != NULL)
+	if(lFd >= 0 && lFd < FILE_PAGE_MAX_FDS && fstat(lFd, &stStatus) == 0 &&
+	   S_ISREG(stStatus.st_mode))
 	{
-		cResult = fclose(pstFile);
-		if(cResult == 0)
+		fileFillIdentity(&stStatus, &stIdentity);
+		pthread_mutex_lock(&stFilePageLock);
+		if(filePageSetup() == true)
 		{
-			blReturn = true;
+			ulFile = filePageTrack(stStatus.st_dev, &stIdentity);
 		}
-		else
+
+		if(ulFile != 0)
 		{
-			printf("\nFailed to close the file");
+			if(pstFilePageFds[lFd].ulCount == 0)
+			{
+				pstFilePageFds[lFd].ulFile = ulFile;
+				pstFilePageFiles[ulFile - 1].ulAttached++;
+			}
+			pstFilePageFds[lFd].ulCount++;
+			blReturn = true;
 		}
+		pthread_mutex_unlock(&stFilePageLock);
 	}
-	else
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To drop the cached pages of a file changed by another process
+//Inputs	: lFd, an attached descriptor of the file
+//Outputs	: None
+//Return	: True, if the descriptor is attached
+//Return	: False, if it is not
+//Notes		: Called where a reader has to see the current content, the
+//			  cached pages are kept while the file is unchanged
+//******************************************************************************
+bool filePageRefresh(int32 lFd)
+{
+	bool blReturn = false;
+	struct stat stStatus;
+	FILE_IDENTITY stIdentity = {0};
+
+	if(lFd >= 0 && lFd < FILE_PAGE_MAX_FDS && fstat(lFd, &stStatus) == 0)
 	{
-		printf("\nUnable to close the file : Invalid file");
+		fileFillIdentity(&stStatus, &stIdentity);
+		pthread_mutex_lock(&stFilePageLock);
+		if(filePageGetEpoch(lFd) != FILE_PAGE_NO_EPOCH)
+		{
+			filePageTrack(stStatus.st_dev, &stIdentity);
+			blReturn = true;
+		}
+		pthread_mutex_unlock(&stFilePageLock);
 	}
+
 	return blReturn;
 }
 
 //******************************.FUNCTION_HEADER.*******************************
-//Purpose	: To write data to the file
-//Inputs	: pData, pointer to the data which is to be written to the file
-//Inputs	: ulDataSize, size of the data to be written to the file
-//Inputs	: ulDataCount, number of elements to be written to the file
-//Inputs	: pstFile, pointer to the file to which the data is written
+//Purpose	: To pin a page of a file in the pool
+//Inputs	: lFd, an attached descriptor of the file
+//Inputs	: ulPage, number of the page, offset / FILE_PAGE_SIZE
+//Outputs	: pulSize, bytes of the page within the file
+//Return	: The content of the page, read only, until filePageUnpin()
+//Return	: NULL, if the descriptor is not attached or in case of an error
+//Notes		: A pinned page is never evicted
+//******************************************************************************
+const uint8 *filePagePin(int32 lFd, uint32 ulPage, uint32 *pulSize)
+{
+	const uint8 *pucPage = NULL;
+	uint32 ulFrame = 0;
+
+	if(pulSize != NULL &&
+	   filePagePinRun(lFd, ulPage, 1, false, &ulFrame) == 1)
+	{
+		pucPage = pucFilePageData + (size_t)ulFrame * FILE_PAGE_SIZE;
+		*pulSize = pstFilePageFrames[ulFrame].ulSize;
+	}
+
+	return pucPage;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To unpin a page
+//Inputs	: pucPage, the content returned by filePagePin()
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+void filePageUnpin(const uint8 *pucPage)
+{
+	uint32 ulFrame = 0;
+
+	if(pucPage != NULL)
+	{
+		ulFrame = (pucPage - pucFilePageData) / FILE_PAGE_SIZE;
+		filePageRelease(&ulFrame, 1);
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read a byte range of a file through the page pool
+//Inputs	: lFd, the descriptor, read directly when not attached
+//Inputs	: ulSize and ulOffset, the byte range
+//Outputs	: pvData, the bytes read
+//Return	: True, if the whole range has been read
+//Return	: False, past the end of the file or in case of an error
+//Notes		: Replaces pread(), the pages read are referenced
+//******************************************************************************
+bool filePageRead(int32 lFd, void *pvData, uint32 ulSize, uint32 ulOffset)
+{
+	return (pvData != NULL &&
+			filePageCopy(lFd, pvData, ulSize, ulOffset, false) == ulSize);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read a byte range of a file through the page pool as part of
+//			  a sequential scan
+//Inputs	: lFd, the descriptor, read directly when not attached
+//Inputs	: ulSize and ulOffset, the byte range
+//Outputs	: pvData, the bytes read
+//Return	: True, if the whole range has been read
+//Return	: False, past the end of the file or in case of an error
+//Notes		: The pages cached are copied without being referenced, the
+//			  others are read directly and not cached, so a scan larger than
+//			  the pool does not evict the hot pages
+//******************************************************************************
+bool filePageScan(int32 lFd, void *pvData, uint32 ulSize, uint32 ulOffset)
+{
+	return (pvData != NULL &&
+			filePageCopy(lFd, pvData, ulSize, ulOffset, true) == ulSize);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write a byte range of a file through the page pool
+//Inputs	: lFd, the descriptor, written directly when not attached
+//Inputs	: pvData, the bytes to be written
+//Inputs	: ulSize and ulOffset, the byte range
 //Outputs	: None
 //Return	: True, at time of successful execution
 //Return	: False, in case of an error
-//Notes		: 
+//Notes		: Replaces pwrite(). The pages are changed in the pool and only
+//			  written to the file when evicted, flushed or detached.
 //******************************************************************************
-bool fileWrite(const void *pData, uint32 ulDataSize, uint32 ulDataCount,
-				FILE *pstFile)
+bool filePageWrite(int32 lFd, const void *pvData, uint32 ulSize,
+				   uint32 ulOffset)
 {
-	bool blReturn = false;
-	uint32 ucResult = 0;
+	bool blReturn = (pvData != NULL);
+	FILE_FRAME *pstFrame = NULL;
+	uint32 ulDone = 0;
+	uint32 ulFrame = 0;
+	uint32 ulStart = 0;
+	uint32 ulLength = 0;
 
-	if(pData != NULL)
+	pthread_mutex_lock(&stFilePageLock);
+	if(blReturn == true && filePageGetEpoch(lFd) == FILE_PAGE_NO_EPOCH)
 	{
-		if(ulDataSize !=0 && ulDataCount !=0)
+		blReturn = (pwrite(lFd, pvData, ulSize, ulOffset) == (ssize_t)ulSize);
+		ulDone = ulSize;
+	}
+	pthread_mutex_unlock(&stFilePageLock);
+
+	while(ulDone < ulSize && blReturn == true)
+	{
+		blReturn = (filePagePinRun(lFd, (ulOffset + ulDone) / FILE_PAGE_SIZE,
+								   1, false, &ulFrame) == 1);
+		if(blReturn == true)
 		{
-			ucResult = fwrite(pData,ulDataSize,ulDataCount,pstFile);
-			if(ucResult == ulDataCount)
-			{
-				blReturn = true;
-			}
-			else
+			ulStart = (ulOffset + ulDone) % FILE_PAGE_SIZE;
+			ulLength = FILE_PAGE_SIZE - ulStart;
+			ulLength = (ulLength > ulSize - ulDone) ? ulSize - ulDone :
+													  ulLength;
+
+			pthread_mutex_lock(&stFilePageLock);
+			pstFrame = &pstFilePageFrames[ulFrame];
+			memcpy(pucFilePageData + (size_t)ulFrame * FILE_PAGE_SIZE +
+				   ulStart, (const uint8 *)pvData + ulDone, ulLength);
+			if(pstFrame->ulSize < ulStart + ulLength)
 			{
-				printf("\nUnable to write to the file : Write error");
+				pstFrame->ulSize = ulStart + ulLength;
 			}
+			pstFrame->blDirty = true;
+			pstFrame->lFd = lFd;
+			pstFrame->ulPins--;
+			pthread_cond_broadcast(&stFilePageChanged);
+			pthread_mutex_unlock(&stFilePageLock);
+			ulDone += ulLength;
 		}
-		else
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write the dirty pages of a file back
+//Inputs	: lFd, an attached descriptor of the file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, if a page cannot be written
+//Notes		: The pages stay cached. Writers flush before the changes may be
+//			  seen by other processes.
+//******************************************************************************
+bool filePageFlush(int32 lFd)
+{
+	bool blReturn = true;
+	uint32 ulEpoch = FILE_PAGE_NO_EPOCH;
+	uint32 ulFrame = 0;
+
+	pthread_mutex_lock(&stFilePageLock);
+	ulEpoch = filePageGetEpoch(lFd);
+	for(ulFrame = 0; ulFrame < ulFilePageFrameCount &&
+		ulEpoch != FILE_PAGE_NO_EPOCH; ulFrame++)
+	{
+		if(pstFilePageFrames[ulFrame].ulEpoch == ulEpoch &&
+		   pstFilePageFrames[ulFrame].blDirty == true &&
+		   filePageWriteBack(ulFrame) != true)
 		{
-			printf("\nUnable to write to the file : Invalid data parameters");
+			blReturn = false;
 		}
-
 	}
-	else
+	if(ulEpoch != FILE_PAGE_NO_EPOCH)
 	{
-		printf("\nUnable to write to the file : Invalid data");
+		filePageStamp(lFd);
 	}
+	pthread_mutex_unlock(&stFilePageLock);
+
 	return blReturn;
 }
 
 //******************************.FUNCTION_HEADER.*******************************
-//Purpose	: To read data from the file
-//Inputs	: pData, pointer to the data in which the readed data is stored
-//Inputs	: ulDataSize, size of the data to be read from the file
-//Inputs	: ulDataCount, number of elements to be read from the file
-//Inputs	: pstFile, pointer to the file to which the data is written
+//Purpose	: To truncate a file and its cached pages
+//Inputs	: lFd, the descriptor, truncated directly when not attached
+//Inputs	: ulSize, the new size of the file
 //Outputs	: None
 //Return	: True, at time of successful execution
 //Return	: False, in case of an error
-//Notes		: 
+//Notes		: Replaces ftruncate(), the pages past the end are dropped
 //******************************************************************************
-bool fileRead(void *pData, uint32 ulDataSize, uint32 ulDataCount,
-				FILE *pstFile)
+bool filePageTruncate(int32 lFd, uint32 ulSize)
 {
 	bool blReturn = false;
-	uint32 ucResult = 0;
+	FILE_FRAME *pstFrame = NULL;
+	uint32 ulEpoch = FILE_PAGE_NO_EPOCH;
+	uint32 ulFrame = 0;
+	uint32 ulStart = 0;
 
-	if(pData != NULL)
+	pthread_mutex_lock(&stFilePageLock);
+	ulEpoch = filePageGetEpoch(lFd);
+	for(ulFrame = 0; ulFrame < ulFilePageFrameCount &&
+		ulEpoch != FILE_PAGE_NO_EPOCH; ulFrame++)
 	{
-		if(ulDataSize !=0 && ulDataCount !=0)
+		pstFrame = &pstFilePageFrames[ulFrame];
+		ulStart = pstFrame->ulPage * FILE_PAGE_SIZE;
+		if(pstFrame->ulEpoch == ulEpoch && ulStart + pstFrame->ulSize > ulSize)
 		{
-			ucResult = fread(pData,ulDataSize,ulDataCount,pstFile);
-			
-			if(ucResult == ulDataCount)
+			pstFrame->ulSize = (ulStart < ulSize) ? ulSize - ulStart : 0;
+			memset(pucFilePageData + (size_t)ulFrame * FILE_PAGE_SIZE +
+				   pstFrame->ulSize, 0, FILE_PAGE_SIZE - pstFrame->ulSize);
+			if(pstFrame->ulSize == 0 && pstFrame->ulPins == 0)
 			{
-				blReturn = true;
+				filePageUnlink(ulFrame);
 			}
 		}
-		else
+	}
+	blReturn = (ftruncate(lFd, ulSize) == 0);
+	if(ulEpoch != FILE_PAGE_NO_EPOCH)
+	{
+		filePageStamp(lFd);
+	}
+	pthread_mutex_unlock(&stFilePageLock);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To stop reading a file through the page pool
+//Inputs	: lFd, the descriptor
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, if a dirty page cannot be written
+//Notes		: The pages made dirty through the descriptor are written back,
+//			  the clean pages stay cached for the next attach of the file
+//******************************************************************************
+bool filePageDetach(int32 lFd)
+{
+	bool blReturn = true;
+	bool blWritten = false;
+	uint32 ulEpoch = FILE_PAGE_NO_EPOCH;
+	uint32 ulFrame = 0;
+
+	pthread_mutex_lock(&stFilePageLock);
+	ulEpoch = filePageGetEpoch(lFd);
+	for(ulFrame = 0; ulFrame < ulFilePageFrameCount &&
+		ulEpoch != FILE_PAGE_NO_EPOCH; ulFrame++)
+	{
+		if(pstFilePageFrames[ulFrame].ulEpoch == ulEpoch &&
+		   pstFilePageFrames[ulFrame].blDirty == true &&
+		   pstFilePageFrames[ulFrame].lFd == lFd)
 		{
-			printf("\nUnable to read from the file : Invalid data parameters");
+			blReturn = (filePageWriteBack(ulFrame) == true &&
+						blReturn == true);
+			blWritten = true;
 		}
+	}
 
+	if(ulEpoch != FILE_PAGE_NO_EPOCH)
+	{
+		if(blWritten == true)
+		{
+			filePageStamp(lFd);
+		}
+		if(--pstFilePageFds[lFd].ulCount == 0)
+		{
+			pstFilePageFiles[pstFilePageFds[lFd].ulFile - 1].ulAttached--;
+			pstFilePageFds[lFd].ulFile = 0;
+		}
 	}
-	else
+	pthread_mutex_unlock(&stFilePageLock);
+
+	if(blReturn != true)
 	{
-		printf("\nUnable to read from the file : Invalid data");
+		printf("\nUnable to write the cached pages back");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To detach a descriptor from the page pool and close it
+//Inputs	: lFd, the descriptor
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Replaces close() for the descriptors attached
+//******************************************************************************
+bool filePageClose(int32 lFd)
+{
+	bool blReturn = false;
+
+	blReturn = filePageDetach(lFd);
+	if(close(lFd) != 0)
+	{
+		blReturn = false;
 	}
+
 	return blReturn;
 }
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the counters of the page pool
+//Inputs	: None
+//Outputs	: pstStats, the counters since the process started
+//Return	: None
+//Notes		:
+//******************************************************************************
+void filePageGetStats(FILE_PAGE_STATS *pstStats)
+{
+	uint32 ulFrame = 0;
+
+	pthread_mutex_lock(&stFilePageLock);
+	*pstStats = stFilePageStats;
+	pstStats->ulBudget = ulFilePageBudget;
+	pstStats->ulFrameCount = ulFilePageBudget / FILE_PAGE_SIZE;
+	for(ulFrame = 0; ulFrame < ulFilePageFrameCount; ulFrame++)
+	{
+		pstStats->ulUsed += (pstFilePageFrames[ulFrame].ulEpoch !=
+							 FILE_PAGE_NO_EPOCH);
+		pstStats->ulPinned += (pstFilePageFrames[ulFrame].ulPins > 0);
+		pstStats->ulDirty += (pstFilePageFrames[ulFrame].blDirty == true);
+	}
+	pthread_mutex_unlock(&stFilePageLock);
+}
 // EOF
\ No newline at end of file
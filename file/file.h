@@ -4,7 +4,9 @@
 //******************************************************************************
 //
 // Summary	: Handle options related to file handling
-// Note		: Feature to open, close and write to file
+// Note		: Feature to open, close and write to file, and a page pool
+//			  keeping the hot pages of the data, index and keys files under
+//			  a fixed memory budget
 //
 //******************************************************************************
 
@@ -14,13 +16,77 @@
 //******************************* Include Files ********************************
 #include <stdio.h>
 #include <stdbool.h>
+#include <pthread.h>
 #include "customTypes.h"
+#include "constants.h"
 //******************************* Global Types *********************************
+// Identity of a file content, changed by any write, rename or truncation
+typedef struct _FILE_IDENTITY_
+{
+	uint32 ulInode;
+	uint32 ulSize;
+	uint32 ulModified;
+} FILE_IDENTITY;
+
+// A buffer of a read ahead pipeline, full when filled and not yet consumed
+typedef struct _FILE_BUFFER_
+{
+	uint8 *pucData;
+	uint32 ulSize;
+	bool blFull;
+} FILE_BUFFER;
+
+// Sequential reader of a byte range, a background thread fills the next
+// buffers while the current one is consumed
+typedef struct _FILE_READER_
+{
+	int32 lFd;
+	uint32 ulNext;
+	uint32 ulEnd;
+	uint32 ulBufferSize;
+	uint32 ulDepth;
+	FILE_BUFFER *pstBuffers;
+	uint32 ulFill;
+	uint32 ulConsume;
+	bool blHolding;
+	bool blStop;
+	bool blDone;
+	bool blError;
+	bool blThread;
+	bool blPaged;
+	pthread_t stThread;
+	pthread_mutex_t stMutex;
+	pthread_cond_t stFilled;
+	pthread_cond_t stEmptied;
+} FILE_READER;
+
+// Counters of the page pool of the process
+typedef struct _FILE_PAGE_STATS_
+{
+	uint32 ulBudget;
+	uint32 ulFrameCount;
+	uint32 ulUsed;
+	uint32 ulPinned;
+	uint32 ulDirty;
+	uint32 ulHits;
+	uint32 ulMisses;
+	uint32 ulEvictions;
+	uint32 ulWriteBacks;
+} FILE_PAGE_STATS;
 
 //***************************** Global Constants *******************************
 #define FILE_READ_MODE "rb"
 #define FILE_APPEND_MODE "ab"
 #define FILE_WRITE_MODE "wb"
+#define FILE_READ_TEXT_MODE "r"
+#define FILE_READER_BUFFER_SIZE		(1048576)
+#define FILE_READER_DEFAULT_DEPTH	(2)
+#define FILE_READER_MAX_DEPTH		(16)
+#define FILE_PAGE_SIZE				(4096)
+#define FILE_PAGE_DEFAULT_BUDGET	(16777216)
+#define FILE_PAGE_MIN_BUDGET		(131072)
+#define FILE_PAGE_MAX_BUDGET		(4294967296UL)
+#define FILE_PAGE_SUFFIX			(".pages")
 //***************************** Global Variables *******************************
 
 //**************************** Forward Declarations ****************************
@@ -30,6 +96,34 @@ bool fileWrite(const void *pData, uint32 ulDataSize, uint32 ulDataCount,
 				FILE *pstFile);
 bool fileRead(void *pData, uint32 ulDataSize, uint32 ulDataCount,
 				FILE *pstFile);
+bool fileBuildPath(uint8 *pucPath, const uint8 *pucBaseName,
+					const uint8 *pucSuffix);
+bool fileExists(const uint8 *pucFileName);
+void fileGetIdentity(const uint8 *pucFileName, FILE_IDENTITY *pstIdentity);
+void fileGetOpenIdentity(FILE *pstFile, FILE_IDENTITY *pstIdentity);
+bool fileSameIdentity(const FILE_IDENTITY *pstFirst,
+					  const FILE_IDENTITY *pstSecond);
+bool fileReaderOpen(FILE_READER *pstReader, int32 lFd, uint32 ulStart,
+					uint32 ulEnd, uint32 ulBufferSize, uint32 ulDepth);
+bool fileReaderNext(FILE_READER *pstReader, const uint8 **ppucData,
+					uint32 *pulSize);
+bool fileReaderClose(FILE_READER *pstReader);
+bool filePageConfigure(uint32 ulBudget);
+uint32 filePageGetBudget(const uint8 *pucFileName);
+bool filePageSetBudget(const uint8 *pucFileName, uint32 ulBudget);
+bool filePageAttach(int32 lFd);
+bool filePageRefresh(int32 lFd);
+const uint8 *filePagePin(int32 lFd, uint32 ulPage, uint32 *pulSize);
+void filePageUnpin(const uint8 *pucPage);
+bool filePageRead(int32 lFd, void *pvData, uint32 ulSize, uint32 ulOffset);
+bool filePageScan(int32 lFd, void *pvData, uint32 ulSize, uint32 ulOffset);
+bool filePageWrite(int32 lFd, const void *pvData, uint32 ulSize,
+				   uint32 ulOffset);
+bool filePageFlush(int32 lFd);
+bool filePageTruncate(int32 lFd, uint32 ulSize);
+bool filePageDetach(int32 lFd);
+bool filePageClose(int32 lFd);
+void filePageGetStats(FILE_PAGE_STATS *pstStats);
 
 #endif // _FILE_H_
 // EOF
\ No newline at end of file
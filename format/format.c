@@ -0,0 +1,401 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: format.c
+// Summary	: Version of the record layout of the device data
+// Note		: "<data file>.format" holds the version and the record size the
+//			  data files were written with. Data without it was written
+//			  before versions were kept: a file with intact checksummed
+//			  records is of the current version, a file of whole records
+//			  without checksums is of version 1 and is rewritten to
+//			  "<data file>.upgrade" with the checksums set, then renamed
+//			  into place in one generation. Any other layout is refused, so
+//			  that records are never read at the wrong size.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "crc.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "format.h"
+
+//******************************* Local Types **********************************
+// A record of version 1, the device details without a checksum
+typedef struct _FORMAT_PLAIN_RECORD_
+{
+	uint8 pucDeviceName[STR_MAX_SIZE];
+	uint8 pucDeviceType[STR_MAX_SIZE];
+	uint32 ulDeviceId;
+	uint32 ulDeviceVendor;
+	uint32 ulDeviceSerial;
+} FORMAT_PLAIN_RECORD;
+
+//***************************** Local Constants ********************************
+#define WRITE_COUNT				(1)
+#define READ_COUNT				(1)
+#define FORMAT_VERSION_NONE		(0)
+#define FORMAT_BATCH_RECORDS	(1024)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the format version of a data file
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pstHeader, the version and record size
+//Return	: True, when a whole version is kept
+//Return	: False, otherwise
+//Notes		:
+//******************************************************************************
+static bool formatRead(const uint8 *pucFileName, FORMAT_HEADER *pstHeader)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(fileBuildPath(pucPath, pucFileName, FORMAT_SUFFIX) == true)
+	{
+		pstFile = fopen((char *)pucPath, FILE_READ_MODE);
+	}
+
+	if(pstFile != NULL)
+	{
+		blReturn = (fread(pstHeader, sizeof(FORMAT_HEADER), READ_COUNT,
+						  pstFile) == READ_COUNT &&
+					pstHeader->ulMagic == FORMAT_MAGIC &&
+					pstHeader->ulChecksum ==
+					crc32c(CRC_INITIAL, pstHeader,
+						   offsetof(FORMAT_HEADER, ulChecksum)));
+		fclose(pstFile);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To keep the current format version of a data file
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A torn version file is not whole and is written again by the
+//			  next check
+//******************************************************************************
+static bool formatWrite(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	FORMAT_HEADER stHeader = {0};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	stHeader.ulMagic = FORMAT_MAGIC;
+	stHeader.ulVersion = FORMAT_VERSION;
+	stHeader.ulRecordSize = sizeof(DEVICE_DETAILS);
+	stHeader.ulChecksum = crc32c(CRC_INITIAL, &stHeader,
+								 offsetof(FORMAT_HEADER, ulChecksum));
+	if(fileBuildPath(pucPath, pucFileName, FORMAT_SUFFIX) == true)
+	{
+		pstFile = fopen((char *)pucPath, FILE_WRITE_MODE);
+		blReturn = (pstFile != NULL &&
+					fwrite(&stHeader, sizeof(FORMAT_HEADER), WRITE_COUNT,
+						   pstFile) == WRITE_COUNT &&
+					fflush(pstFile) == 0 && fsync(fileno(pstFile)) == 0);
+		if(pstFile != NULL)
+		{
+			blReturn = (fclose(pstFile) == 0 && blReturn == true);
+		}
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to keep the format version of the device data");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To check whether a kept format version can be read
+//Inputs	: pstHeader, the version and record size
+//Outputs	: None
+//Return	: True, when the data has the current layout
+//Return	: False, otherwise
+//Notes		:
+//******************************************************************************
+static bool formatSupported(const FORMAT_HEADER *pstHeader)
+{
+	bool blReturn = (pstHeader->ulVersion == FORMAT_VERSION &&
+					 pstHeader->ulRecordSize == sizeof(DEVICE_DETAILS));
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to open the device data : Format version %lu of"
+			   " %lu byte records is not supported\n", pstHeader->ulVersion,
+			   pstHeader->ulRecordSize);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the format version of a data file written without one
+//Inputs	: pucPath, the data or shard file
+//Outputs	: None
+//Return	: FORMAT_VERSION, when the file is missing, empty or has an
+//			  intact record
+//Return	: FORMAT_VERSION_PLAIN, when no record is intact and the file
+//			  holds whole records of version 1
+//Return	: FORMAT_VERSION_NONE, otherwise
+//Notes		: Stops at the first intact record. A torn or corrupted record
+//			  of the current version is left to verify.
+//******************************************************************************
+static uint32 formatGuess(const uint8 *pucPath)
+{
+	uint32 ulVersion = FORMAT_VERSION_NONE;
+	FILE *pstFile = NULL;
+	DEVICE_DETAILS *pstRecords = NULL;
+	size_t ulRead = 0;
+	uint32 ulSize = 0;
+	uint32 ulIntact = 0;
+	uint32 ulIndex = 0;
+
+	pstFile = fopen((char *)pucPath, FILE_READ_MODE);
+	if(pstFile != NULL)
+	{
+		pstRecords = malloc(FORMAT_BATCH_RECORDS * sizeof(DEVICE_DETAILS));
+		while(pstRecords != NULL && ulIntact == 0 &&
+			  (ulRead = fread(pstRecords, sizeof(uint8),
+							  FORMAT_BATCH_RECORDS * sizeof(DEVICE_DETAILS),
+							  pstFile)) > 0)
+		{
+			ulSize += ulRead;
+			for(ulIndex = 0; ulIndex < ulRead / sizeof(DEVICE_DETAILS);
+				ulIndex++)
+			{
+				ulIntact += (deviceCheckRecord(&pstRecords[ulIndex]) == true);
+			}
+		}
+
+		if(pstRecords != NULL && ferror(pstFile) == 0)
+		{
+			if(ulIntact > 0 || ulSize == 0)
+			{
+				ulVersion = FORMAT_VERSION;
+			}
+			else if(ulSize % sizeof(FORMAT_PLAIN_RECORD) == 0)
+			{
+				ulVersion = FORMAT_VERSION_PLAIN;
+			}
+		}
+		free(pstRecords);
+		fclose(pstFile);
+	}
+	else if(fileExists(pucPath) != true)
+	{
+		ulVersion = FORMAT_VERSION;
+	}
+
+	return ulVersion;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To rewrite an unsharded data file of version 1
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstWriter, the writer state
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The data file is only replaced once the new one is on the
+//			  disk, the version is kept in the same generation
+//******************************************************************************
+static bool formatUpgrade(const uint8 *pucFileName, SNAPSHOT_WRITER *pstWriter)
+{
+	bool blReturn = false;
+	FILE *pstInput = NULL;
+	FILE *pstOutput = NULL;
+	FORMAT_PLAIN_RECORD *pstPlain = NULL;
+	DEVICE_DETAILS *pstRecords = NULL;
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	size_t ulCount = 0;
+	uint32 ulIndex = 0;
+
+	if(fileBuildPath(pucTemporaryPath, pucFileName,
+					 FORMAT_TEMPORARY_SUFFIX) == true)
+	{
+		pstInput = fopen((char *)pucFileName, FILE_READ_MODE);
+		pstOutput = fopen((char *)pucTemporaryPath, FILE_WRITE_MODE);
+		pstPlain = malloc(FORMAT_BATCH_RECORDS * sizeof(FORMAT_PLAIN_RECORD));
+		pstRecords = calloc(FORMAT_BATCH_RECORDS, sizeof(DEVICE_DETAILS));
+		blReturn = (pstInput != NULL && pstOutput != NULL &&
+					pstPlain != NULL && pstRecords != NULL);
+	}
+
+	while(blReturn == true &&
+		  (ulCount = fread(pstPlain, sizeof(FORMAT_PLAIN_RECORD),
+						   FORMAT_BATCH_RECORDS, pstInput)) > 0)
+	{
+		for(ulIndex = 0; ulIndex < ulCount; ulIndex++)
+		{
+			memcpy(pstRecords[ulIndex].pucDeviceName,
+				   pstPlain[ulIndex].pucDeviceName, STR_MAX_SIZE);
+			memcpy(pstRecords[ulIndex].pucDeviceType,
+				   pstPlain[ulIndex].pucDeviceType, STR_MAX_SIZE);
+			pstRecords[ulIndex].ulDeviceId = pstPlain[ulIndex].ulDeviceId;
+			pstRecords[ulIndex].ulDeviceVendor =
+				pstPlain[ulIndex].ulDeviceVendor;
+			pstRecords[ulIndex].ulDeviceSerial =
+				pstPlain[ulIndex].ulDeviceSerial;
+			deviceSealRecord(&pstRecords[ulIndex]);
+		}
+		blReturn = (fwrite(pstRecords, sizeof(DEVICE_DETAILS), ulCount,
+						   pstOutput) == ulCount);
+	}
+
+	blReturn = (blReturn == true && ferror(pstInput) == 0 &&
+				fflush(pstOutput) == 0 && fsync(fileno(pstOutput)) == 0);
+	if(pstOutput != NULL)
+	{
+		blReturn = (fclose(pstOutput) == 0 && blReturn == true);
+	}
+	if(pstInput != NULL)
+	{
+		fclose(pstInput);
+	}
+	free(pstPlain);
+	free(pstRecords);
+
+	if(blReturn == true)
+	{
+		blReturn = snapshotCommitBegin(pstWriter);
+		if(blReturn == true)
+		{
+			blReturn = (rename((char *)pucTemporaryPath,
+							   (char *)pucFileName) == 0 &&
+						formatWrite(pucFileName) == true);
+		}
+		if(snapshotCommitEnd(pstWriter) != true)
+		{
+			blReturn = false;
+		}
+	}
+
+	if(blReturn != true && pucTemporaryPath[0] != '\0')
+	{
+		remove((char *)pucTemporaryPath);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To check the format of the device data, holding the writer
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstWriter, the writer state
+//Outputs	: None
+//Return	: True, when the data has the current layout
+//Return	: False, otherwise
+//Notes		: Another process may have kept the version meanwhile
+//******************************************************************************
+static bool formatCheckLocked(const uint8 *pucFileName,
+							  SNAPSHOT_WRITER *pstWriter)
+{
+	bool blReturn = false;
+	FORMAT_HEADER stHeader;
+	SHARD_LAYOUT stLayout = {0};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulVersion = FORMAT_VERSION;
+	uint32 ulShard = 0;
+
+	if(formatRead(pucFileName, &stHeader) == true)
+	{
+		blReturn = formatSupported(&stHeader);
+	}
+	else
+	{
+		blReturn = shardGetLayout(pucFileName, &stLayout);
+		for(ulShard = 0; ulShard < stLayout.ulShardCount &&
+			ulVersion == FORMAT_VERSION && blReturn == true; ulShard++)
+		{
+			blReturn = shardGetPath(pucFileName, &stLayout, ulShard, pucPath);
+			ulVersion = formatGuess(pucPath);
+		}
+
+		if(blReturn == true && ulVersion == FORMAT_VERSION)
+		{
+			blReturn = formatWrite(pucFileName);
+		}
+		else if(blReturn == true && ulVersion == FORMAT_VERSION_PLAIN &&
+				stLayout.blSharded != true)
+		{
+			blReturn = formatUpgrade(pucFileName, pstWriter);
+			printf(blReturn == true ?
+				   "Upgraded the device data to format version %d\n" :
+				   "\nUnable to upgrade the device data to format version"
+				   " %d\n", FORMAT_VERSION);
+		}
+		else if(blReturn == true)
+		{
+			printf("\nUnable to open the device data : Unknown record"
+				   " layout in %s\n", (char *)pucPath);
+			blReturn = false;
+		}
+	}
+
+	return blReturn;
+}
+
+//****************************** Global Functions ******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To check the format version of the device data
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, when the data has the current layout
+//Return	: False, when the layout is unknown or cannot be upgraded
+//Notes		: Called before the data is used. Data of version 1 is
+//			  upgraded, data without a version is checked once and its
+//			  version kept.
+//******************************************************************************
+bool formatCheck(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	FORMAT_HEADER stHeader;
+	SNAPSHOT_WRITER stWriter;
+
+	if(pucFileName != NULL && formatRead(pucFileName, &stHeader) == true)
+	{
+		blReturn = formatSupported(&stHeader);
+	}
+	else if(pucFileName != NULL)
+	{
+		blReturn = snapshotWriterBegin(pucFileName, &stWriter);
+		if(blReturn == true)
+		{
+			blReturn = formatCheckLocked(pucFileName, &stWriter);
+			snapshotWriterEnd(&stWriter);
+		}
+	}
+	else
+	{
+		printf("\nUnable to check the device data : Invalid parameters");
+	}
+
+	return blReturn;
+}
+// EOF
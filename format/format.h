@@ -0,0 +1,45 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Version of the record layout of the device data
+// Note		: The version is kept beside the data file and checked before
+//			  the data is used, older layouts are rewritten to the current
+//			  one and unknown layouts are refused
+//
+//******************************************************************************
+
+#ifndef _FORMAT_H_
+#define _FORMAT_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+
+//******************************* Global Types *********************************
+typedef struct _FORMAT_HEADER_
+{
+	uint32 ulMagic;
+	uint32 ulVersion;
+	uint32 ulRecordSize;
+	uint32 ulChecksum;
+} FORMAT_HEADER;
+
+//***************************** Global Constants *******************************
+#define FORMAT_SUFFIX			(".format")
+#define FORMAT_TEMPORARY_SUFFIX	(".upgrade")
+#define FORMAT_MAGIC			(0x544D5246UL)
+
+// 1, records without a checksum. 2, records ending with their CRC32C.
+#define FORMAT_VERSION_PLAIN	(1)
+#define FORMAT_VERSION			(2)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool formatCheck(const uint8 *pucFileName);
+
+#endif // _FORMAT_H_
+// EOF
@@ -0,0 +1,285 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: hash.c
+// Summary	: Hash table keyed by numeric device fields
+// Note		: Linear probing over a power of two table, kept at most 3/4
+//			  full. Removal shifts the following entries back so that no
+//			  deleted markers are needed.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "customTypes.h"
+#include "hash.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define HASH_LOAD_NUMERATOR		(3)
+#define HASH_LOAD_DENOMINATOR	(4)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the slot of a key or the free slot where it belongs
+//Inputs	: pstTable, the hash table
+//Inputs	: ulKey, the key to be found
+//Outputs	: None
+//Return	: Index of the slot
+//Notes		: The table always has a free slot
+//******************************************************************************
+static uint32 hashProbe(const HASH_TABLE *pstTable, uint32 ulKey)
+{
+	uint32 ulMask = pstTable->ulCapacity - 1;
+	uint32 ulSlot = hashMix(ulKey) & ulMask;
+
+	while(pstTable->pstEntries[ulSlot].blUsed == true &&
+		  pstTable->pstEntries[ulSlot].ulKey != ulKey)
+	{
+		ulSlot = (ulSlot + 1) & ulMask;
+	}
+
+	return ulSlot;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To move all the entries to a table of a new size
+//Inputs	: pstTable, the hash table
+//Inputs	: ulCapacity, the new number of slots, a power of two
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool hashResize(HASH_TABLE *pstTable, uint32 ulCapacity)
+{
+	bool blReturn = false;
+	HASH_TABLE stNewTable = {0};
+	uint32 ulSlot = 0;
+
+	stNewTable.pstEntries = calloc(ulCapacity, sizeof(HASH_ENTRY));
+	if(stNewTable.pstEntries != NULL)
+	{
+		stNewTable.ulCapacity = ulCapacity;
+		for(ulSlot = 0; ulSlot < pstTable->ulCapacity; ulSlot++)
+		{
+			if(pstTable->pstEntries[ulSlot].blUsed == true)
+			{
+				stNewTable.pstEntries[hashProbe(&stNewTable,
+					pstTable->pstEntries[ulSlot].ulKey)] =
+					pstTable->pstEntries[ulSlot];
+				stNewTable.ulCount++;
+			}
+		}
+		free(pstTable->pstEntries);
+		*pstTable = stNewTable;
+		blReturn = true;
+	}
+	else
+	{
+		printf("\nUnable to grow the hash table : Out of memory");
+	}
+
+	return blReturn;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To scramble a key so that consecutive keys spread evenly
+//Inputs	: ulKey, the key
+//Outputs	: None
+//Return	: The hash of the key
+//Notes		: Finalizer of the 64-bit MurmurHash3
+//******************************************************************************
+uint32 hashMix(uint32 ulKey)
+{
+	unsigned long long ullHash = ulKey;
+
+	ullHash ^= ullHash >> 33;
+	ullHash *= 0xFF51AFD7ED558CCDULL;
+	ullHash ^= ullHash >> 33;
+	ullHash *= 0xC4CEB9FE1A85EC53ULL;
+	ullHash ^= ullHash >> 33;
+
+	return (uint32)ullHash;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To create an empty hash table
+//Inputs	: pstTable, the hash table
+//Inputs	: ulExpectedCount, number of keys expected, to avoid regrowing
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool hashCreate(HASH_TABLE *pstTable, uint32 ulExpectedCount)
+{
+	bool blReturn = false;
+	uint32 ulCapacity = HASH_MIN_CAPACITY;
+
+	if(pstTable != NULL)
+	{
+		while(ulCapacity * HASH_LOAD_NUMERATOR <
+			  ulExpectedCount * HASH_LOAD_DENOMINATOR)
+		{
+			ulCapacity *= 2;
+		}
+
+		pstTable->pstEntries = calloc(ulCapacity, sizeof(HASH_ENTRY));
+		pstTable->ulCapacity = ulCapacity;
+		pstTable->ulCount = 0;
+		blReturn = (pstTable->pstEntries != NULL);
+		if(blReturn != true)
+		{
+			pstTable->ulCapacity = 0;
+			printf("\nUnable to create the hash table : Out of memory");
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To insert a key or to replace the value of a key
+//Inputs	: pstTable, the hash table
+//Inputs	: ulKey, the key
+//Inputs	: ulValue, the value of the key
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The table doubles when it gets 3/4 full
+//******************************************************************************
+bool hashInsert(HASH_TABLE *pstTable, uint32 ulKey, uint32 ulValue)
+{
+	bool blReturn = false;
+	uint32 ulSlot = 0;
+
+	if(pstTable != NULL && pstTable->pstEntries != NULL)
+	{
+		blReturn = true;
+		if((pstTable->ulCount + 1) * HASH_LOAD_DENOMINATOR >
+		   pstTable->ulCapacity * HASH_LOAD_NUMERATOR)
+		{
+			blReturn = hashResize(pstTable, pstTable->ulCapacity * 2);
+		}
+
+		if(blReturn == true)
+		{
+			ulSlot = hashProbe(pstTable, ulKey);
+			if(pstTable->pstEntries[ulSlot].blUsed != true)
+			{
+				pstTable->pstEntries[ulSlot].blUsed = true;
+				pstTable->pstEntries[ulSlot].ulKey = ulKey;
+				pstTable->ulCount++;
+			}
+			pstTable->pstEntries[ulSlot].ulValue = ulValue;
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the value of a key
+//Inputs	: pstTable, the hash table
+//Inputs	: ulKey, the key
+//Outputs	: None
+//Return	: Pointer to the value, NULL if the key is not present
+//Notes		: The value may be changed through the pointer, it stays valid
+//			  until the next insert or removal
+//******************************************************************************
+uint32 *hashLookup(const HASH_TABLE *pstTable, uint32 ulKey)
+{
+	uint32 *pulValue = NULL;
+	uint32 ulSlot = 0;
+
+	if(pstTable != NULL && pstTable->pstEntries != NULL)
+	{
+		ulSlot = hashProbe(pstTable, ulKey);
+		if(pstTable->pstEntries[ulSlot].blUsed == true)
+		{
+			pulValue = &pstTable->pstEntries[ulSlot].ulValue;
+		}
+	}
+
+	return pulValue;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove a key
+//Inputs	: pstTable, the hash table
+//Inputs	: ulKey, the key
+//Outputs	: None
+//Return	: True, if the key has been removed
+//Return	: False, if the key is not present
+//Notes		: Entries after the removed one are shifted back into the gap
+//******************************************************************************
+bool hashRemove(HASH_TABLE *pstTable, uint32 ulKey)
+{
+	bool blReturn = false;
+	uint32 ulMask = 0;
+	uint32 ulGap = 0;
+	uint32 ulSlot = 0;
+	uint32 ulHome = 0;
+
+	if(pstTable != NULL && pstTable->pstEntries != NULL)
+	{
+		ulMask = pstTable->ulCapacity - 1;
+		ulGap = hashProbe(pstTable, ulKey);
+		if(pstTable->pstEntries[ulGap].blUsed == true)
+		{
+			pstTable->pstEntries[ulGap].blUsed = false;
+			pstTable->ulCount--;
+			blReturn = true;
+
+			ulSlot = (ulGap + 1) & ulMask;
+			while(pstTable->pstEntries[ulSlot].blUsed == true)
+			{
+				ulHome = hashMix(pstTable->pstEntries[ulSlot].ulKey) & ulMask;
+				// Move the entry when the gap lies on its probe path
+				if(((ulSlot - ulHome) & ulMask) >= ((ulSlot - ulGap) & ulMask))
+				{
+					pstTable->pstEntries[ulGap] = pstTable->pstEntries[ulSlot];
+					pstTable->pstEntries[ulSlot].blUsed = false;
+					ulGap = ulSlot;
+				}
+				ulSlot = (ulSlot + 1) & ulMask;
+			}
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To release a hash table
+//Inputs	: pstTable, the hash table
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+void hashDestroy(HASH_TABLE *pstTable)
+{
+	if(pstTable != NULL)
+	{
+		free(pstTable->pstEntries);
+		pstTable->pstEntries = NULL;
+		pstTable->ulCapacity = 0;
+		pstTable->ulCount = 0;
+	}
+}
+// EOF
@@ -0,0 +1,48 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Hash table keyed by numeric device fields
+// Note		: Open addressing table mapping a key such as the serial number
+//			  to a value, used as a set or as a map
+//
+//******************************************************************************
+
+#ifndef _HASH_H_
+#define _HASH_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+
+//******************************* Global Types *********************************
+typedef struct _HASH_ENTRY_
+{
+	uint32 ulKey;
+	uint32 ulValue;
+	bool blUsed;
+} HASH_ENTRY;
+
+typedef struct _HASH_TABLE_
+{
+	HASH_ENTRY *pstEntries;
+	uint32 ulCapacity;
+	uint32 ulCount;
+} HASH_TABLE;
+
+//***************************** Global Constants *******************************
+#define HASH_MIN_CAPACITY	(16)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+uint32 hashMix(uint32 ulKey);
+bool hashCreate(HASH_TABLE *pstTable, uint32 ulExpectedCount);
+bool hashInsert(HASH_TABLE *pstTable, uint32 ulKey, uint32 ulValue);
+uint32 *hashLookup(const HASH_TABLE *pstTable, uint32 ulKey);
+bool hashRemove(HASH_TABLE *pstTable, uint32 ulKey);
+void hashDestroy(HASH_TABLE *pstTable);
+
+#endif // _HASH_H_
+// EOF
@@ -0,0 +1,678 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: history.c
+// Summary	: Timestamped history of the device data
+// Note		: Writers log every version of a device they insert or remove,
+//			  with the time in seconds, while they hold the writer lock. The
+//			  entries of a UTC day go to "<data file>.history.YYYYMMDD", and
+//			  "<data file>.history" holds the time since which the history
+//			  is complete. The devices as of a time are found by taking the
+//			  current devices and undoing, newest first, the entries logged
+//			  after that time, so only the partitions since then are read.
+//			  A time range reads the partitions of its days. Retention
+//			  deletes whole partitions.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "crc.h"
+#include "hash.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "history.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define WRITE_COUNT				(1)
+#define READ_COUNT				(1)
+#define FILE_PERMISSIONS		(0644)
+#define HISTORY_BATCH_ENTRIES	(1024)
+#define HISTORY_SUFFIX_SIZE		(24)
+#define HISTORY_BASE_YEAR		(1900)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compute the checksum of a history entry
+//Inputs	: pstEntry, the entry
+//Outputs	: None
+//Return	: The checksum of every field before ulChecksum
+//Notes		:
+//******************************************************************************
+static uint32 historyChecksum(const HISTORY_ENTRY *pstEntry)
+{
+	return crc32c(CRC_INITIAL, pstEntry, offsetof(HISTORY_ENTRY, ulChecksum));
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To build the name of the partition of a day
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulDay, the day, counted from the epoch
+//Outputs	: pucPath, "<data file>.history.YYYYMMDD"
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool historyGetPartitionPath(const uint8 *pucFileName, uint32 ulDay,
+									uint8 *pucPath)
+{
+	struct tm stDate;
+	time_t lTime = (time_t)ulDay * HISTORY_PARTITION_SECONDS;
+	uint8 pucDate[HISTORY_TIME_SIZE] = "";
+	uint8 pucSuffix[HISTORY_SUFFIX_SIZE] = "";
+
+	return (gmtime_r(&lTime, &stDate) != NULL &&
+			strftime((char *)pucDate, sizeof(pucDate), "%Y%m%d",
+					 &stDate) > 0 &&
+			snprintf((char *)pucSuffix, sizeof(pucSuffix), "%s.%s",
+					 HISTORY_SUFFIX, (char *)pucDate) > 0 &&
+			fileBuildPath(pucPath, pucFileName, pucSuffix) == true);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open the partition of a day
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulDay, the day, counted from the epoch
+//Inputs	: lFlags, flags of open
+//Outputs	: pulCount, number of complete entries of the partition
+//Return	: The descriptor, negative if the partition does not exist
+//Notes		:
+//******************************************************************************
+static int32 historyOpenPartition(const uint8 *pucFileName, uint32 ulDay,
+								  int32 lFlags, uint32 *pulCount)
+{
+	struct stat stStat;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	int32 lFd = -1;
+
+	*pulCount = 0;
+	if(historyGetPartitionPath(pucFileName, ulDay, pucPath) == true)
+	{
+		lFd = open((char *)pucPath, lFlags, FILE_PERMISSIONS);
+	}
+
+	if(lFd >= 0)
+	{
+		if(fstat(lFd, &stStat) == 0)
+		{
+			*pulCount = stStat.st_size / sizeof(HISTORY_ENTRY);
+		}
+		else
+		{
+			close(lFd);
+			lFd = -1;
+		}
+	}
+
+	return lFd;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the time since which the history is complete
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pstHeader, the header of the history
+//Return	: True, if a history is kept
+//Return	: False, otherwise
+//Notes		:
+//******************************************************************************
+static bool historyReadHeader(const uint8 *pucFileName,
+							  HISTORY_HEADER *pstHeader)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(fileBuildPath(pucPath, pucFileName, HISTORY_SUFFIX) == true)
+	{
+		pstFile = fopen((char *)pucPath, FILE_READ_MODE);
+	}
+
+	if(pstFile != NULL)
+	{
+		blReturn = (fread(pstHeader, sizeof(HISTORY_HEADER), READ_COUNT,
+						  pstFile) == READ_COUNT &&
+					pstHeader->ulMagic == HISTORY_MAGIC);
+		fclose(pstFile);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To record the time since which the history is complete
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulStartTime, the time
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Written to a temporary file and renamed over the old one
+//******************************************************************************
+static bool historyWriteHeader(const uint8 *pucFileName, uint32 ulStartTime)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	HISTORY_HEADER stHeader = {HISTORY_MAGIC, ulStartTime};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(fileBuildPath(pucPath, pucFileName, HISTORY_SUFFIX) == true &&
+	   fileBuildPath(pucTemporaryPath, pucPath,
+					 SNAPSHOT_TEMPORARY_SUFFIX) == true)
+	{
+		pstFile = fopen((char *)pucTemporaryPath, FILE_WRITE_MODE);
+	}
+
+	if(pstFile != NULL)
+	{
+		blReturn = (fwrite(&stHeader, sizeof(HISTORY_HEADER), WRITE_COUNT,
+						   pstFile) == WRITE_COUNT);
+		blReturn = (fclose(pstFile) == 0 && blReturn == true &&
+					rename((char *)pucTemporaryPath, (char *)pucPath) == 0);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To undo a history entry on a set of devices
+//Inputs	: pstTable, position of every device of the set by serial
+//Inputs	: pstResult, the set of devices
+//Inputs	: pstEntry, the entry to be undone
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: An inserted version is taken out, the last device taking its
+//			  place, a removed version is put back
+//******************************************************************************
+static bool historyUndo(HASH_TABLE *pstTable, SHARD_RESULT *pstResult,
+						const HISTORY_ENTRY *pstEntry)
+{
+	bool blReturn = true;
+	uint32 *pulPosition = NULL;
+	uint32 ulSerial = pstEntry->stDevice.ulDeviceSerial;
+	uint32 ulPosition = 0;
+	uint32 ulLast = 0;
+
+	pulPosition = hashLookup(pstTable, ulSerial);
+	if(pstEntry->ulOperation == HISTORY_INSERT && pulPosition != NULL)
+	{
+		ulPosition = *pulPosition;
+		ulLast = pstResult->ulCount - 1;
+		if(ulPosition != ulLast)
+		{
+			pstResult->pstRecords[ulPosition] = pstResult->pstRecords[ulLast];
+			blReturn = hashInsert(pstTable,
+						pstResult->pstRecords[ulPosition].ulDeviceSerial,
+						ulPosition);
+		}
+		hashRemove(pstTable, ulSerial);
+		pstResult->ulCount = ulLast;
+	}
+	else if(pstEntry->ulOperation == HISTORY_REMOVE && pulPosition != NULL)
+	{
+		pstResult->pstRecords[*pulPosition] = pstEntry->stDevice;
+	}
+	else if(pstEntry->ulOperation == HISTORY_REMOVE)
+	{
+		blReturn = (shardResultAppend(pstResult, &pstEntry->stDevice) == true &&
+					hashInsert(pstTable, ulSerial,
+							   pstResult->ulCount - 1) == true);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To undo the entries of a partition logged after a time
+//Inputs	: lFd and ulCount, the partition and its number of entries
+//Inputs	: ulTime, the time
+//Inputs	: pstTable and pstResult, the set of devices
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error or of a corrupt entry
+//Notes		: The entries are read backwards, by batches
+//******************************************************************************
+static bool historyUndoPartition(int32 lFd, uint32 ulCount, uint32 ulTime,
+								 HASH_TABLE *pstTable, SHARD_RESULT *pstResult)
+{
+	bool blReturn = true;
+	HISTORY_ENTRY pstEntries[HISTORY_BATCH_ENTRIES];
+	uint32 ulEnd = ulCount;
+	uint32 ulStart = 0;
+	uint32 ulIndex = 0;
+	uint32 ulSize = 0;
+
+	while(blReturn == true && ulEnd > 0)
+	{
+		ulStart = ulEnd > HISTORY_BATCH_ENTRIES ?
+				  ulEnd - HISTORY_BATCH_ENTRIES : 0;
+		ulSize = (ulEnd - ulStart) * sizeof(HISTORY_ENTRY);
+		blReturn = (pread(lFd, pstEntries, ulSize,
+						  (off_t)ulStart * sizeof(HISTORY_ENTRY)) ==
+					(ssize_t)ulSize);
+		for(ulIndex = ulEnd - ulStart; ulIndex > 0 && blReturn == true;
+			ulIndex--)
+		{
+			blReturn = (pstEntries[ulIndex - 1].ulChecksum ==
+						historyChecksum(&pstEntries[ulIndex - 1]));
+			if(blReturn == true && pstEntries[ulIndex - 1].ulTime > ulTime)
+			{
+				blReturn = historyUndo(pstTable, pstResult,
+									   &pstEntries[ulIndex - 1]);
+			}
+		}
+		ulEnd = ulStart;
+	}
+
+	return blReturn;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To log versions of devices to the history
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstRemoved, the removed versions, NULL if none
+//Inputs	: pstInserted, the inserted versions, NULL if none
+//Inputs	: ulCount, number of versions in each array
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Called under the writer lock, after the change is published.
+//			  Each removed version is logged before the inserted version of
+//			  the same position, which together make an update.
+//******************************************************************************
+bool historyAppend(const uint8 *pucFileName, const DEVICE_DETAILS *pstRemoved,
+				   const DEVICE_DETAILS *pstInserted, uint32 ulCount)
+{
+	bool blReturn = false;
+	HISTORY_ENTRY pstEntries[HISTORY_BATCH_ENTRIES];
+	HISTORY_HEADER stHeader = {0};
+	uint32 ulTime = time(NULL);
+	uint32 ulEnd = 0;
+	uint32 ulIndex = 0;
+	uint32 ulBatch = 0;
+	uint32 ulEntry = 0;
+	uint32 ulSize = 0;
+	int32 lFd = -1;
+
+	if(pucFileName == NULL || ulCount == 0)
+	{
+		return (pucFileName != NULL);
+	}
+
+	blReturn = (historyReadHeader(pucFileName, &stHeader) == true ||
+				historyWriteHeader(pucFileName, ulTime) == true);
+	if(blReturn == true)
+	{
+		lFd = historyOpenPartition(pucFileName,
+								   ulTime / HISTORY_PARTITION_SECONDS,
+								   O_RDWR | O_CREAT, &ulEnd);
+		blReturn = (lFd >= 0);
+	}
+
+	// A torn entry at the tail is cut off
+	while(blReturn == true && ulIndex < ulCount)
+	{
+		for(ulBatch = 0; ulBatch + 1 < HISTORY_BATCH_ENTRIES &&
+			ulIndex < ulCount; ulIndex++)
+		{
+			if(pstRemoved != NULL)
+			{
+				memset(&pstEntries[ulBatch], 0, sizeof(HISTORY_ENTRY));
+				pstEntries[ulBatch].ulOperation = HISTORY_REMOVE;
+				pstEntries[ulBatch++].stDevice = pstRemoved[ulIndex];
+			}
+			if(pstInserted != NULL)
+			{
+				memset(&pstEntries[ulBatch], 0, sizeof(HISTORY_ENTRY));
+				pstEntries[ulBatch].ulOperation = HISTORY_INSERT;
+				pstEntries[ulBatch++].stDevice = pstInserted[ulIndex];
+			}
+		}
+		for(ulEntry = 0; ulEntry < ulBatch; ulEntry++)
+		{
+			pstEntries[ulEntry].ulTime = ulTime;
+			pstEntries[ulEntry].ulChecksum =
+				historyChecksum(&pstEntries[ulEntry]);
+		}
+
+		ulSize = ulBatch * sizeof(HISTORY_ENTRY);
+		blReturn = (pwrite(lFd, pstEntries, ulSize,
+						   (off_t)ulEnd * sizeof(HISTORY_ENTRY)) ==
+					(ssize_t)ulSize);
+		ulEnd += ulBatch;
+	}
+
+	if(lFd >= 0)
+	{
+		blReturn = (ftruncate(lFd, (off_t)ulEnd * sizeof(HISTORY_ENTRY)) == 0 &&
+					blReturn == true);
+		close(lFd);
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to log the change to the history\n");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the devices existing at a time
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulTime, the time
+//Outputs	: pstResult, the devices, in no particular order
+//Return	: True, at time of successful execution
+//Return	: False, if the history does not reach the time or in case of
+//			  an error
+//Notes		: Holds the writer lock, so the current devices and the history
+//			  match. Only the partitions from the day of the time on are
+//			  read.
+//******************************************************************************
+bool historyAsOf(const uint8 *pucFileName, uint32 ulTime,
+				 SHARD_RESULT *pstResult)
+{
+	bool blReturn = false;
+	DEVICE_DETAILS DeviceData = {0};
+	HISTORY_HEADER stHeader = {0};
+	HASH_TABLE stTable = {0};
+	SNAPSHOT stSnapshot;
+	SNAPSHOT_WRITER stWriter;
+	SHARD_LAYOUT stLayout = {0};
+	uint8 pucStart[HISTORY_TIME_SIZE] = "";
+	uint32 ulDay = time(NULL) / HISTORY_PARTITION_SECONDS;
+	uint32 ulCount = 0;
+	uint32 ulShard = 0;
+	int32 lFd = -1;
+
+	if(pucFileName == NULL || pstResult == NULL)
+	{
+		printf("\nUnable to query the history : Invalid parameters\n");
+		return false;
+	}
+
+	if(snapshotWriterBegin(pucFileName, &stWriter) != true)
+	{
+		return false;
+	}
+
+	if(historyReadHeader(pucFileName, &stHeader) != true)
+	{
+		printf("\nUnable to query the history : No history is kept yet\n");
+	}
+	else if(ulTime < stHeader.ulStartTime)
+	{
+		historyFormatTime(stHeader.ulStartTime, pucStart);
+		printf("\nUnable to query the history : It starts at %s\n", pucStart);
+	}
+	else if(hashCreate(&stTable, 0) == true &&
+			shardAcquireSnapshot(pucFileName, &stSnapshot, &stLayout) == true)
+	{
+		blReturn = true;
+		for(ulShard = 0; ulShard < stSnapshot.ulFileCount; ulShard++)
+		{
+			while(blReturn == true &&
+				  snapshotRead(&stSnapshot, ulShard, &DeviceData) == true)
+			{
+				blReturn = (shardResultAppend(pstResult, &DeviceData) == true &&
+							hashInsert(&stTable, DeviceData.ulDeviceSerial,
+									   pstResult->ulCount - 1) == true);
+			}
+		}
+		snapshotRelease(&stSnapshot);
+
+		for(; blReturn == true &&
+			ulDay >= ulTime / HISTORY_PARTITION_SECONDS; ulDay--)
+		{
+			lFd = historyOpenPartition(pucFileName, ulDay, O_RDONLY, &ulCount);
+			if(lFd >= 0)
+			{
+				blReturn = historyUndoPartition(lFd, ulCount, ulTime, &stTable,
+												pstResult);
+				close(lFd);
+			}
+			if(ulDay == 0)
+			{
+				break;
+			}
+		}
+
+		if(blReturn != true)
+		{
+			printf("\nUnable to query the history : Corrupt partition\n");
+		}
+	}
+	hashDestroy(&stTable);
+	snapshotWriterEnd(&stWriter);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To enumerate the history entries of a time range
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulFrom and ulTo, the range, ulTo excluded
+//Inputs	: pfnVisit and pvContext, called with every entry in time order
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Only the partitions of the days in the range are read. A
+//			  partition ends at its first incomplete or corrupt entry.
+//******************************************************************************
+bool historyRange(const uint8 *pucFileName, uint32 ulFrom, uint32 ulTo,
+				  HISTORY_VISIT pfnVisit, void *pvContext)
+{
+	bool blReturn = false;
+	bool blContinue = true;
+	HISTORY_ENTRY pstEntries[HISTORY_BATCH_ENTRIES];
+	uint32 ulLastDay = time(NULL) / HISTORY_PARTITION_SECONDS;
+	uint32 ulDay = ulFrom / HISTORY_PARTITION_SECONDS;
+	uint32 ulCount = 0;
+	uint32 ulStart = 0;
+	uint32 ulBatch = 0;
+	uint32 ulIndex = 0;
+	int32 lFd = -1;
+
+	if(pucFileName == NULL || pfnVisit == NULL || ulFrom >= ulTo)
+	{
+		printf("\nUnable to query the history : Invalid parameters\n");
+		return false;
+	}
+
+	if(ulLastDay > (ulTo - 1) / HISTORY_PARTITION_SECONDS)
+	{
+		ulLastDay = (ulTo - 1) / HISTORY_PARTITION_SECONDS;
+	}
+
+	blReturn = true;
+	for(; ulDay <= ulLastDay && blContinue == true; ulDay++)
+	{
+		lFd = historyOpenPartition(pucFileName, ulDay, O_RDONLY, &ulCount);
+		for(ulStart = 0; lFd >= 0 && ulStart < ulCount &&
+			blContinue == true; ulStart += ulBatch)
+		{
+			ulBatch = ulCount - ulStart < HISTORY_BATCH_ENTRIES ?
+					  ulCount - ulStart : HISTORY_BATCH_ENTRIES;
+			blContinue = (pread(lFd, pstEntries,
+								ulBatch * sizeof(HISTORY_ENTRY),
+								(off_t)ulStart * sizeof(HISTORY_ENTRY)) ==
+						  (ssize_t)(ulBatch * sizeof(HISTORY_ENTRY)));
+			for(ulIndex = 0; ulIndex < ulBatch && blContinue == true;
+				ulIndex++)
+			{
+				if(pstEntries[ulIndex].ulChecksum !=
+				   historyChecksum(&pstEntries[ulIndex]))
+				{
+					ulCount = ulStart;
+					ulBatch = 0;
+					break;
+				}
+				if(pstEntries[ulIndex].ulTime >= ulFrom &&
+				   pstEntries[ulIndex].ulTime < ulTo)
+				{
+					blContinue = pfnVisit(&pstEntries[ulIndex], pvContext);
+				}
+			}
+		}
+		if(lFd >= 0)
+		{
+			close(lFd);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To drop the history partitions before a time
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulBefore, the time
+//Outputs	: pulDropped, number of partitions deleted
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Only whole days are dropped, the history then starts at the
+//			  day of the time. Deleting a partition does not depend on its
+//			  size.
+//******************************************************************************
+bool historyDrop(const uint8 *pucFileName, uint32 ulBefore,
+				 uint32 *pulDropped)
+{
+	bool blReturn = false;
+	SNAPSHOT_WRITER stWriter;
+	HISTORY_HEADER stHeader = {0};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulDay = 0;
+	uint32 ulStartDay = ulBefore / HISTORY_PARTITION_SECONDS;
+
+	if(pucFileName == NULL || pulDropped == NULL)
+	{
+		printf("\nUnable to drop the history : Invalid parameters\n");
+		return false;
+	}
+
+	if(snapshotWriterBegin(pucFileName, &stWriter) != true)
+	{
+		return false;
+	}
+
+	*pulDropped = 0;
+	blReturn = true;
+	if(historyReadHeader(pucFileName, &stHeader) == true &&
+	   stHeader.ulStartTime < ulStartDay * HISTORY_PARTITION_SECONDS)
+	{
+		for(ulDay = stHeader.ulStartTime / HISTORY_PARTITION_SECONDS;
+			ulDay < ulStartDay && blReturn == true; ulDay++)
+		{
+			blReturn = historyGetPartitionPath(pucFileName, ulDay, pucPath);
+			if(blReturn == true && unlink((char *)pucPath) == 0)
+			{
+				(*pulDropped)++;
+			}
+		}
+
+		// Recorded last, an interrupted drop is completed by the next one
+		blReturn = (blReturn == true &&
+					historyWriteHeader(pucFileName, ulStartDay *
+									   HISTORY_PARTITION_SECONDS) == true);
+	}
+	snapshotWriterEnd(&stWriter);
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to drop the history\n");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read a UTC time
+//Inputs	: pucText, "YYYY-MM-DD" or "YYYY-MM-DDTHH:MM:SS"
+//Outputs	: pulTime, the time in seconds since the epoch
+//Return	: True, if the time is valid
+//Return	: False, otherwise
+//Notes		:
+//******************************************************************************
+bool historyParseTime(const uint8 *pucText, uint32 *pulTime)
+{
+	bool blReturn = false;
+	struct tm stDate = {0};
+	struct tm stCheck = {0};
+	time_t lTime = 0;
+	int iDateEnd = 0;
+	int iTimeEnd = 0;
+
+	if(pucText != NULL && pulTime != NULL &&
+	   sscanf((const char *)pucText, "%4d-%2d-%2d%n", &stDate.tm_year,
+			  &stDate.tm_mon, &stDate.tm_mday, &iDateEnd) == 3)
+	{
+		blReturn = (pucText[iDateEnd] == '\0' ||
+					(sscanf((const char *)pucText + iDateEnd,
+							"T%2d:%2d:%2d%n", &stDate.tm_hour, &stDate.tm_min,
+							&stDate.tm_sec, &iTimeEnd) == 3 &&
+					 pucText[iDateEnd + iTimeEnd] == '\0'));
+	}
+
+	if(blReturn == true)
+	{
+		stDate.tm_year -= HISTORY_BASE_YEAR;
+		stDate.tm_mon--;
+		stCheck = stDate;
+		lTime = timegm(&stDate);
+		// Out of range fields are normalized by timegm
+		blReturn = (lTime >= 0 && stDate.tm_year == stCheck.tm_year &&
+					stDate.tm_mon == stCheck.tm_mon &&
+					stDate.tm_mday == stCheck.tm_mday &&
+					stDate.tm_hour == stCheck.tm_hour &&
+					stDate.tm_min == stCheck.tm_min &&
+					stDate.tm_sec == stCheck.tm_sec);
+		*pulTime = lTime;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print a time as UTC
+//Inputs	: ulTime, the time in seconds since the epoch
+//Outputs	: pucText, "YYYY-MM-DD HH:MM:SS", HISTORY_TIME_SIZE bytes
+//Return	: None
+//Notes		:
+//******************************************************************************
+void historyFormatTime(uint32 ulTime, uint8 *pucText)
+{
+	struct tm stDate;
+	time_t lTime = ulTime;
+
+	pucText[0] = '\0';
+	if(gmtime_r(&lTime, &stDate) != NULL)
+	{
+		strftime((char *)pucText, HISTORY_TIME_SIZE, "%Y-%m-%d %H:%M:%S",
+				 &stDate);
+	}
+}
+// EOF
@@ -0,0 +1,67 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Timestamped history of the device data
+// Note		: Every version of a device is logged when it is inserted and
+//			  when it is removed, in one partition file per day, for as of
+//			  and time range queries
+//
+//******************************************************************************
+
+#ifndef _HISTORY_H_
+#define _HISTORY_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "shard.h"
+
+//******************************* Global Types *********************************
+typedef struct _HISTORY_ENTRY_
+{
+	uint32 ulTime;
+	uint32 ulOperation;
+	DEVICE_DETAILS stDevice;
+	uint32 ulChecksum;
+} HISTORY_ENTRY;
+
+// Time since which the history is complete
+typedef struct _HISTORY_HEADER_
+{
+	uint32 ulMagic;
+	uint32 ulStartTime;
+} HISTORY_HEADER;
+
+// Returns false to stop the enumeration
+typedef bool (*HISTORY_VISIT)(const HISTORY_ENTRY *pstEntry, void *pvContext);
+
+//***************************** Global Constants *******************************
+#define HISTORY_SUFFIX				(".history")
+#define HISTORY_MAGIC				(0x54534948UL)
+#define HISTORY_PARTITION_SECONDS	(86400)
+#define HISTORY_TIME_SIZE			(20)
+
+// Operations of the entries, an update removes a version and inserts one
+#define HISTORY_INSERT				(1)
+#define HISTORY_REMOVE				(2)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool historyAppend(const uint8 *pucFileName, const DEVICE_DETAILS *pstRemoved,
+				   const DEVICE_DETAILS *pstInserted, uint32 ulCount);
+bool historyAsOf(const uint8 *pucFileName, uint32 ulTime,
+				 SHARD_RESULT *pstResult);
+bool historyRange(const uint8 *pucFileName, uint32 ulFrom, uint32 ulTo,
+				  HISTORY_VISIT pfnVisit, void *pvContext);
+bool historyDrop(const uint8 *pucFileName, uint32 ulBefore,
+				 uint32 *pulDropped);
+bool historyParseTime(const uint8 *pucText, uint32 *pulTime);
+void historyFormatTime(uint32 ulTime, uint8 *pucText);
+
+#endif // _HISTORY_H_
+// EOF
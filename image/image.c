@@ -0,0 +1,732 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: image.c
+// Summary	: Checkpointed memory image of the device data
+// Note		: "<data file>.image" holds a header, the device records and an
+//			  open addressing table of slots, each slot 0 when empty or the
+//			  position of a record plus one. Nothing in the file is an
+//			  address, so it is mapped back privately and used in place.
+//			  The header records the generation and the last feed sequence
+//			  the image contains, both taken under the writer lock. Loading
+//			  replays the feed entries written after the checkpoint, under
+//			  the writer lock, and checks the resulting device count
+//			  against the data files. The records and slots are checksummed
+//			  as a whole at the checkpoint and checked at load, a lookup
+//			  checks the slots it follows and the record it returns, so a
+//			  damaged image is built again instead of being trusted.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "crc.h"
+#include "hash.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "feed.h"
+#include "image.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define WRITE_COUNT				(1)
+#define IMAGE_EMPTY				(0)
+#define IMAGE_SLOT_NONE			((uint32)-1)
+#define IMAGE_MIN_CAPACITY		(1024)
+#define IMAGE_HEADROOM_DIVISOR	(4)
+#define IMAGE_LOAD_FACTOR		(2)
+#define IMAGE_FEED_BATCH		(1024)
+#define IMAGE_NANOSECONDS		(1e9)
+#define IMAGE_MILLISECONDS		(1e3)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compute the checksum of an image header
+//Inputs	: pstHeader, the header
+//Outputs	: None
+//Return	: The checksum of every field before ulChecksum
+//Notes		:
+//******************************************************************************
+static uint32 imageChecksum(const IMAGE_HEADER *pstHeader)
+{
+	return crc32c(CRC_INITIAL, pstHeader, offsetof(IMAGE_HEADER, ulChecksum));
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compute the size of an image
+//Inputs	: ulCapacity, number of records
+//Inputs	: ulSlotCount, number of slots
+//Outputs	: None
+//Return	: The size in bytes
+//Notes		:
+//******************************************************************************
+static uint32 imageSize(uint32 ulCapacity, uint32 ulSlotCount)
+{
+	return sizeof(IMAGE_HEADER) + ulCapacity * sizeof(DEVICE_DETAILS) +
+		   ulSlotCount * sizeof(uint32);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To point the parts of an image into its memory
+//Inputs	: pstImage, the image with its base set
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void imageLocate(IMAGE *pstImage)
+{
+	pstImage->pstHeader = (IMAGE_HEADER *)pstImage->pvBase;
+	pstImage->pstRecords = (DEVICE_DETAILS *)(pstImage->pstHeader + 1);
+	pstImage->pulSlots = (uint32 *)(pstImage->pstRecords +
+									pstImage->pstHeader->ulCapacity);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To allocate an empty image
+//Inputs	: ulCapacity, number of records it can hold
+//Outputs	: pstImage, the image
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The slots are kept at most half used
+//******************************************************************************
+static bool imageAllocate(uint32 ulCapacity, IMAGE *pstImage)
+{
+	uint32 ulSlotCount = IMAGE_MIN_CAPACITY;
+
+	while(ulSlotCount < ulCapacity * IMAGE_LOAD_FACTOR)
+	{
+		ulSlotCount <<= 1;
+	}
+
+	memset(pstImage, 0, sizeof(IMAGE));
+	pstImage->ulSize = imageSize(ulCapacity, ulSlotCount);
+	pstImage->pvBase = calloc(1, pstImage->ulSize);
+	if(pstImage->pvBase != NULL)
+	{
+		((IMAGE_HEADER *)pstImage->pvBase)->ulCapacity = ulCapacity;
+		imageLocate(pstImage);
+		pstImage->pstHeader->ulMagic = IMAGE_MAGIC;
+		pstImage->pstHeader->ulSlotCount = ulSlotCount;
+	}
+
+	return (pstImage->pvBase != NULL);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the slot of a serial
+//Inputs	: pstImage, the image
+//Inputs	: ulSerial, serial of the device
+//Outputs	: pulSlot, the slot of the serial, or the empty slot ending
+//			  its probe
+//Return	: True, if the serial is in the image
+//Return	: False, otherwise
+//Notes		: The slot is IMAGE_SLOT_NONE when the slots are damaged: one
+//			  names a record past the last one or none is empty
+//******************************************************************************
+static bool imageProbe(const IMAGE *pstImage, uint32 ulSerial, uint32 *pulSlot)
+{
+	const uint32 *pulSlots = pstImage->pulSlots;
+	const IMAGE_HEADER *pstHeader = pstImage->pstHeader;
+	uint32 ulMask = pstHeader->ulSlotCount - 1;
+	uint32 ulSlot = hashMix(ulSerial) & ulMask;
+	uint32 ulProbes = 0;
+	bool blFound = false;
+
+	*pulSlot = IMAGE_SLOT_NONE;
+	while(*pulSlot == IMAGE_SLOT_NONE && ulProbes < pstHeader->ulSlotCount &&
+		  pulSlots[ulSlot] <= pstHeader->ulRecordCount)
+	{
+		if(pulSlots[ulSlot] == IMAGE_EMPTY)
+		{
+			*pulSlot = ulSlot;
+		}
+		else if(pstImage->pstRecords[pulSlots[ulSlot] - 1].ulDeviceSerial ==
+				ulSerial)
+		{
+			*pulSlot = ulSlot;
+			blFound = true;
+		}
+		else
+		{
+			ulSlot = (ulSlot + 1) & ulMask;
+			ulProbes++;
+		}
+	}
+
+	return blFound;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To double the capacity of an image
+//Inputs	: pstImage, the image
+//Outputs	: pstImage, the image moved to the heap
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The image is unchanged in case of an error
+//******************************************************************************
+static bool imageGrow(IMAGE *pstImage)
+{
+	bool blReturn = false;
+	IMAGE stGrown;
+	uint32 ulIndex = 0;
+	uint32 ulSlot = 0;
+
+	blReturn = imageAllocate(pstImage->pstHeader->ulCapacity * 2, &stGrown);
+	if(blReturn == true)
+	{
+		stGrown.pstHeader->ulGeneration = pstImage->pstHeader->ulGeneration;
+		stGrown.pstHeader->ulSequence = pstImage->pstHeader->ulSequence;
+		stGrown.pstHeader->ulRecordCount = pstImage->pstHeader->ulRecordCount;
+		memcpy(stGrown.pstRecords, pstImage->pstRecords,
+			   pstImage->pstHeader->ulRecordCount * sizeof(DEVICE_DETAILS));
+		for(ulIndex = 0; ulIndex < stGrown.pstHeader->ulRecordCount; ulIndex++)
+		{
+			imageProbe(&stGrown, stGrown.pstRecords[ulIndex].ulDeviceSerial,
+					   &ulSlot);
+			stGrown.pulSlots[ulSlot] = ulIndex + 1;
+		}
+		imageClose(pstImage);
+		*pstImage = stGrown;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To add a device to an image or replace it
+//Inputs	: pstImage, the image
+//Inputs	: pstDeviceData, the device
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool imagePut(IMAGE *pstImage, const DEVICE_DETAILS *pstDeviceData)
+{
+	bool blReturn = true;
+	IMAGE_HEADER *pstHeader = pstImage->pstHeader;
+	uint32 ulSlot = 0;
+
+	if(imageProbe(pstImage, pstDeviceData->ulDeviceSerial, &ulSlot) == true)
+	{
+		pstImage->pstRecords[pstImage->pulSlots[ulSlot] - 1] = *pstDeviceData;
+	}
+	else if(ulSlot == IMAGE_SLOT_NONE)
+	{
+		blReturn = false;
+	}
+	else
+	{
+		if(pstHeader->ulRecordCount == pstHeader->ulCapacity)
+		{
+			blReturn = (imageGrow(pstImage) == true &&
+						imageProbe(pstImage, pstDeviceData->ulDeviceSerial,
+								   &ulSlot) != true);
+			pstHeader = pstImage->pstHeader;
+		}
+		if(blReturn == true)
+		{
+			pstImage->pstRecords[pstHeader->ulRecordCount] = *pstDeviceData;
+			pstImage->pulSlots[ulSlot] = ++pstHeader->ulRecordCount;
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove a device from an image
+//Inputs	: pstImage, the image
+//Inputs	: ulSerial, serial of the device
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, when the slots are damaged
+//Notes		: The slot is emptied by shifting its probe run back, the last
+//			  record takes the place of the removed one
+//******************************************************************************
+static bool imageDelete(IMAGE *pstImage, uint32 ulSerial)
+{
+	bool blReturn = true;
+	IMAGE_HEADER *pstHeader = pstImage->pstHeader;
+	uint32 ulMask = pstHeader->ulSlotCount - 1;
+	uint32 ulEmpty = 0;
+	uint32 ulNext = 0;
+	uint32 ulHome = 0;
+	uint32 ulRecord = 0;
+	uint32 ulLast = 0;
+	uint32 ulProbes = 0;
+
+	if(imageProbe(pstImage, ulSerial, &ulEmpty) == true)
+	{
+		ulRecord = pstImage->pulSlots[ulEmpty] - 1;
+		for(ulNext = (ulEmpty + 1) & ulMask;
+			pstImage->pulSlots[ulNext] != IMAGE_EMPTY && blReturn == true;
+			ulNext = (ulNext + 1) & ulMask)
+		{
+			blReturn = (++ulProbes < pstHeader->ulSlotCount &&
+						pstImage->pulSlots[ulNext] <= pstHeader->ulRecordCount);
+			if(blReturn == true)
+			{
+				ulHome = hashMix(pstImage->pstRecords[
+								 pstImage->pulSlots[ulNext] -
+								 1].ulDeviceSerial) & ulMask;
+				// Moved back unless its home lies after the empty slot
+				if(((ulNext - ulHome) & ulMask) >=
+				   ((ulNext - ulEmpty) & ulMask))
+				{
+					pstImage->pulSlots[ulEmpty] = pstImage->pulSlots[ulNext];
+					ulEmpty = ulNext;
+				}
+			}
+		}
+		pstImage->pulSlots[ulEmpty] = IMAGE_EMPTY;
+
+		ulLast = pstHeader->ulRecordCount - 1;
+		if(blReturn == true && ulRecord != ulLast)
+		{
+			blReturn = imageProbe(pstImage,
+								  pstImage->pstRecords[ulLast].ulDeviceSerial,
+								  &ulNext);
+			if(blReturn == true)
+			{
+				pstImage->pulSlots[ulNext] = ulRecord + 1;
+				pstImage->pstRecords[ulRecord] = pstImage->pstRecords[ulLast];
+			}
+		}
+		if(blReturn == true)
+		{
+			memset(&pstImage->pstRecords[ulLast], 0, sizeof(DEVICE_DETAILS));
+			pstHeader->ulRecordCount = ulLast;
+		}
+	}
+	else
+	{
+		blReturn = (ulEmpty != IMAGE_SLOT_NONE);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To apply a change feed entry to an image
+//Inputs	: pstImage, the image
+//Inputs	: pstEntry, the entry
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Applying an entry twice has no further effect
+//******************************************************************************
+static bool imageApply(IMAGE *pstImage, const FEED_ENTRY *pstEntry)
+{
+	bool blReturn = true;
+
+	if(pstEntry->ulOperation == FEED_REMOVE)
+	{
+		blReturn = imageDelete(pstImage, pstEntry->stDevice.ulDeviceSerial);
+	}
+	else if(pstEntry->ulOperation == FEED_ADD ||
+			pstEntry->ulOperation == FEED_UPDATE)
+	{
+		blReturn = imagePut(pstImage, &pstEntry->stDevice);
+	}
+	else
+	{
+		blReturn = false;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To count the records of the data files
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pulCount, number of records
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The caller holds the writer lock
+//******************************************************************************
+static bool imageCountRecords(const uint8 *pucFileName, uint32 *pulCount)
+{
+	bool blReturn = false;
+	SHARD_LAYOUT stLayout = {0};
+	struct stat stStat;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+
+	*pulCount = 0;
+	blReturn = shardGetLayout(pucFileName, &stLayout);
+	for(ulShard = 0; ulShard < stLayout.ulShardCount && blReturn == true;
+		ulShard++)
+	{
+		blReturn = shardGetPath(pucFileName, &stLayout, ulShard, pucPath);
+		if(blReturn == true && stat((char *)pucPath, &stStat) == 0)
+		{
+			*pulCount += stStat.st_size / sizeof(DEVICE_DETAILS);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To build the image of the device data
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pstImage, the image
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Holds the writer lock, so the devices, the generation and the
+//			  feed sequence match
+//******************************************************************************
+bool imageBuild(const uint8 *pucFileName, IMAGE *pstImage)
+{
+	bool blReturn = false;
+	DEVICE_DETAILS DeviceData = {0};
+	SNAPSHOT stSnapshot;
+	SNAPSHOT_WRITER stWriter;
+	SHARD_LAYOUT stLayout = {0};
+	uint32 ulCount = 0;
+	uint32 ulShard = 0;
+
+	if(pucFileName == NULL || pstImage == NULL)
+	{
+		return false;
+	}
+
+	memset(pstImage, 0, sizeof(IMAGE));
+	if(snapshotWriterBegin(pucFileName, &stWriter) == true)
+	{
+		if(shardAcquireSnapshot(pucFileName, &stSnapshot, &stLayout) == true)
+		{
+			for(ulShard = 0; ulShard < stSnapshot.ulFileCount; ulShard++)
+			{
+				ulCount += stSnapshot.pulRecordCounts[ulShard];
+			}
+			blReturn = imageAllocate(ulCount + ulCount /
+									 IMAGE_HEADROOM_DIVISOR +
+									 IMAGE_MIN_CAPACITY, pstImage);
+			if(blReturn == true)
+			{
+				pstImage->pstHeader->ulGeneration = stWriter.ulGeneration;
+				blReturn = feedGetLastSequence(
+						pucFileName, &pstImage->pstHeader->ulSequence);
+			}
+			for(ulShard = 0; ulShard < stSnapshot.ulFileCount; ulShard++)
+			{
+				while(blReturn == true &&
+					  snapshotRead(&stSnapshot, ulShard, &DeviceData) == true)
+				{
+					blReturn = imagePut(pstImage, &DeviceData);
+				}
+			}
+			snapshotRelease(&stSnapshot);
+		}
+		snapshotWriterEnd(&stWriter);
+	}
+
+	if(blReturn != true)
+	{
+		imageClose(pstImage);
+		printf("\nUnable to build the image of %s", (char *)pucFileName);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To save an image as the checkpoint of the device data
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstImage, the image
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The checkpoint is replaced at once
+//******************************************************************************
+bool imageSave(const uint8 *pucFileName, const IMAGE *pstImage)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	IMAGE_HEADER stHeader;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(pucFileName != NULL && pstImage != NULL && pstImage->pvBase != NULL &&
+	   fileBuildPath(pucPath, pucFileName, IMAGE_SUFFIX) == true &&
+	   fileBuildPath(pucTemporaryPath, pucPath,
+					 SNAPSHOT_TEMPORARY_SUFFIX) == true)
+	{
+		pstFile = fopen((char *)pucTemporaryPath, FILE_WRITE_MODE);
+	}
+
+	if(pstFile != NULL)
+	{
+		stHeader = *pstImage->pstHeader;
+		stHeader.ulBodyChecksum = crc32c(CRC_INITIAL, pstImage->pstRecords,
+										 pstImage->ulSize -
+										 sizeof(IMAGE_HEADER));
+		stHeader.ulChecksum = imageChecksum(&stHeader);
+		blReturn = (fwrite(&stHeader, sizeof(IMAGE_HEADER), WRITE_COUNT,
+						   pstFile) == WRITE_COUNT &&
+					fwrite(pstImage->pstRecords,
+						   pstImage->ulSize - sizeof(IMAGE_HEADER),
+						   WRITE_COUNT, pstFile) == WRITE_COUNT);
+		blReturn = (fclose(pstFile) == 0 && blReturn == true &&
+					rename((char *)pucTemporaryPath, (char *)pucPath) == 0);
+		if(blReturn != true)
+		{
+			remove((char *)pucTemporaryPath);
+		}
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to save the image of %s", (char *)pucFileName);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To load the checkpoint of the device data
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pstImage, the image, up to date with the device data
+//Return	: True, at time of successful execution
+//Return	: False, if there is no usable checkpoint
+//Notes		: The file is mapped privately, the changes replayed on it are
+//			  not written back. A checkpoint whose records or slots do not
+//			  match their checksum is not used.
+//******************************************************************************
+bool imageLoad(const uint8 *pucFileName, IMAGE *pstImage)
+{
+	bool blReturn = false;
+	IMAGE_HEADER *pstHeader = NULL;
+	struct stat stStat;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	int32 lFd = -1;
+
+	if(pucFileName == NULL || pstImage == NULL)
+	{
+		return false;
+	}
+
+	memset(pstImage, 0, sizeof(IMAGE));
+	if(fileBuildPath(pucPath, pucFileName, IMAGE_SUFFIX) == true)
+	{
+		lFd = open((char *)pucPath, O_RDONLY);
+	}
+
+	if(lFd >= 0)
+	{
+		if(fstat(lFd, &stStat) == 0 &&
+		   stStat.st_size >= (off_t)sizeof(IMAGE_HEADER))
+		{
+			pstImage->pvBase = mmap(NULL, stStat.st_size,
+									PROT_READ | PROT_WRITE, MAP_PRIVATE,
+									lFd, 0);
+			if(pstImage->pvBase != MAP_FAILED)
+			{
+				pstImage->ulSize = stStat.st_size;
+				pstImage->blMapped = true;
+				pstHeader = (IMAGE_HEADER *)pstImage->pvBase;
+			}
+			else
+			{
+				pstImage->pvBase = NULL;
+			}
+		}
+		close(lFd);
+	}
+
+	if(pstHeader != NULL && pstHeader->ulMagic == IMAGE_MAGIC &&
+	   pstHeader->ulChecksum == imageChecksum(pstHeader) &&
+	   pstHeader->ulRecordCount <= pstHeader->ulCapacity &&
+	   pstHeader->ulSlotCount >= pstHeader->ulCapacity * IMAGE_LOAD_FACTOR &&
+	   (pstHeader->ulSlotCount & (pstHeader->ulSlotCount - 1)) == 0 &&
+	   pstImage->ulSize == imageSize(pstHeader->ulCapacity,
+									 pstHeader->ulSlotCount) &&
+	   pstHeader->ulBodyChecksum ==
+	   crc32c(CRC_INITIAL, pstHeader + 1,
+			  pstImage->ulSize - sizeof(IMAGE_HEADER)))
+	{
+		imageLocate(pstImage);
+		blReturn = imageCatchUp(pucFileName, pstImage);
+	}
+
+	if(blReturn != true)
+	{
+		imageClose(pstImage);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To bring an image up to date with the device data
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstImage, the image
+//Outputs	: pstImage, the image at the current generation
+//Return	: True, at time of successful execution
+//Return	: False, if the image cannot be brought up to date
+//Notes		: Replays the feed entries after the image sequence under the
+//			  writer lock, nothing is read while the generation has not
+//			  moved
+//******************************************************************************
+bool imageCatchUp(const uint8 *pucFileName, IMAGE *pstImage)
+{
+	bool blReturn = false;
+	FEED_ENTRY pstEntries[IMAGE_FEED_BATCH];
+	SNAPSHOT_WRITER stWriter;
+	uint32 ulBatch = IMAGE_FEED_BATCH;
+	uint32 ulIndex = 0;
+	uint32 ulCount = 0;
+
+	if(pucFileName == NULL || pstImage == NULL || pstImage->pvBase == NULL ||
+	   snapshotWriterBegin(pucFileName, &stWriter) != true)
+	{
+		return false;
+	}
+
+	blReturn = true;
+	if(pstImage->pstHeader->ulGeneration != stWriter.ulGeneration)
+	{
+		while(blReturn == true && ulBatch == IMAGE_FEED_BATCH)
+		{
+			blReturn = feedRead(pucFileName,
+								pstImage->pstHeader->ulSequence + 1,
+								pstEntries, IMAGE_FEED_BATCH, &ulBatch);
+			for(ulIndex = 0; ulIndex < ulBatch && blReturn == true; ulIndex++)
+			{
+				blReturn = imageApply(pstImage, &pstEntries[ulIndex]);
+				pstImage->pstHeader->ulSequence++;
+			}
+		}
+
+		// A feed cut short or replaced does not add up to the data files
+		blReturn = (blReturn == true &&
+					imageCountRecords(pucFileName, &ulCount) == true &&
+					ulCount == pstImage->pstHeader->ulRecordCount);
+		if(blReturn == true)
+		{
+			pstImage->pstHeader->ulGeneration = stWriter.ulGeneration;
+		}
+	}
+	snapshotWriterEnd(&stWriter);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the device with a given serial from an image
+//Inputs	: pstImage, the image
+//Inputs	: ulSerial, serial of the device
+//Outputs	: pstDeviceData, the device
+//Outputs	: pblFound, whether the device is in the image
+//Return	: True, at time of successful execution
+//Return	: False, when the image is damaged
+//Notes		: A damaged image has to be built again
+//******************************************************************************
+bool imageFind(const IMAGE *pstImage, uint32 ulSerial,
+			   DEVICE_DETAILS *pstDeviceData, bool *pblFound)
+{
+	bool blReturn = false;
+	uint32 ulSlot = 0;
+
+	if(pstImage != NULL && pstImage->pvBase != NULL && pstDeviceData != NULL &&
+	   pblFound != NULL)
+	{
+		*pblFound = imageProbe(pstImage, ulSerial, &ulSlot);
+		blReturn = (ulSlot != IMAGE_SLOT_NONE);
+		if(*pblFound == true)
+		{
+			*pstDeviceData = pstImage->pstRecords[pstImage->pulSlots[ulSlot] -
+												  1];
+			blReturn = deviceCheckRecord(pstDeviceData);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To release an image
+//Inputs	: pstImage, the image
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+void imageClose(IMAGE *pstImage)
+{
+	if(pstImage != NULL && pstImage->pvBase != NULL)
+	{
+		if(pstImage->blMapped == true)
+		{
+			munmap(pstImage->pvBase, pstImage->ulSize);
+		}
+		else
+		{
+			free(pstImage->pvBase);
+		}
+	}
+	if(pstImage != NULL)
+	{
+		memset(pstImage, 0, sizeof(IMAGE));
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write the checkpoint of the device data
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool imageCheckpoint(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	IMAGE stImage = {0};
+	struct timespec stStart;
+	struct timespec stEnd;
+	double dSeconds = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &stStart);
+	blReturn = (imageBuild(pucFileName, &stImage) == true &&
+				imageSave(pucFileName, &stImage) == true);
+	clock_gettime(CLOCK_MONOTONIC, &stEnd);
+	dSeconds = (stEnd.tv_sec - stStart.tv_sec) +
+			   (stEnd.tv_nsec - stStart.tv_nsec) / IMAGE_NANOSECONDS;
+	if(blReturn == true)
+	{
+		printf("Checkpoint of %lu device(s) at sequence %lu written"
+			   " (%.3f ms)\n", stImage.pstHeader->ulRecordCount,
+			   stImage.pstHeader->ulSequence, dSeconds * IMAGE_MILLISECONDS);
+	}
+	imageClose(&stImage);
+
+	return blReturn;
+}
+// EOF
@@ -0,0 +1,64 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Checkpointed memory image of the device data
+// Note		: The devices and their serial table, saved as one file that is
+//			  mapped back at start up and brought up to date with the
+//			  change feed
+//
+//******************************************************************************
+
+#ifndef _IMAGE_H_
+#define _IMAGE_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "feed.h"
+
+//******************************* Global Types *********************************
+// Followed by ulCapacity records and ulSlotCount slots, holding offsets only
+typedef struct _IMAGE_HEADER_
+{
+	uint32 ulMagic;
+	uint32 ulGeneration;
+	uint32 ulSequence;
+	uint32 ulRecordCount;
+	uint32 ulCapacity;
+	uint32 ulSlotCount;
+	uint32 ulBodyChecksum;
+	uint32 ulChecksum;
+} IMAGE_HEADER;
+
+typedef struct _IMAGE_
+{
+	void *pvBase;
+	uint32 ulSize;
+	bool blMapped;
+	IMAGE_HEADER *pstHeader;
+	DEVICE_DETAILS *pstRecords;
+	uint32 *pulSlots;
+} IMAGE;
+
+//***************************** Global Constants *******************************
+#define IMAGE_SUFFIX		(".image")
+#define IMAGE_MAGIC			(0x4547414DUL)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool imageBuild(const uint8 *pucFileName, IMAGE *pstImage);
+bool imageSave(const uint8 *pucFileName, const IMAGE *pstImage);
+bool imageLoad(const uint8 *pucFileName, IMAGE *pstImage);
+bool imageCatchUp(const uint8 *pucFileName, IMAGE *pstImage);
+bool imageFind(const IMAGE *pstImage, uint32 ulSerial,
+			   DEVICE_DETAILS *pstDeviceData, bool *pblFound);
+void imageClose(IMAGE *pstImage);
+bool imageCheckpoint(const uint8 *pucFileName);
+
+#endif // _IMAGE_H_
+// EOF
@@ -0,0 +1,622 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: index.c
+// Summary	: Persisted serial number index of a data file
+// Note		: Linear probing hash table stored in "<data file>.idx" and
+//			  accessed slot by slot through the page pool, so a lookup costs
+//			  a couple of small reads whatever the size of the data file,
+//			  none when its pages are cached. The
+//			  header records the inode, size and modification time of the
+//			  data file it describes; an index not matching its data file is
+//			  rebuilt on open. Writers keeping the index up to date call
+//			  indexSync() after changing the data file.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "hash.h"
+#include "index.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define READ_COUNT			(1)
+#define FILE_PERMISSIONS	(0644)
+#define INDEX_EMPTY			(0)
+#define INDEX_PROBE_WINDOW	(8)
+#define INDEX_LOAD_FACTOR	(2)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To get the file offset of a slot
+//Inputs	: ulSlot, index of the slot
+//Outputs	: None
+//Return	: Offset of the slot in the index file
+//Notes		:
+//******************************************************************************
+static off_t indexSlotOffset(uint32 ulSlot)
+{
+	return (off_t)sizeof(INDEX_HEADER) + (off_t)ulSlot * sizeof(INDEX_SLOT);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write the header of the index
+//Inputs	: pstIndex, the index
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool indexWriteHeader(INDEX *pstIndex)
+{
+	return filePageWrite(pstIndex->lFd, &pstIndex->stHeader,
+						 sizeof(INDEX_HEADER), 0);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write a whole table of slots as the new index content
+//Inputs	: pstIndex, the index
+//Inputs	: pstSlots, the slots
+//Inputs	: ulCapacity, number of slots
+//Inputs	: ulCount, number of used slots
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The table is written directly, the cached pages being dropped
+//******************************************************************************
+static bool indexWriteTable(INDEX *pstIndex, const INDEX_SLOT *pstSlots,
+							uint32 ulCapacity, uint32 ulCount)
+{
+	bool blReturn = false;
+	size_t ulBytes = (size_t)ulCapacity * sizeof(INDEX_SLOT);
+
+	pstIndex->stHeader.ulMagic = INDEX_MAGIC;
+	pstIndex->stHeader.ulCapacity = ulCapacity;
+	pstIndex->stHeader.ulCount = ulCount;
+
+	blReturn = (filePageTruncate(pstIndex->lFd, 0) == true &&
+				ftruncate(pstIndex->lFd, indexSlotOffset(ulCapacity)) == 0 &&
+				pwrite(pstIndex->lFd, pstSlots, ulBytes, indexSlotOffset(0)) ==
+				(ssize_t)ulBytes &&
+				indexWriteHeader(pstIndex) == true);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To put a key into an in memory table of slots
+//Inputs	: pstSlots, the slots
+//Inputs	: ulCapacity, number of slots, a power of two
+//Inputs	: ulKey, the key
+//Inputs	: ulValue, the stored value, slot of the record plus one
+//Outputs	: None
+//Return	: True, if the key is new
+//Return	: False, if the value of an existing key has been replaced
+//Notes		:
+//******************************************************************************
+static bool indexPlace(INDEX_SLOT *pstSlots, uint32 ulCapacity, uint32 ulKey,
+						uint32 ulValue)
+{
+	uint32 ulMask = ulCapacity - 1;
+	uint32 ulSlot = hashMix(ulKey) & ulMask;
+
+	while(pstSlots[ulSlot].ulValue != INDEX_EMPTY &&
+		  pstSlots[ulSlot].ulKey != ulKey)
+	{
+		ulSlot = (ulSlot + 1) & ulMask;
+	}
+
+	pstSlots[ulSlot].ulKey = ulKey;
+	if(pstSlots[ulSlot].ulValue == INDEX_EMPTY)
+	{
+		pstSlots[ulSlot].ulValue = ulValue;
+		return true;
+	}
+	pstSlots[ulSlot].ulValue = ulValue;
+	return false;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To get the number of slots needed for a number of keys
+//Inputs	: ulCount, number of keys
+//Outputs	: None
+//Return	: Number of slots, a power of two
+//Notes		: The table is kept at most half full
+//******************************************************************************
+static uint32 indexCapacity(uint32 ulCount)
+{
+	uint32 ulCapacity = INDEX_MIN_CAPACITY;
+
+	while(ulCapacity < ulCount * INDEX_LOAD_FACTOR)
+	{
+		ulCapacity *= 2;
+	}
+
+	return ulCapacity;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To rebuild the index from its data file
+//Inputs	: pucDataPath, name of the data file
+//Inputs	: pstIndex, the open index
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: One sequential pass over the data file
+//******************************************************************************
+static bool indexBuild(const uint8 *pucDataPath, INDEX *pstIndex)
+{
+	bool blReturn = true;
+	DEVICE_DETAILS DeviceData = {0};
+	FILE *pstFile = NULL;
+	INDEX_SLOT *pstSlots = NULL;
+	uint32 ulRecords = 0;
+	uint32 ulCapacity = 0;
+	uint32 ulCount = 0;
+	uint32 ulSlot = 0;
+
+	fileGetIdentity(pucDataPath, &pstIndex->stHeader.stData);
+	ulRecords = pstIndex->stHeader.stData.ulSize / sizeof(DEVICE_DETAILS);
+	ulCapacity = indexCapacity(ulRecords);
+	pstSlots = calloc(ulCapacity, sizeof(INDEX_SLOT));
+	blReturn = (pstSlots != NULL);
+
+	if(blReturn == true && ulRecords > 0)
+	{
+		pstFile = fileOpen(pucDataPath, FILE_READ_MODE);
+		blReturn = (pstFile != NULL);
+		while(blReturn == true && ulSlot < ulRecords &&
+			  fileRead(&DeviceData, sizeof(DeviceData),
+					   READ_COUNT, pstFile) == true)
+		{
+			ulCount += indexPlace(pstSlots, ulCapacity,
+								  DeviceData.ulDeviceSerial, ulSlot + 1);
+			ulSlot++;
+		}
+		if(pstFile != NULL)
+		{
+			fileClose(pstFile);
+		}
+	}
+
+	if(blReturn == true)
+	{
+		blReturn = indexWriteTable(pstIndex, pstSlots, ulCapacity, ulCount);
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to build the serial index of %s", (char *)pucDataPath);
+	}
+	free(pstSlots);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To double the number of slots of the index
+//Inputs	: pstIndex, the index
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The dirty slots are written back first, the old table is then
+//			  read directly
+//******************************************************************************
+static bool indexGrow(INDEX *pstIndex)
+{
+	bool blReturn = false;
+	INDEX_SLOT *pstOldSlots = NULL;
+	INDEX_SLOT *pstNewSlots = NULL;
+	uint32 ulOldCapacity = pstIndex->stHeader.ulCapacity;
+	uint32 ulNewCapacity = ulOldCapacity * 2;
+	size_t ulBytes = (size_t)ulOldCapacity * sizeof(INDEX_SLOT);
+	uint32 ulSlot = 0;
+
+	pstOldSlots = malloc(ulBytes);
+	pstNewSlots = calloc(ulNewCapacity, sizeof(INDEX_SLOT));
+	if(pstOldSlots != NULL && pstNewSlots != NULL &&
+	   filePageFlush(pstIndex->lFd) == true &&
+	   pread(pstIndex->lFd, pstOldSlots, ulBytes, indexSlotOffset(0)) ==
+	   (ssize_t)ulBytes)
+	{
+		for(ulSlot = 0; ulSlot < ulOldCapacity; ulSlot++)
+		{
+			if(pstOldSlots[ulSlot].ulValue != INDEX_EMPTY)
+			{
+				indexPlace(pstNewSlots, ulNewCapacity,
+						   pstOldSlots[ulSlot].ulKey,
+						   pstOldSlots[ulSlot].ulValue);
+			}
+		}
+		blReturn = indexWriteTable(pstIndex, pstNewSlots, ulNewCapacity,
+								   pstIndex->stHeader.ulCount);
+	}
+	free(pstOldSlots);
+	free(pstNewSlots);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the slot of a key or the free slot where it belongs
+//Inputs	: pstIndex, the index
+//Inputs	: ulKey, the key
+//Outputs	: pulSlot, index of the slot
+//Outputs	: pstSlot, content of the slot
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Slots are read a few at a time along the probe sequence
+//******************************************************************************
+static bool indexProbe(INDEX *pstIndex, uint32 ulKey, uint32 *pulSlot,
+						INDEX_SLOT *pstSlot)
+{
+	bool blReturn = true;
+	bool blFound = false;
+	INDEX_SLOT pstWindow[INDEX_PROBE_WINDOW];
+	uint32 ulMask = pstIndex->stHeader.ulCapacity - 1;
+	uint32 ulSlot = hashMix(ulKey) & ulMask;
+	uint32 ulWindow = 0;
+	uint32 ulIndex = 0;
+
+	while(blReturn == true && blFound != true)
+	{
+		// Read up to the end of the table, the probe then wraps around
+		ulWindow = pstIndex->stHeader.ulCapacity - ulSlot;
+		if(ulWindow > INDEX_PROBE_WINDOW)
+		{
+			ulWindow = INDEX_PROBE_WINDOW;
+		}
+		blReturn = filePageRead(pstIndex->lFd, pstWindow,
+								ulWindow * sizeof(INDEX_SLOT),
+								indexSlotOffset(ulSlot));
+
+		for(ulIndex = 0; ulIndex < ulWindow && blReturn == true &&
+			blFound != true; ulIndex++)
+		{
+			if(pstWindow[ulIndex].ulValue == INDEX_EMPTY ||
+			   pstWindow[ulIndex].ulKey == ulKey)
+			{
+				*pulSlot = ulSlot + ulIndex;
+				*pstSlot = pstWindow[ulIndex];
+				blFound = true;
+			}
+		}
+		ulSlot = (ulSlot + ulWindow) & ulMask;
+	}
+
+	return blReturn;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open the serial index of a data file
+//Inputs	: pucDataPath, name of the data or shard file
+//Outputs	: pstIndex, the open index
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A missing or outdated index is rebuilt. The caller has to be
+//			  the only writer of the data file.
+//******************************************************************************
+bool indexOpen(const uint8 *pucDataPath, INDEX *pstIndex)
+{
+	bool blReturn = false;
+	uint8 pucIndexPath[FILE_PATH_MAX_SIZE] = "";
+	FILE_IDENTITY stCurrent = {0};
+
+	if(pucDataPath != NULL && pstIndex != NULL)
+	{
+		pstIndex->lFd = INDEX_INVALID_FD;
+		if(fileBuildPath(pucIndexPath, pucDataPath, INDEX_SUFFIX) == true)
+		{
+			pstIndex->lFd = open((char *)pucIndexPath, O_RDWR | O_CREAT,
+								 FILE_PERMISSIONS);
+		}
+
+		if(pstIndex->lFd >= 0)
+		{
+			filePageAttach(pstIndex->lFd);
+			fileGetIdentity(pucDataPath, &stCurrent);
+			if(filePageRead(pstIndex->lFd, &pstIndex->stHeader,
+							sizeof(INDEX_HEADER), 0) == true &&
+			   pstIndex->stHeader.ulMagic == INDEX_MAGIC &&
+			   fileSameIdentity(&pstIndex->stHeader.stData,
+								&stCurrent) == true)
+			{
+				blReturn = true;
+			}
+			else
+			{
+				blReturn = indexBuild(pucDataPath, pstIndex);
+			}
+
+			if(blReturn != true)
+			{
+				indexClose(pstIndex);
+			}
+		}
+		else
+		{
+			pstIndex->lFd = INDEX_INVALID_FD;
+			printf("\nUnable to open the serial index : Open failed");
+		}
+	}
+	else
+	{
+		printf("\nUnable to open the serial index : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open the serial index of a data file for lookups only
+//Inputs	: pucDataPath, name of the data or shard file
+//Outputs	: pstIndex, the open index
+//Return	: True, at time of successful execution
+//Return	: False, if there is no index or in case of an error
+//Notes		: Never rebuilt, indexIsCurrent() tells whether it can be used
+//******************************************************************************
+bool indexAttach(const uint8 *pucDataPath, INDEX *pstIndex)
+{
+	bool blReturn = false;
+	uint8 pucIndexPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(pucDataPath != NULL && pstIndex != NULL)
+	{
+		pstIndex->lFd = INDEX_INVALID_FD;
+		memset(&pstIndex->stHeader, 0, sizeof(INDEX_HEADER));
+		if(fileBuildPath(pucIndexPath, pucDataPath, INDEX_SUFFIX) == true &&
+		   fileExists(pucIndexPath) == true)
+		{
+			pstIndex->lFd = open((char *)pucIndexPath, O_RDONLY);
+			if(pstIndex->lFd < 0)
+			{
+				pstIndex->lFd = INDEX_INVALID_FD;
+			}
+			else
+			{
+				filePageAttach(pstIndex->lFd);
+			}
+		}
+		blReturn = (pstIndex->lFd != INDEX_INVALID_FD);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To tell whether an index describes a data file
+//Inputs	: pstIndex, the index
+//Inputs	: pstData, identity of the data file
+//Outputs	: None
+//Return	: True, if the index describes the data file
+//Return	: False, if it does not or in case of an error
+//Notes		: The header is read again, so the lookups that follow use the
+//			  current capacity, after dropping the cached pages of an index
+//			  changed by a writer
+//******************************************************************************
+bool indexIsCurrent(INDEX *pstIndex, const FILE_IDENTITY *pstData)
+{
+	bool blReturn = false;
+
+	if(pstIndex != NULL && pstData != NULL &&
+	   pstIndex->lFd != INDEX_INVALID_FD)
+	{
+		filePageRefresh(pstIndex->lFd);
+		blReturn = (filePageRead(pstIndex->lFd, &pstIndex->stHeader,
+								 sizeof(INDEX_HEADER), 0) == true &&
+					pstIndex->stHeader.ulMagic == INDEX_MAGIC &&
+					pstIndex->stHeader.ulCapacity > 0 &&
+					fileSameIdentity(&pstIndex->stHeader.stData,
+									 pstData) == true);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the record slot of a serial
+//Inputs	: pstIndex, the index
+//Inputs	: ulKey, the serial
+//Outputs	: pulSlot, the record slot in the data file
+//Return	: True, if the serial is indexed
+//Return	: False, if the serial is not indexed or in case of an error
+//Notes		:
+//******************************************************************************
+bool indexFind(INDEX *pstIndex, uint32 ulKey, uint32 *pulSlot)
+{
+	bool blReturn = false;
+	INDEX_SLOT stSlot = {0};
+	uint32 ulSlot = 0;
+
+	if(pstIndex != NULL && pulSlot != NULL &&
+	   pstIndex->lFd != INDEX_INVALID_FD &&
+	   indexProbe(pstIndex, ulKey, &ulSlot, &stSlot) == true &&
+	   stSlot.ulValue != INDEX_EMPTY)
+	{
+		*pulSlot = stSlot.ulValue - 1;
+		blReturn = true;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To index a serial or to change its record slot
+//Inputs	: pstIndex, the index
+//Inputs	: ulKey, the serial
+//Inputs	: ulSlot, the record slot in the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The table doubles when it gets half full
+//******************************************************************************
+bool indexInsert(INDEX *pstIndex, uint32 ulKey, uint32 ulSlot)
+{
+	bool blReturn = false;
+	INDEX_SLOT stSlot = {0};
+	uint32 ulTableSlot = 0;
+
+	if(pstIndex != NULL && pstIndex->lFd != INDEX_INVALID_FD)
+	{
+		blReturn = true;
+		if((pstIndex->stHeader.ulCount + 1) * INDEX_LOAD_FACTOR >
+		   pstIndex->stHeader.ulCapacity)
+		{
+			blReturn = indexGrow(pstIndex);
+		}
+
+		if(blReturn == true)
+		{
+			blReturn = indexProbe(pstIndex, ulKey, &ulTableSlot, &stSlot);
+		}
+
+		if(blReturn == true)
+		{
+			if(stSlot.ulValue == INDEX_EMPTY)
+			{
+				pstIndex->stHeader.ulCount++;
+			}
+			stSlot.ulKey = ulKey;
+			stSlot.ulValue = ulSlot + 1;
+			blReturn = (filePageWrite(pstIndex->lFd, &stSlot, sizeof(stSlot),
+									  indexSlotOffset(ulTableSlot)) == true &&
+						indexWriteHeader(pstIndex) == true);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove a serial from the index
+//Inputs	: pstIndex, the index
+//Inputs	: ulKey, the serial
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The following slots of the probe cluster are shifted back
+//******************************************************************************
+bool indexRemove(INDEX *pstIndex, uint32 ulKey)
+{
+	bool blReturn = false;
+	INDEX_SLOT stSlot = {0};
+	INDEX_SLOT stEmpty = {0};
+	uint32 ulMask = 0;
+	uint32 ulGap = 0;
+	uint32 ulSlot = 0;
+	uint32 ulHome = 0;
+
+	if(pstIndex != NULL && pstIndex->lFd != INDEX_INVALID_FD &&
+	   indexProbe(pstIndex, ulKey, &ulGap, &stSlot) == true)
+	{
+		blReturn = true;
+		if(stSlot.ulValue != INDEX_EMPTY)
+		{
+			ulMask = pstIndex->stHeader.ulCapacity - 1;
+			ulSlot = (ulGap + 1) & ulMask;
+			blReturn = filePageRead(pstIndex->lFd, &stSlot, sizeof(stSlot),
+									indexSlotOffset(ulSlot));
+			while(blReturn == true && stSlot.ulValue != INDEX_EMPTY)
+			{
+				ulHome = hashMix(stSlot.ulKey) & ulMask;
+				// Move the slot when the gap lies on its probe path
+				if(((ulSlot - ulHome) & ulMask) >= ((ulSlot - ulGap) & ulMask))
+				{
+					blReturn = filePageWrite(pstIndex->lFd, &stSlot,
+											 sizeof(stSlot),
+											 indexSlotOffset(ulGap));
+					ulGap = ulSlot;
+				}
+				ulSlot = (ulSlot + 1) & ulMask;
+				if(blReturn == true)
+				{
+					blReturn = filePageRead(pstIndex->lFd, &stSlot,
+											sizeof(stSlot),
+											indexSlotOffset(ulSlot));
+				}
+			}
+
+			if(blReturn == true)
+			{
+				pstIndex->stHeader.ulCount--;
+				blReturn = (filePageWrite(pstIndex->lFd, &stEmpty,
+										  sizeof(stEmpty),
+										  indexSlotOffset(ulGap)) == true &&
+							indexWriteHeader(pstIndex) == true);
+			}
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To mark the index as describing the current data file
+//Inputs	: pstIndex, the index
+//Inputs	: pucDataPath, name of the data or shard file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Called after the data file and the index have been changed
+//			  consistently. The slots are written back before the header
+//			  naming the data file, so no reader sees it over old slots.
+//******************************************************************************
+bool indexSync(INDEX *pstIndex, const uint8 *pucDataPath)
+{
+	bool blReturn = false;
+
+	if(pstIndex != NULL && pucDataPath != NULL &&
+	   pstIndex->lFd != INDEX_INVALID_FD)
+	{
+		fileGetIdentity(pucDataPath, &pstIndex->stHeader.stData);
+		blReturn = (filePageFlush(pstIndex->lFd) == true &&
+					indexWriteHeader(pstIndex) == true &&
+					filePageFlush(pstIndex->lFd) == true);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To close the index
+//Inputs	: pstIndex, the index
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The slots changed since the last indexSync() are written back
+//******************************************************************************
+bool indexClose(INDEX *pstIndex)
+{
+	bool blReturn = false;
+
+	if(pstIndex != NULL && pstIndex->lFd != INDEX_INVALID_FD)
+	{
+		blReturn = filePageClose(pstIndex->lFd);
+		pstIndex->lFd = INDEX_INVALID_FD;
+	}
+
+	return blReturn;
+}
+// EOF
@@ -0,0 +1,61 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Persisted serial number index of a data file
+// Note		: On disk hash table mapping the serial of each device to its
+//			  record slot, so a device is found without scanning the file
+//
+//******************************************************************************
+
+#ifndef _INDEX_H_
+#define _INDEX_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "file.h"
+
+//******************************* Global Types *********************************
+typedef struct _INDEX_HEADER_
+{
+	uint32 ulMagic;
+	FILE_IDENTITY stData;
+	uint32 ulCapacity;
+	uint32 ulCount;
+} INDEX_HEADER;
+
+typedef struct _INDEX_SLOT_
+{
+	uint32 ulKey;
+	uint32 ulValue;
+} INDEX_SLOT;
+
+typedef struct _INDEX_
+{
+	int32 lFd;
+	INDEX_HEADER stHeader;
+} INDEX;
+
+//***************************** Global Constants *******************************
+#define INDEX_SUFFIX		(".idx")
+#define INDEX_MAGIC			(0x58444953UL)
+#define INDEX_MIN_CAPACITY	(1024)
+#define INDEX_INVALID_FD	(-1)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool indexOpen(const uint8 *pucDataPath, INDEX *pstIndex);
+bool indexAttach(const uint8 *pucDataPath, INDEX *pstIndex);
+bool indexIsCurrent(INDEX *pstIndex, const FILE_IDENTITY *pstData);
+bool indexFind(INDEX *pstIndex, uint32 ulKey, uint32 *pulSlot);
+bool indexInsert(INDEX *pstIndex, uint32 ulKey, uint32 ulSlot);
+bool indexRemove(INDEX *pstIndex, uint32 ulKey);
+bool indexSync(INDEX *pstIndex, const uint8 *pucDataPath);
+bool indexClose(INDEX *pstIndex);
+
+#endif // _INDEX_H_
+// EOF
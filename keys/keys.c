@@ -0,0 +1,616 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: keys.c
+// Summary	: Normalized device names and types
+// Note		: "<data file>.keys" holds, for every record slot, the name and
+//			  the type folded to lower case, leading and trailing blanks
+//			  removed and inner runs of blanks replaced by one space. The
+//			  keys are computed when a record is written, a search compares
+//			  them as they are. Writers keep the keys of a data file they
+//			  describe, other keys are rebuilt by the next search. A writer
+//			  clears the data identity of the header before changing any
+//			  key and sets it back once done, a search seeing the identity
+//			  change while it read the keys searches the records instead.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "keys.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define WRITE_COUNT				(1)
+#define KEYS_READ_RECORDS		(8192)
+#define KEYS_SPACE				(' ')
+#define KEYS_TEMPORARY_FORMAT	(".tmp.%d")
+#define KEYS_SUFFIX_SIZE		(32)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To give the offset of the key of a record slot
+//Inputs	: ulSlot, the record slot
+//Outputs	: None
+//Return	: Offset of the key in the keys file
+//Notes		:
+//******************************************************************************
+static off_t keysGetOffset(uint32 ulSlot)
+{
+	return (off_t)sizeof(KEYS_HEADER) + (off_t)ulSlot * sizeof(KEYS_ENTRY);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compute the keys of consecutive records
+//Inputs	: lDataFd, the data file
+//Inputs	: ulFirst and ulCount, the first record and number of records
+//Outputs	: pstRecords, the records
+//Outputs	: pstEntries, their keys
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool keysCompute(int32 lDataFd, uint32 ulFirst, uint32 ulCount,
+						DEVICE_DETAILS *pstRecords, KEYS_ENTRY *pstEntries)
+{
+	bool blReturn = false;
+	uint32 ulIndex = 0;
+
+	blReturn = filePageScan(lDataFd, pstRecords,
+							ulCount * sizeof(DEVICE_DETAILS),
+							ulFirst * sizeof(DEVICE_DETAILS));
+	for(ulIndex = 0; ulIndex < ulCount && blReturn == true; ulIndex++)
+	{
+		keysNormalize(pstRecords[ulIndex].pucDeviceName,
+					  pstEntries[ulIndex].pucName);
+		keysNormalize(pstRecords[ulIndex].pucDeviceType,
+					  pstEntries[ulIndex].pucType);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To build the keys of a data file
+//Inputs	: lDataFd, the data file
+//Inputs	: pstData, its identity
+//Inputs	: pucPath, name of the keys file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Written to a temporary file of the process and renamed, so
+//			  concurrent searches may rebuild the same keys
+//******************************************************************************
+static bool keysBuild(int32 lDataFd, const FILE_IDENTITY *pstData,
+					  const uint8 *pucPath)
+{
+	bool blReturn = false;
+	KEYS_HEADER stHeader = {0};
+	DEVICE_DETAILS *pstRecords = NULL;
+	KEYS_ENTRY *pstEntries = NULL;
+	FILE *pstFile = NULL;
+	char pcSuffix[KEYS_SUFFIX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulFirst = 0;
+	uint32 ulCount = 0;
+
+	stHeader.ulMagic = KEYS_MAGIC;
+	stHeader.stData = *pstData;
+	stHeader.ulRecordCount = pstData->ulSize / sizeof(DEVICE_DETAILS);
+
+	pstRecords = malloc(KEYS_READ_RECORDS * sizeof(DEVICE_DETAILS));
+	pstEntries = malloc(KEYS_READ_RECORDS * sizeof(KEYS_ENTRY));
+	snprintf(pcSuffix, sizeof(pcSuffix), KEYS_TEMPORARY_FORMAT, getpid());
+	if(pstRecords != NULL && pstEntries != NULL &&
+	   fileBuildPath(pucTemporaryPath, pucPath, (uint8 *)pcSuffix) == true)
+	{
+		pstFile = fopen((char *)pucTemporaryPath, FILE_WRITE_MODE);
+		blReturn = (pstFile != NULL &&
+					fwrite(&stHeader, sizeof(stHeader), WRITE_COUNT,
+						   pstFile) == WRITE_COUNT);
+		for(ulFirst = 0; ulFirst < stHeader.ulRecordCount &&
+			blReturn == true; ulFirst += ulCount)
+		{
+			ulCount = stHeader.ulRecordCount - ulFirst;
+			if(ulCount > KEYS_READ_RECORDS)
+			{
+				ulCount = KEYS_READ_RECORDS;
+			}
+			blReturn = (keysCompute(lDataFd, ulFirst, ulCount, pstRecords,
+									pstEntries) == true &&
+						fwrite(pstEntries, ulCount * sizeof(KEYS_ENTRY),
+							   WRITE_COUNT, pstFile) == WRITE_COUNT);
+		}
+
+		if(pstFile != NULL)
+		{
+			blReturn = (fclose(pstFile) == 0 && blReturn == true &&
+						rename((char *)pucTemporaryPath,
+							   (char *)pucPath) == 0);
+			if(blReturn != true)
+			{
+				remove((char *)pucTemporaryPath);
+			}
+		}
+	}
+
+	free(pstRecords);
+	free(pstEntries);
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to build the search keys %s", (char *)pucPath);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open the keys of a pinned data file
+//Inputs	: pucDataPath, name of the data or shard file
+//Inputs	: pstData, the pinned data file
+//Outputs	: plFd, the open keys
+//Outputs	: pstHeader, their header
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Missing or outdated keys are first rebuilt
+//******************************************************************************
+static bool keysLoad(const uint8 *pucDataPath, FILE *pstData, int32 *plFd,
+					 KEYS_HEADER *pstHeader)
+{
+	bool blReturn = false;
+	bool blBuilt = false;
+	FILE_IDENTITY stIdentity = {0};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	fileGetOpenIdentity(pstData, &stIdentity);
+	if(fileBuildPath(pucPath, pucDataPath, KEYS_SUFFIX) == true)
+	{
+		do
+		{
+			*plFd = open((char *)pucPath, O_RDONLY);
+			blReturn = (*plFd >= 0 && filePageAttach(*plFd) == true &&
+						filePageRead(*plFd, pstHeader, sizeof(KEYS_HEADER),
+									 0) == true &&
+						pstHeader->ulMagic == KEYS_MAGIC &&
+						fileSameIdentity(&pstHeader->stData,
+										 &stIdentity) == true);
+			if(blReturn != true && *plFd >= 0)
+			{
+				filePageClose(*plFd);
+				*plFd = KEYS_INVALID_FD;
+			}
+
+			if(blReturn != true && blBuilt != true)
+			{
+				blBuilt = keysBuild(fileno(pstData), &stIdentity, pucPath);
+				if(blBuilt != true)
+				{
+					break;
+				}
+			}
+			else
+			{
+				break;
+			}
+		} while(true);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To collect the records of a file whose key is a given one
+//Inputs	: lKeysFd, the keys of the file, KEYS_INVALID_FD to compute them
+//Inputs	: lDataFd and ulRecordCount, the data file and its records
+//Inputs	: ulField, KEYS_FIELD_NAME or KEYS_FIELD_TYPE
+//Inputs	: pucKey, the normalized name or type, NUL padded
+//Outputs	: pstResult, the matching records appended
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Records are only read for the chunks holding a match
+//******************************************************************************
+static bool keysSearchFile(int32 lKeysFd, int32 lDataFd, uint32 ulRecordCount,
+						   uint32 ulField, const uint8 *pucKey,
+						   SHARD_RESULT *pstResult)
+{
+	bool blReturn = false;
+	bool blRead = false;
+	DEVICE_DETAILS *pstRecords = NULL;
+	KEYS_ENTRY *pstEntries = NULL;
+	const uint8 *pucEntryKey = NULL;
+	uint32 ulFirst = 0;
+	uint32 ulCount = 0;
+	uint32 ulIndex = 0;
+
+	pstRecords = malloc(KEYS_READ_RECORDS * sizeof(DEVICE_DETAILS));
+	pstEntries = malloc(KEYS_READ_RECORDS * sizeof(KEYS_ENTRY));
+	blReturn = (pstRecords != NULL && pstEntries != NULL);
+	for(ulFirst = 0; ulFirst < ulRecordCount && blReturn == true;
+		ulFirst += ulCount)
+	{
+		ulCount = ulRecordCount - ulFirst;
+		if(ulCount > KEYS_READ_RECORDS)
+		{
+			ulCount = KEYS_READ_RECORDS;
+		}
+
+		if(lKeysFd != KEYS_INVALID_FD)
+		{
+			blRead = false;
+			blReturn = filePageScan(lKeysFd, pstEntries,
+									ulCount * sizeof(KEYS_ENTRY),
+									keysGetOffset(ulFirst));
+		}
+		else
+		{
+			blRead = true;
+			blReturn = keysCompute(lDataFd, ulFirst, ulCount, pstRecords,
+								   pstEntries);
+		}
+
+		for(ulIndex = 0; ulIndex < ulCount && blReturn == true; ulIndex++)
+		{
+			pucEntryKey = (ulField == KEYS_FIELD_NAME) ?
+						  pstEntries[ulIndex].pucName :
+						  pstEntries[ulIndex].pucType;
+			if(memcmp(pucEntryKey, pucKey, STR_MAX_SIZE) == 0)
+			{
+				if(blRead != true)
+				{
+					blRead = true;
+					blReturn = filePageScan(lDataFd, pstRecords,
+											ulCount *
+											sizeof(DEVICE_DETAILS),
+											ulFirst *
+											sizeof(DEVICE_DETAILS));
+				}
+				if(blReturn == true)
+				{
+					blReturn = shardResultAppend(pstResult,
+												 &pstRecords[ulIndex]);
+				}
+			}
+		}
+	}
+
+	free(pstRecords);
+	free(pstEntries);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write the header of the keys
+//Inputs	: pstKeys, the keys
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool keysWriteHeader(KEYS *pstKeys)
+{
+	return (filePageWrite(pstKeys->lFd, &pstKeys->stHeader,
+						  sizeof(KEYS_HEADER), 0) == true &&
+			filePageFlush(pstKeys->lFd) == true);
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compute the search key of a name or type
+//Inputs	: pucString, the name or type
+//Outputs	: pucKey, STR_MAX_SIZE bytes, the key padded with NULs
+//Return	: None
+//Notes		: "  Core   ROUTER " gives "core router"
+//******************************************************************************
+void keysNormalize(const uint8 *pucString, uint8 *pucKey)
+{
+	uint32 ulLength = 0;
+	uint32 ulIndex = 0;
+	bool blBlank = false;
+
+	memset(pucKey, 0, STR_MAX_SIZE);
+	for(ulIndex = 0; ulIndex < STR_MAX_SIZE && pucString[ulIndex] != '\0' &&
+		ulLength + blBlank < STR_MAX_SIZE - 1; ulIndex++)
+	{
+		if(isspace(pucString[ulIndex]))
+		{
+			blBlank = (ulLength > 0);
+		}
+		else
+		{
+			if(blBlank == true)
+			{
+				pucKey[ulLength++] = KEYS_SPACE;
+				blBlank = false;
+			}
+			pucKey[ulLength++] = (uint8)tolower(pucString[ulIndex]);
+		}
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open the keys of a data file being changed by a writer
+//Inputs	: pucDataPath, name of the data or shard file
+//Inputs	: pstBefore, identity of the data file before the change
+//Outputs	: pstKeys, the keys
+//Return	: True, if the keys describe the data file before the change
+//Return	: False, if they have to be rebuilt or in case of an error
+//Notes		: The keys are marked outdated until keysSync()
+//******************************************************************************
+bool keysOpen(const uint8 *pucDataPath, const FILE_IDENTITY *pstBefore,
+			  KEYS *pstKeys)
+{
+	bool blReturn = false;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(pucDataPath != NULL && pstBefore != NULL && pstKeys != NULL)
+	{
+		pstKeys->lFd = KEYS_INVALID_FD;
+		if(fileBuildPath(pucPath, pucDataPath, KEYS_SUFFIX) == true &&
+		   fileExists(pucPath) == true)
+		{
+			pstKeys->lFd = open((char *)pucPath, O_RDWR);
+		}
+
+		blReturn = (pstKeys->lFd != KEYS_INVALID_FD &&
+					filePageAttach(pstKeys->lFd) == true &&
+					filePageRead(pstKeys->lFd, &pstKeys->stHeader,
+								 sizeof(KEYS_HEADER), 0) == true &&
+					pstKeys->stHeader.ulMagic == KEYS_MAGIC &&
+					fileSameIdentity(&pstKeys->stHeader.stData,
+									 pstBefore) == true);
+		if(blReturn == true)
+		{
+			memset(&pstKeys->stHeader.stData, 0, sizeof(FILE_IDENTITY));
+			blReturn = keysWriteHeader(pstKeys);
+		}
+
+		if(blReturn != true)
+		{
+			keysClose(pstKeys);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To set the keys of a record slot
+//Inputs	: pstKeys, the keys
+//Inputs	: ulSlot, the record slot, at most the number of records
+//Inputs	: pstDeviceData, the record written to the slot
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool keysPut(KEYS *pstKeys, uint32 ulSlot, const DEVICE_DETAILS *pstDeviceData)
+{
+	bool blReturn = false;
+	KEYS_ENTRY stEntry;
+
+	if(pstKeys != NULL && pstKeys->lFd != KEYS_INVALID_FD &&
+	   pstDeviceData != NULL && ulSlot <= pstKeys->stHeader.ulRecordCount)
+	{
+		keysNormalize(pstDeviceData->pucDeviceName, stEntry.pucName);
+		keysNormalize(pstDeviceData->pucDeviceType, stEntry.pucType);
+		blReturn = filePageWrite(pstKeys->lFd, &stEntry, sizeof(stEntry),
+								 keysGetOffset(ulSlot));
+		if(blReturn == true && ulSlot == pstKeys->stHeader.ulRecordCount)
+		{
+			pstKeys->stHeader.ulRecordCount++;
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To copy the keys of a record slot to another slot
+//Inputs	: pstKeys, the keys
+//Inputs	: ulFrom and ulTo, the record slots
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool keysMove(KEYS *pstKeys, uint32 ulFrom, uint32 ulTo)
+{
+	bool blReturn = false;
+	KEYS_ENTRY stEntry;
+
+	if(pstKeys != NULL && pstKeys->lFd != KEYS_INVALID_FD &&
+	   ulFrom < pstKeys->stHeader.ulRecordCount &&
+	   ulTo < pstKeys->stHeader.ulRecordCount)
+	{
+		blReturn = (filePageRead(pstKeys->lFd, &stEntry, sizeof(stEntry),
+								 keysGetOffset(ulFrom)) == true &&
+					filePageWrite(pstKeys->lFd, &stEntry, sizeof(stEntry),
+								  keysGetOffset(ulTo)) == true);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To drop the keys of the last record slots
+//Inputs	: pstKeys, the keys
+//Inputs	: ulRecordCount, number of records kept
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool keysTruncate(KEYS *pstKeys, uint32 ulRecordCount)
+{
+	bool blReturn = false;
+
+	if(pstKeys != NULL && pstKeys->lFd != KEYS_INVALID_FD &&
+	   ulRecordCount <= pstKeys->stHeader.ulRecordCount)
+	{
+		blReturn = filePageTruncate(pstKeys->lFd,
+									keysGetOffset(ulRecordCount));
+		if(blReturn == true)
+		{
+			pstKeys->stHeader.ulRecordCount = ulRecordCount;
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To mark the keys as describing the changed data file
+//Inputs	: pstKeys, the keys
+//Inputs	: pucDataPath, name of the data or shard file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Called once all the keys of the change are set, they are
+//			  written back before the header
+//******************************************************************************
+bool keysSync(KEYS *pstKeys, const uint8 *pucDataPath)
+{
+	bool blReturn = false;
+
+	if(pstKeys != NULL && pstKeys->lFd != KEYS_INVALID_FD &&
+	   pucDataPath != NULL)
+	{
+		fileGetIdentity(pucDataPath, &pstKeys->stHeader.stData);
+		blReturn = (filePageFlush(pstKeys->lFd) == true &&
+					keysWriteHeader(pstKeys) == true);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To close the keys
+//Inputs	: pstKeys, the keys
+//Outputs	: None
+//Return	: None
+//Notes		: Keys not synced stay outdated
+//******************************************************************************
+void keysClose(KEYS *pstKeys)
+{
+	if(pstKeys != NULL && pstKeys->lFd != KEYS_INVALID_FD)
+	{
+		filePageClose(pstKeys->lFd);
+		pstKeys->lFd = KEYS_INVALID_FD;
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the devices whose normalized name or type is a given one
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulField, KEYS_FIELD_NAME or KEYS_FIELD_TYPE
+//Inputs	: pucString, the name or type, normalized here
+//Outputs	: pstResult, the matching devices appended
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Searches a snapshot, shard after shard. A shard whose keys
+//			  cannot be built or change during the search is searched by
+//			  normalizing its records.
+//******************************************************************************
+bool keysSearch(const uint8 *pucFileName, uint32 ulField,
+				const uint8 *pucString, SHARD_RESULT *pstResult)
+{
+	bool blReturn = false;
+	bool blCurrent = false;
+	bool blAttached = false;
+	SNAPSHOT stSnapshot;
+	SHARD_LAYOUT stLayout = {0};
+	KEYS_HEADER stHeader = {0};
+	KEYS_HEADER stAfter = {0};
+	FILE *pstData = NULL;
+	uint8 pucKey[STR_MAX_SIZE];
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+	uint32 ulFound = 0;
+	uint32 ulRecordCount = 0;
+	int32 lFd = KEYS_INVALID_FD;
+
+	if(pucFileName != NULL && pucString != NULL && pstResult != NULL &&
+	   (ulField == KEYS_FIELD_NAME || ulField == KEYS_FIELD_TYPE) &&
+	   shardAcquireSnapshot(pucFileName, &stSnapshot, &stLayout) == true)
+	{
+		keysNormalize(pucString, pucKey);
+		blReturn = true;
+		for(ulShard = 0; ulShard < stSnapshot.ulFileCount &&
+			blReturn == true; ulShard++)
+		{
+			pstData = stSnapshot.pstFiles[ulShard];
+			ulRecordCount = stSnapshot.pulRecordCounts[ulShard];
+			ulFound = pstResult->ulCount;
+			blAttached = filePageAttach(fileno(pstData));
+			blCurrent = (shardGetPath(pucFileName, &stLayout, ulShard,
+									  pucPath) == true &&
+						 keysLoad(pucPath, pstData, &lFd, &stHeader) == true &&
+						 stHeader.ulRecordCount >= ulRecordCount);
+			// The header is read again from the file, not from the pool,
+			// to see a rebuild by another process during the search
+			if(blCurrent == true)
+			{
+				blCurrent = (keysSearchFile(lFd, fileno(pstData),
+											ulRecordCount, ulField, pucKey,
+											pstResult) == true &&
+							 pread(lFd, &stAfter, sizeof(stAfter), 0) ==
+							 sizeof(stAfter) &&
+							 fileSameIdentity(&stAfter.stData,
+											  &stHeader.stData) == true);
+			}
+
+			if(lFd != KEYS_INVALID_FD)
+			{
+				filePageClose(lFd);
+				lFd = KEYS_INVALID_FD;
+			}
+
+			if(blCurrent != true)
+			{
+				pstResult->ulCount = ulFound;
+				blReturn = keysSearchFile(KEYS_INVALID_FD, fileno(pstData),
+										  ulRecordCount, ulField, pucKey,
+										  pstResult);
+			}
+
+			if(blAttached == true)
+			{
+				filePageDetach(fileno(pstData));
+			}
+		}
+		snapshotRelease(&stSnapshot);
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to search the normalized keys");
+	}
+
+	return blReturn;
+}
+// EOF
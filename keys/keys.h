@@ -0,0 +1,66 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Normalized device names and types
+// Note		: Names and types folded to lower case with their blanks
+//			  trimmed, kept per record slot for case insensitive searches
+//
+//******************************************************************************
+
+#ifndef _KEYS_H_
+#define _KEYS_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "file.h"
+#include "shard.h"
+
+//******************************* Global Types *********************************
+// Followed by ulRecordCount entries, one per record slot
+typedef struct _KEYS_HEADER_
+{
+	uint32 ulMagic;
+	FILE_IDENTITY stData;
+	uint32 ulRecordCount;
+} KEYS_HEADER;
+
+typedef struct _KEYS_ENTRY_
+{
+	uint8 pucName[STR_MAX_SIZE];
+	uint8 pucType[STR_MAX_SIZE];
+} KEYS_ENTRY;
+
+typedef struct _KEYS_
+{
+	int32 lFd;
+	KEYS_HEADER stHeader;
+} KEYS;
+
+//***************************** Global Constants *******************************
+#define KEYS_SUFFIX			(".keys")
+#define KEYS_MAGIC			(0x5359454BUL)
+#define KEYS_INVALID_FD		(-1)
+#define KEYS_FIELD_NAME		(0)
+#define KEYS_FIELD_TYPE		(1)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+void keysNormalize(const uint8 *pucString, uint8 *pucKey);
+bool keysOpen(const uint8 *pucDataPath, const FILE_IDENTITY *pstBefore,
+			  KEYS *pstKeys);
+bool keysPut(KEYS *pstKeys, uint32 ulSlot,
+			 const DEVICE_DETAILS *pstDeviceData);
+bool keysMove(KEYS *pstKeys, uint32 ulFrom, uint32 ulTo);
+bool keysTruncate(KEYS *pstKeys, uint32 ulRecordCount);
+bool keysSync(KEYS *pstKeys, const uint8 *pucDataPath);
+void keysClose(KEYS *pstKeys);
+bool keysSearch(const uint8 *pucFileName, uint32 ulField,
+				const uint8 *pucString, SHARD_RESULT *pstResult);
+
+#endif // _KEYS_H_
+// EOF
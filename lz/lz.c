@@ -0,0 +1,275 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: lz.c
+// Summary	: LZ77 block compression
+// Note		: A sequence is a token byte holding the literal count in its
+//			  high nibble and the match length less LZ_MIN_MATCH in its low
+//			  nibble, the literals, a two byte little endian offset and the
+//			  match length extension. A nibble of 15 is continued by bytes
+//			  added to it until a byte below 255. The last sequence of a
+//			  block only holds literals. Matches are found through a hash
+//			  table of the last position of every four byte prefix.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include "customTypes.h"
+#include "lz.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define LZ_MIN_MATCH		(4)
+#define LZ_MAX_OFFSET		(65535)
+#define LZ_HASH_BITS		(12)
+#define LZ_HASH_SIZE		(1 << LZ_HASH_BITS)
+#define LZ_HASH_PRIME		(2654435761U)
+#define LZ_NIBBLE_MAX		(15)
+#define LZ_NIBBLE_BITS		(4)
+#define LZ_BYTE_MAX			(255)
+#define LZ_BYTE_BITS		(8)
+#define LZ_OFFSET_SIZE		(2)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write the extension of a literal count or match length
+//Inputs	: ulValue, the count beyond LZ_NIBBLE_MAX
+//Inputs	: pucOutput, where to write
+//Outputs	: None
+//Return	: Position following the extension
+//Notes		:
+//******************************************************************************
+static uint8 *lzWriteLength(uint32 ulValue, uint8 *pucOutput)
+{
+	while(ulValue >= LZ_BYTE_MAX)
+	{
+		*pucOutput++ = LZ_BYTE_MAX;
+		ulValue -= LZ_BYTE_MAX;
+	}
+	*pucOutput++ = (uint8)ulValue;
+
+	return pucOutput;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the extension of a literal count or match length
+//Inputs	: ppucInput, position of the extension, moved past it
+//Inputs	: pucEnd, end of the compressed block
+//Outputs	: pulValue, incremented by the extension
+//Return	: True, at time of successful execution
+//Return	: False, if the block ends within the extension
+//Notes		:
+//******************************************************************************
+static bool lzReadLength(const uint8 **ppucInput, const uint8 *pucEnd,
+						 uint32 *pulValue)
+{
+	uint8 ucByte = LZ_BYTE_MAX;
+
+	while(ucByte == LZ_BYTE_MAX && *ppucInput < pucEnd)
+	{
+		ucByte = **ppucInput;
+		(*ppucInput)++;
+		*pulValue += ucByte;
+	}
+
+	return (ucByte != LZ_BYTE_MAX);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write one sequence
+//Inputs	: pucLiterals and ulLiteralCount, the literals
+//Inputs	: ulOffset and ulMatchLength, the back reference, a length of 0
+//			  for the last sequence
+//Inputs	: pucOutput, where to write
+//Outputs	: None
+//Return	: Position following the sequence
+//Notes		:
+//******************************************************************************
+static uint8 *lzWriteSequence(const uint8 *pucLiterals, uint32 ulLiteralCount,
+							  uint32 ulOffset, uint32 ulMatchLength,
+							  uint8 *pucOutput)
+{
+	uint8 *pucToken = pucOutput++;
+	uint32 ulMatchCode = 0;
+
+	*pucToken = (ulLiteralCount < LZ_NIBBLE_MAX ? ulLiteralCount :
+				 LZ_NIBBLE_MAX) << LZ_NIBBLE_BITS;
+	if(ulLiteralCount >= LZ_NIBBLE_MAX)
+	{
+		pucOutput = lzWriteLength(ulLiteralCount - LZ_NIBBLE_MAX, pucOutput);
+	}
+	memcpy(pucOutput, pucLiterals, ulLiteralCount);
+	pucOutput += ulLiteralCount;
+
+	if(ulMatchLength > 0)
+	{
+		*pucOutput++ = (uint8)ulOffset;
+		*pucOutput++ = (uint8)(ulOffset >> LZ_BYTE_BITS);
+		ulMatchCode = ulMatchLength - LZ_MIN_MATCH;
+		*pucToken |= (ulMatchCode < LZ_NIBBLE_MAX ? ulMatchCode :
+					  LZ_NIBBLE_MAX);
+		if(ulMatchCode >= LZ_NIBBLE_MAX)
+		{
+			pucOutput = lzWriteLength(ulMatchCode - LZ_NIBBLE_MAX, pucOutput);
+		}
+	}
+
+	return pucOutput;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To give the largest compressed size of a block
+//Inputs	: ulSize, size of the block
+//Outputs	: None
+//Return	: Size of the buffer to be given to lzCompress()
+//Notes		: Incompressible data grows by one byte per 255 literals
+//******************************************************************************
+uint32 lzBound(uint32 ulSize)
+{
+	return ulSize + ulSize / LZ_BYTE_MAX + LZ_NIBBLE_MAX + 1;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compress a block
+//Inputs	: pucInput and ulSize, the block
+//Inputs	: pucOutput, a buffer of lzBound(ulSize) bytes
+//Outputs	: None
+//Return	: Size of the compressed block
+//Notes		:
+//******************************************************************************
+uint32 lzCompress(const uint8 *pucInput, uint32 ulSize, uint8 *pucOutput)
+{
+	unsigned int puiTable[LZ_HASH_SIZE];
+	uint8 *pucWrite = pucOutput;
+	unsigned int uiPrefix = 0;
+	unsigned int uiHash = 0;
+	unsigned int uiCandidate = 0;
+	uint32 ulPosition = 0;
+	uint32 ulAnchor = 0;
+	uint32 ulLength = 0;
+
+	memset(puiTable, 0, sizeof(puiTable));
+
+	while(ulPosition + LZ_MIN_MATCH <= ulSize)
+	{
+		memcpy(&uiPrefix, pucInput + ulPosition, LZ_MIN_MATCH);
+		uiHash = (uiPrefix * LZ_HASH_PRIME) >> (32 - LZ_HASH_BITS);
+		// Positions are stored plus one, zero marks an empty entry
+		uiCandidate = puiTable[uiHash];
+		puiTable[uiHash] = ulPosition + 1;
+
+		if(uiCandidate > 0 && ulPosition - (uiCandidate - 1) <= LZ_MAX_OFFSET &&
+		   memcmp(pucInput + uiCandidate - 1, pucInput + ulPosition,
+				  LZ_MIN_MATCH) == 0)
+		{
+			ulLength = LZ_MIN_MATCH;
+			while(ulPosition + ulLength < ulSize &&
+				  pucInput[uiCandidate - 1 + ulLength] ==
+				  pucInput[ulPosition + ulLength])
+			{
+				ulLength++;
+			}
+			pucWrite = lzWriteSequence(pucInput + ulAnchor,
+									   ulPosition - ulAnchor,
+									   ulPosition - (uiCandidate - 1),
+									   ulLength, pucWrite);
+			ulPosition += ulLength;
+			ulAnchor = ulPosition;
+		}
+		else
+		{
+			ulPosition++;
+		}
+	}
+
+	pucWrite = lzWriteSequence(pucInput + ulAnchor, ulSize - ulAnchor, 0, 0,
+							   pucWrite);
+
+	return pucWrite - pucOutput;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To decompress a block
+//Inputs	: pucInput and ulSize, the compressed block
+//Inputs	: pucOutput and ulOutputSize, the buffer for the block
+//Outputs	: None
+//Return	: True, if the block decompresses to exactly ulOutputSize bytes
+//Return	: False, if the compressed block is damaged
+//Notes		: Every length and offset is checked against the buffers
+//******************************************************************************
+bool lzDecompress(const uint8 *pucInput, uint32 ulSize, uint8 *pucOutput,
+				  uint32 ulOutputSize)
+{
+	bool blReturn = true;
+	const uint8 *pucEnd = pucInput + ulSize;
+	uint32 ulWritten = 0;
+	uint32 ulLiteralCount = 0;
+	uint32 ulMatchLength = 0;
+	uint32 ulOffset = 0;
+	uint8 ucToken = 0;
+
+	while(blReturn == true && pucInput < pucEnd)
+	{
+		ucToken = *pucInput++;
+		ulLiteralCount = ucToken >> LZ_NIBBLE_BITS;
+		if(ulLiteralCount == LZ_NIBBLE_MAX)
+		{
+			blReturn = lzReadLength(&pucInput, pucEnd, &ulLiteralCount);
+		}
+		blReturn = (blReturn == true &&
+					ulLiteralCount <= (uint32)(pucEnd - pucInput) &&
+					ulLiteralCount <= ulOutputSize - ulWritten);
+		if(blReturn == true)
+		{
+			memcpy(pucOutput + ulWritten, pucInput, ulLiteralCount);
+			pucInput += ulLiteralCount;
+			ulWritten += ulLiteralCount;
+		}
+
+		// The last sequence ends with its literals
+		if(blReturn == true && pucInput < pucEnd)
+		{
+			blReturn = (pucEnd - pucInput >= LZ_OFFSET_SIZE);
+			if(blReturn == true)
+			{
+				ulOffset = pucInput[0] | (pucInput[1] << LZ_BYTE_BITS);
+				pucInput += LZ_OFFSET_SIZE;
+				ulMatchLength = ucToken & LZ_NIBBLE_MAX;
+				if(ulMatchLength == LZ_NIBBLE_MAX)
+				{
+					blReturn = lzReadLength(&pucInput, pucEnd, &ulMatchLength);
+				}
+				ulMatchLength += LZ_MIN_MATCH;
+			}
+			blReturn = (blReturn == true && ulOffset > 0 &&
+						ulOffset <= ulWritten &&
+						ulMatchLength <= ulOutputSize - ulWritten);
+
+			// Byte by byte, a match may overlap the bytes it produces
+			while(blReturn == true && ulMatchLength > 0)
+			{
+				pucOutput[ulWritten] = pucOutput[ulWritten - ulOffset];
+				ulWritten++;
+				ulMatchLength--;
+			}
+		}
+	}
+
+	return (blReturn == true && ulWritten == ulOutputSize);
+}
+// EOF
@@ -0,0 +1,32 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: LZ77 block compression
+// Note		: Byte oriented codec in the style of LZ4, a compressed block is
+//			  a run of sequences made of literals and one back reference
+//
+//******************************************************************************
+
+#ifndef _LZ_H_
+#define _LZ_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+
+//******************************* Global Types *********************************
+
+//***************************** Global Constants *******************************
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+uint32 lzBound(uint32 ulSize);
+uint32 lzCompress(const uint8 *pucInput, uint32 ulSize, uint8 *pucOutput);
+bool lzDecompress(const uint8 *pucInput, uint32 ulSize, uint8 *pucOutput,
+				  uint32 ulOutputSize);
+
+#endif // _LZ_H_
+// EOF
@@ -30,12 +30,22 @@
 //Outputs	: None
 //Return	: Return 0 at time of successful execution
 //Return	: Returns a non-zero integer value in case of an error
-//Notes		: Code execution begins from here 
+//Notes		: Code execution begins from here. Without arguments the menu
+//			  is started, otherwise the arguments name a maintenance command
 //******************************************************************************
-int main()
+int main(int argc, char *argv[])
 {
-	menuMain();
+	int iReturn = 0;
+
+	if(argc > 1)
+	{
+		iReturn = (menuRunCommand(argc, argv) == true) ? 0 : 1;
+	}
+	else
+	{
+		menuMain();
+	}
 	
-	return 0;
+	return iReturn;
 }
 // EOF
\ No newline at end of file
@@ -15,18 +15,60 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
 #include "customTypes.h"
 #include "menu.h"
+#include "file.h"
 #include "device.h"
+#include "shard.h"
+#include "stats.h"
+#include "verify.h"
+#include "segment.h"
+#include "snapshot.h"
+#include "bloom.h"
+#include "feed.h"
+#include "workload.h"
+#include "trigram.h"
+#include "image.h"
+#include "history.h"
+#include "format.h"
+#include "txn.h"
+#include "chash.h"
+#include "cache.h"
+#include "trace.h"
 
 //******************************* Local Types **********************************
 
 //***************************** Local Constants ********************************
+#define STRINGS_EQUAL	(0)
+#define NUMBER_BASE		(10)
+#define MENU_MEGABYTE	(1048576)
 
 //***************************** Local Variables ********************************
 
 //****************************** Local Functions *******************************
 
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the counters of the page pool
+//Inputs	: None
+//Outputs	: None
+//Return	: None
+//Notes		: Counted since the program started
+//******************************************************************************
+static void menuShowPages(void)
+{
+	FILE_PAGE_STATS stStats = {0};
+
+	filePageGetStats(&stStats);
+	printf("\nPage pool        : %lu MB, %lu of %lu page(s) used, %lu pinned,"
+		   " %lu dirty", stStats.ulBudget / MENU_MEGABYTE, stStats.ulUsed,
+		   stStats.ulFrameCount, stStats.ulPinned, stStats.ulDirty);
+	printf("\nPage hits        : %lu, %lu miss(es), %lu eviction(s),"
+		   " %lu write back(s)\n", stStats.ulHits, stStats.ulMisses,
+		   stStats.ulEvictions, stStats.ulWriteBacks);
+}
+
 //******************************.FUNCTION_HEADER.*******************************
 //Purpose	: Validate the choice selected from menu option 
 //Inputs	: uint8 ucChoice, the choice which is to be validated
@@ -70,6 +112,8 @@ static uint8 menuDisplaySeconadryOptions(void)
 		printf("3. Id\n");
 		printf("4. Vendor\n");
 		printf("5. Serial\n");
+		printf("6. Name, ignoring case and blanks\n");
+		printf("7. Type, ignoring case and blanks\n");
 		printf("0. Back to main menu\n");
 		printf("Enter choice: ");
 		blResult = scanf("%hhu", &ucChoice);
@@ -110,6 +154,9 @@ static uint8 menuDisplayMainOptions(void)
 		printf("2. List devices\n");
 		printf("3. Search device\n");
 		printf("4. Remove device\n");
+		printf("5. Bulk remove devices\n");
+		printf("6. Update device\n");
+		printf("7. Device statistics\n");
 		printf("0. Exit\n");
 		printf("Enter choice: ");
 		blResult = scanf("%hhu", &ucChoice);
@@ -158,7 +205,8 @@ bool menuFlushInput(void)
 //Outputs	: None
 //Return	: True, in case of successful execution
 //Return	: False, in case of any error
-//Notes		: Select exit option to terminate
+//Notes		: Select exit option to terminate. A reshard or a transaction
+//			  interrupted before is finished first.
 //******************************************************************************
 bool menuMain(void)
 {
@@ -166,58 +214,468 @@ bool menuMain(void)
 	uint8 ucMainChoice = 0;
 	uint8 ucSecondaryChoice = 0;
 	
-	printf("Device Management System");
-
-	do 
+	filePageConfigure(filePageGetBudget(FILE_NAME));
+	shardRecover(FILE_NAME);
+	txnRecover(FILE_NAME);
+	if(formatCheck(FILE_NAME) == true)
 	{
-		ucMainChoice = menuDisplayMainOptions();
-		
-		switch( ucMainChoice )
+		printf("Device Management System");
+
+		do 
 		{
-			case MENU_EXIT:
+			ucMainChoice = menuDisplayMainOptions();
+		
+			switch( ucMainChoice )
 			{
-				printf("Exiting...\n");
+				case MENU_EXIT:
+				{
+					printf("Exiting...\n");
+				}
+				break;
+
+				case MENU_ADD:
+				{
+					TRACE_SPAN("menu", "MENU_ADD");
+
+					deviceAdd(FILE_NAME);
+				}
+				break;
+
+				case MENU_LIST:
+				{
+					TRACE_SPAN("menu", "MENU_LIST");
+
+					deviceList(FILE_NAME); 
+				}
+				break;
+
+				case MENU_SEARCH:
+				{
+					printf("\nSearch device\n");
+					printf("-----------------------------\n");
+					printf("Select the search criteria:\n");
+					ucSecondaryChoice = menuDisplaySeconadryOptions();
+					TRACE_SPAN("menu", "MENU_SEARCH");
+
+					deviceSearch(FILE_NAME, ucSecondaryChoice);
+				}
+				break;
+
+				case MENU_REMOVE:
+				{
+					printf("\nRemove device\n");
+					printf("-----------------------------\n");
+					printf("Select the removal criteria:\n");
+					ucSecondaryChoice = menuDisplaySeconadryOptions();				
+					TRACE_SPAN("menu", "MENU_REMOVE");
+
+					deviceRemove(FILE_NAME, ucSecondaryChoice);
+				}
+				break;
+
+				case MENU_BULK_REMOVE:
+				{
+					TRACE_SPAN("menu", "MENU_BULK_REMOVE");
+
+					deviceBulkRemove(FILE_NAME);
+				}
+				break;
+
+				case MENU_UPDATE:
+				{
+					TRACE_SPAN("menu", "MENU_UPDATE");
+
+					deviceUpdate(FILE_NAME);
+				}
+				break;
+
+				case MENU_STATISTICS:
+				{
+					TRACE_SPAN("menu", "MENU_STATISTICS");
+
+					workloadRecord(FILE_NAME, WORKLOAD_STATS, NULL, 0);
+					statsShow(FILE_NAME);
+					menuShowPages();
+				}
+				break;
+
+				default:
+					printf("Invalid choice!\n");
 			}
-			break;
+		}
+		while (ucMainChoice != 0);
+	}
+
+	return blReturn;
+}
 
-			case MENU_ADD:
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To run a maintenance command given on the command line
+//Inputs	: int32 lArgCount, number of command line arguments
+//Inputs	: char *ppcArgs[], the command line arguments
+//Outputs	: None
+//Return	: True, in case of successful execution
+//Return	: False, in case of any error
+//Notes		: shard <count>, spread the device data over count shard files,
+//			  a count of 1 merges the shards back into a single file
+//Notes		: remove-list <file>, remove the devices whose serials are
+//			  listed in the file
+//Notes		: update-batch <file>, apply the updates listed in the file
+//Notes		: stats [enable | disable], print the device counts, or start or
+//			  stop keeping materialized counters
+//Notes		: bloom [rate], print the serial filter statistics, or rebuild
+//			  the filters for a false positive rate between 0 and 1
+//Notes		: verify [salvage], check the record checksums, and copy the
+//			  intact records of a corrupted file to "<file>.salvage"
+//Notes		: archive, write the compressed segment of every file, used by
+//			  searches until the file changes
+//Notes		: readahead [depth], print or set the number of buffers read
+//			  ahead by scans
+//Notes		: replicate <replica> [sequence], apply the change feed to the
+//			  replica file from the sequence on, by default from the first
+//			  change it misses. A new replica starts as a copy of the data.
+//Notes		: record [<trace> | off], print whether the operations are
+//			  recorded, start recording them to the trace or stop
+//Notes		: replay <trace> <copy> [max], run the recorded operations on a
+//			  new copy of the data, at their recorded pace or at maximum
+//			  speed, and print their latency distribution
+//Notes		: fuzzy <name> [count], print the devices with the closest
+//			  names, by number of edits
+//Notes		: checkpoint, write the memory image of the device data, mapped
+//			  back by programs opening the store
+//Notes		: history <time> [<time>], print the devices existing at the
+//			  time, or the changes made from the first time to the second.
+//			  Times are UTC, "YYYY-MM-DD" or "YYYY-MM-DDTHH:MM:SS".
+//Notes		: history drop <time>, delete the history of the days before
+//			  the day of the time
+//Notes		: diff <file> [apply], print the devices added, removed or
+//			  changed in a device file compared with the data, and with
+//			  apply, make the data the same as the file
+//Notes		: transaction <file>, apply the additions, removals and updates
+//			  listed in the file all together or not at all
+//Notes		: concurrent <threads>, measure the lookups of the concurrent
+//			  serial index from 1 up to the given number of threads, one
+//			  lookup in a hundred being followed by a replacement
+//Notes		: batch <file>, run the lookups, searches, additions, removals
+//			  and updates listed in the file on the shared pool, those of
+//			  a serial in the order of the file
+//Notes		: cache [drop], print the state of the shared memory cache of
+//			  the indexes, or remove it
+//Notes		: pages [megabytes], print or set the memory of the page pool
+//			  caching the data and index files
+//******************************************************************************
+bool menuRunCommand(int32 lArgCount, char *ppcArgs[])
+{
+	bool blReturn = false;
+	uint32 ulCount = 0;
+	uint32 ulFrom = 0;
+	uint32 ulTo = 0;
+	double dRate = 0;
+	char *pcEnd = NULL;
+
+	TRACE_SPAN("menu", "menuRunCommand");
+
+	if(lArgCount > 1 && ppcArgs != NULL)
+	{
+		filePageConfigure(filePageGetBudget(FILE_NAME));
+		shardRecover(FILE_NAME);
+		txnRecover(FILE_NAME);
+		if(formatCheck(FILE_NAME) != true)
+		{
+			blReturn = false;
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_SHARD) == STRINGS_EQUAL &&
+		   lArgCount == 3)
+		{
+			ulCount = strtoul(ppcArgs[2], &pcEnd, NUMBER_BASE);
+			if(*pcEnd == '\0')
 			{
-				deviceAdd(FILE_NAME);
+				blReturn = (shardReshard(FILE_NAME, ulCount) == true &&
+							statsRefresh(FILE_NAME) == true);
 			}
-			break;
-
-			case MENU_LIST:
+			printf(blReturn == true ? "Device data spread over %lu shard(s)\n"
+					: "\nUnable to shard the device data to %lu shard(s)\n",
+					ulCount);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_REMOVE_LIST) == STRINGS_EQUAL &&
+				lArgCount == 3)
+		{
+			blReturn = deviceRemoveSerialList(FILE_NAME,
+											  (const uint8 *)ppcArgs[2]);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_UPDATE_BATCH) == STRINGS_EQUAL &&
+				lArgCount == 3)
+		{
+			blReturn = deviceUpdateBatch(FILE_NAME, (const uint8 *)ppcArgs[2]);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_STATS) == STRINGS_EQUAL &&
+				lArgCount == 2)
+		{
+			workloadRecord(FILE_NAME, WORKLOAD_STATS, NULL, 0);
+			blReturn = statsShow(FILE_NAME);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_STATS) == STRINGS_EQUAL &&
+				lArgCount == 3 &&
+				strcmp(ppcArgs[2], COMMAND_STATS_ENABLE) == STRINGS_EQUAL)
+		{
+			blReturn = statsMaterialize(FILE_NAME);
+			printf(blReturn == true ? "Device counters materialized\n"
+					: "\nUnable to materialize the device counters\n");
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_STATS) == STRINGS_EQUAL &&
+				lArgCount == 3 &&
+				strcmp(ppcArgs[2], COMMAND_STATS_DISABLE) == STRINGS_EQUAL)
+		{
+			blReturn = statsDisable(FILE_NAME);
+			printf(blReturn == true ? "Device counters dropped\n"
+					: "\nUnable to drop the device counters\n");
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_BLOOM) == STRINGS_EQUAL &&
+				lArgCount == 2)
+		{
+			blReturn = bloomShow(FILE_NAME);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_BLOOM) == STRINGS_EQUAL &&
+				lArgCount == 3)
+		{
+			dRate = strtod(ppcArgs[2], &pcEnd);
+			if(*pcEnd == '\0')
 			{
-				deviceList(FILE_NAME); 
+				blReturn = bloomConfigure(FILE_NAME,
+										  (uint32)(dRate * BLOOM_PPM + 0.5));
 			}
-			break;
-
-			case MENU_SEARCH:
+			printf(blReturn == true ? "Serial filters rebuilt for a false"
+					" positive rate of %s\n" : "\nUnable to set the false"
+					" positive rate %s, expected between 0 and 1\n",
+					ppcArgs[2]);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_VERIFY) == STRINGS_EQUAL &&
+				lArgCount == 2)
+		{
+			blReturn = verifyRun(FILE_NAME, false);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_VERIFY) == STRINGS_EQUAL &&
+				lArgCount == 3 &&
+				strcmp(ppcArgs[2], COMMAND_VERIFY_SALVAGE) == STRINGS_EQUAL)
+		{
+			blReturn = verifyRun(FILE_NAME, true);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_ARCHIVE) == STRINGS_EQUAL &&
+				lArgCount == 2)
+		{
+			blReturn = segmentArchive(FILE_NAME);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_READ_AHEAD) == STRINGS_EQUAL &&
+				lArgCount == 2)
+		{
+			printf("Scans read %lu buffer(s) ahead\n",
+				   snapshotGetReadAhead(FILE_NAME));
+			blReturn = true;
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_READ_AHEAD) == STRINGS_EQUAL &&
+				lArgCount == 3)
+		{
+			ulCount = strtoul(ppcArgs[2], &pcEnd, NUMBER_BASE);
+			if(*pcEnd == '\0')
 			{
-				printf("\nSearch device\n");
-				printf("-----------------------------\n");
-				printf("Select the search criteria:\n");
-				ucSecondaryChoice = menuDisplaySeconadryOptions();
-				deviceSearch(FILE_NAME, ucSecondaryChoice);
+				blReturn = snapshotSetReadAhead(FILE_NAME, ulCount);
 			}
-			break;
-
-			case MENU_REMOVE:
+			printf(blReturn == true ? "Scans read %s buffer(s) ahead\n" :
+					"\nUnable to read %s buffer(s) ahead\n", ppcArgs[2]);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_REPLICATE) == STRINGS_EQUAL &&
+				(lArgCount == 3 || lArgCount == 4))
+		{
+			if(lArgCount == 4)
 			{
-				printf("\nRemove device\n");
-				printf("-----------------------------\n");
-				printf("Select the removal criteria:\n");
-				ucSecondaryChoice = menuDisplaySeconadryOptions();				
-				deviceRemove(FILE_NAME, ucSecondaryChoice);
+				ulCount = strtoul(ppcArgs[3], &pcEnd, NUMBER_BASE);
+			}
+			if(lArgCount == 3 || (*pcEnd == '\0' && ulCount > 0))
+			{
+				blReturn = feedReplicate(FILE_NAME, (const uint8 *)ppcArgs[2],
+										 ulCount);
+			}
+			else
+			{
+				printf("\nUnable to replicate : Sequences start at %d\n",
+					   FEED_FIRST_SEQUENCE);
+			}
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_RECORD) == STRINGS_EQUAL &&
+				lArgCount == 2)
+		{
+			blReturn = workloadShow(FILE_NAME);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_RECORD) == STRINGS_EQUAL &&
+				lArgCount == 3 &&
+				strcmp(ppcArgs[2], COMMAND_RECORD_OFF) == STRINGS_EQUAL)
+		{
+			blReturn = workloadStop(FILE_NAME);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_RECORD) == STRINGS_EQUAL &&
+				lArgCount == 3)
+		{
+			blReturn = workloadStart(FILE_NAME, (const uint8 *)ppcArgs[2]);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_REPLAY) == STRINGS_EQUAL &&
+				(lArgCount == 4 ||
+				 (lArgCount == 5 &&
+				  strcmp(ppcArgs[4], COMMAND_REPLAY_MAX) == STRINGS_EQUAL)))
+		{
+			blReturn = workloadReplay(FILE_NAME, (const uint8 *)ppcArgs[2],
+									  (const uint8 *)ppcArgs[3],
+									  lArgCount == 5);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_FUZZY) == STRINGS_EQUAL &&
+				(lArgCount == 3 || lArgCount == 4) &&
+				strlen(ppcArgs[2]) < STR_MAX_SIZE)
+		{
+			ulCount = TRIGRAM_DEFAULT_MATCHES;
+			if(lArgCount == 4)
+			{
+				ulCount = strtoul(ppcArgs[3], &pcEnd, NUMBER_BASE);
+			}
+			if(lArgCount == 3 ||
+			   (*pcEnd == '\0' && ulCount > 0 &&
+				ulCount <= TRIGRAM_MAX_MATCHES))
+			{
+				blReturn = deviceSearchClosest(FILE_NAME,
+											   (const uint8 *)ppcArgs[2],
+											   ulCount);
+			}
+			else
+			{
+				printf("\nUnable to search : Up to %d names are printed\n",
+					   TRIGRAM_MAX_MATCHES);
+			}
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_CHECKPOINT) == STRINGS_EQUAL &&
+				lArgCount == 2)
+		{
+			blReturn = imageCheckpoint(FILE_NAME);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_HISTORY) == STRINGS_EQUAL &&
+				lArgCount == 4 &&
+				strcmp(ppcArgs[2], COMMAND_HISTORY_DROP) == STRINGS_EQUAL)
+		{
+			if(historyParseTime((const uint8 *)ppcArgs[3], &ulTo) != true)
+			{
+				printf("\nUnable to drop the history : Invalid time\n");
+			}
+			else if(historyDrop(FILE_NAME, ulTo, &ulCount) == true)
+			{
+				printf("\nDropped %lu day(s) of history\n", ulCount);
+				blReturn = true;
 			}
-			break;
-
-			default:
-				printf("Invalid choice!\n");
 		}
+		else if(strcmp(ppcArgs[1], COMMAND_HISTORY) == STRINGS_EQUAL &&
+				(lArgCount == 3 || lArgCount == 4))
+		{
+			if(historyParseTime((const uint8 *)ppcArgs[2], &ulFrom) == true &&
+			   (lArgCount == 3 ||
+				historyParseTime((const uint8 *)ppcArgs[3], &ulTo) == true))
+			{
+				blReturn = (lArgCount == 3 ?
+							deviceHistoryAsOf(FILE_NAME, ulFrom) :
+							deviceHistoryChanges(FILE_NAME, ulFrom, ulTo));
+			}
+			else
+			{
+				printf("\nUnable to query the history : Times are"
+					   " YYYY-MM-DD or YYYY-MM-DDTHH:MM:SS\n");
+			}
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_DIFF) == STRINGS_EQUAL &&
+				(lArgCount == 3 ||
+				 (lArgCount == 4 &&
+				  strcmp(ppcArgs[3], COMMAND_DIFF_APPLY) == STRINGS_EQUAL)))
+		{
+			blReturn = deviceDiff(FILE_NAME, (const uint8 *)ppcArgs[2],
+								  lArgCount == 4);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_TRANSACTION) == STRINGS_EQUAL &&
+				lArgCount == 3)
+		{
+			blReturn = deviceTransaction(FILE_NAME, (const uint8 *)ppcArgs[2]);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_CONCURRENT) == STRINGS_EQUAL &&
+				lArgCount == 3)
+		{
+			ulCount = strtoul(ppcArgs[2], &pcEnd, NUMBER_BASE);
+			if(*pcEnd == '\0' && ulCount > 0 && ulCount <= CHASH_MAX_READERS)
+			{
+				blReturn = chashBenchmark(FILE_NAME, ulCount);
+			}
+			else
+			{
+				printf("\nUnable to measure : Between 1 and %d threads\n",
+					   CHASH_MAX_READERS);
+			}
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_BATCH) == STRINGS_EQUAL &&
+				lArgCount == 3)
+		{
+			blReturn = deviceBatch(FILE_NAME, (const uint8 *)ppcArgs[2]);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_CACHE) == STRINGS_EQUAL &&
+				lArgCount == 2)
+		{
+			blReturn = cacheShow(FILE_NAME);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_CACHE) == STRINGS_EQUAL &&
+				lArgCount == 3 &&
+				strcmp(ppcArgs[2], COMMAND_CACHE_DROP) == STRINGS_EQUAL)
+		{
+			blReturn = cacheDrop(FILE_NAME);
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_PAGES) == STRINGS_EQUAL &&
+				lArgCount == 2)
+		{
+			printf("The page pool holds %lu MB\n",
+				   filePageGetBudget(FILE_NAME) / MENU_MEGABYTE);
+			blReturn = true;
+		}
+		else if(strcmp(ppcArgs[1], COMMAND_PAGES) == STRINGS_EQUAL &&
+				lArgCount == 3)
+		{
+			ulCount = strtoul(ppcArgs[2], &pcEnd, NUMBER_BASE);
+			if(*pcEnd == '\0' &&
+			   ulCount <= FILE_PAGE_MAX_BUDGET / MENU_MEGABYTE)
+			{
+				blReturn = filePageSetBudget(FILE_NAME,
+											 ulCount * MENU_MEGABYTE);
+			}
+			printf(blReturn == true ? "The page pool holds %s MB\n" :
+					"\nUnable to hold %s MB in the page pool\n", ppcArgs[2]);
+		}
+		else
+		{
+			printf("Usage: %s [%s <count> | %s <file> | %s <file> |"
+				   " %s [%s | %s] | %s [<false positive rate>] | %s [%s] |"
+				   " %s | %s [<depth>] | %s <replica> [<sequence>] |"
+				   " %s [<trace> | %s] | %s <trace> <copy> [%s] |"
+				   " %s <name> [<count>] | %s | %s <time> [<time>] |"
+				   " %s %s <time> | %s <file> [%s] | %s <file> |"
+				   " %s <threads> | %s <file> | %s [%s] |"
+				   " %s [<megabytes>]]\n",
+				   ppcArgs[0], COMMAND_SHARD,
+				   COMMAND_REMOVE_LIST, COMMAND_UPDATE_BATCH, COMMAND_STATS,
+				   COMMAND_STATS_ENABLE, COMMAND_STATS_DISABLE, COMMAND_BLOOM,
+				   COMMAND_VERIFY, COMMAND_VERIFY_SALVAGE, COMMAND_ARCHIVE,
+				   COMMAND_READ_AHEAD, COMMAND_REPLICATE, COMMAND_RECORD,
+				   COMMAND_RECORD_OFF, COMMAND_REPLAY, COMMAND_REPLAY_MAX,
+				   COMMAND_FUZZY, COMMAND_CHECKPOINT, COMMAND_HISTORY,
+				   COMMAND_HISTORY, COMMAND_HISTORY_DROP, COMMAND_DIFF,
+				   COMMAND_DIFF_APPLY, COMMAND_TRANSACTION, COMMAND_CONCURRENT,
+				   COMMAND_BATCH, COMMAND_CACHE, COMMAND_CACHE_DROP,
+				   COMMAND_PAGES);
+		}
+	}
+	else
+	{
+		printf("\nUnable to run the command : Invalid arguments");
 	}
-	while (ucMainChoice != 0);
 
 	return blReturn;
 }
-// EOF
+// EOF
\ No newline at end of file
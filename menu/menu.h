@@ -18,10 +18,38 @@
 //******************************* Global Types *********************************
 
 //***************************** Global Constants *******************************
-#define MENU_MAIN_OPTIONS_MAX			(4)
-#define MENU_SECONDARY_OPTIONS_MAX		(5)
-#define SEARCH_CRITERIA_MAXIMUM_OPTIONS (5)
-#define REMOVE_CRITERIA_MAXIMUM_OPTIONS (4)
+#define MENU_MAIN_OPTIONS_MAX			(7)
+#define MENU_SECONDARY_OPTIONS_MAX		(7)
+#define SEARCH_CRITERIA_MAXIMUM_OPTIONS (7)
+#define REMOVE_CRITERIA_MAXIMUM_OPTIONS (7)
+#define COMMAND_SHARD					("shard")
+#define COMMAND_REMOVE_LIST				("remove-list")
+#define COMMAND_UPDATE_BATCH			("update-batch")
+#define COMMAND_STATS					("stats")
+#define COMMAND_STATS_ENABLE			("enable")
+#define COMMAND_STATS_DISABLE			("disable")
+#define COMMAND_BLOOM					("bloom")
+#define COMMAND_VERIFY					("verify")
+#define COMMAND_VERIFY_SALVAGE			("salvage")
+#define COMMAND_ARCHIVE					("archive")
+#define COMMAND_READ_AHEAD				("readahead")
+#define COMMAND_REPLICATE				("replicate")
+#define COMMAND_RECORD					("record")
+#define COMMAND_RECORD_OFF				("off")
+#define COMMAND_REPLAY					("replay")
+#define COMMAND_REPLAY_MAX				("max")
+#define COMMAND_FUZZY					("fuzzy")
+#define COMMAND_CHECKPOINT				("checkpoint")
+#define COMMAND_HISTORY					("history")
+#define COMMAND_HISTORY_DROP			("drop")
+#define COMMAND_DIFF					("diff")
+#define COMMAND_DIFF_APPLY				("apply")
+#define COMMAND_TRANSACTION				("transaction")
+#define COMMAND_CONCURRENT				("concurrent")
+#define COMMAND_BATCH					("batch")
+#define COMMAND_CACHE					("cache")
+#define COMMAND_CACHE_DROP				("drop")
+#define COMMAND_PAGES					("pages")
 
 //***************************** Global Variables *******************************
 typedef enum{
@@ -29,7 +57,10 @@ typedef enum{
 	MENU_ADD,
 	MENU_LIST,
 	MENU_SEARCH,
-	MENU_REMOVE
+	MENU_REMOVE,
+	MENU_BULK_REMOVE,
+	MENU_UPDATE,
+	MENU_STATISTICS
 }MENU_OPTIONS;
 
 typedef enum{
@@ -38,7 +69,9 @@ typedef enum{
 	SEARCH_BY_TYPE,
 	SEARCH_BY_ID,
 	SEARCH_BY_VENDOR,
-	SEARCH_BY_SERIAL
+	SEARCH_BY_SERIAL,
+	SEARCH_BY_NAME_FOLDED,
+	SEARCH_BY_TYPE_FOLDED
 }SEARCH_OPTIONS;
 
 typedef enum{
@@ -46,12 +79,16 @@ typedef enum{
 	REMOVE_BY_NAME,
 	REMOVE_BY_TYPE,
 	REMOVE_BY_ID,
-	REMOVE_BY_VENDOR
+	REMOVE_BY_VENDOR,
+	REMOVE_BY_SERIAL,
+	REMOVE_BY_NAME_FOLDED,
+	REMOVE_BY_TYPE_FOLDED
 }REMOVE_OPTIONS;
 
 //**************************** Forward Declarations ****************************
 bool menuMain(void);
 bool menuFlushInput(void);
+bool menuRunCommand(int32 lArgCount, char *ppcArgs[]);
 
 #endif // MENU_H
 // EOF
\ No newline at end of file
@@ -0,0 +1,526 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: pool.c
+// Summary	: Shared work stealing pool of worker threads
+// Note		: The workers are started on first use, one per processor, and
+//			  live as long as the process. A worker pushes the tasks it
+//			  submits to the bottom of its own deque and takes them back
+//			  from there, newest first, while an idle worker steals the
+//			  oldest task from the top of another deque. Tasks submitted by
+//			  other threads are queued in a shared injection queue. A
+//			  thread waiting for a group runs the queued tasks of that group
+//			  itself, so a task may wait for the tasks it submitted. Keyed
+//			  tasks are queued on the strand of their key, a strand runs as
+//			  a single task at a time.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "hash.h"
+#include "pool.h"
+
+//******************************* Local Types **********************************
+typedef struct _POOL_TASK_
+{
+	POOL_TASK_FUNCTION pfnTask;
+	void *pvArgument;
+	POOL_GROUP *pstGroup;
+} POOL_TASK;
+
+// Ring of tasks from the top, the oldest, to the bottom, the newest
+typedef struct _POOL_QUEUE_
+{
+	pthread_mutex_t stLock;
+	POOL_TASK *pstTasks;
+	uint32 ulCapacity;
+	uint32 ulTop;
+	uint32 ulCount;
+} POOL_QUEUE;
+
+typedef struct _POOL_STRAND_
+{
+	POOL_QUEUE stQueue;
+	bool blScheduled;
+} POOL_STRAND;
+
+typedef struct _POOL_
+{
+	POOL_QUEUE pstDeques[POOL_MAX_WORKERS];
+	POOL_QUEUE stInjected;
+	POOL_STRAND pstStrands[POOL_STRANDS];
+	_Atomic uint32 ulWorkerCount;
+	_Atomic uint32 ulQueued;
+	pthread_mutex_t stLock;
+	pthread_cond_t stWork;
+	pthread_cond_t stDone;
+} POOL;
+
+//***************************** Local Constants ********************************
+#define POOL_MIN_CAPACITY		(64)
+#define POOL_NO_WORKER			(-1)
+
+//***************************** Local Variables ********************************
+static POOL stPool;
+static pthread_once_t stPoolOnce = PTHREAD_ONCE_INIT;
+static _Thread_local int32 lPoolWorker = POOL_NO_WORKER;
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To add a task at the bottom of a queue
+//Inputs	: pstQueue, the queue
+//Inputs	: pstTask, the task
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, when out of memory
+//Notes		: The queue doubles when full
+//******************************************************************************
+static bool poolQueuePush(POOL_QUEUE *pstQueue, const POOL_TASK *pstTask)
+{
+	bool blReturn = true;
+	POOL_TASK *pstTasks = NULL;
+	uint32 ulCapacity = 0;
+	uint32 ulTask = 0;
+
+	pthread_mutex_lock(&pstQueue->stLock);
+	if(pstQueue->ulCount == pstQueue->ulCapacity)
+	{
+		ulCapacity = pstQueue->ulCapacity > 0 ?
+					 pstQueue->ulCapacity * 2 : POOL_MIN_CAPACITY;
+		pstTasks = malloc(ulCapacity * sizeof(POOL_TASK));
+		blReturn = (pstTasks != NULL);
+		for(ulTask = 0; ulTask < pstQueue->ulCount && blReturn == true;
+			ulTask++)
+		{
+			pstTasks[ulTask] = pstQueue->pstTasks[(pstQueue->ulTop + ulTask) %
+												  pstQueue->ulCapacity];
+		}
+		if(blReturn == true)
+		{
+			free(pstQueue->pstTasks);
+			pstQueue->pstTasks = pstTasks;
+			pstQueue->ulCapacity = ulCapacity;
+			pstQueue->ulTop = 0;
+		}
+	}
+	if(blReturn == true)
+	{
+		pstQueue->pstTasks[(pstQueue->ulTop + pstQueue->ulCount) %
+						   pstQueue->ulCapacity] = *pstTask;
+		pstQueue->ulCount++;
+	}
+	pthread_mutex_unlock(&pstQueue->stLock);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To take a task from one end of a queue
+//Inputs	: pstQueue, the queue
+//Inputs	: blBottom, true for the newest task, false for the oldest
+//Inputs	: pstOnly, the group the task must belong to, NULL for any
+//Outputs	: pstTask, the task taken
+//Return	: True, when a task was taken
+//Return	: False, when the queue is empty or its end task is of another
+//			  group
+//Notes		:
+//******************************************************************************
+static bool poolQueueTake(POOL_QUEUE *pstQueue, bool blBottom,
+						  const POOL_GROUP *pstOnly, POOL_TASK *pstTask)
+{
+	bool blReturn = false;
+	uint32 ulSlot = 0;
+
+	pthread_mutex_lock(&pstQueue->stLock);
+	if(pstQueue->ulCount > 0)
+	{
+		ulSlot = blBottom == true ?
+				 (pstQueue->ulTop + pstQueue->ulCount - 1) %
+				 pstQueue->ulCapacity : pstQueue->ulTop;
+		if(pstOnly == NULL || pstQueue->pstTasks[ulSlot].pstGroup == pstOnly)
+		{
+			*pstTask = pstQueue->pstTasks[ulSlot];
+			if(blBottom != true)
+			{
+				pstQueue->ulTop = (pstQueue->ulTop + 1) % pstQueue->ulCapacity;
+			}
+			pstQueue->ulCount--;
+			blReturn = true;
+		}
+	}
+	pthread_mutex_unlock(&pstQueue->stLock);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find a queued task to run
+//Inputs	: lWorker, index of the calling worker, POOL_NO_WORKER for any
+//			  other thread
+//Inputs	: pstOnly, the group the task must belong to, NULL for any
+//Outputs	: pstTask, the task taken
+//Return	: True, when a task was taken
+//Return	: False, when there is none
+//Notes		: The own deque comes first, then the injection queue, then the
+//			  other deques from the next worker on
+//******************************************************************************
+static bool poolFind(int32 lWorker, const POOL_GROUP *pstOnly,
+					 POOL_TASK *pstTask)
+{
+	bool blReturn = false;
+	uint32 ulWorkerCount = atomic_load(&stPool.ulWorkerCount);
+	uint32 ulVictim = 0;
+	uint32 ulStep = 0;
+
+	if(lWorker != POOL_NO_WORKER)
+	{
+		blReturn = poolQueueTake(&stPool.pstDeques[lWorker], true, pstOnly,
+								 pstTask);
+		ulVictim = lWorker + 1;
+	}
+	if(blReturn != true)
+	{
+		blReturn = poolQueueTake(&stPool.stInjected, false, pstOnly,
+								 pstTask);
+	}
+	for(ulStep = 0; ulStep < ulWorkerCount && blReturn != true; ulStep++)
+	{
+		if((int32)((ulVictim + ulStep) % ulWorkerCount) != lWorker)
+		{
+			blReturn = poolQueueTake(&stPool.pstDeques[(ulVictim + ulStep) %
+													   ulWorkerCount],
+									 false, pstOnly, pstTask);
+		}
+	}
+	if(blReturn == true)
+	{
+		atomic_fetch_sub(&stPool.ulQueued, 1);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To run a task and account for it in its group
+//Inputs	: pstTask, the task
+//Outputs	: None
+//Return	: None
+//Notes		: The waiters are woken when the last task of a group is done
+//******************************************************************************
+static void poolExecute(const POOL_TASK *pstTask)
+{
+	pstTask->pfnTask(pstTask->pvArgument);
+	if(pstTask->pstGroup != NULL &&
+	   atomic_fetch_sub(&pstTask->pstGroup->ulPending, 1) == 1)
+	{
+		pthread_mutex_lock(&stPool.stLock);
+		pthread_cond_broadcast(&stPool.stDone);
+		pthread_mutex_unlock(&stPool.stLock);
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To run the tasks of the pool
+//Inputs	: pvArgument, the deque of the worker
+//Outputs	: None
+//Return	: None
+//Notes		: Sleeps while nothing is queued
+//******************************************************************************
+static void *poolWorker(void *pvArgument)
+{
+	POOL_TASK stTask;
+
+	lPoolWorker = (POOL_QUEUE *)pvArgument - stPool.pstDeques;
+	while(true)
+	{
+		if(poolFind(lPoolWorker, NULL, &stTask) == true)
+		{
+			poolExecute(&stTask);
+		}
+		else
+		{
+			pthread_mutex_lock(&stPool.stLock);
+			while(atomic_load(&stPool.ulQueued) == 0)
+			{
+				pthread_cond_wait(&stPool.stWork, &stPool.stLock);
+			}
+			pthread_mutex_unlock(&stPool.stLock);
+		}
+	}
+
+	return NULL;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To start the workers of the pool
+//Inputs	: None
+//Outputs	: None
+//Return	: None
+//Notes		: A pool whose workers could not be started runs every task in
+//			  the submitting thread
+//******************************************************************************
+static void poolStart(void)
+{
+	pthread_t stThread;
+	uint32 ulWorker = 0;
+	uint32 ulStrand = 0;
+	uint32 ulWorkerCount = 1;
+	long lProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if(lProcessors > 1)
+	{
+		ulWorkerCount = lProcessors < POOL_MAX_WORKERS ?
+						lProcessors : POOL_MAX_WORKERS;
+	}
+	pthread_mutex_init(&stPool.stLock, NULL);
+	pthread_cond_init(&stPool.stWork, NULL);
+	pthread_cond_init(&stPool.stDone, NULL);
+	pthread_mutex_init(&stPool.stInjected.stLock, NULL);
+	for(ulWorker = 0; ulWorker < POOL_MAX_WORKERS; ulWorker++)
+	{
+		pthread_mutex_init(&stPool.pstDeques[ulWorker].stLock, NULL);
+	}
+	for(ulStrand = 0; ulStrand < POOL_STRANDS; ulStrand++)
+	{
+		pthread_mutex_init(&stPool.pstStrands[ulStrand].stQueue.stLock, NULL);
+	}
+
+	for(ulWorker = 0; ulWorker < ulWorkerCount; ulWorker++)
+	{
+		if(pthread_create(&stThread, NULL, poolWorker,
+						  &stPool.pstDeques[ulWorker]) != 0)
+		{
+			break;
+		}
+		pthread_detach(stThread);
+		atomic_store(&stPool.ulWorkerCount, ulWorker + 1);
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To run the next task of a strand
+//Inputs	: pvArgument, the strand
+//Outputs	: None
+//Return	: None
+//Notes		: Queues itself again while the strand has tasks left, so the
+//			  tasks of a strand never run at the same time
+//******************************************************************************
+static void *poolRunStrand(void *pvArgument)
+{
+	POOL_STRAND *pstStrand = pvArgument;
+	POOL_TASK stTask;
+	bool blTaken = false;
+	bool blMore = false;
+
+	blTaken = poolQueueTake(&pstStrand->stQueue, false, NULL, &stTask);
+	if(blTaken == true)
+	{
+		poolExecute(&stTask);
+	}
+
+	pthread_mutex_lock(&pstStrand->stQueue.stLock);
+	blMore = (pstStrand->stQueue.ulCount > 0);
+	pstStrand->blScheduled = blMore;
+	pthread_mutex_unlock(&pstStrand->stQueue.stLock);
+
+	if(blMore == true)
+	{
+		poolSubmit(NULL, poolRunStrand, pstStrand);
+	}
+
+	return NULL;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To queue a task on the pool
+//Inputs	: pstGroup, the group of the task, NULL for none
+//Inputs	: pfnTask and pvArgument, the task
+//Outputs	: None
+//Return	: None
+//Notes		: A task that cannot be queued is run by the calling thread
+//******************************************************************************
+void poolSubmit(POOL_GROUP *pstGroup, POOL_TASK_FUNCTION pfnTask,
+				void *pvArgument)
+{
+	POOL_TASK stTask = {pfnTask, pvArgument, pstGroup};
+	bool blQueued = false;
+
+	pthread_once(&stPoolOnce, poolStart);
+	if(pstGroup != NULL)
+	{
+		atomic_fetch_add(&pstGroup->ulPending, 1);
+	}
+	if(atomic_load(&stPool.ulWorkerCount) > 0)
+	{
+		blQueued = poolQueuePush(lPoolWorker != POOL_NO_WORKER ?
+								 &stPool.pstDeques[lPoolWorker] :
+								 &stPool.stInjected, &stTask);
+	}
+
+	if(blQueued == true)
+	{
+		atomic_fetch_add(&stPool.ulQueued, 1);
+		pthread_mutex_lock(&stPool.stLock);
+		pthread_cond_signal(&stPool.stWork);
+		pthread_mutex_unlock(&stPool.stLock);
+	}
+	else
+	{
+		poolExecute(&stTask);
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To queue a task after the tasks submitted before with its key
+//Inputs	: pstGroup, the group of the task, NULL for none
+//Inputs	: ulKey, the key ordering the task
+//Inputs	: pfnTask and pvArgument, the task
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, when out of memory, the task is then not run
+//Notes		: Keys sharing a strand are ordered together
+//******************************************************************************
+bool poolSubmitOrdered(POOL_GROUP *pstGroup, uint32 ulKey,
+					   POOL_TASK_FUNCTION pfnTask, void *pvArgument)
+{
+	POOL_TASK stTask = {pfnTask, pvArgument, pstGroup};
+	POOL_STRAND *pstStrand = NULL;
+	bool blReturn = false;
+	bool blSchedule = false;
+
+	pthread_once(&stPoolOnce, poolStart);
+	pstStrand = &stPool.pstStrands[hashMix(ulKey) % POOL_STRANDS];
+	if(pstGroup != NULL)
+	{
+		atomic_fetch_add(&pstGroup->ulPending, 1);
+	}
+
+	// The strand is marked scheduled under its lock, so a single runner
+	// drains it
+	blReturn = poolQueuePush(&pstStrand->stQueue, &stTask);
+	if(blReturn == true)
+	{
+		pthread_mutex_lock(&pstStrand->stQueue.stLock);
+		blSchedule = (pstStrand->blScheduled != true);
+		pstStrand->blScheduled = true;
+		pthread_mutex_unlock(&pstStrand->stQueue.stLock);
+		if(blSchedule == true)
+		{
+			poolSubmit(NULL, poolRunStrand, pstStrand);
+		}
+	}
+	else
+	{
+		if(pstGroup != NULL)
+		{
+			atomic_fetch_sub(&pstGroup->ulPending, 1);
+		}
+		printf("\nUnable to queue the task : Out of memory");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To wait until every task of a group is done
+//Inputs	: pstGroup, the group
+//Outputs	: None
+//Return	: None
+//Notes		: Queued tasks of the group are run by the calling thread
+//******************************************************************************
+void poolWait(POOL_GROUP *pstGroup)
+{
+	POOL_TASK stTask;
+
+	while(atomic_load(&pstGroup->ulPending) > 0)
+	{
+		if(poolFind(lPoolWorker, pstGroup, &stTask) == true)
+		{
+			poolExecute(&stTask);
+		}
+		else
+		{
+			pthread_mutex_lock(&stPool.stLock);
+			if(atomic_load(&pstGroup->ulPending) > 0)
+			{
+				pthread_cond_wait(&stPool.stDone, &stPool.stLock);
+			}
+			pthread_mutex_unlock(&stPool.stLock);
+		}
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To run an array of tasks on the pool and wait for them
+//Inputs	: pfnTask, the task run with each element
+//Inputs	: pvTasks, the elements
+//Inputs	: ulTaskSize, size of an element
+//Inputs	: ulTaskCount, number of elements
+//Outputs	: pvTasks, the completed elements
+//Return	: None
+//Notes		: The calling thread runs the first element itself
+//******************************************************************************
+void poolRun(POOL_TASK_FUNCTION pfnTask, void *pvTasks, uint32 ulTaskSize,
+			 uint32 ulTaskCount)
+{
+	POOL_GROUP stGroup = {0};
+	uint32 ulTask = 0;
+
+	for(ulTask = 1; ulTask < ulTaskCount; ulTask++)
+	{
+		poolSubmit(&stGroup, pfnTask, (uint8 *)pvTasks + ulTask * ulTaskSize);
+	}
+	if(ulTaskCount > 0)
+	{
+		pfnTask(pvTasks);
+	}
+	poolWait(&stGroup);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To get the number of workers of the pool
+//Inputs	: None
+//Outputs	: None
+//Return	: The number of workers, 0 when every task runs in the
+//			  submitting thread
+//Notes		: Starts the pool
+//******************************************************************************
+uint32 poolGetWorkerCount(void)
+{
+	pthread_once(&stPoolOnce, poolStart);
+
+	return atomic_load(&stPool.ulWorkerCount);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To get the index of the worker running the calling thread
+//Inputs	: None
+//Outputs	: None
+//Return	: The index of the worker, below poolGetWorkerCount()
+//Return	: poolGetWorkerCount(), for a thread outside the pool
+//Notes		: A thread waiting for a group runs its tasks with that index
+//******************************************************************************
+uint32 poolGetWorkerIndex(void)
+{
+	return (lPoolWorker == POOL_NO_WORKER) ? poolGetWorkerCount() :
+											 (uint32)lPoolWorker;
+}
+// EOF
@@ -0,0 +1,48 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Shared work stealing pool of worker threads
+// Note		: Every worker owns a deque of tasks, idle workers steal from
+//			  the others. Tasks submitted with a key run one at a time in
+//			  the order they were submitted for that key.
+//
+//******************************************************************************
+
+#ifndef _POOL_H_
+#define _POOL_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "customTypes.h"
+
+//******************************* Global Types *********************************
+typedef void *(*POOL_TASK_FUNCTION)(void *pvArgument);
+
+// Tasks submitted together and waited for together
+typedef struct _POOL_GROUP_
+{
+	_Atomic uint32 ulPending;
+} POOL_GROUP;
+
+//***************************** Global Constants *******************************
+#define POOL_MAX_WORKERS		(64)
+#define POOL_STRANDS			(256)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+void poolSubmit(POOL_GROUP *pstGroup, POOL_TASK_FUNCTION pfnTask,
+				void *pvArgument);
+bool poolSubmitOrdered(POOL_GROUP *pstGroup, uint32 ulKey,
+					   POOL_TASK_FUNCTION pfnTask, void *pvArgument);
+void poolWait(POOL_GROUP *pstGroup);
+void poolRun(POOL_TASK_FUNCTION pfnTask, void *pvTasks, uint32 ulTaskSize,
+			 uint32 ulTaskCount);
+uint32 poolGetWorkerCount(void);
+uint32 poolGetWorkerIndex(void);
+
+#endif // _POOL_H_
+// EOF
@@ -0,0 +1,419 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: segment.c
+// Summary	: Compressed segment image of a data file
+// Note		: "<data file>.seg" holds a header, one directory entry per block
+//			  and the compressed blocks. A block holds SEGMENT_BLOCK_RECORDS
+//			  records, the last one possibly fewer, and its directory entry
+//			  gives its place, its CRC32C and the smallest and largest Id,
+//			  Vendor and Serial it holds. Like the serial index, the header
+//			  records the identity of the data file; a segment is only used
+//			  while its data file is unchanged and is never updated, an
+//			  archive run builds it again.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "crc.h"
+#include "lz.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "segment.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define WRITE_COUNT			(1)
+#define SEGMENT_BLOCK_SIZE	(SEGMENT_BLOCK_RECORDS * sizeof(DEVICE_DETAILS))
+#define PERCENT				(100.0)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To widen a zone to hold a value
+//Inputs	: pstZone, the zone
+//Inputs	: ulValue, the value
+//Inputs	: blFirst, whether the value is the first of the block
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void segmentWiden(SEGMENT_ZONE *pstZone, uint32 ulValue, bool blFirst)
+{
+	if(blFirst == true || ulValue < pstZone->ulMin)
+	{
+		pstZone->ulMin = ulValue;
+	}
+	if(blFirst == true || ulValue > pstZone->ulMax)
+	{
+		pstZone->ulMax = ulValue;
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compress the blocks of a data file into a segment file
+//Inputs	: lFd, the data file
+//Inputs	: pstHeader, the header, with the record and block counts
+//Inputs	: pstFile, the segment file, positioned after the directory
+//Outputs	: pstBlocks, the directory entries of the blocks
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool segmentWriteBlocks(int32 lFd, const SEGMENT_HEADER *pstHeader,
+							   SEGMENT_BLOCK *pstBlocks, FILE *pstFile)
+{
+	bool blReturn = false;
+	DEVICE_DETAILS *pstRecords = NULL;
+	uint8 *pucCompressed = NULL;
+	uint32 ulOffset = sizeof(SEGMENT_HEADER) +
+					  pstHeader->ulBlockCount * sizeof(SEGMENT_BLOCK);
+	uint32 ulBlock = 0;
+	uint32 ulIndex = 0;
+	uint32 ulCount = 0;
+	uint32 ulSize = 0;
+
+	pstRecords = malloc(SEGMENT_BLOCK_SIZE);
+	pucCompressed = malloc(lzBound(SEGMENT_BLOCK_SIZE));
+	blReturn = (pstRecords != NULL && pucCompressed != NULL);
+
+	for(ulBlock = 0; ulBlock < pstHeader->ulBlockCount && blReturn == true;
+		ulBlock++)
+	{
+		ulCount = pstHeader->ulRecordCount - ulBlock * SEGMENT_BLOCK_RECORDS;
+		if(ulCount > SEGMENT_BLOCK_RECORDS)
+		{
+			ulCount = SEGMENT_BLOCK_RECORDS;
+		}
+		ulSize = ulCount * sizeof(DEVICE_DETAILS);
+		blReturn = (pread(lFd, pstRecords, ulSize, (off_t)ulBlock *
+						  SEGMENT_BLOCK_SIZE) == (ssize_t)ulSize);
+
+		for(ulIndex = 0; ulIndex < ulCount && blReturn == true; ulIndex++)
+		{
+			segmentWiden(&pstBlocks[ulBlock].stId,
+						 pstRecords[ulIndex].ulDeviceId, ulIndex == 0);
+			segmentWiden(&pstBlocks[ulBlock].stVendor,
+						 pstRecords[ulIndex].ulDeviceVendor, ulIndex == 0);
+			segmentWiden(&pstBlocks[ulBlock].stSerial,
+						 pstRecords[ulIndex].ulDeviceSerial, ulIndex == 0);
+		}
+
+		if(blReturn == true)
+		{
+			pstBlocks[ulBlock].ulOffset = ulOffset;
+			pstBlocks[ulBlock].ulRecordCount = ulCount;
+			pstBlocks[ulBlock].ulSize = lzCompress((uint8 *)pstRecords, ulSize,
+												   pucCompressed);
+			pstBlocks[ulBlock].ulChecksum = crc32c(CRC_INITIAL, pucCompressed,
+												   pstBlocks[ulBlock].ulSize);
+			ulOffset += pstBlocks[ulBlock].ulSize;
+			blReturn = fileWrite(pucCompressed, pstBlocks[ulBlock].ulSize,
+								 WRITE_COUNT, pstFile);
+		}
+	}
+
+	free(pstRecords);
+	free(pucCompressed);
+
+	return blReturn;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To build the segment of a data file
+//Inputs	: pucDataPath, name of the data or shard file
+//Outputs	: pulRecordCount, number of records of the segment
+//Outputs	: pulStoredSize, size of the segment file
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The data file has to be left unchanged until the segment is
+//			  built, the caller being the only writer. Written to a temporary
+//			  file first, so readers never see a partly written segment.
+//******************************************************************************
+bool segmentBuild(const uint8 *pucDataPath, uint32 *pulRecordCount,
+				  uint32 *pulStoredSize)
+{
+	bool blReturn = false;
+	SEGMENT_HEADER stHeader = {0};
+	SEGMENT_BLOCK *pstBlocks = NULL;
+	FILE *pstFile = NULL;
+	FILE_IDENTITY stIdentity = {0};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	int32 lFd = -1;
+
+	if(pucDataPath != NULL && pulRecordCount != NULL && pulStoredSize != NULL)
+	{
+		fileGetIdentity(pucDataPath, &stIdentity);
+		stHeader.ulMagic = SEGMENT_MAGIC;
+		stHeader.stData = stIdentity;
+		stHeader.ulRecordCount = stIdentity.ulSize / sizeof(DEVICE_DETAILS);
+		stHeader.ulBlockCount = (stHeader.ulRecordCount +
+								 SEGMENT_BLOCK_RECORDS - 1) /
+								SEGMENT_BLOCK_RECORDS;
+
+		if(stIdentity.ulSize % sizeof(DEVICE_DETAILS) != 0)
+		{
+			printf("\nUnable to archive %s : Partial record, run verify",
+				   (char *)pucDataPath);
+		}
+		else if(fileBuildPath(pucPath, pucDataPath, SEGMENT_SUFFIX) == true &&
+				fileBuildPath(pucTemporaryPath, pucPath,
+							  SNAPSHOT_TEMPORARY_SUFFIX) == true)
+		{
+			lFd = open((char *)pucDataPath, O_RDONLY);
+			pstBlocks = calloc(stHeader.ulBlockCount + 1,
+							   sizeof(SEGMENT_BLOCK));
+			pstFile = fileOpen(pucTemporaryPath, FILE_WRITE_MODE);
+			blReturn = ((lFd >= 0 || stIdentity.ulSize == 0) &&
+						pstBlocks != NULL && pstFile != NULL);
+		}
+
+		// The directory is written again once the blocks are placed
+		if(blReturn == true)
+		{
+			posix_fadvise(lFd, 0, 0, POSIX_FADV_SEQUENTIAL);
+			blReturn = (fileWrite(&stHeader, sizeof(stHeader), WRITE_COUNT,
+								  pstFile) == true &&
+						(stHeader.ulBlockCount == 0 ||
+						 fileWrite(pstBlocks, stHeader.ulBlockCount *
+								   sizeof(SEGMENT_BLOCK), WRITE_COUNT,
+								   pstFile) == true) &&
+						segmentWriteBlocks(lFd, &stHeader, pstBlocks,
+										   pstFile) == true);
+			*pulStoredSize = ftell(pstFile);
+			blReturn = (blReturn == true &&
+						fseek(pstFile, 0, SEEK_SET) == 0 &&
+						fileWrite(&stHeader, sizeof(stHeader), WRITE_COUNT,
+								  pstFile) == true &&
+						(stHeader.ulBlockCount == 0 ||
+						 fileWrite(pstBlocks, stHeader.ulBlockCount *
+								   sizeof(SEGMENT_BLOCK), WRITE_COUNT,
+								   pstFile) == true));
+		}
+
+		if(pstFile != NULL)
+		{
+			if(fileClose(pstFile) != true)
+			{
+				blReturn = false;
+			}
+
+			if(blReturn == true)
+			{
+				blReturn = (rename((char *)pucTemporaryPath,
+								   (char *)pucPath) == 0);
+			}
+			else
+			{
+				remove((char *)pucTemporaryPath);
+			}
+		}
+
+		if(lFd >= 0)
+		{
+			close(lFd);
+		}
+		free(pstBlocks);
+		*pulRecordCount = stHeader.ulRecordCount;
+
+		if(blReturn != true)
+		{
+			printf("\nUnable to build the segment of %s", (char *)pucDataPath);
+		}
+	}
+	else
+	{
+		printf("\nUnable to build the segment : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open the segment of a data file
+//Inputs	: pucDataPath, name of the data or shard file
+//Inputs	: pstData, identity of the data file the segment has to describe
+//Outputs	: pstSegment, the open segment, to be closed with segmentClose()
+//Return	: True, if the segment describes the data file
+//Return	: False, if there is no such segment
+//Notes		: A missing or outdated segment is not an error, the caller
+//			  reads the data file instead
+//******************************************************************************
+bool segmentOpen(const uint8 *pucDataPath, const FILE_IDENTITY *pstData,
+				 SEGMENT *pstSegment)
+{
+	bool blReturn = false;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulSize = 0;
+
+	if(pucDataPath != NULL && pstData != NULL && pstSegment != NULL)
+	{
+		memset(pstSegment, 0, sizeof(SEGMENT));
+		pstSegment->lFd = SEGMENT_INVALID_FD;
+		if(fileBuildPath(pucPath, pucDataPath, SEGMENT_SUFFIX) == true)
+		{
+			pstSegment->lFd = open((char *)pucPath, O_RDONLY);
+		}
+
+		blReturn = (pstSegment->lFd != SEGMENT_INVALID_FD &&
+					filePageAttach(pstSegment->lFd) == true &&
+					filePageRead(pstSegment->lFd, &pstSegment->stHeader,
+								 sizeof(SEGMENT_HEADER), 0) == true &&
+					pstSegment->stHeader.ulMagic == SEGMENT_MAGIC &&
+					fileSameIdentity(&pstSegment->stHeader.stData,
+									 pstData) == true &&
+					pstSegment->stHeader.ulRecordCount ==
+					pstData->ulSize / sizeof(DEVICE_DETAILS));
+
+		if(blReturn == true)
+		{
+			ulSize = pstSegment->stHeader.ulBlockCount * sizeof(SEGMENT_BLOCK);
+			pstSegment->pstBlocks = malloc(ulSize + 1);
+			pstSegment->pucBuffer = malloc(lzBound(SEGMENT_BLOCK_SIZE));
+			blReturn = (pstSegment->pstBlocks != NULL &&
+						pstSegment->pucBuffer != NULL &&
+						filePageRead(pstSegment->lFd, pstSegment->pstBlocks,
+									 ulSize, sizeof(SEGMENT_HEADER)) == true);
+		}
+
+		if(blReturn != true)
+		{
+			segmentClose(pstSegment);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the records of a block
+//Inputs	: pstSegment, the open segment
+//Inputs	: ulBlock, the block
+//Outputs	: pstRecords, room for SEGMENT_BLOCK_RECORDS records, holds the
+//			  ulRecordCount records of the block
+//Return	: True, at time of successful execution
+//Return	: False, if the block cannot be read or is damaged
+//Notes		: Read through the page pool as a scan
+//******************************************************************************
+bool segmentReadBlock(SEGMENT *pstSegment, uint32 ulBlock,
+					  DEVICE_DETAILS *pstRecords)
+{
+	bool blReturn = false;
+	const SEGMENT_BLOCK *pstBlock = NULL;
+
+	if(pstSegment != NULL && pstRecords != NULL &&
+	   ulBlock < pstSegment->stHeader.ulBlockCount)
+	{
+		pstBlock = &pstSegment->pstBlocks[ulBlock];
+		blReturn = (pstBlock->ulSize <= lzBound(SEGMENT_BLOCK_SIZE) &&
+					pstBlock->ulRecordCount <= SEGMENT_BLOCK_RECORDS &&
+					filePageScan(pstSegment->lFd, pstSegment->pucBuffer,
+								 pstBlock->ulSize, pstBlock->ulOffset) ==
+					true &&
+					crc32c(CRC_INITIAL, pstSegment->pucBuffer,
+						   pstBlock->ulSize) == pstBlock->ulChecksum &&
+					lzDecompress(pstSegment->pucBuffer, pstBlock->ulSize,
+								 (uint8 *)pstRecords, pstBlock->ulRecordCount *
+								 sizeof(DEVICE_DETAILS)) == true);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To close a segment
+//Inputs	: pstSegment, the segment
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+void segmentClose(SEGMENT *pstSegment)
+{
+	if(pstSegment != NULL)
+	{
+		if(pstSegment->lFd != SEGMENT_INVALID_FD)
+		{
+			filePageClose(pstSegment->lFd);
+			pstSegment->lFd = SEGMENT_INVALID_FD;
+		}
+		free(pstSegment->pstBlocks);
+		free(pstSegment->pucBuffer);
+		pstSegment->pstBlocks = NULL;
+		pstSegment->pucBuffer = NULL;
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To build the segments of all the files of the device data
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Runs as the only writer, readers are not blocked
+//******************************************************************************
+bool segmentArchive(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	SHARD_LAYOUT stLayout = {0};
+	SNAPSHOT_WRITER stWriter;
+	FILE_IDENTITY stIdentity = {0};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+	uint32 ulRecordCount = 0;
+	uint32 ulStoredSize = 0;
+
+	if(pucFileName != NULL &&
+	   snapshotWriterBegin(pucFileName, &stWriter) == true)
+	{
+		blReturn = shardGetLayout(pucFileName, &stLayout);
+		for(ulShard = 0; ulShard < stLayout.ulShardCount && blReturn == true;
+			ulShard++)
+		{
+			blReturn = (shardGetPath(pucFileName, &stLayout, ulShard,
+									 pucPath) == true &&
+						segmentBuild(pucPath, &ulRecordCount,
+									 &ulStoredSize) == true);
+			if(blReturn == true)
+			{
+				fileGetIdentity(pucPath, &stIdentity);
+				printf("%s\t%lu record(s) in %lu block(s), %lu bytes stored"
+					   " in %lu bytes (%.1f%%)\n", (char *)pucPath,
+					   ulRecordCount, (ulRecordCount + SEGMENT_BLOCK_RECORDS -
+									   1) / SEGMENT_BLOCK_RECORDS,
+					   stIdentity.ulSize, ulStoredSize,
+					   stIdentity.ulSize > 0 ? ulStoredSize * PERCENT /
+					   stIdentity.ulSize : PERCENT);
+			}
+		}
+		snapshotWriterEnd(&stWriter);
+	}
+	else
+	{
+		printf("\nUnable to archive the device data : Lock failed");
+	}
+
+	return blReturn;
+}
+// EOF
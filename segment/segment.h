@@ -0,0 +1,80 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Compressed segment image of a data file
+// Note		: Fixed size blocks of records compressed with the LZ codec, each
+//			  with the ranges of its Id, Vendor and Serial, so a scan reads
+//			  less and skips the blocks that cannot match
+//
+//******************************************************************************
+
+#ifndef _SEGMENT_H_
+#define _SEGMENT_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+
+//******************************* Global Types *********************************
+typedef struct _SEGMENT_ZONE_
+{
+	uint32 ulMin;
+	uint32 ulMax;
+} SEGMENT_ZONE;
+
+typedef struct _SEGMENT_BLOCK_
+{
+	uint32 ulOffset;
+	uint32 ulSize;
+	uint32 ulRecordCount;
+	uint32 ulChecksum;
+	SEGMENT_ZONE stId;
+	SEGMENT_ZONE stVendor;
+	SEGMENT_ZONE stSerial;
+} SEGMENT_BLOCK;
+
+typedef struct _SEGMENT_HEADER_
+{
+	uint32 ulMagic;
+	FILE_IDENTITY stData;
+	uint32 ulRecordCount;
+	uint32 ulBlockCount;
+} SEGMENT_HEADER;
+
+typedef struct _SEGMENT_
+{
+	int32 lFd;
+	SEGMENT_HEADER stHeader;
+	SEGMENT_BLOCK *pstBlocks;
+	uint8 *pucBuffer;
+} SEGMENT;
+
+// Tells whether a block may hold a record matching the context
+typedef bool (*SEGMENT_PRUNE)(const SEGMENT_BLOCK *pstBlock,
+							  const void *pvContext);
+
+//***************************** Global Constants *******************************
+#define SEGMENT_SUFFIX			(".seg")
+#define SEGMENT_MAGIC			(0x47455344UL)
+#define SEGMENT_BLOCK_RECORDS	(512)
+#define SEGMENT_INVALID_FD		(-1)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool segmentBuild(const uint8 *pucDataPath, uint32 *pulRecordCount,
+				  uint32 *pulStoredSize);
+bool segmentOpen(const uint8 *pucDataPath, const FILE_IDENTITY *pstData,
+				 SEGMENT *pstSegment);
+bool segmentReadBlock(SEGMENT *pstSegment, uint32 ulBlock,
+					  DEVICE_DETAILS *pstRecords);
+void segmentClose(SEGMENT *pstSegment);
+bool segmentArchive(const uint8 *pucFileName);
+
+#endif // _SEGMENT_H_
+// EOF
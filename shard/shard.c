@@ -0,0 +1,1301 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: shard.c
+// Summary	: Hash sharded layout of the device data file
+// Note		: Records are routed to a shard by the hash of the serial number.
+//			  Scans and removals fan out to one pool task per shard and a
+//			  removal only rewrites the shards holding a matching record.
+//			  A reshard writes the new shards to "<shard>.tmp" and lists
+//			  both layouts in "<data file>.reshard" before renaming them
+//			  into place, a journal left by an interruption is rolled
+//			  forward by the next start.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "crc.h"
+#include "hash.h"
+#include "index.h"
+#include "bloom.h"
+#include "snapshot.h"
+#include "segment.h"
+#include "pool.h"
+#include "shard.h"
+
+//******************************* Local Types **********************************
+typedef struct _SHARD_TASK_
+{
+	uint8 pucPath[FILE_PATH_MAX_SIZE];
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE];
+	SHARD_MATCH pfnMatch;
+	SEGMENT_PRUNE pfnPrune;
+	const void *pvContext;
+	SNAPSHOT *pstSnapshot;
+	uint32 ulFile;
+	SHARD_RESULT stResult;
+	ARENA stArena;
+	uint32 ulRemoved;
+	bool blCollect;
+	bool blStatus;
+} SHARD_TASK;
+
+//***************************** Local Constants ********************************
+#define READ_COUNT				(1)
+#define WRITE_COUNT				(1)
+#define SHARD_NAME_FORMAT		("%s.%03lu")
+#define SHARD_RESULT_MIN_SIZE	(16)
+#define STRINGS_EQUAL			(0)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To collect the matching records of a pinned file from its
+//			  segment
+//Inputs	: pstTask, SHARD_TASK with the pinned file and the predicates
+//Outputs	: stResult of the task holds the matching records
+//Return	: True, if the segment has been scanned
+//Return	: False, if the file has no usable segment, nothing is collected
+//Notes		: Only the blocks kept by the prune predicate are read
+//******************************************************************************
+static bool shardScanSegment(SHARD_TASK *pstTask)
+{
+	bool blReturn = false;
+	SEGMENT stSegment;
+	FILE_IDENTITY stIdentity = {0};
+	DEVICE_DETAILS *pstRecords = NULL;
+	uint32 ulBlock = 0;
+	uint32 ulIndex = 0;
+
+	// The pinned file only grows while pinned, an unchanged identity means
+	// the segment holds exactly its records
+	fileGetOpenIdentity(pstTask->pstSnapshot->pstFiles[pstTask->ulFile],
+						&stIdentity);
+	if(segmentOpen(pstTask->pucPath, &stIdentity, &stSegment) == true)
+	{
+		pstRecords = arenaAlloc(&pstTask->stArena, SEGMENT_BLOCK_RECORDS *
+								sizeof(DEVICE_DETAILS));
+		blReturn = (pstRecords != NULL &&
+					stSegment.stHeader.ulRecordCount ==
+					pstTask->pstSnapshot->pulRecordCounts[pstTask->ulFile]);
+
+		for(ulBlock = 0; ulBlock < stSegment.stHeader.ulBlockCount &&
+			blReturn == true; ulBlock++)
+		{
+			if(pstTask->pfnPrune(&stSegment.pstBlocks[ulBlock],
+								 pstTask->pvContext) == true)
+			{
+				blReturn = segmentReadBlock(&stSegment, ulBlock, pstRecords);
+				for(ulIndex = 0; ulIndex <
+					stSegment.pstBlocks[ulBlock].ulRecordCount &&
+					blReturn == true; ulIndex++)
+				{
+					if(pstTask->pfnMatch(&pstRecords[ulIndex],
+										 pstTask->pvContext) == true)
+					{
+						blReturn = shardResultAppend(&pstTask->stResult,
+													 &pstRecords[ulIndex]);
+					}
+				}
+			}
+		}
+		segmentClose(&stSegment);
+
+		if(blReturn != true)
+		{
+			shardResultFree(&pstTask->stResult);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To collect the matching records of a single pinned file
+//Inputs	: pvTask, SHARD_TASK with the pinned file and the predicate
+//Outputs	: stResult of the task holds the matching records
+//Return	: NULL
+//Notes		: Runs as a pool task. The segment of the file is scanned
+//			  instead when the task has a prune predicate and the segment is
+//			  up to date.
+//******************************************************************************
+static void *shardScanFile(void *pvTask)
+{
+	SHARD_TASK *pstTask = pvTask;
+	DEVICE_DETAILS DeviceData = {0};
+
+	pstTask->blStatus = true;
+
+	if(pstTask->pfnPrune == NULL || shardScanSegment(pstTask) != true)
+	{
+		while(pstTask->blStatus == true &&
+			  snapshotRead(pstTask->pstSnapshot, pstTask->ulFile,
+						   &DeviceData) == true)
+		{
+			if(pstTask->pfnMatch(&DeviceData, pstTask->pvContext) == true)
+			{
+				pstTask->blStatus = shardResultAppend(&pstTask->stResult,
+													  &DeviceData);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To copy the leading records of a file to a new file
+//Inputs	: pucPath, the file to copy from
+//Inputs	: ulRecordCount, number of records to copy
+//Inputs	: pstTemporaryFile, the file to copy to
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool shardCopyPrefix(const uint8 *pucPath, uint32 ulRecordCount,
+							FILE *pstTemporaryFile)
+{
+	bool blReturn = false;
+	DEVICE_DETAILS DeviceData = {0};
+	FILE *pstFile = NULL;
+	uint32 ulIndex = 0;
+
+	pstFile = fileOpen(pucPath, FILE_READ_MODE);
+	if(pstFile != NULL)
+	{
+		blReturn = true;
+		for(ulIndex = 0; ulIndex < ulRecordCount && blReturn == true;
+			ulIndex++)
+		{
+			blReturn = fileRead(&DeviceData, sizeof(DeviceData),
+								READ_COUNT, pstFile);
+			if(blReturn == true)
+			{
+				blReturn = fileWrite(&DeviceData, sizeof(DeviceData),
+									 WRITE_COUNT, pstTemporaryFile);
+			}
+		}
+		fileClose(pstFile);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write a single data file without its matching records
+//Inputs	: pvTask, SHARD_TASK with the file name and the predicate
+//Outputs	: ulRemoved of the task holds the number of removed records
+//Outputs	: stResult of the task holds the removed records, when blCollect
+//			  is set
+//Outputs	: pucTemporaryPath of the task names the rewritten file, it is
+//			  empty when the file holds no matching record
+//Return	: NULL
+//Notes		: Runs as a pool task. The temporary file is only created on
+//			  the first match, so a file without matches is never rewritten.
+//******************************************************************************
+static void *shardRemoveFromFile(void *pvTask)
+{
+	SHARD_TASK *pstTask = pvTask;
+	DEVICE_DETAILS DeviceData = {0};
+	FILE *pstFile = NULL;
+	FILE *pstTemporaryFile = NULL;
+	uint32 ulIndex = 0;
+
+	pstTask->blStatus = true;
+	pstTask->ulRemoved = 0;
+	pstTask->pucTemporaryPath[0] = '\0';
+
+	if(fileExists(pstTask->pucPath) == true)
+	{
+		pstFile = fileOpen(pstTask->pucPath, FILE_READ_MODE);
+		if(pstFile != NULL)
+		{
+			while(pstTask->blStatus == true &&
+				  fileRead(&DeviceData, sizeof(DeviceData),
+						   READ_COUNT, pstFile) == true)
+			{
+				if(pstTask->pfnMatch(&DeviceData, pstTask->pvContext) == true)
+				{
+					if(pstTemporaryFile == NULL)
+					{
+						pstTask->blStatus = fileBuildPath(
+												pstTask->pucTemporaryPath,
+												pstTask->pucPath,
+												SHARD_TEMPORARY_SUFFIX);
+						if(pstTask->blStatus == true)
+						{
+							pstTemporaryFile = fileOpen(
+												pstTask->pucTemporaryPath,
+												FILE_WRITE_MODE);
+							pstTask->blStatus = (pstTemporaryFile != NULL);
+						}
+						if(pstTask->blStatus == true)
+						{
+							pstTask->blStatus = shardCopyPrefix(
+													pstTask->pucPath, ulIndex,
+													pstTemporaryFile);
+						}
+					}
+					pstTask->ulRemoved++;
+					if(pstTask->blStatus == true && pstTask->blCollect == true)
+					{
+						pstTask->blStatus = shardResultAppend(
+												&pstTask->stResult,
+												&DeviceData);
+					}
+				}
+				else if(pstTemporaryFile != NULL)
+				{
+					pstTask->blStatus = fileWrite(&DeviceData,
+												  sizeof(DeviceData),
+												  WRITE_COUNT,
+												  pstTemporaryFile);
+				}
+				ulIndex++;
+			}
+			fileClose(pstFile);
+		}
+		else
+		{
+			pstTask->blStatus = false;
+		}
+	}
+
+	if(pstTemporaryFile != NULL && fileClose(pstTemporaryFile) != true)
+	{
+		pstTask->blStatus = false;
+	}
+
+	if(pstTask->blStatus != true && pstTask->pucTemporaryPath[0] != '\0')
+	{
+		remove((char *)pstTask->pucTemporaryPath);
+		pstTask->pucTemporaryPath[0] = '\0';
+		pstTask->ulRemoved = 0;
+	}
+
+	return NULL;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To prepare one task per shard of a layout
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstLayout, the shard layout
+//Inputs	: pfnMatch and pvContext, the predicate used by the tasks
+//Outputs	: pstTasks, one task per shard
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool shardPrepareTasks(const uint8 *pucFileName,
+								const SHARD_LAYOUT *pstLayout,
+								SHARD_MATCH pfnMatch, const void *pvContext,
+								SHARD_TASK *pstTasks)
+{
+	bool blReturn = true;
+	uint32 ulShard = 0;
+
+	for(ulShard = 0; ulShard < pstLayout->ulShardCount && blReturn == true;
+		ulShard++)
+	{
+		memset(&pstTasks[ulShard], 0, sizeof(SHARD_TASK));
+		pstTasks[ulShard].pfnMatch = pfnMatch;
+		pstTasks[ulShard].pvContext = pvContext;
+		pstTasks[ulShard].ulFile = ulShard;
+		blReturn = shardGetPath(pucFileName, pstLayout, ulShard,
+								pstTasks[ulShard].pucPath);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To run a set of shard tasks
+//Inputs	: pfnTask, the per shard task to be run
+//Inputs	: pstTasks, the prepared tasks
+//Inputs	: ulTaskCount, number of tasks
+//Outputs	: pstTasks, the completed tasks
+//Return	: None
+//Notes		: The tasks are run on the shared pool, a single task is run by
+//			  the calling thread
+//******************************************************************************
+static void shardRunTasks(void *(*pfnTask)(void *), SHARD_TASK *pstTasks,
+							uint32 ulTaskCount)
+{
+	poolRun(pfnTask, pstTasks, sizeof(SHARD_TASK), ulTaskCount);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To scan the pinned files of a snapshot for matching records
+//Inputs	: pstSnapshot, the snapshot holding the pinned shards
+//Inputs	: pstTasks, the tasks prepared for the pinned shards
+//Outputs	: pstResult, the matching records in shard order
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool shardScanSnapshot(SNAPSHOT *pstSnapshot, SHARD_TASK *pstTasks,
+								SHARD_RESULT *pstResult)
+{
+	bool blReturn = true;
+	uint32 ulShard = 0;
+	uint32 ulIndex = 0;
+
+	for(ulShard = 0; ulShard < pstSnapshot->ulFileCount; ulShard++)
+	{
+		pstTasks[ulShard].pstSnapshot = pstSnapshot;
+		pstTasks[ulShard].ulFile = ulShard;
+		arenaInit(&pstTasks[ulShard].stArena, ARENA_QUERY_SIZE);
+		pstTasks[ulShard].stResult.pstArena = &pstTasks[ulShard].stArena;
+	}
+
+	shardRunTasks(shardScanFile, pstTasks, pstSnapshot->ulFileCount);
+
+	for(ulShard = 0; ulShard < pstSnapshot->ulFileCount; ulShard++)
+	{
+		blReturn = (blReturn == true && pstTasks[ulShard].blStatus == true);
+		for(ulIndex = 0; ulIndex < pstTasks[ulShard].stResult.ulCount &&
+			blReturn == true; ulIndex++)
+		{
+			blReturn = shardResultAppend(pstResult,
+							&pstTasks[ulShard].stResult.pstRecords[ulIndex]);
+		}
+		arenaRelease(&pstTasks[ulShard].stArena);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write the shard count of a layout
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulShardCount, number of shards
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The layout file is replaced with a single rename
+//******************************************************************************
+static bool shardWriteLayout(const uint8 *pucFileName, uint32 ulShardCount)
+{
+	bool blReturn = false;
+	uint8 pucLayoutPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	FILE *pstFile = NULL;
+
+	if(fileBuildPath(pucLayoutPath, pucFileName, SHARD_LAYOUT_SUFFIX) == true &&
+	   fileBuildPath(pucTemporaryPath, pucLayoutPath,
+					 SHARD_TEMPORARY_SUFFIX) == true)
+	{
+		pstFile = fileOpen(pucTemporaryPath, FILE_WRITE_MODE);
+		if(pstFile != NULL)
+		{
+			blReturn = fileWrite(&ulShardCount, sizeof(ulShardCount),
+								 WRITE_COUNT, pstFile);
+			blReturn = (fileClose(pstFile) == true && blReturn == true);
+		}
+
+		if(blReturn == true)
+		{
+			blReturn = (rename((char *)pucTemporaryPath,
+							   (char *)pucLayoutPath) == 0);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write a file to the disk before it is published
+//Inputs	: pstFile, the file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool shardSync(FILE *pstFile)
+{
+	return (fflush(pstFile) == 0 && fsync(fileno(pstFile)) == 0);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the shard files of the old layout of a reshard
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstJournal, the journal of the reshard
+//Inputs	: pucSuffix, suffix of the files, "" for the shards themselves
+//Outputs	: None
+//Return	: None
+//Notes		: The names reused by the new layout are kept. The shards are
+//			  removed once the new layout is published, their index and
+//			  filter while it is published.
+//******************************************************************************
+static void shardRemoveOld(const uint8 *pucFileName,
+						   const SHARD_JOURNAL *pstJournal,
+						   const uint8 *pucSuffix)
+{
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucNewPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucSidePath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+	uint32 ulNew = 0;
+	bool blReused = false;
+
+	for(ulShard = 0; ulShard < pstJournal->stOldLayout.ulShardCount;
+		ulShard++)
+	{
+		blReused = (shardGetPath(pucFileName, &pstJournal->stOldLayout,
+								 ulShard, pucPath) != true);
+		for(ulNew = 0; ulNew < pstJournal->stNewLayout.ulShardCount &&
+			blReused != true; ulNew++)
+		{
+			blReused = (shardGetPath(pucFileName, &pstJournal->stNewLayout,
+									 ulNew, pucNewPath) == true &&
+						strcmp((char *)pucPath, (char *)pucNewPath) ==
+						STRINGS_EQUAL);
+		}
+
+		if(blReused != true &&
+		   fileBuildPath(pucSidePath, pucPath, pucSuffix) == true)
+		{
+			remove((char *)pucSidePath);
+		}
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the new shards of a reshard not published
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstLayout, the new layout
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void shardDiscard(const uint8 *pucFileName,
+						 const SHARD_LAYOUT *pstLayout)
+{
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+
+	for(ulShard = 0; ulShard < pstLayout->ulShardCount; ulShard++)
+	{
+		if(shardGetPath(pucFileName, pstLayout, ulShard, pucPath) == true &&
+		   fileBuildPath(pucTemporaryPath, pucPath,
+						 SHARD_TEMPORARY_SUFFIX) == true)
+		{
+			remove((char *)pucTemporaryPath);
+		}
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write the journal of a reshard to the disk
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstJournal, the journal, its checksum being set
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The reshard commits once the journal is on the disk
+//******************************************************************************
+static bool shardWriteJournal(const uint8 *pucFileName,
+							  SHARD_JOURNAL *pstJournal)
+{
+	bool blReturn = false;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	FILE *pstFile = NULL;
+
+	pstJournal->ulChecksum = crc32c(CRC_INITIAL, pstJournal,
+									offsetof(SHARD_JOURNAL, ulChecksum));
+	if(fileBuildPath(pucPath, pucFileName, SHARD_JOURNAL_SUFFIX) == true)
+	{
+		pstFile = fopen((char *)pucPath, FILE_WRITE_MODE);
+		blReturn = (pstFile != NULL &&
+					fwrite(pstJournal, sizeof(SHARD_JOURNAL), WRITE_COUNT,
+						   pstFile) == WRITE_COUNT &&
+					shardSync(pstFile) == true);
+		if(pstFile != NULL)
+		{
+			blReturn = (fclose(pstFile) == 0 && blReturn == true);
+		}
+		if(blReturn != true)
+		{
+			remove((char *)pucPath);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To publish the new layout of a reshard
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstWriter, the writer state
+//Inputs	: pstJournal, the journal of the reshard
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Shards already renamed by an interrupted reshard are skipped.
+//			  The index and filter of the old shards no longer used go with
+//			  the commit, the old shards and then the journal once the new
+//			  layout is published.
+//******************************************************************************
+static bool shardPublish(const uint8 *pucFileName, SNAPSHOT_WRITER *pstWriter,
+						 const SHARD_JOURNAL *pstJournal)
+{
+	bool blReturn = false;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+
+	blReturn = snapshotCommitBegin(pstWriter);
+	for(ulShard = 0; ulShard < pstJournal->stNewLayout.ulShardCount &&
+		blReturn == true; ulShard++)
+	{
+		blReturn = (shardGetPath(pucFileName, &pstJournal->stNewLayout,
+								 ulShard, pucPath) == true &&
+					fileBuildPath(pucTemporaryPath, pucPath,
+								  SHARD_TEMPORARY_SUFFIX) == true);
+		if(blReturn == true && fileExists(pucTemporaryPath) == true)
+		{
+			blReturn = (rename((char *)pucTemporaryPath,
+							   (char *)pucPath) == 0);
+		}
+	}
+
+	if(blReturn == true && pstJournal->stNewLayout.blSharded == true)
+	{
+		blReturn = shardWriteLayout(pucFileName,
+									pstJournal->stNewLayout.ulShardCount);
+	}
+	else if(blReturn == true &&
+			fileBuildPath(pucPath, pucFileName, SHARD_LAYOUT_SUFFIX) == true)
+	{
+		remove((char *)pucPath);
+	}
+
+	if(blReturn == true)
+	{
+		shardRemoveOld(pucFileName, pstJournal, INDEX_SUFFIX);
+		shardRemoveOld(pucFileName, pstJournal, BLOOM_SUFFIX);
+	}
+
+	if(snapshotCommitEnd(pstWriter) != true)
+	{
+		blReturn = false;
+	}
+
+	if(blReturn == true)
+	{
+		shardRemoveOld(pucFileName, pstJournal, (uint8 *)"");
+		if(fileBuildPath(pucPath, pucFileName, SHARD_JOURNAL_SUFFIX) == true)
+		{
+			remove((char *)pucPath);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To finish or to drop a reshard left by an interruption
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstWriter, the writer state
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A whole journal of the current generation is rolled forward.
+//			  Once its layout is published only the old shards are left to
+//			  remove, any other journal only tells which files to remove.
+//******************************************************************************
+static bool shardRecoverLocked(const uint8 *pucFileName,
+							   SNAPSHOT_WRITER *pstWriter)
+{
+	bool blReturn = true;
+	bool blWhole = false;
+	FILE *pstFile = NULL;
+	SHARD_JOURNAL stJournal;
+	SHARD_LAYOUT stLayout = {0};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	blReturn = fileBuildPath(pucPath, pucFileName, SHARD_JOURNAL_SUFFIX);
+	if(blReturn == true)
+	{
+		pstFile = fopen((char *)pucPath, FILE_READ_MODE);
+	}
+
+	if(pstFile != NULL)
+	{
+		blWhole = (fread(&stJournal, sizeof(SHARD_JOURNAL), READ_COUNT,
+						 pstFile) == READ_COUNT &&
+				   stJournal.ulMagic == SHARD_MAGIC &&
+				   stJournal.ulChecksum ==
+				   crc32c(CRC_INITIAL, &stJournal,
+						  offsetof(SHARD_JOURNAL, ulChecksum)) &&
+				   stJournal.stOldLayout.ulShardCount <= SHARD_MAX_COUNT &&
+				   stJournal.stNewLayout.ulShardCount <= SHARD_MAX_COUNT);
+		fclose(pstFile);
+
+		if(blWhole == true &&
+		   stJournal.ulGeneration == pstWriter->ulGeneration)
+		{
+			blReturn = shardPublish(pucFileName, pstWriter, &stJournal);
+			printf(blReturn == true ? "Finished an interrupted reshard\n"
+				   : "\nUnable to finish an interrupted reshard\n");
+		}
+		else
+		{
+			if(blWhole == true &&
+			   shardGetLayout(pucFileName, &stLayout) == true &&
+			   stLayout.ulShardCount == stJournal.stNewLayout.ulShardCount)
+			{
+				shardRemoveOld(pucFileName, &stJournal, (uint8 *)"");
+			}
+			else if(blWhole == true)
+			{
+				shardDiscard(pucFileName, &stJournal.stNewLayout);
+			}
+			remove((char *)pucPath);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the shard layout of a data file
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pstLayout, the shard layout
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A data file without a layout file is a single unsharded file
+//******************************************************************************
+bool shardGetLayout(const uint8 *pucFileName, SHARD_LAYOUT *pstLayout)
+{
+	bool blReturn = false;
+	uint8 pucLayoutPath[FILE_PATH_MAX_SIZE] = "";
+	FILE *pstFile = NULL;
+	uint32 ulShardCount = 0;
+
+	if(pucFileName != NULL && pstLayout != NULL)
+	{
+		pstLayout->ulShardCount = 1;
+		pstLayout->blSharded = false;
+
+		blReturn = fileBuildPath(pucLayoutPath, pucFileName,
+								 SHARD_LAYOUT_SUFFIX);
+		if(blReturn == true && fileExists(pucLayoutPath) == true)
+		{
+			pstFile = fileOpen(pucLayoutPath, FILE_READ_MODE);
+			blReturn = (pstFile != NULL);
+			if(blReturn == true)
+			{
+				blReturn = fileRead(&ulShardCount, sizeof(ulShardCount),
+									READ_COUNT, pstFile);
+				fileClose(pstFile);
+			}
+
+			if(blReturn == true && ulShardCount > 1 &&
+			   ulShardCount <= SHARD_MAX_COUNT)
+			{
+				pstLayout->ulShardCount = ulShardCount;
+				pstLayout->blSharded = true;
+			}
+			else
+			{
+				printf("\nUnable to read the shard layout : Invalid layout");
+				blReturn = false;
+			}
+		}
+	}
+	else
+	{
+		printf("\nUnable to read the shard layout : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the shard which holds a serial number
+//Inputs	: ulSerial, the serial number of the device
+//Inputs	: ulShardCount, number of shards
+//Outputs	: None
+//Return	: Index of the shard
+//Notes		: The serial is mixed so that consecutive serials spread evenly
+//******************************************************************************
+uint32 shardRoute(uint32 ulSerial, uint32 ulShardCount)
+{
+	return (ulShardCount > 1) ? (hashMix(ulSerial) % ulShardCount) : 0;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To get the file name of a shard
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstLayout, the shard layout
+//Inputs	: ulShard, index of the shard
+//Outputs	: pucPath, name of the shard file
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The only shard of an unsharded layout is the data file itself
+//******************************************************************************
+bool shardGetPath(const uint8 *pucFileName, const SHARD_LAYOUT *pstLayout,
+					uint32 ulShard, uint8 *pucPath)
+{
+	bool blReturn = false;
+	int32 lResult = 0;
+
+	if(pucFileName != NULL && pstLayout != NULL && pucPath != NULL &&
+	   ulShard < pstLayout->ulShardCount)
+	{
+		if(pstLayout->blSharded == true)
+		{
+			lResult = snprintf((char *)pucPath, FILE_PATH_MAX_SIZE,
+							   SHARD_NAME_FORMAT, (const char *)pucFileName,
+							   ulShard);
+			blReturn = (lResult > 0 && lResult < FILE_PATH_MAX_SIZE);
+		}
+		else
+		{
+			blReturn = fileBuildPath(pucPath, pucFileName, (uint8 *)"");
+		}
+	}
+	else
+	{
+		printf("\nUnable to get the shard name : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To get the file name of the shard holding a serial number
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulSerial, the serial number of the device
+//Outputs	: pucPath, name of the shard file
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Used to route adds and serial lookups to a single shard
+//******************************************************************************
+bool shardGetSerialPath(const uint8 *pucFileName, uint32 ulSerial,
+						uint8 *pucPath)
+{
+	bool blReturn = false;
+	SHARD_LAYOUT stLayout = {0};
+
+	blReturn = shardGetLayout(pucFileName, &stLayout);
+	if(blReturn == true)
+	{
+		blReturn = shardGetPath(pucFileName, &stLayout,
+								shardRoute(ulSerial, stLayout.ulShardCount),
+								pucPath);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To take a snapshot of all the shards of the device data
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pstSnapshot, the snapshot with one pinned file per shard
+//Outputs	: pstLayout, the shard layout of the snapshot
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The snapshot has to be released with snapshotRelease()
+//******************************************************************************
+bool shardAcquireSnapshot(const uint8 *pucFileName, SNAPSHOT *pstSnapshot,
+							SHARD_LAYOUT *pstLayout)
+{
+	bool blReturn = false;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+
+	if(snapshotAcquire(pucFileName, pstSnapshot) == true)
+	{
+		blReturn = shardGetLayout(pucFileName, pstLayout);
+		for(ulShard = 0; ulShard < pstLayout->ulShardCount &&
+			blReturn == true; ulShard++)
+		{
+			blReturn = (shardGetPath(pucFileName, pstLayout, ulShard,
+									 pucPath) == true &&
+						snapshotPin(pstSnapshot, pucPath) == true);
+		}
+		snapshotSeal(pstSnapshot);
+
+		if(blReturn != true)
+		{
+			snapshotRelease(pstSnapshot);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To collect the records matching a predicate from all shards
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pfnMatch, the predicate selecting the records
+//Inputs	: pfnPrune, the predicate selecting the blocks of up to date
+//			  segments, NULL to always read the data files
+//Inputs	: pvContext, argument passed to the predicates
+//Outputs	: pstResult, the matching records in shard order
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The shards of one snapshot are scanned in parallel, the result
+//			  has to be released with shardResultFree(). pstResult has to be
+//			  empty, its records are taken from its arena when it has one.
+//******************************************************************************
+bool shardScan(const uint8 *pucFileName, SHARD_MATCH pfnMatch,
+				SEGMENT_PRUNE pfnPrune, const void *pvContext,
+				SHARD_RESULT *pstResult)
+{
+	bool blReturn = false;
+	SHARD_TASK *pstTasks = NULL;
+	SNAPSHOT stSnapshot;
+	SHARD_LAYOUT stLayout = {0};
+	uint32 ulShard = 0;
+
+	if(pucFileName != NULL && pfnMatch != NULL && pstResult != NULL)
+	{
+		shardResultFree(pstResult);
+		pstTasks = calloc(SHARD_MAX_COUNT, sizeof(SHARD_TASK));
+		if(pstTasks != NULL &&
+		   shardAcquireSnapshot(pucFileName, &stSnapshot, &stLayout) == true)
+		{
+			blReturn = shardPrepareTasks(pucFileName, &stLayout, pfnMatch,
+										 pvContext, pstTasks);
+			for(ulShard = 0; ulShard < stLayout.ulShardCount; ulShard++)
+			{
+				pstTasks[ulShard].pfnPrune = pfnPrune;
+			}
+			blReturn = (blReturn == true &&
+						shardScanSnapshot(&stSnapshot, pstTasks,
+										  pstResult) == true);
+			snapshotRelease(&stSnapshot);
+		}
+		else if(pstTasks == NULL)
+		{
+			printf("\nUnable to scan the shards : Out of memory");
+		}
+		free(pstTasks);
+	}
+	else
+	{
+		printf("\nUnable to scan the shards : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To collect the records matching a predicate from the shard
+//			  holding a serial number
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulSerial, the serial number routing the scan
+//Inputs	: pfnMatch, the predicate selecting the records
+//Inputs	: pfnPrune, the predicate selecting the blocks of an up to date
+//			  segment, NULL to always read the data file
+//Inputs	: pvContext, argument passed to the predicates
+//Outputs	: pstResult, the matching records
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Only the routed shard is pinned and read. pstResult has to be
+//			  empty, its records are taken from its arena when it has one.
+//******************************************************************************
+bool shardScanSerial(const uint8 *pucFileName, uint32 ulSerial,
+						SHARD_MATCH pfnMatch, SEGMENT_PRUNE pfnPrune,
+						const void *pvContext, SHARD_RESULT *pstResult)
+{
+	bool blReturn = false;
+	SHARD_TASK stTask;
+	SNAPSHOT stSnapshot;
+	SHARD_LAYOUT stLayout = {0};
+
+	if(pucFileName != NULL && pfnMatch != NULL && pstResult != NULL)
+	{
+		shardResultFree(pstResult);
+		memset(&stTask, 0, sizeof(stTask));
+		stTask.pfnMatch = pfnMatch;
+		stTask.pfnPrune = pfnPrune;
+		stTask.pvContext = pvContext;
+
+		if(snapshotAcquire(pucFileName, &stSnapshot) == true)
+		{
+			blReturn = (shardGetLayout(pucFileName, &stLayout) == true &&
+						shardGetPath(pucFileName, &stLayout,
+									 shardRoute(ulSerial,
+												stLayout.ulShardCount),
+									 stTask.pucPath) == true &&
+						snapshotPin(&stSnapshot, stTask.pucPath) == true);
+			snapshotSeal(&stSnapshot);
+
+			if(blReturn == true)
+			{
+				blReturn = shardScanSnapshot(&stSnapshot, &stTask, pstResult);
+			}
+			snapshotRelease(&stSnapshot);
+		}
+	}
+	else
+	{
+		printf("\nUnable to scan the shard : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the records matching a predicate from all shards
+//Inputs	: pstWriter, the writer state, the caller being the only writer
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pfnMatch, the predicate selecting the records
+//Inputs	: pvContext, argument passed to the predicate
+//Outputs	: pulRemoved, number of removed records
+//Outputs	: pstRemoved, the removed records in shard order, may be NULL
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Shards are rewritten in parallel and only the shards holding a
+//			  matching record are rewritten. All the rewritten shards are
+//			  published together as one new generation.
+//******************************************************************************
+bool shardRemove(SNAPSHOT_WRITER *pstWriter, const uint8 *pucFileName,
+				SHARD_MATCH pfnMatch, const void *pvContext,
+				uint32 *pulRemoved, SHARD_RESULT *pstRemoved)
+{
+	bool blReturn = false;
+	SHARD_TASK *pstTasks = NULL;
+	SHARD_LAYOUT stLayout = {0};
+	uint32 ulShard = 0;
+	uint32 ulIndex = 0;
+
+	if(pstWriter != NULL && pucFileName != NULL && pfnMatch != NULL &&
+	   pulRemoved != NULL)
+	{
+		*pulRemoved = 0;
+		pstTasks = calloc(SHARD_MAX_COUNT, sizeof(SHARD_TASK));
+		if(pstTasks != NULL)
+		{
+			blReturn = (shardGetLayout(pucFileName, &stLayout) == true &&
+						shardPrepareTasks(pucFileName, &stLayout, pfnMatch,
+										  pvContext, pstTasks) == true);
+			if(blReturn == true)
+			{
+				for(ulShard = 0; ulShard < stLayout.ulShardCount; ulShard++)
+				{
+					pstTasks[ulShard].blCollect = (pstRemoved != NULL);
+					arenaInit(&pstTasks[ulShard].stArena, ARENA_QUERY_SIZE);
+					pstTasks[ulShard].stResult.pstArena =
+						&pstTasks[ulShard].stArena;
+				}
+				shardRunTasks(shardRemoveFromFile, pstTasks,
+							  stLayout.ulShardCount);
+			}
+
+			for(ulShard = 0; ulShard < stLayout.ulShardCount; ulShard++)
+			{
+				blReturn = (blReturn == true &&
+							pstTasks[ulShard].blStatus == true);
+				*pulRemoved += pstTasks[ulShard].ulRemoved;
+			}
+
+			if(blReturn == true && *pulRemoved > 0)
+			{
+				blReturn = snapshotCommitBegin(pstWriter);
+				for(ulShard = 0; ulShard < stLayout.ulShardCount &&
+					blReturn == true; ulShard++)
+				{
+					if(pstTasks[ulShard].pucTemporaryPath[0] != '\0')
+					{
+						blReturn = (rename(
+								(char *)pstTasks[ulShard].pucTemporaryPath,
+								(char *)pstTasks[ulShard].pucPath) == 0);
+						pstTasks[ulShard].pucTemporaryPath[0] = '\0';
+					}
+				}
+				if(snapshotCommitEnd(pstWriter) != true)
+				{
+					blReturn = false;
+				}
+			}
+
+			for(ulShard = 0; ulShard < stLayout.ulShardCount; ulShard++)
+			{
+				if(pstTasks[ulShard].pucTemporaryPath[0] != '\0')
+				{
+					remove((char *)pstTasks[ulShard].pucTemporaryPath);
+				}
+				for(ulIndex = 0; ulIndex < pstTasks[ulShard].stResult.ulCount &&
+					blReturn == true; ulIndex++)
+				{
+					blReturn = shardResultAppend(pstRemoved,
+								&pstTasks[ulShard].stResult.pstRecords[ulIndex]);
+				}
+				arenaRelease(&pstTasks[ulShard].stArena);
+			}
+		}
+		else
+		{
+			printf("\nUnable to remove from the shards : Out of memory");
+		}
+		free(pstTasks);
+	}
+	else
+	{
+		printf("\nUnable to remove from the shards : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To redistribute the device records over a new number of shards
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulShardCount, the new number of shards, 1 for a single file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The new shards are written to temporary files and journaled
+//			  before the old layout is replaced, a reshard interrupted after
+//			  its journal is written is finished by shardRecover()
+//******************************************************************************
+bool shardReshard(const uint8 *pucFileName, uint32 ulShardCount)
+{
+	bool blReturn = false;
+	SHARD_LAYOUT stOldLayout = {0};
+	SHARD_LAYOUT stNewLayout = {0};
+	DEVICE_DETAILS DeviceData = {0};
+	FILE *pstFile = NULL;
+	FILE *pstOutputs[SHARD_MAX_COUNT] = {NULL};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	SNAPSHOT_WRITER stWriter;
+	SHARD_JOURNAL stJournal = {0};
+	bool blJournal = false;
+	uint32 ulShard = 0;
+	uint32 ulTarget = 0;
+
+	if(pucFileName != NULL && ulShardCount >= 1 &&
+	   ulShardCount <= SHARD_MAX_COUNT &&
+	   snapshotWriterBegin(pucFileName, &stWriter) == true)
+	{
+		blReturn = (shardRecoverLocked(pucFileName, &stWriter) == true &&
+					shardGetLayout(pucFileName, &stOldLayout) == true);
+		stNewLayout.ulShardCount = ulShardCount;
+		stNewLayout.blSharded = (ulShardCount > 1);
+
+		// Open a temporary file for each of the new shards
+		for(ulShard = 0; ulShard < ulShardCount && blReturn == true; ulShard++)
+		{
+			blReturn = (shardGetPath(pucFileName, &stNewLayout, ulShard,
+									 pucPath) == true &&
+						fileBuildPath(pucTemporaryPath, pucPath,
+									  SHARD_TEMPORARY_SUFFIX) == true);
+			if(blReturn == true)
+			{
+				pstOutputs[ulShard] = fileOpen(pucTemporaryPath,
+											   FILE_WRITE_MODE);
+				blReturn = (pstOutputs[ulShard] != NULL);
+			}
+		}
+
+		// Route every record of the old layout to its new shard
+		for(ulShard = 0; ulShard < stOldLayout.ulShardCount &&
+			blReturn == true; ulShard++)
+		{
+			blReturn = shardGetPath(pucFileName, &stOldLayout, ulShard,
+									pucPath);
+			if(blReturn == true && fileExists(pucPath) == true)
+			{
+				pstFile = fileOpen(pucPath, FILE_READ_MODE);
+				blReturn = (pstFile != NULL);
+				while(blReturn == true &&
+					  fileRead(&DeviceData, sizeof(DeviceData),
+							   READ_COUNT, pstFile) == true)
+				{
+					ulTarget = shardRoute(DeviceData.ulDeviceSerial,
+										  ulShardCount);
+					blReturn = fileWrite(&DeviceData, sizeof(DeviceData),
+										 WRITE_COUNT, pstOutputs[ulTarget]);
+				}
+				if(pstFile != NULL)
+				{
+					fileClose(pstFile);
+				}
+			}
+		}
+
+		for(ulShard = 0; ulShard < ulShardCount; ulShard++)
+		{
+			if(pstOutputs[ulShard] != NULL)
+			{
+				blReturn = (shardSync(pstOutputs[ulShard]) == true &&
+							blReturn == true);
+				blReturn = (fileClose(pstOutputs[ulShard]) == true &&
+							blReturn == true);
+			}
+		}
+
+		// The reshard commits once its journal is on the disk
+		if(blReturn == true)
+		{
+			stJournal.ulMagic = SHARD_MAGIC;
+			stJournal.ulGeneration = stWriter.ulGeneration;
+			stJournal.stOldLayout = stOldLayout;
+			stJournal.stNewLayout = stNewLayout;
+			blReturn = shardWriteJournal(pucFileName, &stJournal);
+			blJournal = blReturn;
+		}
+
+		if(blReturn == true)
+		{
+			blReturn = shardPublish(pucFileName, &stWriter, &stJournal);
+		}
+		else
+		{
+			shardDiscard(pucFileName, &stNewLayout);
+		}
+
+		if(blReturn != true)
+		{
+			printf(blJournal == true ? "\nUnable to reshard the device data,"
+				   " finished at the next start" :
+				   "\nUnable to reshard the device data");
+		}
+		snapshotWriterEnd(&stWriter);
+	}
+	else
+	{
+		printf("\nUnable to reshard : Invalid shard count");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To add a record to a result set
+//Inputs	: pstResult, the result set
+//Inputs	: pstDeviceData, the record to be added
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The record array grows by doubling, within the arena of the
+//			  result set when it has one
+//******************************************************************************
+bool shardResultAppend(SHARD_RESULT *pstResult,
+						const DEVICE_DETAILS *pstDeviceData)
+{
+	bool blReturn = true;
+	DEVICE_DETAILS *pstRecords = NULL;
+	uint32 ulCapacity = 0;
+
+	if(pstResult->ulCount == pstResult->ulCapacity)
+	{
+		ulCapacity = pstResult->ulCapacity * 2;
+		if(ulCapacity < SHARD_RESULT_MIN_SIZE)
+		{
+			ulCapacity = SHARD_RESULT_MIN_SIZE;
+		}
+
+		if(pstResult->pstArena != NULL)
+		{
+			pstRecords = arenaGrow(pstResult->pstArena, pstResult->pstRecords,
+								   pstResult->ulCount * sizeof(DEVICE_DETAILS),
+								   ulCapacity * sizeof(DEVICE_DETAILS));
+		}
+		else
+		{
+			pstRecords = realloc(pstResult->pstRecords,
+								 ulCapacity * sizeof(DEVICE_DETAILS));
+		}
+		if(pstRecords != NULL)
+		{
+			pstResult->pstRecords = pstRecords;
+			pstResult->ulCapacity = ulCapacity;
+		}
+		else
+		{
+			printf("\nUnable to store the result : Out of memory");
+			blReturn = false;
+		}
+	}
+
+	if(blReturn == true)
+	{
+		pstResult->pstRecords[pstResult->ulCount] = *pstDeviceData;
+		pstResult->ulCount++;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To release the records of a result set
+//Inputs	: pstResult, the result set
+//Outputs	: None
+//Return	: None
+//Notes		: The result set is left empty with the same arena. Records
+//			  taken from an arena are released with the arena.
+//******************************************************************************
+void shardResultFree(SHARD_RESULT *pstResult)
+{
+	if(pstResult != NULL)
+	{
+		if(pstResult->pstArena == NULL)
+		{
+			free(pstResult->pstRecords);
+		}
+		pstResult->pstRecords = NULL;
+		pstResult->ulCount = 0;
+		pstResult->ulCapacity = 0;
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To finish or to drop a reshard left by an interruption
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Called before the data is used, the next reshard does it as
+//			  well
+//******************************************************************************
+bool shardRecover(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	SNAPSHOT_WRITER stWriter;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	blReturn = (pucFileName != NULL &&
+				fileBuildPath(pucPath, pucFileName,
+							  SHARD_JOURNAL_SUFFIX) == true);
+	if(blReturn == true && fileExists(pucPath) == true)
+	{
+		blReturn = snapshotWriterBegin(pucFileName, &stWriter);
+		if(blReturn == true)
+		{
+			blReturn = shardRecoverLocked(pucFileName, &stWriter);
+			snapshotWriterEnd(&stWriter);
+		}
+	}
+
+	return blReturn;
+}
+// EOF
@@ -0,0 +1,88 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Hash sharded layout of the device data file
+// Note		: Spread device records across shard files by serial hash and
+//			  run scans and removals per shard in parallel
+//
+//******************************************************************************
+
+#ifndef _SHARD_H_
+#define _SHARD_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "snapshot.h"
+#include "segment.h"
+#include "arena.h"
+
+//******************************* Global Types *********************************
+typedef struct _SHARD_LAYOUT_
+{
+	uint32 ulShardCount;
+	bool blSharded;
+} SHARD_LAYOUT;
+
+// Records taken from pstArena when set, from the heap otherwise
+typedef struct _SHARD_RESULT_
+{
+	DEVICE_DETAILS *pstRecords;
+	uint32 ulCount;
+	uint32 ulCapacity;
+	ARENA *pstArena;
+} SHARD_RESULT;
+
+// Layouts of a reshard, the new shards renamed into place once written
+typedef struct _SHARD_JOURNAL_
+{
+	uint32 ulMagic;
+	uint32 ulGeneration;
+	SHARD_LAYOUT stOldLayout;
+	SHARD_LAYOUT stNewLayout;
+	uint32 ulChecksum;
+} SHARD_JOURNAL;
+
+// Returns true when the record has to be selected
+typedef bool (*SHARD_MATCH)(const DEVICE_DETAILS *pstDeviceData,
+							const void *pvContext);
+
+//***************************** Global Constants *******************************
+#define SHARD_LAYOUT_SUFFIX		(".shards")
+#define SHARD_TEMPORARY_SUFFIX	(".tmp")
+#define SHARD_JOURNAL_SUFFIX	(".reshard")
+#define SHARD_MAGIC				(0x44524853UL)
+#define SHARD_MAX_COUNT			(64)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool shardGetLayout(const uint8 *pucFileName, SHARD_LAYOUT *pstLayout);
+uint32 shardRoute(uint32 ulSerial, uint32 ulShardCount);
+bool shardGetPath(const uint8 *pucFileName, const SHARD_LAYOUT *pstLayout,
+					uint32 ulShard, uint8 *pucPath);
+bool shardGetSerialPath(const uint8 *pucFileName, uint32 ulSerial,
+						uint8 *pucPath);
+bool shardAcquireSnapshot(const uint8 *pucFileName, SNAPSHOT *pstSnapshot,
+							SHARD_LAYOUT *pstLayout);
+bool shardScan(const uint8 *pucFileName, SHARD_MATCH pfnMatch,
+				SEGMENT_PRUNE pfnPrune, const void *pvContext,
+				SHARD_RESULT *pstResult);
+bool shardScanSerial(const uint8 *pucFileName, uint32 ulSerial,
+						SHARD_MATCH pfnMatch, SEGMENT_PRUNE pfnPrune,
+						const void *pvContext, SHARD_RESULT *pstResult);
+bool shardRemove(SNAPSHOT_WRITER *pstWriter, const uint8 *pucFileName,
+				SHARD_MATCH pfnMatch, const void *pvContext,
+				uint32 *pulRemoved, SHARD_RESULT *pstRemoved);
+bool shardReshard(const uint8 *pucFileName, uint32 ulShardCount);
+bool shardRecover(const uint8 *pucFileName);
+bool shardResultAppend(SHARD_RESULT *pstResult,
+						const DEVICE_DETAILS *pstDeviceData);
+void shardResultFree(SHARD_RESULT *pstResult);
+
+#endif // _SHARD_H_
+// EOF
@@ -0,0 +1,846 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: snapshot.c
+// Summary	: Snapshot isolation between readers and writers of device data
+// Note		: Every change of the device data is published as a new
+//			  generation. A reader pins the open files of one generation and
+//			  their record counts, so it never sees a partial change. Writers
+//			  replace files by rename, the old version stays readable through
+//			  the pinned descriptors and is reclaimed when the last reader
+//			  closes it. Readers only wait for the short publish step.
+//			  Records changed in place are patched directly when no reader
+//			  pins the file, otherwise a patched copy is published.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "snapshot.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define READ_COUNT			(1)
+#define FILE_PERMISSIONS	(0644)
+#define COPY_BUFFER_SIZE	(65536)
+#define WRITE_COUNT			(1)
+#define READ_BUFFER_SIZE	((FILE_READER_BUFFER_SIZE / sizeof(DEVICE_DETAILS)) * \
+							 sizeof(DEVICE_DETAILS))
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open a side file of the data file used for locking
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pucSuffix, suffix of the side file
+//Outputs	: None
+//Return	: Descriptor of the side file, SNAPSHOT_INVALID_FD on error
+//Notes		: The side file is created when it does not exist
+//******************************************************************************
+static int32 snapshotOpenSideFile(const uint8 *pucFileName,
+									const uint8 *pucSuffix)
+{
+	int32 lFd = SNAPSHOT_INVALID_FD;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(fileBuildPath(pucPath, pucFileName, pucSuffix) == true)
+	{
+		lFd = open((char *)pucPath, O_RDWR | O_CREAT, FILE_PERMISSIONS);
+		if(lFd < 0)
+		{
+			printf("\nUnable to open the file %s", (char *)pucPath);
+			lFd = SNAPSHOT_INVALID_FD;
+		}
+	}
+
+	return lFd;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the current generation number
+//Inputs	: lGenerationFd, descriptor of the generation file
+//Outputs	: None
+//Return	: The generation number, 0 for a new data file
+//Notes		: The caller holds a lock on the generation file
+//******************************************************************************
+static uint32 snapshotReadGeneration(int32 lGenerationFd)
+{
+	uint32 ulGeneration = 0;
+
+	if(pread(lGenerationFd, &ulGeneration, sizeof(ulGeneration), 0) !=
+	   sizeof(ulGeneration))
+	{
+		ulGeneration = 0;
+	}
+
+	return ulGeneration;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To copy a data file
+//Inputs	: pucSourcePath, name of the file to be copied
+//Inputs	: pucTargetPath, name of the copy
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A missing source file gives an empty copy
+//******************************************************************************
+static bool snapshotCopyFile(const uint8 *pucSourcePath,
+							 const uint8 *pucTargetPath)
+{
+	bool blReturn = false;
+	uint8 pucBuffer[COPY_BUFFER_SIZE];
+	int32 lSourceFd = SNAPSHOT_INVALID_FD;
+	int32 lTargetFd = SNAPSHOT_INVALID_FD;
+	int32 lRead = 0;
+
+	lTargetFd = open((char *)pucTargetPath, O_WRONLY | O_CREAT | O_TRUNC,
+					 FILE_PERMISSIONS);
+	if(lTargetFd >= 0)
+	{
+		blReturn = true;
+		lSourceFd = open((char *)pucSourcePath, O_RDONLY);
+		if(lSourceFd >= 0)
+		{
+			while(blReturn == true &&
+				  (lRead = read(lSourceFd, pucBuffer, sizeof(pucBuffer))) > 0)
+			{
+				blReturn = (write(lTargetFd, pucBuffer, lRead) == lRead);
+			}
+			if(lRead < 0)
+			{
+				blReturn = false;
+			}
+			close(lSourceFd);
+		}
+
+		if(close(lTargetFd) != 0)
+		{
+			blReturn = false;
+		}
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to copy the file %s", (char *)pucSourcePath);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To start reading a pinned file ahead
+//Inputs	: pstSnapshot, the snapshot
+//Inputs	: ulFile, index of the pinned file
+//Outputs	: None
+//Return	: The reader of the pinned records
+//Return	: NULL, if no reader can be started, the file is read directly
+//Notes		: Started on the first read, so files never read cost nothing
+//******************************************************************************
+static SNAPSHOT_READER *snapshotStartReader(SNAPSHOT *pstSnapshot,
+											uint32 ulFile)
+{
+	SNAPSHOT_READER *pstReader = NULL;
+
+	pstReader = calloc(1, sizeof(SNAPSHOT_READER));
+	if(pstReader != NULL &&
+	   fileReaderOpen(&pstReader->stReader,
+					  fileno(pstSnapshot->pstFiles[ulFile]), 0,
+					  pstSnapshot->pulRecordCounts[ulFile] *
+					  sizeof(DEVICE_DETAILS), READ_BUFFER_SIZE,
+					  pstSnapshot->ulReadAheadDepth) != true)
+	{
+		free(pstReader);
+		pstReader = NULL;
+	}
+	pstSnapshot->pstReaders[ulFile] = pstReader;
+
+	return pstReader;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To start taking a snapshot of the device data
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pstSnapshot, the snapshot holding the current generation
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Blocks publishing of new generations until snapshotSeal(), so
+//			  all the files pinned in between belong to the same generation
+//******************************************************************************
+bool snapshotAcquire(const uint8 *pucFileName, SNAPSHOT *pstSnapshot)
+{
+	bool blReturn = false;
+
+	if(pucFileName != NULL && pstSnapshot != NULL)
+	{
+		memset(pstSnapshot, 0, sizeof(SNAPSHOT));
+		pstSnapshot->ulReadAheadDepth = snapshotGetReadAhead(pucFileName);
+		pstSnapshot->lGenerationFd = snapshotOpenSideFile(pucFileName,
+											SNAPSHOT_GENERATION_SUFFIX);
+		if(pstSnapshot->lGenerationFd != SNAPSHOT_INVALID_FD)
+		{
+			if(flock(pstSnapshot->lGenerationFd, LOCK_SH) == 0)
+			{
+				pstSnapshot->ulGeneration =
+					snapshotReadGeneration(pstSnapshot->lGenerationFd);
+				blReturn = true;
+			}
+			else
+			{
+				close(pstSnapshot->lGenerationFd);
+				pstSnapshot->lGenerationFd = SNAPSHOT_INVALID_FD;
+				printf("\nUnable to take the snapshot : Lock failed");
+			}
+		}
+	}
+	else
+	{
+		printf("\nUnable to take the snapshot : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To pin a data file into the snapshot
+//Inputs	: pstSnapshot, the snapshot being taken
+//Inputs	: pucPath, name of the data or shard file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The number of complete records is fixed at this point, records
+//			  appended later are not part of the snapshot. A missing file is
+//			  pinned as an empty file.
+//******************************************************************************
+bool snapshotPin(SNAPSHOT *pstSnapshot, const uint8 *pucPath)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	struct stat stStatus;
+
+	if(pstSnapshot != NULL && pucPath != NULL &&
+	   pstSnapshot->lGenerationFd != SNAPSHOT_INVALID_FD &&
+	   pstSnapshot->ulFileCount < SNAPSHOT_MAX_FILES)
+	{
+		blReturn = true;
+		if(fileExists(pucPath) == true)
+		{
+			pstFile = fileOpen(pucPath, FILE_READ_MODE);
+			blReturn = (pstFile != NULL &&
+						flock(fileno(pstFile), LOCK_SH) == 0 &&
+						fstat(fileno(pstFile), &stStatus) == 0);
+			if(blReturn == true)
+			{
+				pstSnapshot->pulRecordCounts[pstSnapshot->ulFileCount] =
+					stStatus.st_size / sizeof(DEVICE_DETAILS);
+			}
+			else if(pstFile != NULL)
+			{
+				fileClose(pstFile);
+				pstFile = NULL;
+			}
+		}
+
+		if(blReturn == true)
+		{
+			pstSnapshot->pstFiles[pstSnapshot->ulFileCount] = pstFile;
+			pstSnapshot->pulRecordsRead[pstSnapshot->ulFileCount] = 0;
+			pstSnapshot->ulFileCount++;
+		}
+		else
+		{
+			printf("\nUnable to pin the file %s", (char *)pucPath);
+		}
+	}
+	else
+	{
+		printf("\nUnable to pin the file : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To finish taking a snapshot
+//Inputs	: pstSnapshot, the snapshot being taken
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Writers can publish again, the pinned files stay unchanged
+//******************************************************************************
+bool snapshotSeal(SNAPSHOT *pstSnapshot)
+{
+	bool blReturn = false;
+
+	if(pstSnapshot != NULL &&
+	   pstSnapshot->lGenerationFd != SNAPSHOT_INVALID_FD)
+	{
+		blReturn = (close(pstSnapshot->lGenerationFd) == 0);
+		pstSnapshot->lGenerationFd = SNAPSHOT_INVALID_FD;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the next record of a pinned file
+//Inputs	: pstSnapshot, the snapshot
+//Inputs	: ulFile, index of the pinned file
+//Outputs	: pstDeviceData, the record read
+//Return	: True, if a record has been read
+//Return	: False, at the end of the pinned records or in case of an error
+//Notes		: Records are taken from the buffers of a read ahead pipeline,
+//			  so the next buffer is read while the current one is consumed
+//******************************************************************************
+bool snapshotRead(SNAPSHOT *pstSnapshot, uint32 ulFile,
+					DEVICE_DETAILS *pstDeviceData)
+{
+	bool blReturn = false;
+	SNAPSHOT_READER *pstReader = NULL;
+
+	if(pstSnapshot != NULL && pstDeviceData != NULL &&
+	   ulFile < pstSnapshot->ulFileCount &&
+	   pstSnapshot->pstFiles[ulFile] != NULL &&
+	   pstSnapshot->pulRecordsRead[ulFile] <
+	   pstSnapshot->pulRecordCounts[ulFile])
+	{
+		pstReader = pstSnapshot->pstReaders[ulFile];
+		if(pstReader == NULL)
+		{
+			pstReader = snapshotStartReader(pstSnapshot, ulFile);
+		}
+
+		if(pstReader == NULL)
+		{
+			blReturn = fileRead(pstDeviceData, sizeof(DEVICE_DETAILS),
+								READ_COUNT, pstSnapshot->pstFiles[ulFile]);
+		}
+		else
+		{
+			if(pstReader->ulSize - pstReader->ulPosition <
+			   sizeof(DEVICE_DETAILS))
+			{
+				pstReader->ulPosition = 0;
+				pstReader->ulSize = 0;
+				fileReaderNext(&pstReader->stReader, &pstReader->pucData,
+							   &pstReader->ulSize);
+			}
+
+			blReturn = (pstReader->ulSize - pstReader->ulPosition >=
+						sizeof(DEVICE_DETAILS));
+			if(blReturn == true)
+			{
+				memcpy(pstDeviceData, pstReader->pucData +
+					   pstReader->ulPosition, sizeof(DEVICE_DETAILS));
+				pstReader->ulPosition += sizeof(DEVICE_DETAILS);
+			}
+		}
+
+		if(blReturn == true)
+		{
+			pstSnapshot->pulRecordsRead[ulFile]++;
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To release a snapshot
+//Inputs	: pstSnapshot, the snapshot
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Versions replaced while pinned are reclaimed on the last close
+//******************************************************************************
+bool snapshotRelease(SNAPSHOT *pstSnapshot)
+{
+	bool blReturn = false;
+	uint32 ulFile = 0;
+
+	if(pstSnapshot != NULL)
+	{
+		blReturn = true;
+		snapshotSeal(pstSnapshot);
+		for(ulFile = 0; ulFile < pstSnapshot->ulFileCount; ulFile++)
+		{
+			if(pstSnapshot->pstReaders[ulFile] != NULL)
+			{
+				fileReaderClose(&pstSnapshot->pstReaders[ulFile]->stReader);
+				free(pstSnapshot->pstReaders[ulFile]);
+				pstSnapshot->pstReaders[ulFile] = NULL;
+			}
+			if(pstSnapshot->pstFiles[ulFile] != NULL &&
+			   fileClose(pstSnapshot->pstFiles[ulFile]) != true)
+			{
+				blReturn = false;
+			}
+			pstSnapshot->pstFiles[ulFile] = NULL;
+		}
+		pstSnapshot->ulFileCount = 0;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the generation currently published
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pulGeneration, the current generation
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Waits while a generation is being published
+//******************************************************************************
+bool snapshotGetGeneration(const uint8 *pucFileName, uint32 *pulGeneration)
+{
+	bool blReturn = false;
+	int32 lGenerationFd = SNAPSHOT_INVALID_FD;
+
+	if(pucFileName != NULL && pulGeneration != NULL)
+	{
+		lGenerationFd = snapshotOpenSideFile(pucFileName,
+											 SNAPSHOT_GENERATION_SUFFIX);
+		if(lGenerationFd != SNAPSHOT_INVALID_FD)
+		{
+			if(flock(lGenerationFd, LOCK_SH) == 0)
+			{
+				*pulGeneration = snapshotReadGeneration(lGenerationFd);
+				blReturn = true;
+			}
+			close(lGenerationFd);
+		}
+	}
+	else
+	{
+		printf("\nUnable to read the generation : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open the generation file for repeated snapshotHold() calls
+//Inputs	: pucFileName, name of the data file
+//Outputs	: plGenerationFd, descriptor of the generation file
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Closed with close()
+//******************************************************************************
+bool snapshotOpenGeneration(const uint8 *pucFileName, int32 *plGenerationFd)
+{
+	bool blReturn = false;
+
+	if(pucFileName != NULL && plGenerationFd != NULL)
+	{
+		*plGenerationFd = snapshotOpenSideFile(pucFileName,
+											   SNAPSHOT_GENERATION_SUFFIX);
+		blReturn = (*plGenerationFd != SNAPSHOT_INVALID_FD);
+	}
+	else
+	{
+		printf("\nUnable to open the generation : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To keep the current generation from being replaced
+//Inputs	: lGenerationFd, descriptor of the generation file
+//Outputs	: pulGeneration, the current generation
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: No change is published until snapshotUnhold(), the files of
+//			  the generation may be read directly meanwhile. Must be short.
+//******************************************************************************
+bool snapshotHold(int32 lGenerationFd, uint32 *pulGeneration)
+{
+	bool blReturn = false;
+
+	if(lGenerationFd != SNAPSHOT_INVALID_FD && pulGeneration != NULL &&
+	   flock(lGenerationFd, LOCK_SH) == 0)
+	{
+		*pulGeneration = snapshotReadGeneration(lGenerationFd);
+		blReturn = true;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To let the held generation be replaced
+//Inputs	: lGenerationFd, descriptor of the generation file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool snapshotUnhold(int32 lGenerationFd)
+{
+	return (lGenerationFd != SNAPSHOT_INVALID_FD &&
+			flock(lGenerationFd, LOCK_UN) == 0);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the read ahead depth of the device data
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: Number of buffers read ahead by every scan of a pinned file
+//Notes		: FILE_READER_DEFAULT_DEPTH unless set by snapshotSetReadAhead()
+//******************************************************************************
+uint32 snapshotGetReadAhead(const uint8 *pucFileName)
+{
+	uint32 ulDepth = 0;
+	FILE *pstFile = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(fileBuildPath(pucPath, pucFileName,
+					 SNAPSHOT_READ_AHEAD_SUFFIX) == true &&
+	   fileExists(pucPath) == true)
+	{
+		pstFile = fileOpen(pucPath, FILE_READ_MODE);
+	}
+
+	if(pstFile == NULL ||
+	   fileRead(&ulDepth, sizeof(ulDepth), READ_COUNT, pstFile) != true ||
+	   ulDepth < 1 || ulDepth > FILE_READER_MAX_DEPTH)
+	{
+		ulDepth = FILE_READER_DEFAULT_DEPTH;
+	}
+
+	if(pstFile != NULL)
+	{
+		fileClose(pstFile);
+	}
+
+	return ulDepth;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To set the read ahead depth of the device data
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulDepth, number of buffers read ahead, 1 to read without a
+//			  background thread
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Used by the snapshots taken afterwards
+//******************************************************************************
+bool snapshotSetReadAhead(const uint8 *pucFileName, uint32 ulDepth)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(pucFileName != NULL && ulDepth >= 1 &&
+	   ulDepth <= FILE_READER_MAX_DEPTH &&
+	   fileBuildPath(pucPath, pucFileName,
+					 SNAPSHOT_READ_AHEAD_SUFFIX) == true)
+	{
+		pstFile = fileOpen(pucPath, FILE_WRITE_MODE);
+		if(pstFile != NULL)
+		{
+			blReturn = fileWrite(&ulDepth, sizeof(ulDepth), WRITE_COUNT,
+								 pstFile);
+			if(fileClose(pstFile) != true)
+			{
+				blReturn = false;
+			}
+		}
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to set the read ahead depth %lu, expected between 1"
+			   " and %d", ulDepth, FILE_READER_MAX_DEPTH);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To become the only writer of the device data
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pstWriter, the writer state
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Waits for other writers, never for readers
+//******************************************************************************
+bool snapshotWriterBegin(const uint8 *pucFileName, SNAPSHOT_WRITER *pstWriter)
+{
+	bool blReturn = false;
+
+	if(pucFileName != NULL && pstWriter != NULL)
+	{
+		pstWriter->lGenerationFd = SNAPSHOT_INVALID_FD;
+		pstWriter->lLockFd = snapshotOpenSideFile(pucFileName,
+												  SNAPSHOT_LOCK_SUFFIX);
+		if(pstWriter->lLockFd != SNAPSHOT_INVALID_FD &&
+		   flock(pstWriter->lLockFd, LOCK_EX) == 0)
+		{
+			pstWriter->lGenerationFd = snapshotOpenSideFile(pucFileName,
+											SNAPSHOT_GENERATION_SUFFIX);
+		}
+
+		if(pstWriter->lGenerationFd != SNAPSHOT_INVALID_FD)
+		{
+			pstWriter->ulGeneration =
+				snapshotReadGeneration(pstWriter->lGenerationFd);
+			blReturn = true;
+		}
+		else
+		{
+			snapshotWriterEnd(pstWriter);
+			printf("\nUnable to write the device data : Lock failed");
+		}
+	}
+	else
+	{
+		printf("\nUnable to write the device data : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To start publishing a new generation
+//Inputs	: pstWriter, the writer state
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Waits until no reader is taking a snapshot. The changes made
+//			  visible until snapshotCommitEnd() must be short: appends and
+//			  renames of prepared files.
+//******************************************************************************
+bool snapshotCommitBegin(SNAPSHOT_WRITER *pstWriter)
+{
+	bool blReturn = false;
+
+	if(pstWriter != NULL && pstWriter->lGenerationFd != SNAPSHOT_INVALID_FD)
+	{
+		blReturn = (flock(pstWriter->lGenerationFd, LOCK_EX) == 0);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To finish publishing a new generation
+//Inputs	: pstWriter, the writer state
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Readers taking a snapshot from now on see the new generation
+//******************************************************************************
+bool snapshotCommitEnd(SNAPSHOT_WRITER *pstWriter)
+{
+	bool blReturn = false;
+
+	if(pstWriter != NULL && pstWriter->lGenerationFd != SNAPSHOT_INVALID_FD)
+	{
+		pstWriter->ulGeneration++;
+		blReturn = (pwrite(pstWriter->lGenerationFd, &pstWriter->ulGeneration,
+						   sizeof(pstWriter->ulGeneration), 0) ==
+					sizeof(pstWriter->ulGeneration));
+		if(flock(pstWriter->lGenerationFd, LOCK_UN) != 0)
+		{
+			blReturn = false;
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To stop being the writer of the device data
+//Inputs	: pstWriter, the writer state
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool snapshotWriterEnd(SNAPSHOT_WRITER *pstWriter)
+{
+	bool blReturn = false;
+
+	if(pstWriter != NULL)
+	{
+		blReturn = true;
+		if(pstWriter->lGenerationFd != SNAPSHOT_INVALID_FD &&
+		   close(pstWriter->lGenerationFd) != 0)
+		{
+			blReturn = false;
+		}
+		if(pstWriter->lLockFd != SNAPSHOT_INVALID_FD &&
+		   close(pstWriter->lLockFd) != 0)
+		{
+			blReturn = false;
+		}
+		pstWriter->lGenerationFd = SNAPSHOT_INVALID_FD;
+		pstWriter->lLockFd = SNAPSHOT_INVALID_FD;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To stop publishing without creating a new generation
+//Inputs	: pstWriter, the writer state
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Nothing may have been changed since snapshotCommitBegin()
+//******************************************************************************
+bool snapshotCommitCancel(SNAPSHOT_WRITER *pstWriter)
+{
+	bool blReturn = false;
+
+	if(pstWriter != NULL && pstWriter->lGenerationFd != SNAPSHOT_INVALID_FD)
+	{
+		blReturn = (flock(pstWriter->lGenerationFd, LOCK_UN) == 0);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open a data file for changing records in place
+//Inputs	: pstWriter, the writer state
+//Inputs	: pucPath, name of the data or shard file
+//Outputs	: pstPatch, the patch with the descriptor to be written with
+//			  filePageWrite()
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: When no reader pins the file it is patched directly and
+//			  publishing is held until snapshotPatchEnd(), so the patch must
+//			  be short. Otherwise the patch goes to a copy of the file.
+//******************************************************************************
+bool snapshotPatchBegin(SNAPSHOT_WRITER *pstWriter, const uint8 *pucPath,
+						SNAPSHOT_PATCH *pstPatch)
+{
+	bool blReturn = false;
+
+	if(pstWriter != NULL && pucPath != NULL && pstPatch != NULL &&
+	   fileBuildPath(pstPatch->pucPath, pucPath, (uint8 *)"") == true)
+	{
+		pstPatch->lFd = SNAPSHOT_INVALID_FD;
+		pstPatch->blCopy = true;
+
+		if(snapshotCommitBegin(pstWriter) == true)
+		{
+			pstPatch->lFd = open((char *)pucPath, O_RDWR | O_CREAT,
+								 FILE_PERMISSIONS);
+			if(pstPatch->lFd >= 0 &&
+			   flock(pstPatch->lFd, LOCK_EX | LOCK_NB) == 0)
+			{
+				pstPatch->blCopy = false;
+				filePageAttach(pstPatch->lFd);
+				blReturn = true;
+			}
+			else
+			{
+				if(pstPatch->lFd >= 0)
+				{
+					close(pstPatch->lFd);
+				}
+				pstPatch->lFd = SNAPSHOT_INVALID_FD;
+				snapshotCommitCancel(pstWriter);
+			}
+		}
+
+		// Pinned by a reader, patch a copy instead
+		if(pstPatch->blCopy == true &&
+		   fileBuildPath(pstPatch->pucTemporaryPath, pucPath,
+						 SNAPSHOT_TEMPORARY_SUFFIX) == true &&
+		   snapshotCopyFile(pucPath, pstPatch->pucTemporaryPath) == true)
+		{
+			pstPatch->lFd = open((char *)pstPatch->pucTemporaryPath, O_RDWR);
+			blReturn = (pstPatch->lFd >= 0);
+			if(blReturn == true)
+			{
+				filePageAttach(pstPatch->lFd);
+			}
+		}
+	}
+	else
+	{
+		printf("\nUnable to patch the file : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To publish the records changed through a patch
+//Inputs	: pstWriter, the writer state
+//Inputs	: pstPatch, the patch
+//Inputs	: blApply, false to drop a patched copy
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Changes made directly to the file are always published, the
+//			  pages changed are written back first
+//******************************************************************************
+bool snapshotPatchEnd(SNAPSHOT_WRITER *pstWriter, SNAPSHOT_PATCH *pstPatch,
+						bool blApply)
+{
+	bool blReturn = false;
+
+	if(pstWriter != NULL && pstPatch != NULL &&
+	   pstPatch->lFd != SNAPSHOT_INVALID_FD)
+	{
+		blReturn = filePageClose(pstPatch->lFd);
+		pstPatch->lFd = SNAPSHOT_INVALID_FD;
+
+		if(pstPatch->blCopy != true)
+		{
+			if(snapshotCommitEnd(pstWriter) != true)
+			{
+				blReturn = false;
+			}
+		}
+		else if(blApply == true && blReturn == true &&
+				snapshotCommitBegin(pstWriter) == true)
+		{
+			blReturn = (rename((char *)pstPatch->pucTemporaryPath,
+							   (char *)pstPatch->pucPath) == 0);
+			if(snapshotCommitEnd(pstWriter) != true)
+			{
+				blReturn = false;
+			}
+		}
+		else
+		{
+			remove((char *)pstPatch->pucTemporaryPath);
+			if(blApply == true)
+			{
+				blReturn = false;
+			}
+		}
+	}
+
+	return blReturn;
+}
+// EOF
\ No newline at end of file
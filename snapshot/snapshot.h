@@ -0,0 +1,94 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Snapshot isolation between readers and writers of device data
+// Note		: Readers pin a consistent generation of the data files, writers
+//			  publish a new generation without waiting for the readers
+//
+//******************************************************************************
+
+#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+
+//***************************** Global Constants *******************************
+#define SNAPSHOT_MAX_FILES			(64)
+#define SNAPSHOT_GENERATION_SUFFIX	(".gen")
+#define SNAPSHOT_LOCK_SUFFIX		(".lock")
+#define SNAPSHOT_TEMPORARY_SUFFIX	(".tmp")
+#define SNAPSHOT_INVALID_FD			(-1)
+#define SNAPSHOT_READ_AHEAD_SUFFIX	(".readahead")
+
+//******************************* Global Types *********************************
+// Read ahead pipeline of a pinned file and the buffer being consumed
+typedef struct _SNAPSHOT_READER_
+{
+	FILE_READER stReader;
+	const uint8 *pucData;
+	uint32 ulSize;
+	uint32 ulPosition;
+} SNAPSHOT_READER;
+
+typedef struct _SNAPSHOT_
+{
+	FILE *pstFiles[SNAPSHOT_MAX_FILES];
+	uint32 pulRecordCounts[SNAPSHOT_MAX_FILES];
+	uint32 pulRecordsRead[SNAPSHOT_MAX_FILES];
+	SNAPSHOT_READER *pstReaders[SNAPSHOT_MAX_FILES];
+	uint32 ulFileCount;
+	uint32 ulGeneration;
+	uint32 ulReadAheadDepth;
+	int32 lGenerationFd;
+} SNAPSHOT;
+
+typedef struct _SNAPSHOT_WRITER_
+{
+	int32 lLockFd;
+	int32 lGenerationFd;
+	uint32 ulGeneration;
+} SNAPSHOT_WRITER;
+
+typedef struct _SNAPSHOT_PATCH_
+{
+	uint8 pucPath[FILE_PATH_MAX_SIZE];
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE];
+	int32 lFd;
+	bool blCopy;
+} SNAPSHOT_PATCH;
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool snapshotAcquire(const uint8 *pucFileName, SNAPSHOT *pstSnapshot);
+bool snapshotPin(SNAPSHOT *pstSnapshot, const uint8 *pucPath);
+bool snapshotSeal(SNAPSHOT *pstSnapshot);
+bool snapshotRead(SNAPSHOT *pstSnapshot, uint32 ulFile,
+					DEVICE_DETAILS *pstDeviceData);
+bool snapshotRelease(SNAPSHOT *pstSnapshot);
+bool snapshotGetGeneration(const uint8 *pucFileName, uint32 *pulGeneration);
+bool snapshotOpenGeneration(const uint8 *pucFileName, int32 *plGenerationFd);
+bool snapshotHold(int32 lGenerationFd, uint32 *pulGeneration);
+bool snapshotUnhold(int32 lGenerationFd);
+uint32 snapshotGetReadAhead(const uint8 *pucFileName);
+bool snapshotSetReadAhead(const uint8 *pucFileName, uint32 ulDepth);
+bool snapshotWriterBegin(const uint8 *pucFileName, SNAPSHOT_WRITER *pstWriter);
+bool snapshotCommitBegin(SNAPSHOT_WRITER *pstWriter);
+bool snapshotCommitEnd(SNAPSHOT_WRITER *pstWriter);
+bool snapshotCommitCancel(SNAPSHOT_WRITER *pstWriter);
+bool snapshotPatchBegin(SNAPSHOT_WRITER *pstWriter, const uint8 *pucPath,
+						SNAPSHOT_PATCH *pstPatch);
+bool snapshotPatchEnd(SNAPSHOT_WRITER *pstWriter, SNAPSHOT_PATCH *pstPatch,
+						bool blApply);
+bool snapshotWriterEnd(SNAPSHOT_WRITER *pstWriter);
+
+#endif // _SNAPSHOT_H_
+// EOF
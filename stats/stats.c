@@ -0,0 +1,696 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: stats.c
+// Summary	: Aggregate counts of the device data
+// Note		: Groups are kept sorted by key, so a record is counted with a
+//			  binary search and distinct counts are the number of groups.
+//			  Materialized counters are stored in "<data file>.stats" with
+//			  the generation they describe. Writers apply their changes to
+//			  them; counters of another generation are out of date and a
+//			  full pass is made instead.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "stats.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define READ_COUNT			(1)
+#define WRITE_COUNT			(1)
+#define STRINGS_EQUAL		(0)
+#define STATS_MIN_GROUPS	(16)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To make room for one more group in a group array
+//Inputs	: ppvGroups, the group array
+//Inputs	: pulCapacity, number of groups the array can hold
+//Inputs	: ulCount, number of groups in the array
+//Inputs	: ulGroupSize, size of one group
+//Outputs	: ppvGroups and pulCapacity, the grown array
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The array grows by doubling
+//******************************************************************************
+static bool statsReserve(void **ppvGroups, uint32 *pulCapacity, uint32 ulCount,
+						 size_t ulGroupSize)
+{
+	bool blReturn = true;
+	void *pvGroups = NULL;
+	uint32 ulCapacity = 0;
+
+	if(ulCount == *pulCapacity)
+	{
+		ulCapacity = *pulCapacity * 2;
+		if(ulCapacity < STATS_MIN_GROUPS)
+		{
+			ulCapacity = STATS_MIN_GROUPS;
+		}
+
+		pvGroups = realloc(*ppvGroups, ulCapacity * ulGroupSize);
+		if(pvGroups != NULL)
+		{
+			*ppvGroups = pvGroups;
+			*pulCapacity = ulCapacity;
+		}
+		else
+		{
+			printf("\nUnable to count the devices : Out of memory");
+			blReturn = false;
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the position of a type in the sorted type groups
+//Inputs	: pstStats, the counts
+//Inputs	: pucType, the type
+//Outputs	: pulPosition, position of the type or where it belongs
+//Return	: True, if the type has a group
+//Return	: False, if the type has no group
+//Notes		:
+//******************************************************************************
+static bool statsFindType(const STATS *pstStats, const uint8 *pucType,
+						  uint32 *pulPosition)
+{
+	uint32 ulLow = 0;
+	uint32 ulHigh = pstStats->stHeader.ulTypeCount;
+	uint32 ulMiddle = 0;
+	int32 lCompare = 0;
+
+	while(ulLow < ulHigh)
+	{
+		ulMiddle = ulLow + (ulHigh - ulLow) / 2;
+		lCompare = strncmp((char *)pstStats->pstTypes[ulMiddle].pucType,
+						   (char *)pucType, STR_MAX_SIZE);
+		if(lCompare == STRINGS_EQUAL)
+		{
+			*pulPosition = ulMiddle;
+			return true;
+		}
+		if(lCompare < 0)
+		{
+			ulLow = ulMiddle + 1;
+		}
+		else
+		{
+			ulHigh = ulMiddle;
+		}
+	}
+	*pulPosition = ulLow;
+
+	return false;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the position of a vendor in the sorted vendor groups
+//Inputs	: pstStats, the counts
+//Inputs	: ulVendor, the vendor
+//Outputs	: pulPosition, position of the vendor or where it belongs
+//Return	: True, if the vendor has a group
+//Return	: False, if the vendor has no group
+//Notes		:
+//******************************************************************************
+static bool statsFindVendor(const STATS *pstStats, uint32 ulVendor,
+							uint32 *pulPosition)
+{
+	uint32 ulLow = 0;
+	uint32 ulHigh = pstStats->stHeader.ulVendorCount;
+	uint32 ulMiddle = 0;
+
+	while(ulLow < ulHigh)
+	{
+		ulMiddle = ulLow + (ulHigh - ulLow) / 2;
+		if(pstStats->pstVendors[ulMiddle].ulVendor == ulVendor)
+		{
+			*pulPosition = ulMiddle;
+			return true;
+		}
+		if(pstStats->pstVendors[ulMiddle].ulVendor < ulVendor)
+		{
+			ulLow = ulMiddle + 1;
+		}
+		else
+		{
+			ulHigh = ulMiddle;
+		}
+	}
+	*pulPosition = ulLow;
+
+	return false;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To count a device in or out of the counts
+//Inputs	: pstStats, the counts
+//Inputs	: pstDeviceData, the device
+//Inputs	: blAdd, true to count the device in, false to count it out
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, if out of memory or the device is not counted
+//Notes		: A group is dropped when its count reaches zero
+//******************************************************************************
+static bool statsCount(STATS *pstStats, const DEVICE_DETAILS *pstDeviceData,
+					   bool blAdd)
+{
+	bool blReturn = true;
+	bool blTypeFound = false;
+	bool blVendorFound = false;
+	STATS_HEADER *pstHeader = &pstStats->stHeader;
+	uint32 ulType = 0;
+	uint32 ulVendor = 0;
+
+	blTypeFound = statsFindType(pstStats, pstDeviceData->pucDeviceType,
+								&ulType);
+	blVendorFound = statsFindVendor(pstStats, pstDeviceData->ulDeviceVendor,
+									&ulVendor);
+
+	if(blAdd == true)
+	{
+		if(blTypeFound != true)
+		{
+			blReturn = statsReserve((void **)&pstStats->pstTypes,
+									&pstStats->ulTypeCapacity,
+									pstHeader->ulTypeCount,
+									sizeof(STATS_TYPE_GROUP));
+			if(blReturn == true)
+			{
+				memmove(&pstStats->pstTypes[ulType + 1],
+						&pstStats->pstTypes[ulType],
+						(pstHeader->ulTypeCount - ulType) *
+						sizeof(STATS_TYPE_GROUP));
+				memset(&pstStats->pstTypes[ulType], 0,
+					   sizeof(STATS_TYPE_GROUP));
+				strncpy((char *)pstStats->pstTypes[ulType].pucType,
+						(char *)pstDeviceData->pucDeviceType,
+						STR_MAX_SIZE - 1);
+				pstHeader->ulTypeCount++;
+			}
+		}
+
+		if(blReturn == true && blVendorFound != true)
+		{
+			blReturn = statsReserve((void **)&pstStats->pstVendors,
+									&pstStats->ulVendorCapacity,
+									pstHeader->ulVendorCount,
+									sizeof(STATS_VENDOR_GROUP));
+			if(blReturn == true)
+			{
+				memmove(&pstStats->pstVendors[ulVendor + 1],
+						&pstStats->pstVendors[ulVendor],
+						(pstHeader->ulVendorCount - ulVendor) *
+						sizeof(STATS_VENDOR_GROUP));
+				pstStats->pstVendors[ulVendor].ulVendor =
+					pstDeviceData->ulDeviceVendor;
+				pstStats->pstVendors[ulVendor].ulCount = 0;
+				pstHeader->ulVendorCount++;
+			}
+		}
+
+		if(blReturn == true)
+		{
+			pstStats->pstTypes[ulType].ulCount++;
+			pstStats->pstVendors[ulVendor].ulCount++;
+			pstHeader->ulTotal++;
+		}
+	}
+	else if(blTypeFound == true && blVendorFound == true &&
+			pstHeader->ulTotal > 0)
+	{
+		pstHeader->ulTotal--;
+		pstStats->pstTypes[ulType].ulCount--;
+		if(pstStats->pstTypes[ulType].ulCount == 0)
+		{
+			pstHeader->ulTypeCount--;
+			memmove(&pstStats->pstTypes[ulType],
+					&pstStats->pstTypes[ulType + 1],
+					(pstHeader->ulTypeCount - ulType) *
+					sizeof(STATS_TYPE_GROUP));
+		}
+		pstStats->pstVendors[ulVendor].ulCount--;
+		if(pstStats->pstVendors[ulVendor].ulCount == 0)
+		{
+			pstHeader->ulVendorCount--;
+			memmove(&pstStats->pstVendors[ulVendor],
+					&pstStats->pstVendors[ulVendor + 1],
+					(pstHeader->ulVendorCount - ulVendor) *
+					sizeof(STATS_VENDOR_GROUP));
+		}
+	}
+	else
+	{
+		// The counters do not describe the data, they are left out of date
+		blReturn = false;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To store the counts as the materialized counters
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstStats, the counts
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Written to a temporary file first, so readers never see a
+//			  partly written file. The caller is the only writer.
+//******************************************************************************
+static bool statsStore(const uint8 *pucFileName, STATS *pstStats)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+
+	pstStats->stHeader.ulMagic = STATS_MAGIC;
+	if(fileBuildPath(pucPath, pucFileName, STATS_SUFFIX) == true &&
+	   fileBuildPath(pucTemporaryPath, pucPath,
+					 SNAPSHOT_TEMPORARY_SUFFIX) == true)
+	{
+		pstFile = fileOpen(pucTemporaryPath, FILE_WRITE_MODE);
+	}
+
+	if(pstFile != NULL)
+	{
+		blReturn = (fileWrite(&pstStats->stHeader, sizeof(STATS_HEADER),
+							  WRITE_COUNT, pstFile) == true &&
+					(pstStats->stHeader.ulTypeCount == 0 ||
+					 fileWrite(pstStats->pstTypes, sizeof(STATS_TYPE_GROUP) *
+							   pstStats->stHeader.ulTypeCount, WRITE_COUNT,
+							   pstFile) == true) &&
+					(pstStats->stHeader.ulVendorCount == 0 ||
+					 fileWrite(pstStats->pstVendors,
+							   sizeof(STATS_VENDOR_GROUP) *
+							   pstStats->stHeader.ulVendorCount, WRITE_COUNT,
+							   pstFile) == true));
+
+		if(fileClose(pstFile) != true)
+		{
+			blReturn = false;
+		}
+
+		if(blReturn == true)
+		{
+			blReturn = (rename((char *)pucTemporaryPath, (char *)pucPath) == 0);
+		}
+		else
+		{
+			remove((char *)pucTemporaryPath);
+		}
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to store the device counters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the counts
+//Inputs	: pstStats, the counts
+//Inputs	: blMaterialized, whether the counts come from the counters
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void statsPrint(const STATS *pstStats, bool blMaterialized)
+{
+	uint32 ulGroup = 0;
+
+	printf("\nDevice statistics (%s)\n",
+		   blMaterialized == true ? "materialized counters" : "full pass");
+	printf("-----------------------------\n");
+	printf("Total devices\t\t%lu\n", pstStats->stHeader.ulTotal);
+	printf("Distinct types\t\t%lu\n", pstStats->stHeader.ulTypeCount);
+	printf("Distinct vendors\t%lu\n", pstStats->stHeader.ulVendorCount);
+
+	printf("\nType\t\tCount\n");
+	for(ulGroup = 0; ulGroup < pstStats->stHeader.ulTypeCount; ulGroup++)
+	{
+		printf("%s\t\t%lu\n", (char *)pstStats->pstTypes[ulGroup].pucType,
+			   pstStats->pstTypes[ulGroup].ulCount);
+	}
+
+	printf("\nVendor\t\tCount\n");
+	for(ulGroup = 0; ulGroup < pstStats->stHeader.ulVendorCount; ulGroup++)
+	{
+		printf("0x%lx\t\t%lu\n", pstStats->pstVendors[ulGroup].ulVendor,
+			   pstStats->pstVendors[ulGroup].ulCount);
+	}
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To count the devices in one pass over the data
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pstStats, the counts, to be released with statsFree()
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Counts a snapshot, the generation of the counts is the one of
+//			  the snapshot
+//******************************************************************************
+bool statsCompute(const uint8 *pucFileName, STATS *pstStats)
+{
+	bool blReturn = false;
+	DEVICE_DETAILS DeviceData = {0};
+	SNAPSHOT stSnapshot;
+	SHARD_LAYOUT stLayout = {0};
+	uint32 ulShard = 0;
+
+	if(pucFileName != NULL && pstStats != NULL)
+	{
+		memset(pstStats, 0, sizeof(STATS));
+		blReturn = shardAcquireSnapshot(pucFileName, &stSnapshot, &stLayout);
+		if(blReturn == true)
+		{
+			pstStats->stHeader.ulGeneration = stSnapshot.ulGeneration;
+			for(ulShard = 0; ulShard < stSnapshot.ulFileCount; ulShard++)
+			{
+				while(blReturn == true &&
+					  snapshotRead(&stSnapshot, ulShard, &DeviceData) == true)
+				{
+					blReturn = statsCount(pstStats, &DeviceData, true);
+				}
+			}
+			snapshotRelease(&stSnapshot);
+		}
+
+		if(blReturn != true)
+		{
+			statsFree(pstStats);
+			printf("\nUnable to count the devices");
+		}
+	}
+	else
+	{
+		printf("\nUnable to count the devices : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the materialized counters
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pstStats, the counters, to be released with statsFree()
+//Outputs	: pblFresh, whether the counters describe the current generation
+//Return	: True, at time of successful execution
+//Return	: False, if the counters are not materialized or unreadable
+//Notes		: Reads the groups only, whatever the number of devices
+//******************************************************************************
+bool statsLoad(const uint8 *pucFileName, STATS *pstStats, bool *pblFresh)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	STATS_HEADER *pstHeader = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulGeneration = 0;
+
+	if(pucFileName != NULL && pstStats != NULL && pblFresh != NULL)
+	{
+		memset(pstStats, 0, sizeof(STATS));
+		pstHeader = &pstStats->stHeader;
+		*pblFresh = false;
+		if(fileBuildPath(pucPath, pucFileName, STATS_SUFFIX) == true &&
+		   fileExists(pucPath) == true)
+		{
+			pstFile = fileOpen(pucPath, FILE_READ_MODE);
+		}
+
+		if(pstFile != NULL)
+		{
+			blReturn = (fileRead(pstHeader, sizeof(STATS_HEADER), READ_COUNT,
+								 pstFile) == true &&
+						pstHeader->ulMagic == STATS_MAGIC);
+			if(blReturn == true)
+			{
+				pstStats->ulTypeCapacity = pstHeader->ulTypeCount;
+				pstStats->ulVendorCapacity = pstHeader->ulVendorCount;
+				pstStats->pstTypes = calloc(pstHeader->ulTypeCount + 1,
+											sizeof(STATS_TYPE_GROUP));
+				pstStats->pstVendors = calloc(pstHeader->ulVendorCount + 1,
+											  sizeof(STATS_VENDOR_GROUP));
+				blReturn = (pstStats->pstTypes != NULL &&
+							pstStats->pstVendors != NULL &&
+							(pstHeader->ulTypeCount == 0 ||
+							 fileRead(pstStats->pstTypes,
+									  sizeof(STATS_TYPE_GROUP) *
+									  pstHeader->ulTypeCount, READ_COUNT,
+									  pstFile) == true) &&
+							(pstHeader->ulVendorCount == 0 ||
+							 fileRead(pstStats->pstVendors,
+									  sizeof(STATS_VENDOR_GROUP) *
+									  pstHeader->ulVendorCount, READ_COUNT,
+									  pstFile) == true));
+			}
+			fileClose(pstFile);
+
+			if(blReturn == true &&
+			   snapshotGetGeneration(pucFileName, &ulGeneration) == true)
+			{
+				*pblFresh = (ulGeneration == pstHeader->ulGeneration);
+			}
+
+			if(blReturn != true)
+			{
+				statsFree(pstStats);
+				printf("\nUnable to read the device counters : Invalid file");
+			}
+		}
+	}
+	else
+	{
+		printf("\nUnable to read the device counters : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To materialize the counters of the device data
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Counts the data as the only writer, so no generation is
+//			  published while counting. From then on the writers keep the
+//			  counters up to date.
+//******************************************************************************
+bool statsMaterialize(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	SNAPSHOT_WRITER stWriter;
+	STATS stStats;
+
+	if(pucFileName != NULL &&
+	   snapshotWriterBegin(pucFileName, &stWriter) == true)
+	{
+		blReturn = statsCompute(pucFileName, &stStats);
+		if(blReturn == true)
+		{
+			blReturn = statsStore(pucFileName, &stStats);
+			statsFree(&stStats);
+		}
+		snapshotWriterEnd(&stWriter);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To recount materialized counters
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: For changes made without updating the counters. Nothing is
+//			  done when the counters are not materialized.
+//******************************************************************************
+bool statsRefresh(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(pucFileName != NULL &&
+	   fileBuildPath(pucPath, pucFileName, STATS_SUFFIX) == true)
+	{
+		blReturn = true;
+		if(fileExists(pucPath) == true)
+		{
+			blReturn = statsMaterialize(pucFileName);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To stop materializing the counters
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool statsDisable(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	SNAPSHOT_WRITER stWriter;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(pucFileName != NULL &&
+	   fileBuildPath(pucPath, pucFileName, STATS_SUFFIX) == true &&
+	   snapshotWriterBegin(pucFileName, &stWriter) == true)
+	{
+		blReturn = (fileExists(pucPath) != true ||
+					remove((char *)pucPath) == 0);
+		snapshotWriterEnd(&stWriter);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To apply the changes of a writer to the materialized counters
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulFromGeneration, generation before the changes
+//Inputs	: ulToGeneration, generation published with the changes
+//Inputs	: pstRemoved and ulRemovedCount, the removed devices
+//Inputs	: pstAdded and ulAddedCount, the added devices
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The caller is still the only writer. Counters of another
+//			  generation than ulFromGeneration, or not matching the
+//			  removed devices, are left out of date.
+//******************************************************************************
+bool statsUpdate(const uint8 *pucFileName, uint32 ulFromGeneration,
+				 uint32 ulToGeneration, const DEVICE_DETAILS *pstRemoved,
+				 uint32 ulRemovedCount, const DEVICE_DETAILS *pstAdded,
+				 uint32 ulAddedCount)
+{
+	bool blReturn = true;
+	bool blCounted = true;
+	bool blFresh = false;
+	STATS stStats;
+	uint32 ulIndex = 0;
+
+	if(pucFileName != NULL &&
+	   statsLoad(pucFileName, &stStats, &blFresh) == true)
+	{
+		if(stStats.stHeader.ulGeneration == ulFromGeneration)
+		{
+			for(ulIndex = 0; ulIndex < ulRemovedCount && blCounted == true;
+				ulIndex++)
+			{
+				blCounted = statsCount(&stStats, &pstRemoved[ulIndex], false);
+			}
+			for(ulIndex = 0; ulIndex < ulAddedCount && blCounted == true;
+				ulIndex++)
+			{
+				blCounted = statsCount(&stStats, &pstAdded[ulIndex], true);
+			}
+
+			if(blCounted == true)
+			{
+				stStats.stHeader.ulGeneration = ulToGeneration;
+				blReturn = statsStore(pucFileName, &stStats);
+			}
+		}
+		statsFree(&stStats);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the device counts
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Up to date materialized counters are read as they are, else
+//			  the devices are counted in one pass
+//******************************************************************************
+bool statsShow(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	bool blFresh = false;
+	STATS stStats;
+
+	if(pucFileName != NULL)
+	{
+		if(statsLoad(pucFileName, &stStats, &blFresh) == true &&
+		   blFresh != true)
+		{
+			statsFree(&stStats);
+		}
+
+		if(blFresh == true)
+		{
+			blReturn = true;
+		}
+		else
+		{
+			blReturn = statsCompute(pucFileName, &stStats);
+		}
+
+		if(blReturn == true)
+		{
+			statsPrint(&stStats, blFresh);
+			statsFree(&stStats);
+		}
+	}
+	else
+	{
+		printf("\nUnable to show the device counts : Missing file name");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To release counts
+//Inputs	: pstStats, the counts
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+void statsFree(STATS *pstStats)
+{
+	if(pstStats != NULL)
+	{
+		free(pstStats->pstTypes);
+		free(pstStats->pstVendors);
+		memset(pstStats, 0, sizeof(STATS));
+	}
+}
+// EOF
@@ -0,0 +1,72 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Aggregate counts of the device data
+// Note		: Total, per type and per vendor counts computed in one pass or
+//			  read from counters materialized alongside the data file
+//
+//******************************************************************************
+
+#ifndef _STATS_H_
+#define _STATS_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+
+//******************************* Global Types *********************************
+typedef struct _STATS_HEADER_
+{
+	uint32 ulMagic;
+	uint32 ulGeneration;
+	uint32 ulTotal;
+	uint32 ulTypeCount;
+	uint32 ulVendorCount;
+} STATS_HEADER;
+
+typedef struct _STATS_TYPE_GROUP_
+{
+	uint8 pucType[STR_MAX_SIZE];
+	uint32 ulCount;
+} STATS_TYPE_GROUP;
+
+typedef struct _STATS_VENDOR_GROUP_
+{
+	uint32 ulVendor;
+	uint32 ulCount;
+} STATS_VENDOR_GROUP;
+
+typedef struct _STATS_
+{
+	STATS_HEADER stHeader;
+	STATS_TYPE_GROUP *pstTypes;
+	uint32 ulTypeCapacity;
+	STATS_VENDOR_GROUP *pstVendors;
+	uint32 ulVendorCapacity;
+} STATS;
+
+//***************************** Global Constants *******************************
+#define STATS_SUFFIX		(".stats")
+#define STATS_MAGIC			(0x54534453UL)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool statsCompute(const uint8 *pucFileName, STATS *pstStats);
+bool statsLoad(const uint8 *pucFileName, STATS *pstStats, bool *pblFresh);
+bool statsMaterialize(const uint8 *pucFileName);
+bool statsRefresh(const uint8 *pucFileName);
+bool statsDisable(const uint8 *pucFileName);
+bool statsUpdate(const uint8 *pucFileName, uint32 ulFromGeneration,
+				 uint32 ulToGeneration, const DEVICE_DETAILS *pstRemoved,
+				 uint32 ulRemovedCount, const DEVICE_DETAILS *pstAdded,
+				 uint32 ulAddedCount);
+bool statsShow(const uint8 *pucFileName);
+void statsFree(STATS *pstStats);
+
+#endif // _STATS_H_
+// EOF
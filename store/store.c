@@ -0,0 +1,726 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: store.c
+// Summary	: Device store handle for programs linking libdevstore.a
+// Note		: A handle keeps the generation file, the shard files and their
+//			  serial indexes open. Every change to the device data publishes
+//			  a new generation, so the open files are only checked again
+//			  when the generation moves. A serial lookup holds the
+//			  generation and reads the record through the index, falling
+//			  back to a snapshot search when the index is being changed. An
+//			  outdated index is rebuilt once under the writer lock.
+//			  Changes go through the device functions, under the writer
+//			  lock. The results of searches are kept in an arena reused by
+//			  the next call. A handle with its image loaded answers serial
+//			  lookups from memory, replaying the change feed whenever the
+//			  generation moves. A handle with its map loaded answers them
+//			  from the concurrent index, loaded again whenever the
+//			  generation moves.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "menu.h"
+#include "file.h"
+#include "index.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "arena.h"
+#include "image.h"
+#include "chash.h"
+#include "txn.h"
+#include "format.h"
+#include "store.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To close the files of a shard
+//Inputs	: pstShard, the shard
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void storeCloseShard(STORE_SHARD *pstShard)
+{
+	if(pstShard->lFd != STORE_INVALID_FD)
+	{
+		filePageClose(pstShard->lFd);
+		pstShard->lFd = STORE_INVALID_FD;
+	}
+	indexClose(&pstShard->stIndex);
+	memset(&pstShard->stData, 0, sizeof(FILE_IDENTITY));
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To bring the open files up to date with a new generation
+//Inputs	: pstStore, the store
+//Inputs	: ulGeneration, the generation being held
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A shard file is only reopened when it has been replaced, a
+//			  missing shard file stays closed
+//******************************************************************************
+static bool storeRefresh(STORE *pstStore, uint32 ulGeneration)
+{
+	bool blReturn = false;
+	STORE_SHARD *pstShard = NULL;
+	FILE_IDENTITY stIdentity = {0};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+
+	pstStore->blLoaded = false;
+	blReturn = shardGetLayout(pstStore->pucFileName, &pstStore->stLayout);
+	for(ulShard = 0; ulShard < SHARD_MAX_COUNT; ulShard++)
+	{
+		pstShard = &pstStore->pstShards[ulShard];
+		if(blReturn == true && ulShard < pstStore->stLayout.ulShardCount)
+		{
+			blReturn = shardGetPath(pstStore->pucFileName, &pstStore->stLayout,
+									ulShard, pucPath);
+			fileGetIdentity(pucPath, &stIdentity);
+			if(pstShard->lFd != STORE_INVALID_FD &&
+			   pstShard->stData.ulInode != stIdentity.ulInode)
+			{
+				storeCloseShard(pstShard);
+			}
+
+			// A shard kept open may have been patched in place
+			if(pstShard->lFd != STORE_INVALID_FD)
+			{
+				filePageRefresh(pstShard->lFd);
+			}
+
+			if(blReturn == true && pstShard->lFd == STORE_INVALID_FD &&
+			   fileExists(pucPath) == true)
+			{
+				pstShard->lFd = open((char *)pucPath, O_RDONLY);
+				blReturn = (pstShard->lFd >= 0);
+				if(blReturn != true)
+				{
+					pstShard->lFd = STORE_INVALID_FD;
+				}
+				else
+				{
+					filePageAttach(pstShard->lFd);
+				}
+			}
+
+			// The index may have been replaced along with its data file
+			indexClose(&pstShard->stIndex);
+			pstShard->blRepaired = false;
+			if(blReturn == true && pstShard->lFd != STORE_INVALID_FD)
+			{
+				pstShard->stData = stIdentity;
+				indexAttach(pucPath, &pstShard->stIndex);
+			}
+		}
+		else
+		{
+			storeCloseShard(pstShard);
+		}
+	}
+
+	if(blReturn == true)
+	{
+		pstStore->ulGeneration = ulGeneration;
+		pstStore->blLoaded = true;
+	}
+	else
+	{
+		printf("\nUnable to open the device store %s",
+			   (char *)pstStore->pucFileName);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read a device through the serial index
+//Inputs	: pstStore, the store
+//Inputs	: ulSerial, serial of the device
+//Outputs	: pstDeviceData, the device
+//Outputs	: pblFound, whether the device exists
+//Outputs	: pblStale, whether the index does not describe its shard
+//Return	: True, if the index gave a definite answer
+//Return	: False, if the device has to be searched otherwise
+//Notes		: The caller holds the current generation
+//******************************************************************************
+static bool storeGetIndexed(STORE *pstStore, uint32 ulSerial,
+							DEVICE_DETAILS *pstDeviceData, bool *pblFound,
+							bool *pblStale)
+{
+	bool blReturn = false;
+	STORE_SHARD *pstShard = NULL;
+	uint32 ulShard = 0;
+	uint32 ulSlot = 0;
+
+	ulShard = shardRoute(ulSerial, pstStore->stLayout.ulShardCount);
+	pstShard = &pstStore->pstShards[ulShard];
+	*pblFound = false;
+	*pblStale = false;
+	if(pstShard->lFd == STORE_INVALID_FD)
+	{
+		blReturn = true;
+	}
+	else if(indexIsCurrent(&pstShard->stIndex, &pstShard->stData) == true)
+	{
+		if(indexFind(&pstShard->stIndex, ulSerial, &ulSlot) == true)
+		{
+			*pblFound = (filePageRead(pstShard->lFd, pstDeviceData,
+									  sizeof(DEVICE_DETAILS),
+									  ulSlot * sizeof(DEVICE_DETAILS)) ==
+						 true &&
+						 pstDeviceData->ulDeviceSerial == ulSerial &&
+						 deviceCheckRecord(pstDeviceData) == true);
+			blReturn = *pblFound;
+		}
+		else
+		{
+			blReturn = true;
+		}
+	}
+	else
+	{
+		*pblStale = true;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To rebuild the outdated serial index of a shard
+//Inputs	: pstStore, the store
+//Inputs	: ulSerial, a serial of the shard
+//Outputs	: None
+//Return	: None
+//Notes		: Tried once per generation, under the writer lock, which the
+//			  caller must not hold the generation across
+//******************************************************************************
+static void storeRepairIndex(STORE *pstStore, uint32 ulSerial)
+{
+	STORE_SHARD *pstShard = NULL;
+	SNAPSHOT_WRITER stWriter;
+	INDEX stIndex = {INDEX_INVALID_FD, {0}};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+
+	ulShard = shardRoute(ulSerial, pstStore->stLayout.ulShardCount);
+	pstShard = &pstStore->pstShards[ulShard];
+	if(pstShard->blRepaired != true)
+	{
+		pstShard->blRepaired = true;
+		if(shardGetSerialPath(pstStore->pucFileName, ulSerial,
+							  pucPath) == true &&
+		   snapshotWriterBegin(pstStore->pucFileName, &stWriter) == true)
+		{
+			if(indexOpen(pucPath, &stIndex) == true)
+			{
+				indexClose(&stIndex);
+			}
+			snapshotWriterEnd(&stWriter);
+		}
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read a device from the loaded image
+//Inputs	: pstStore, the store
+//Inputs	: ulSerial, serial of the device
+//Outputs	: pstDeviceData, the device
+//Outputs	: pblFound, whether the device exists
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: An image the feed cannot bring up to date or found damaged
+//			  is built again
+//******************************************************************************
+static bool storeGetImage(STORE *pstStore, uint32 ulSerial,
+						  DEVICE_DETAILS *pstDeviceData, bool *pblFound)
+{
+	bool blReturn = false;
+	uint32 ulGeneration = 0;
+
+	if(snapshotHold(pstStore->lGenerationFd, &ulGeneration) == true)
+	{
+		snapshotUnhold(pstStore->lGenerationFd);
+		blReturn = true;
+		if(pstStore->stImage.pstHeader->ulGeneration != ulGeneration &&
+		   imageCatchUp(pstStore->pucFileName, &pstStore->stImage) != true)
+		{
+			imageClose(&pstStore->stImage);
+			blReturn = imageBuild(pstStore->pucFileName, &pstStore->stImage);
+			pstStore->blImage = blReturn;
+		}
+	}
+
+	if(blReturn == true &&
+	   imageFind(&pstStore->stImage, ulSerial, pstDeviceData,
+				 pblFound) != true)
+	{
+		imageClose(&pstStore->stImage);
+		pstStore->blImage = imageBuild(pstStore->pucFileName,
+									   &pstStore->stImage);
+		blReturn = (pstStore->blImage == true &&
+					imageFind(&pstStore->stImage, ulSerial, pstDeviceData,
+							  pblFound) == true);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To free the serial map of a store
+//Inputs	: pstStore, the store
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void storeDropMap(STORE *pstStore)
+{
+	if(pstStore->pstMap != NULL)
+	{
+		chashDestroy(pstStore->pstMap);
+		free(pstStore->pstMap);
+		pstStore->pstMap = NULL;
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read a device from the serial map
+//Inputs	: pstStore, the store
+//Inputs	: ulSerial, serial of the device
+//Outputs	: pstDeviceData, the device
+//Outputs	: pblFound, whether the device exists
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A map of an older generation is loaded again
+//******************************************************************************
+static bool storeGetMap(STORE *pstStore, uint32 ulSerial,
+						DEVICE_DETAILS *pstDeviceData, bool *pblFound)
+{
+	bool blReturn = false;
+	uint32 ulGeneration = 0;
+
+	if(snapshotHold(pstStore->lGenerationFd, &ulGeneration) == true)
+	{
+		snapshotUnhold(pstStore->lGenerationFd);
+		blReturn = (pstStore->ulMapGeneration == ulGeneration ||
+					storeLoadMap(pstStore) == true);
+	}
+
+	if(blReturn == true)
+	{
+		*pblFound = chashFind(pstStore->pstMap, pstStore->ulMapReader,
+							  ulSerial, pstDeviceData);
+	}
+
+	return blReturn;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open a device store
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pstStore, the store
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The data file does not have to exist yet
+//******************************************************************************
+bool storeOpen(const uint8 *pucFileName, STORE *pstStore)
+{
+	bool blReturn = false;
+	uint32 ulShard = 0;
+
+	if(pucFileName != NULL && pstStore != NULL &&
+	   strlen((const char *)pucFileName) < FILE_PATH_MAX_SIZE)
+	{
+		memset(pstStore, 0, sizeof(STORE));
+		strcpy((char *)pstStore->pucFileName, (const char *)pucFileName);
+		for(ulShard = 0; ulShard < SHARD_MAX_COUNT; ulShard++)
+		{
+			pstStore->pstShards[ulShard].lFd = STORE_INVALID_FD;
+			pstStore->pstShards[ulShard].stIndex.lFd = INDEX_INVALID_FD;
+		}
+		arenaInit(&pstStore->stArena, ARENA_QUERY_SIZE);
+		filePageConfigure(filePageGetBudget(pucFileName));
+		blReturn = (shardRecover(pucFileName) == true &&
+					txnRecover(pucFileName) == true &&
+					formatCheck(pucFileName) == true &&
+					snapshotOpenGeneration(pucFileName,
+										   &pstStore->lGenerationFd) == true);
+		if(blReturn != true)
+		{
+			pstStore->lGenerationFd = STORE_INVALID_FD;
+			storeClose(pstStore);
+		}
+	}
+	else
+	{
+		printf("\nUnable to open the device store : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To close a device store
+//Inputs	: pstStore, the store
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool storeClose(STORE *pstStore)
+{
+	bool blReturn = false;
+	uint32 ulShard = 0;
+
+	if(pstStore != NULL)
+	{
+		blReturn = true;
+		for(ulShard = 0; ulShard < SHARD_MAX_COUNT; ulShard++)
+		{
+			storeCloseShard(&pstStore->pstShards[ulShard]);
+		}
+		if(pstStore->lGenerationFd != STORE_INVALID_FD &&
+		   close(pstStore->lGenerationFd) != 0)
+		{
+			blReturn = false;
+		}
+		pstStore->lGenerationFd = STORE_INVALID_FD;
+		pstStore->blLoaded = false;
+		arenaRelease(&pstStore->stArena);
+		imageClose(&pstStore->stImage);
+		pstStore->blImage = false;
+		storeDropMap(pstStore);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To keep the devices of a store in memory
+//Inputs	: pstStore, the store
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Maps the checkpoint and replays the changes made after it.
+//			  Without a usable checkpoint the image is built from the data
+//			  files and saved as the new checkpoint.
+//******************************************************************************
+bool storeLoadImage(STORE *pstStore)
+{
+	bool blReturn = false;
+
+	if(pstStore != NULL)
+	{
+		imageClose(&pstStore->stImage);
+		blReturn = imageLoad(pstStore->pucFileName, &pstStore->stImage);
+		if(blReturn != true)
+		{
+			blReturn = imageBuild(pstStore->pucFileName, &pstStore->stImage);
+			if(blReturn == true)
+			{
+				imageSave(pstStore->pucFileName, &pstStore->stImage);
+			}
+		}
+		pstStore->blImage = blReturn;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To keep the serials of a store in the concurrent index
+//Inputs	: pstStore, the store
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The devices of one snapshot are loaded, lookups then read them
+//			  without taking a lock. A loaded image is used first.
+//******************************************************************************
+bool storeLoadMap(STORE *pstStore)
+{
+	bool blReturn = false;
+
+	if(pstStore != NULL)
+	{
+		storeDropMap(pstStore);
+		pstStore->pstMap = malloc(sizeof(CHASH));
+		blReturn = (pstStore->pstMap != NULL &&
+					chashCreate(pstStore->pstMap, 0) == true &&
+					chashLoad(pstStore->pstMap, pstStore->pucFileName,
+							  &pstStore->ulMapGeneration) == true &&
+					chashAttach(pstStore->pstMap,
+								&pstStore->ulMapReader) == true);
+		if(blReturn != true)
+		{
+			storeDropMap(pstStore);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To save the loaded image as the checkpoint of the store
+//Inputs	: pstStore, the store
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The image is brought up to date first
+//******************************************************************************
+bool storeCheckpoint(STORE *pstStore)
+{
+	bool blReturn = false;
+
+	if(pstStore != NULL && pstStore->blImage == true)
+	{
+		blReturn = imageCatchUp(pstStore->pucFileName, &pstStore->stImage);
+		if(blReturn != true)
+		{
+			imageClose(&pstStore->stImage);
+			blReturn = imageBuild(pstStore->pucFileName, &pstStore->stImage);
+			pstStore->blImage = blReturn;
+		}
+		blReturn = (blReturn == true &&
+					imageSave(pstStore->pucFileName,
+							  &pstStore->stImage) == true);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the device with a given serial
+//Inputs	: pstStore, the store
+//Inputs	: ulSerial, serial of the device
+//Outputs	: pstDeviceData, the device
+//Outputs	: pblFound, whether the device exists
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A couple of reads while the generation does not move. An
+//			  outdated index is rebuilt for the next lookups. With the
+//			  image or the map loaded the device is read from memory.
+//******************************************************************************
+bool storeGet(STORE *pstStore, uint32 ulSerial, DEVICE_DETAILS *pstDeviceData,
+			  bool *pblFound)
+{
+	bool blReturn = false;
+	bool blIndexed = false;
+	bool blStale = false;
+	DEVICE_CRITERIA stCriteria = {0};
+	SHARD_RESULT stResult = {0};
+	uint32 ulGeneration = 0;
+
+	if(pstStore != NULL && pstDeviceData != NULL && pblFound != NULL &&
+	   pstStore->blImage == true)
+	{
+		blReturn = storeGetImage(pstStore, ulSerial, pstDeviceData, pblFound);
+	}
+	else if(pstStore != NULL && pstDeviceData != NULL && pblFound != NULL &&
+			pstStore->pstMap != NULL)
+	{
+		blReturn = storeGetMap(pstStore, ulSerial, pstDeviceData, pblFound);
+	}
+	else if(pstStore != NULL && pstDeviceData != NULL && pblFound != NULL &&
+			snapshotHold(pstStore->lGenerationFd, &ulGeneration) == true)
+	{
+		*pblFound = false;
+		blReturn = true;
+		if(pstStore->blLoaded != true || pstStore->ulGeneration != ulGeneration)
+		{
+			blReturn = storeRefresh(pstStore, ulGeneration);
+		}
+		if(blReturn == true)
+		{
+			blIndexed = storeGetIndexed(pstStore, ulSerial, pstDeviceData,
+										pblFound, &blStale);
+		}
+		snapshotUnhold(pstStore->lGenerationFd);
+
+		if(blReturn == true && blStale == true)
+		{
+			storeRepairIndex(pstStore, ulSerial);
+		}
+
+		if(blReturn == true && blIndexed != true)
+		{
+			stCriteria.ulChoice = SEARCH_BY_SERIAL;
+			stCriteria.ulValue = ulSerial;
+			arenaReset(&pstStore->stArena);
+			stResult.pstArena = &pstStore->stArena;
+			blReturn = deviceCollectCriteria(pstStore->pucFileName,
+											 &stCriteria, &stResult);
+			*pblFound = (blReturn == true && stResult.ulCount > 0);
+			if(*pblFound == true)
+			{
+				*pstDeviceData = stResult.pstRecords[0];
+			}
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the devices matching search criteria
+//Inputs	: pstStore, the store
+//Inputs	: pstCriteria, the criteria to be matched
+//Inputs	: pfnVisit and pvContext, called with every matching device
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The devices passed to pfnVisit are valid until the next call
+//******************************************************************************
+bool storeSearch(STORE *pstStore, const DEVICE_CRITERIA *pstCriteria,
+				 STORE_VISIT pfnVisit, void *pvContext)
+{
+	bool blReturn = false;
+	SHARD_RESULT stResult = {0};
+	uint32 ulIndex = 0;
+
+	if(pstStore != NULL && pstCriteria != NULL && pfnVisit != NULL)
+	{
+		arenaReset(&pstStore->stArena);
+		stResult.pstArena = &pstStore->stArena;
+		blReturn = deviceCollectCriteria(pstStore->pucFileName, pstCriteria,
+										 &stResult);
+		for(ulIndex = 0; ulIndex < stResult.ulCount && blReturn == true &&
+			pfnVisit(&stResult.pstRecords[ulIndex], pvContext) == true;
+			ulIndex++)
+		{
+			//NOP
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To enumerate all the devices
+//Inputs	: pstStore, the store
+//Inputs	: pfnVisit and pvContext, called with every device
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Enumerates a snapshot, shard after shard
+//******************************************************************************
+bool storeList(STORE *pstStore, STORE_VISIT pfnVisit, void *pvContext)
+{
+	bool blReturn = false;
+	bool blContinue = true;
+	DEVICE_DETAILS DeviceData = {0};
+	SNAPSHOT stSnapshot;
+	SHARD_LAYOUT stLayout = {0};
+	uint32 ulShard = 0;
+
+	if(pstStore != NULL && pfnVisit != NULL &&
+	   shardAcquireSnapshot(pstStore->pucFileName, &stSnapshot,
+							&stLayout) == true)
+	{
+		blReturn = true;
+		for(ulShard = 0; ulShard < stSnapshot.ulFileCount &&
+			blContinue == true; ulShard++)
+		{
+			while(blContinue == true &&
+				  snapshotRead(&stSnapshot, ulShard, &DeviceData) == true)
+			{
+				blContinue = pfnVisit(&DeviceData, pvContext);
+			}
+		}
+		snapshotRelease(&stSnapshot);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To add a device
+//Inputs	: pstStore, the store
+//Inputs	: pstDeviceData, the device, its checksum is set
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, if the serial exists or in case of an error
+//Notes		:
+//******************************************************************************
+bool storeAdd(STORE *pstStore, DEVICE_DETAILS *pstDeviceData)
+{
+	return (pstStore != NULL &&
+			deviceAddRecord(pstStore->pucFileName, pstDeviceData) == true);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the devices matching criteria
+//Inputs	: pstStore, the store
+//Inputs	: pstCriteria, the criteria to be matched
+//Outputs	: pulRemoved, number of removed devices
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool storeRemove(STORE *pstStore, const DEVICE_CRITERIA *pstCriteria,
+				 uint32 *pulRemoved)
+{
+	return (pstStore != NULL &&
+			deviceRemoveCriteria(pstStore->pucFileName, pstCriteria,
+								 pulRemoved) == true);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the device with a given serial
+//Inputs	: pstStore, the store
+//Inputs	: ulSerial, serial of the device
+//Outputs	: pblRemoved, whether a device has been removed
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool storeRemoveSerial(STORE *pstStore, uint32 ulSerial, bool *pblRemoved)
+{
+	return (pstStore != NULL &&
+			deviceRemoveSerial(pstStore->pucFileName, ulSerial,
+							   pblRemoved) == true);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To update devices
+//Inputs	: pstStore, the store
+//Inputs	: pstUpdates and ulCount, the updates, by serial
+//Outputs	: pblUpdated, set for every update applied
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool storeUpdate(STORE *pstStore, const DEVICE_UPDATE *pstUpdates,
+				 uint32 ulCount, bool *pblUpdated)
+{
+	return (pstStore != NULL &&
+			deviceUpdateRecords(pstStore->pucFileName, pstUpdates, ulCount,
+								pblUpdated) == true);
+}
+// EOF
@@ -0,0 +1,80 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Device store handle for programs linking libdevstore.a
+// Note		: Results are returned through structures and callbacks, the
+//			  files of the store stay open between calls
+//
+//******************************************************************************
+
+#ifndef _STORE_H_
+#define _STORE_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "index.h"
+#include "shard.h"
+#include "arena.h"
+#include "image.h"
+#include "chash.h"
+
+//******************************* Global Types *********************************
+// Returns false to stop the enumeration
+typedef bool (*STORE_VISIT)(const DEVICE_DETAILS *pstDeviceData,
+							void *pvContext);
+
+typedef struct _STORE_SHARD_
+{
+	int32 lFd;
+	FILE_IDENTITY stData;
+	INDEX stIndex;
+	bool blRepaired;
+} STORE_SHARD;
+
+typedef struct _STORE_
+{
+	uint8 pucFileName[FILE_PATH_MAX_SIZE];
+	int32 lGenerationFd;
+	uint32 ulGeneration;
+	bool blLoaded;
+	SHARD_LAYOUT stLayout;
+	STORE_SHARD pstShards[SHARD_MAX_COUNT];
+	ARENA stArena;
+	IMAGE stImage;
+	bool blImage;
+	CHASH *pstMap;
+	uint32 ulMapGeneration;
+	uint32 ulMapReader;
+} STORE;
+
+//***************************** Global Constants *******************************
+#define STORE_INVALID_FD	(-1)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool storeOpen(const uint8 *pucFileName, STORE *pstStore);
+bool storeClose(STORE *pstStore);
+bool storeLoadImage(STORE *pstStore);
+bool storeLoadMap(STORE *pstStore);
+bool storeCheckpoint(STORE *pstStore);
+bool storeGet(STORE *pstStore, uint32 ulSerial, DEVICE_DETAILS *pstDeviceData,
+			  bool *pblFound);
+bool storeSearch(STORE *pstStore, const DEVICE_CRITERIA *pstCriteria,
+				 STORE_VISIT pfnVisit, void *pvContext);
+bool storeList(STORE *pstStore, STORE_VISIT pfnVisit, void *pvContext);
+bool storeAdd(STORE *pstStore, DEVICE_DETAILS *pstDeviceData);
+bool storeRemove(STORE *pstStore, const DEVICE_CRITERIA *pstCriteria,
+				 uint32 *pulRemoved);
+bool storeRemoveSerial(STORE *pstStore, uint32 ulSerial, bool *pblRemoved);
+bool storeUpdate(STORE *pstStore, const DEVICE_UPDATE *pstUpdates,
+				 uint32 ulCount, bool *pblUpdated);
+
+#endif // _STORE_H_
+// EOF
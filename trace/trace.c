@@ -0,0 +1,277 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: trace.c
+// Summary	: Scoped trace spans exported as Chrome trace events
+// Note		: Every thread records its spans in a ring of its own, so a
+//			  span costs a timestamp when it starts and a timestamp and a
+//			  store of the event when it ends, without any lock. A ring
+//			  keeps the last TRACE_RING_EVENTS spans of its thread. A thread
+//			  takes a ring at its first span and gives it back when it
+//			  exits, the next new thread carries on with it, so the short
+//			  lived threads of the read ahead pipelines share a few rings.
+//			  The rings are written out as complete events, "ph":"X", when
+//			  the program exits, one thread of the trace per ring.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "file.h"
+#include "trace.h"
+
+//******************************* Local Types **********************************
+typedef struct _TRACE_RING_
+{
+	TRACE_EVENT pstEvents[TRACE_RING_EVENTS];
+	uint32 ulCount;
+	bool blInUse;
+} TRACE_RING;
+
+//***************************** Local Constants ********************************
+#define TRACE_NANOSECONDS		(1000000000UL)
+#define TRACE_MICROSECONDS		(1e3)
+
+//***************************** Local Variables ********************************
+static TRACE_RING *ppstTraceRings[TRACE_MAX_RINGS];
+static uint32 ulTraceRingCount = 0;
+static pthread_mutex_t stTraceLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t stTraceKey;
+static pthread_once_t stTraceOnce = PTHREAD_ONCE_INIT;
+static _Thread_local TRACE_RING *pstTraceRing = NULL;
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To give back the ring of an exiting thread
+//Inputs	: pvRing, the ring
+//Outputs	: None
+//Return	: None
+//Notes		: Its spans are kept
+//******************************************************************************
+static void traceRelease(void *pvRing)
+{
+	TRACE_RING *pstRing = pvRing;
+
+	pthread_mutex_lock(&stTraceLock);
+	pstRing->blInUse = false;
+	pthread_mutex_unlock(&stTraceLock);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write the trace when the program exits
+//Inputs	: None
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void traceExit(void)
+{
+	traceExport((const uint8 *)TRACE_FILE_NAME);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To prepare the tracing of the process
+//Inputs	: None
+//Outputs	: None
+//Return	: None
+//Notes		: Runs once, at the first span
+//******************************************************************************
+static void traceSetup(void)
+{
+	pthread_key_create(&stTraceKey, traceRelease);
+	atexit(traceExit);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To take a ring for the calling thread
+//Inputs	: None
+//Outputs	: None
+//Return	: The ring, NULL when all TRACE_MAX_RINGS rings are taken or out
+//			  of memory, the spans of the thread are then dropped
+//Notes		: A ring given back by an exited thread is taken first
+//******************************************************************************
+static TRACE_RING *traceClaim(void)
+{
+	TRACE_RING *pstRing = NULL;
+	uint32 ulRing = 0;
+
+	pthread_once(&stTraceOnce, traceSetup);
+	pthread_mutex_lock(&stTraceLock);
+	for(ulRing = 0; ulRing < ulTraceRingCount && pstRing == NULL; ulRing++)
+	{
+		if(ppstTraceRings[ulRing]->blInUse != true)
+		{
+			pstRing = ppstTraceRings[ulRing];
+		}
+	}
+	if(pstRing == NULL && ulTraceRingCount < TRACE_MAX_RINGS)
+	{
+		pstRing = calloc(1, sizeof(TRACE_RING));
+		if(pstRing != NULL)
+		{
+			ppstTraceRings[ulTraceRingCount++] = pstRing;
+		}
+	}
+	if(pstRing != NULL)
+	{
+		pstRing->blInUse = true;
+	}
+	pthread_mutex_unlock(&stTraceLock);
+
+	if(pstRing != NULL)
+	{
+		pthread_setspecific(stTraceKey, pstRing);
+		pstTraceRing = pstRing;
+	}
+
+	return pstRing;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the clock of the spans
+//Inputs	: None
+//Outputs	: None
+//Return	: Monotonic time in nanoseconds
+//Notes		:
+//******************************************************************************
+uint32 traceNow(void)
+{
+	struct timespec stNow;
+
+	clock_gettime(CLOCK_MONOTONIC, &stNow);
+
+	return stNow.tv_sec * TRACE_NANOSECONDS + stNow.tv_nsec;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To record a span when its block is left
+//Inputs	: pstSpan, the span
+//Outputs	: None
+//Return	: None
+//Notes		: Called by the cleanup of TRACE_SPAN(), the oldest span of the
+//			  ring is overwritten once it is full
+//******************************************************************************
+void traceEnd(TRACE_SCOPE *pstSpan)
+{
+	TRACE_RING *pstRing = pstTraceRing;
+	TRACE_EVENT *pstEvent = NULL;
+
+	if(pstRing == NULL)
+	{
+		pstRing = traceClaim();
+	}
+	if(pstRing != NULL)
+	{
+		pstEvent = &pstRing->pstEvents[pstRing->ulCount %
+									   TRACE_RING_EVENTS];
+		pstEvent->pcCategory = pstSpan->pcCategory;
+		pstEvent->pcName = pstSpan->pcName;
+		pstEvent->ulStart = pstSpan->ulStart;
+		pstEvent->ulEnd = traceNow();
+		pstRing->ulCount++;
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write the recorded spans in Chrome trace event format
+//Inputs	: pucPath, name of the JSON file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Nothing is written when no span has been recorded. The times
+//			  are in microseconds from the first span kept.
+//******************************************************************************
+bool traceExport(const uint8 *pucPath)
+{
+	bool blReturn = true;
+	FILE *pstFile = NULL;
+	const TRACE_EVENT *pstEvent = NULL;
+	uint32 pulFirst[TRACE_MAX_RINGS] = {0};
+	uint32 ulBase = (uint32)-1;
+	uint32 ulRing = 0;
+	uint32 ulEvent = 0;
+	uint32 ulWritten = 0;
+
+	if(pucPath == NULL)
+	{
+		printf("\nUnable to write the trace : Invalid parameters");
+		return false;
+	}
+
+	pthread_mutex_lock(&stTraceLock);
+	for(ulRing = 0; ulRing < ulTraceRingCount; ulRing++)
+	{
+		if(ppstTraceRings[ulRing]->ulCount > TRACE_RING_EVENTS)
+		{
+			pulFirst[ulRing] = ppstTraceRings[ulRing]->ulCount -
+							   TRACE_RING_EVENTS;
+		}
+		for(ulEvent = pulFirst[ulRing];
+			ulEvent < ppstTraceRings[ulRing]->ulCount; ulEvent++)
+		{
+			pstEvent = &ppstTraceRings[ulRing]->pstEvents[ulEvent %
+														  TRACE_RING_EVENTS];
+			ulBase = (pstEvent->ulStart < ulBase) ? pstEvent->ulStart : ulBase;
+		}
+	}
+
+	if(ulBase != (uint32)-1)
+	{
+		pstFile = fopen((const char *)pucPath, FILE_WRITE_MODE);
+		blReturn = (pstFile != NULL &&
+					fprintf(pstFile, "{\"traceEvents\":[") > 0);
+	}
+	for(ulRing = 0; ulRing < ulTraceRingCount && pstFile != NULL &&
+		blReturn == true; ulRing++)
+	{
+		for(ulEvent = pulFirst[ulRing];
+			ulEvent < ppstTraceRings[ulRing]->ulCount && blReturn == true;
+			ulEvent++)
+		{
+			pstEvent = &ppstTraceRings[ulRing]->pstEvents[ulEvent %
+														  TRACE_RING_EVENTS];
+			blReturn = (fprintf(pstFile, "%s\n{\"name\":\"%s\",\"cat\":\"%s\","
+								"\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+								"\"pid\":%d,\"tid\":%lu}",
+								(ulWritten > 0) ? "," : "",
+								pstEvent->pcName, pstEvent->pcCategory,
+								(pstEvent->ulStart - ulBase) /
+								TRACE_MICROSECONDS,
+								(pstEvent->ulEnd - pstEvent->ulStart) /
+								TRACE_MICROSECONDS,
+								(int)getpid(), ulRing + 1) > 0);
+			ulWritten++;
+		}
+	}
+	pthread_mutex_unlock(&stTraceLock);
+
+	if(pstFile != NULL)
+	{
+		blReturn = (fprintf(pstFile, "\n]}\n") > 0 && blReturn == true);
+		blReturn = (fclose(pstFile) == 0 && blReturn == true);
+	}
+	if(blReturn != true)
+	{
+		printf("\nUnable to write the trace %s", (const char *)pucPath);
+	}
+
+	return blReturn;
+}
+// EOF
@@ -0,0 +1,63 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Scoped trace spans exported as Chrome trace events
+// Note		: TRACE_SPAN() times the rest of the enclosing block. The spans
+//			  are only compiled in when TRACE_ENABLED is defined, "make
+//			  TRACE=1", and written to TRACE_FILE_NAME when the program
+//			  exits.
+//
+//******************************************************************************
+
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+
+//******************************* Global Types *********************************
+// A finished span, as stored in the ring of its thread
+typedef struct _TRACE_EVENT_
+{
+	const char *pcCategory;
+	const char *pcName;
+	uint32 ulStart;
+	uint32 ulEnd;
+} TRACE_EVENT;
+
+// A span still open, ended by traceEnd() when its block is left
+typedef struct _TRACE_SCOPE_
+{
+	const char *pcCategory;
+	const char *pcName;
+	uint32 ulStart;
+} TRACE_SCOPE;
+
+//***************************** Global Constants *******************************
+#define TRACE_FILE_NAME			("trace.json")
+#define TRACE_RING_EVENTS		(65536)
+#define TRACE_MAX_RINGS			(128)
+
+#define TRACE_CONCAT_(a, b)		a##b
+#define TRACE_CONCAT(a, b)		TRACE_CONCAT_(a, b)
+
+#ifdef TRACE_ENABLED
+#define TRACE_SPAN(pcCategory, pcName) \
+	TRACE_SCOPE TRACE_CONCAT(stTraceSpan, __LINE__) \
+	__attribute__((cleanup(traceEnd))) = {(pcCategory), (pcName), traceNow()}
+#else
+#define TRACE_SPAN(pcCategory, pcName)
+#endif
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+uint32 traceNow(void);
+void traceEnd(TRACE_SCOPE *pstSpan);
+bool traceExport(const uint8 *pucPath);
+
+#endif // _TRACE_H_
+// EOF
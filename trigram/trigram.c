@@ -0,0 +1,642 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: trigram.c
+// Summary	: Approximate device name search
+// Note		: "<data file>.tri" maps the trigrams of the names, hashed to a
+//			  power of two number of buckets, to the slots of the records
+//			  holding them. Names are padded with a NUL at each end, so a
+//			  name of n characters has n trigrams. One edit changes at most
+//			  three trigrams, a name within d edits shares all but 3d of
+//			  the trigrams of the searched name. The records sharing the
+//			  most trigrams are the candidates, ranked by their edit
+//			  distance computed with the bit-parallel algorithm of Myers.
+//			  An index not describing its data file is rebuilt by the next
+//			  search.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "trigram.h"
+
+//******************************* Local Types **********************************
+
+//***************************** Local Constants ********************************
+#define WRITE_COUNT					(1)
+#define TRIGRAM_MIN_BUCKETS			(1024)
+#define TRIGRAM_MAX_BUCKETS			(65536)
+#define TRIGRAM_MAX_GRAMS			(STR_MAX_SIZE)
+#define TRIGRAM_HASH				(2654435761UL)
+#define TRIGRAM_HASH_SHIFT			(16)
+#define TRIGRAM_EDIT_GRAMS			(3)
+#define TRIGRAM_READ_RECORDS		(8192)
+#define TRIGRAM_READ_SLOTS			(8192)
+#define TRIGRAM_MIN_CANDIDATES		(256)
+#define TRIGRAM_CANDIDATES_PER_MATCH	(16)
+#define TRIGRAM_ALPHABET_SIZE		(256)
+#define TRIGRAM_BYTE_BITS			(8)
+#define TRIGRAM_TEMPORARY_FORMAT	(".tmp.%d")
+#define TRIGRAM_SUFFIX_SIZE			(32)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To list the distinct trigram buckets of a name
+//Inputs	: pucName, the name
+//Inputs	: ulBucketCount, number of buckets, a power of two
+//Outputs	: pulBuckets, the buckets in increasing order, TRIGRAM_MAX_GRAMS
+//Return	: Number of buckets
+//Notes		:
+//******************************************************************************
+static uint32 trigramGetBuckets(const uint8 *pucName, uint32 ulBucketCount,
+								uint32 *pulBuckets)
+{
+	uint8 pucPadded[STR_MAX_SIZE + 2] = {0};
+	uint32 ulLength = strnlen((const char *)pucName, STR_MAX_SIZE);
+	uint32 ulGram = 0;
+	uint32 ulBucket = 0;
+	uint32 ulCount = 0;
+	uint32 ulIndex = 0;
+	uint32 ulPosition = 0;
+
+	memcpy(pucPadded + 1, pucName, ulLength);
+	for(ulIndex = 0; ulIndex < ulLength; ulIndex++)
+	{
+		ulGram = ((uint32)pucPadded[ulIndex] << (2 * TRIGRAM_BYTE_BITS)) |
+				 ((uint32)pucPadded[ulIndex + 1] << TRIGRAM_BYTE_BITS) |
+				 pucPadded[ulIndex + 2];
+		ulBucket = ((ulGram * TRIGRAM_HASH) >> TRIGRAM_HASH_SHIFT) &
+				   (ulBucketCount - 1);
+
+		// Insertion into the sorted buckets, skipping a repeated one
+		ulPosition = ulCount;
+		while(ulPosition > 0 && pulBuckets[ulPosition - 1] > ulBucket)
+		{
+			ulPosition--;
+		}
+		if(ulPosition == 0 || pulBuckets[ulPosition - 1] != ulBucket)
+		{
+			memmove(&pulBuckets[ulPosition + 1], &pulBuckets[ulPosition],
+					(ulCount - ulPosition) * sizeof(uint32));
+			pulBuckets[ulPosition] = ulBucket;
+			ulCount++;
+		}
+	}
+
+	return ulCount;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To go through the names of a data file, counting or placing
+//			  their postings
+//Inputs	: lDataFd, the data file
+//Inputs	: pstHeader, header of the index being built
+//Inputs	: pulOffsets, posting count or next posting of every bucket
+//Inputs	: pulPostings, NULL to count the postings, else the postings
+//Inputs	: pstRecords, room for TRIGRAM_READ_RECORDS records
+//Outputs	: pulOffsets and pulPostings, updated
+//Return	: True, at time of successful execution
+//Return	: False, if the data file cannot be read
+//Notes		: The counts of bucket b are made in pulOffsets[b + 1]
+//******************************************************************************
+static bool trigramScan(int32 lDataFd, const TRIGRAM_HEADER *pstHeader,
+						uint32 *pulOffsets, uint32 *pulPostings,
+						DEVICE_DETAILS *pstRecords)
+{
+	bool blReturn = true;
+	uint32 pulBuckets[TRIGRAM_MAX_GRAMS];
+	uint32 ulSlot = 0;
+	uint32 ulRead = 0;
+	uint32 ulIndex = 0;
+	uint32 ulBucket = 0;
+	uint32 ulCount = 0;
+
+	for(ulSlot = 0; ulSlot < pstHeader->ulRecordCount && blReturn == true;
+		ulSlot += ulRead)
+	{
+		ulRead = pstHeader->ulRecordCount - ulSlot;
+		if(ulRead > TRIGRAM_READ_RECORDS)
+		{
+			ulRead = TRIGRAM_READ_RECORDS;
+		}
+		blReturn = (pread(lDataFd, pstRecords, ulRead * sizeof(DEVICE_DETAILS),
+						  ulSlot * sizeof(DEVICE_DETAILS)) ==
+					(ssize_t)(ulRead * sizeof(DEVICE_DETAILS)));
+
+		for(ulIndex = 0; ulIndex < ulRead && blReturn == true; ulIndex++)
+		{
+			ulCount = trigramGetBuckets(pstRecords[ulIndex].pucDeviceName,
+										pstHeader->ulBucketCount, pulBuckets);
+			for(ulBucket = 0; ulBucket < ulCount; ulBucket++)
+			{
+				if(pulPostings == NULL)
+				{
+					pulOffsets[pulBuckets[ulBucket] + 1]++;
+				}
+				else
+				{
+					pulPostings[pulOffsets[pulBuckets[ulBucket]]++] =
+						ulSlot + ulIndex;
+				}
+			}
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To build the trigram index of a data file
+//Inputs	: lDataFd, the data file
+//Inputs	: pstData, identity of the data file
+//Inputs	: pucPath, name of the index
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Written to a temporary file of the process and renamed, so
+//			  concurrent searches may rebuild the same index
+//******************************************************************************
+static bool trigramBuild(int32 lDataFd, const FILE_IDENTITY *pstData,
+						 const uint8 *pucPath)
+{
+	bool blReturn = false;
+	TRIGRAM_HEADER stHeader = {0};
+	DEVICE_DETAILS *pstRecords = NULL;
+	FILE *pstFile = NULL;
+	char pcSuffix[TRIGRAM_SUFFIX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 *pulOffsets = NULL;
+	uint32 *pulNext = NULL;
+	uint32 *pulPostings = NULL;
+	uint32 ulBucket = 0;
+
+	stHeader.ulMagic = TRIGRAM_MAGIC;
+	stHeader.stData = *pstData;
+	stHeader.ulRecordCount = pstData->ulSize / sizeof(DEVICE_DETAILS);
+	stHeader.ulBucketCount = TRIGRAM_MIN_BUCKETS;
+	while(stHeader.ulBucketCount < stHeader.ulRecordCount &&
+		  stHeader.ulBucketCount < TRIGRAM_MAX_BUCKETS)
+	{
+		stHeader.ulBucketCount *= 2;
+	}
+
+	pstRecords = malloc(TRIGRAM_READ_RECORDS * sizeof(DEVICE_DETAILS));
+	pulOffsets = calloc(stHeader.ulBucketCount + 1, sizeof(uint32));
+	pulNext = malloc(stHeader.ulBucketCount * sizeof(uint32));
+	blReturn = (pstRecords != NULL && pulOffsets != NULL && pulNext != NULL &&
+				trigramScan(lDataFd, &stHeader, pulOffsets, NULL,
+							pstRecords) == true);
+
+	if(blReturn == true)
+	{
+		for(ulBucket = 0; ulBucket < stHeader.ulBucketCount; ulBucket++)
+		{
+			pulOffsets[ulBucket + 1] += pulOffsets[ulBucket];
+		}
+		stHeader.ulPostingCount = pulOffsets[stHeader.ulBucketCount];
+		memcpy(pulNext, pulOffsets, stHeader.ulBucketCount * sizeof(uint32));
+		pulPostings = malloc(stHeader.ulPostingCount * sizeof(uint32) + 1);
+		blReturn = (pulPostings != NULL &&
+					trigramScan(lDataFd, &stHeader, pulNext, pulPostings,
+								pstRecords) == true);
+	}
+
+	snprintf(pcSuffix, sizeof(pcSuffix), TRIGRAM_TEMPORARY_FORMAT, getpid());
+	if(blReturn == true &&
+	   fileBuildPath(pucTemporaryPath, pucPath, (uint8 *)pcSuffix) == true)
+	{
+		pstFile = fopen((char *)pucTemporaryPath, FILE_WRITE_MODE);
+		blReturn = (pstFile != NULL &&
+					fwrite(&stHeader, sizeof(stHeader), WRITE_COUNT,
+						   pstFile) == WRITE_COUNT &&
+					fwrite(pulOffsets, (stHeader.ulBucketCount + 1) *
+						   sizeof(uint32), WRITE_COUNT,
+						   pstFile) == WRITE_COUNT &&
+					(stHeader.ulPostingCount == 0 ||
+					 fwrite(pulPostings, stHeader.ulPostingCount *
+							sizeof(uint32), WRITE_COUNT,
+							pstFile) == WRITE_COUNT));
+		if(pstFile != NULL)
+		{
+			blReturn = (fclose(pstFile) == 0 && blReturn == true &&
+						rename((char *)pucTemporaryPath,
+							   (char *)pucPath) == 0);
+			if(blReturn != true)
+			{
+				remove((char *)pucTemporaryPath);
+			}
+		}
+	}
+	else
+	{
+		blReturn = false;
+	}
+
+	free(pstRecords);
+	free(pulOffsets);
+	free(pulNext);
+	free(pulPostings);
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to build the name index %s", (char *)pucPath);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To open the trigram index of a pinned data file
+//Inputs	: pucDataPath, name of the data or shard file
+//Inputs	: pstData, the pinned data file
+//Outputs	: plFd, the open index
+//Outputs	: pstHeader, its header
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A missing or outdated index is first rebuilt
+//******************************************************************************
+static bool trigramOpen(const uint8 *pucDataPath, FILE *pstData, int32 *plFd,
+						TRIGRAM_HEADER *pstHeader)
+{
+	bool blReturn = false;
+	bool blBuilt = false;
+	FILE_IDENTITY stIdentity = {0};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	fileGetOpenIdentity(pstData, &stIdentity);
+	if(fileBuildPath(pucPath, pucDataPath, TRIGRAM_SUFFIX) == true)
+	{
+		do
+		{
+			*plFd = open((char *)pucPath, O_RDONLY);
+			blReturn = (*plFd >= 0 &&
+						pread(*plFd, pstHeader, sizeof(TRIGRAM_HEADER), 0) ==
+						sizeof(TRIGRAM_HEADER) &&
+						pstHeader->ulMagic == TRIGRAM_MAGIC &&
+						fileSameIdentity(&pstHeader->stData,
+										 &stIdentity) == true);
+			if(blReturn != true && *plFd >= 0)
+			{
+				close(*plFd);
+				*plFd = -1;
+			}
+
+			if(blReturn != true && blBuilt != true)
+			{
+				blBuilt = trigramBuild(fileno(pstData), &stIdentity, pucPath);
+				if(blBuilt != true)
+				{
+					break;
+				}
+			}
+			else
+			{
+				break;
+			}
+		} while(true);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To keep a device among the closest ones found
+//Inputs	: pstMatches, the closest devices by increasing distance
+//Inputs	: ulCount, number of devices to be kept
+//Inputs	: pulFound, number of devices kept so far
+//Inputs	: pstDevice and ulDistance, the device and its distance
+//Outputs	: pstMatches and pulFound, updated
+//Return	: None
+//Notes		: Devices at the same distance are ordered by name
+//******************************************************************************
+static void trigramKeep(TRIGRAM_MATCH *pstMatches, uint32 ulCount,
+						uint32 *pulFound, const DEVICE_DETAILS *pstDevice,
+						uint32 ulDistance)
+{
+	uint32 ulPosition = *pulFound;
+
+	while(ulPosition > 0 &&
+		  (pstMatches[ulPosition - 1].ulDistance > ulDistance ||
+		   (pstMatches[ulPosition - 1].ulDistance == ulDistance &&
+			strncmp((char *)pstMatches[ulPosition - 1].stDevice.pucDeviceName,
+					(char *)pstDevice->pucDeviceName, STR_MAX_SIZE) > 0)))
+	{
+		ulPosition--;
+	}
+
+	if(ulPosition < ulCount)
+	{
+		if(*pulFound < ulCount)
+		{
+			(*pulFound)++;
+		}
+		memmove(&pstMatches[ulPosition + 1], &pstMatches[ulPosition],
+				(*pulFound - 1 - ulPosition) * sizeof(TRIGRAM_MATCH));
+		pstMatches[ulPosition].stDevice = *pstDevice;
+		pstMatches[ulPosition].ulDistance = ulDistance;
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To count the trigrams every record shares with a name
+//Inputs	: lFd and pstHeader, the open index
+//Inputs	: pulBuckets and ulBucketCount, the buckets of the name
+//Outputs	: pucShared, the count of every record slot
+//Return	: True, at time of successful execution
+//Return	: False, if the index cannot be read
+//Notes		:
+//******************************************************************************
+static bool trigramCount(int32 lFd, const TRIGRAM_HEADER *pstHeader,
+						 const uint32 *pulBuckets, uint32 ulBucketCount,
+						 uint8 *pucShared)
+{
+	bool blReturn = true;
+	uint32 pulSlots[TRIGRAM_READ_SLOTS];
+	uint32 pulRange[2] = {0};
+	uint32 ulBucket = 0;
+	uint32 ulRead = 0;
+	uint32 ulIndex = 0;
+	off_t lPostings = sizeof(TRIGRAM_HEADER) +
+					  (pstHeader->ulBucketCount + 1) * sizeof(uint32);
+
+	for(ulBucket = 0; ulBucket < ulBucketCount && blReturn == true;
+		ulBucket++)
+	{
+		blReturn = (pread(lFd, pulRange, sizeof(pulRange),
+						  sizeof(TRIGRAM_HEADER) +
+						  pulBuckets[ulBucket] * sizeof(uint32)) ==
+					sizeof(pulRange) && pulRange[0] <= pulRange[1] &&
+					pulRange[1] <= pstHeader->ulPostingCount);
+
+		for(; pulRange[0] < pulRange[1] && blReturn == true;
+			pulRange[0] += ulRead)
+		{
+			ulRead = pulRange[1] - pulRange[0];
+			if(ulRead > TRIGRAM_READ_SLOTS)
+			{
+				ulRead = TRIGRAM_READ_SLOTS;
+			}
+			blReturn = (pread(lFd, pulSlots, ulRead * sizeof(uint32),
+							  lPostings + pulRange[0] * sizeof(uint32)) ==
+						(ssize_t)(ulRead * sizeof(uint32)));
+			for(ulIndex = 0; ulIndex < ulRead && blReturn == true; ulIndex++)
+			{
+				if(pulSlots[ulIndex] < pstHeader->ulRecordCount)
+				{
+					pucShared[pulSlots[ulIndex]]++;
+				}
+			}
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the closest names of one data file
+//Inputs	: lFd and pstHeader, the open index
+//Inputs	: lDataFd, the pinned data file
+//Inputs	: pucName, the searched name
+//Inputs	: ulCount, number of devices to be kept
+//Inputs	: pstMatches and pulFound, the closest devices found so far
+//Outputs	: pstMatches and pulFound, updated
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Only names within a third of the name length of edits are
+//			  kept. The verified candidates are the records sharing the
+//			  most trigrams, at least TRIGRAM_MIN_CANDIDATES of them.
+//******************************************************************************
+static bool trigramSearchFile(int32 lFd, const TRIGRAM_HEADER *pstHeader,
+							  int32 lDataFd, const uint8 *pucName,
+							  uint32 ulCount, TRIGRAM_MATCH *pstMatches,
+							  uint32 *pulFound)
+{
+	bool blReturn = false;
+	DEVICE_DETAILS DeviceData = {0};
+	uint32 pulBuckets[TRIGRAM_MAX_GRAMS];
+	uint32 pulLevels[TRIGRAM_MAX_GRAMS + 1] = {0};
+	uint8 *pucShared = NULL;
+	uint32 ulBucketCount = 0;
+	uint32 ulMaxDistance = 0;
+	uint32 ulThreshold = 1;
+	uint32 ulLimit = 0;
+	uint32 ulTaken = 0;
+	uint32 ulPartial = 0;
+	uint32 ulSlot = 0;
+	uint32 ulDistance = 0;
+	uint32 ulLevel = 0;
+
+	ulMaxDistance = (strnlen((const char *)pucName, STR_MAX_SIZE) + 2) /
+					TRIGRAM_EDIT_GRAMS;
+	ulBucketCount = trigramGetBuckets(pucName, pstHeader->ulBucketCount,
+									  pulBuckets);
+	if(ulBucketCount > TRIGRAM_EDIT_GRAMS * ulMaxDistance)
+	{
+		ulThreshold = ulBucketCount - TRIGRAM_EDIT_GRAMS * ulMaxDistance;
+	}
+
+	pucShared = calloc(pstHeader->ulRecordCount + 1, sizeof(uint8));
+	blReturn = (pucShared != NULL &&
+				trigramCount(lFd, pstHeader, pulBuckets, ulBucketCount,
+							 pucShared) == true);
+
+	// Records sharing ulLevel trigrams or more are all candidates, the
+	// rest of the limit is filled with records sharing one less
+	if(blReturn == true)
+	{
+		for(ulSlot = 0; ulSlot < pstHeader->ulRecordCount; ulSlot++)
+		{
+			pulLevels[pucShared[ulSlot]]++;
+		}
+		ulLimit = ulCount * TRIGRAM_CANDIDATES_PER_MATCH;
+		if(ulLimit < TRIGRAM_MIN_CANDIDATES)
+		{
+			ulLimit = TRIGRAM_MIN_CANDIDATES;
+		}
+		ulLevel = ulBucketCount + 1;
+		while(ulLevel > ulThreshold &&
+			  ulTaken + pulLevels[ulLevel - 1] <= ulLimit)
+		{
+			ulLevel--;
+			ulTaken += pulLevels[ulLevel];
+		}
+		ulPartial = (ulLevel > ulThreshold) ? ulLimit - ulTaken : 0;
+	}
+
+	for(ulSlot = 0; ulSlot < pstHeader->ulRecordCount && blReturn == true &&
+		ulBucketCount > 0; ulSlot++)
+	{
+		if((uint32)pucShared[ulSlot] + 1 == ulLevel && ulPartial > 0)
+		{
+			ulPartial--;
+			pucShared[ulSlot] = ulLevel;
+		}
+
+		if(pucShared[ulSlot] >= ulLevel)
+		{
+			blReturn = (pread(lDataFd, &DeviceData, sizeof(DEVICE_DETAILS),
+							  ulSlot * sizeof(DEVICE_DETAILS)) ==
+						sizeof(DEVICE_DETAILS));
+			ulDistance = trigramDistance(pucName, DeviceData.pucDeviceName);
+			if(blReturn == true && ulDistance <= ulMaxDistance)
+			{
+				trigramKeep(pstMatches, ulCount, pulFound, &DeviceData,
+							ulDistance);
+			}
+		}
+	}
+	free(pucShared);
+
+	return blReturn;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the devices whose names are closest to a name
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pucName, the searched name
+//Inputs	: ulCount, number of devices wanted, up to TRIGRAM_MAX_MATCHES
+//Outputs	: pstMatches, the devices by increasing edit distance
+//Outputs	: pulFound, number of devices found
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Searches a snapshot, shard after shard
+//******************************************************************************
+bool trigramSearch(const uint8 *pucFileName, const uint8 *pucName,
+				   uint32 ulCount, TRIGRAM_MATCH *pstMatches,
+				   uint32 *pulFound)
+{
+	bool blReturn = false;
+	SNAPSHOT stSnapshot;
+	SHARD_LAYOUT stLayout = {0};
+	TRIGRAM_HEADER stHeader = {0};
+	FILE *pstData = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+	int32 lFd = -1;
+
+	if(pucFileName != NULL && pucName != NULL && pstMatches != NULL &&
+	   pulFound != NULL && ulCount > 0 && ulCount <= TRIGRAM_MAX_MATCHES)
+	{
+		*pulFound = 0;
+		if(shardAcquireSnapshot(pucFileName, &stSnapshot, &stLayout) == true)
+		{
+			blReturn = true;
+			for(ulShard = 0; ulShard < stSnapshot.ulFileCount &&
+				blReturn == true; ulShard++)
+			{
+				pstData = stSnapshot.pstFiles[ulShard];
+				blReturn = (shardGetPath(pucFileName, &stLayout, ulShard,
+										 pucPath) == true &&
+							trigramOpen(pucPath, pstData, &lFd,
+										&stHeader) == true);
+				if(blReturn == true)
+				{
+					blReturn = trigramSearchFile(lFd, &stHeader,
+												 fileno(pstData), pucName,
+												 ulCount, pstMatches,
+												 pulFound);
+					close(lFd);
+				}
+			}
+			snapshotRelease(&stSnapshot);
+		}
+
+		if(blReturn != true)
+		{
+			printf("\nUnable to search the closest names");
+		}
+	}
+	else
+	{
+		printf("\nUnable to search the closest names : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compute the edit distance between two names
+//Inputs	: pucPattern and pucText, the names
+//Outputs	: None
+//Return	: The number of insertions, deletions and substitutions turning
+//			  one name into the other
+//Notes		: Myers' bit-parallel algorithm, one column of the distance
+//			  matrix per text character. Names are shorter than the 64 bits
+//			  of a column.
+//******************************************************************************
+uint32 trigramDistance(const uint8 *pucPattern, const uint8 *pucText)
+{
+	unsigned long long pullPeq[TRIGRAM_ALPHABET_SIZE] = {0};
+	unsigned long long ullPv = 0;
+	unsigned long long ullMv = 0;
+	unsigned long long ullPh = 0;
+	unsigned long long ullMh = 0;
+	unsigned long long ullXv = 0;
+	unsigned long long ullXh = 0;
+	unsigned long long ullEq = 0;
+	unsigned long long ullLast = 0;
+	uint32 ulPatternLength = strnlen((const char *)pucPattern, STR_MAX_SIZE);
+	uint32 ulTextLength = strnlen((const char *)pucText, STR_MAX_SIZE);
+	uint32 ulScore = ulPatternLength;
+	uint32 ulIndex = 0;
+
+	if(ulPatternLength == 0)
+	{
+		return ulTextLength;
+	}
+
+	for(ulIndex = 0; ulIndex < ulPatternLength; ulIndex++)
+	{
+		pullPeq[pucPattern[ulIndex]] |= 1ULL << ulIndex;
+	}
+	ullPv = (1ULL << ulPatternLength) - 1;
+	ullLast = 1ULL << (ulPatternLength - 1);
+
+	for(ulIndex = 0; ulIndex < ulTextLength; ulIndex++)
+	{
+		ullEq = pullPeq[pucText[ulIndex]];
+		ullXv = ullEq | ullMv;
+		ullXh = (((ullEq & ullPv) + ullPv) ^ ullPv) | ullEq;
+		ullPh = ullMv | ~(ullXh | ullPv);
+		ullMh = ullPv & ullXh;
+		if(ullPh & ullLast)
+		{
+			ulScore++;
+		}
+		else if(ullMh & ullLast)
+		{
+			ulScore--;
+		}
+
+		// The first row of the matrix grows by one per text character
+		ullPh = (ullPh << 1) | 1;
+		ullMh <<= 1;
+		ullPv = ullMh | ~(ullXv | ullPh);
+		ullMv = ullPh & ullXv;
+	}
+
+	return ulScore;
+}
+// EOF
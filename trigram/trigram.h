@@ -0,0 +1,54 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Approximate device name search
+// Note		: A persisted trigram index of the names gives the candidates,
+//			  their edit distance to the searched name ranks them
+//
+//******************************************************************************
+
+#ifndef _TRIGRAM_H_
+#define _TRIGRAM_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+
+//******************************* Global Types *********************************
+// Followed by ulBucketCount + 1 posting offsets and ulPostingCount slots
+typedef struct _TRIGRAM_HEADER_
+{
+	uint32 ulMagic;
+	FILE_IDENTITY stData;
+	uint32 ulRecordCount;
+	uint32 ulBucketCount;
+	uint32 ulPostingCount;
+} TRIGRAM_HEADER;
+
+typedef struct _TRIGRAM_MATCH_
+{
+	DEVICE_DETAILS stDevice;
+	uint32 ulDistance;
+} TRIGRAM_MATCH;
+
+//***************************** Global Constants *******************************
+#define TRIGRAM_SUFFIX			(".tri")
+#define TRIGRAM_MAGIC			(0x49525444UL)
+#define TRIGRAM_DEFAULT_MATCHES	(5)
+#define TRIGRAM_MAX_MATCHES		(64)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool trigramSearch(const uint8 *pucFileName, const uint8 *pucName,
+				   uint32 ulCount, TRIGRAM_MATCH *pstMatches,
+				   uint32 *pulFound);
+uint32 trigramDistance(const uint8 *pucPattern, const uint8 *pucText);
+
+#endif // _TRIGRAM_H_
+// EOF
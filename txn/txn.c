@@ -0,0 +1,697 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: txn.c
+// Summary	: Atomic transactions of additions, removals and updates
+// Note		: The operations are replayed in order on the devices they name,
+//			  read through the serial indexes, so that a serial in use or a
+//			  missing device fails the whole transaction before anything is
+//			  written. Each shard changed is then rewritten once to
+//			  "<shard>.txn" and "<data file>.journal" lists them before they
+//			  are renamed into place in one generation. A journal left by an
+//			  interruption is rolled forward by the next writer, unless
+//			  another generation was published since.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "crc.h"
+#include "hash.h"
+#include "index.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "stats.h"
+#include "feed.h"
+#include "history.h"
+#include "txn.h"
+
+//******************************* Local Types **********************************
+// A device named by the transaction, before it and after it
+typedef struct _TXN_STATE_
+{
+	DEVICE_DETAILS stBefore;
+	DEVICE_DETAILS stAfter;
+	uint32 ulSerial;
+	bool blBefore;
+	bool blAfter;
+} TXN_STATE;
+
+//***************************** Local Constants ********************************
+#define WRITE_COUNT				(1)
+#define READ_COUNT				(1)
+#define TXN_BATCH_RECORDS		(1024)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To check whether a transaction changes a device
+//Inputs	: pstState, the device
+//Outputs	: None
+//Return	: True, when the device is added, removed or has new details
+//Return	: False, otherwise
+//Notes		:
+//******************************************************************************
+static bool txnChanged(const TXN_STATE *pstState)
+{
+	return (pstState->blBefore != pstState->blAfter ||
+			(pstState->blAfter == true &&
+			 memcmp(&pstState->stBefore, &pstState->stAfter,
+					sizeof(DEVICE_DETAILS)) != 0));
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write a file to the disk before it is published
+//Inputs	: pstFile, the file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool txnSync(FILE *pstFile)
+{
+	return (fflush(pstFile) == 0 && fsync(fileno(pstFile)) == 0);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the devices of a transaction as they are in the data
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstLayout, the shard layout
+//Inputs	: pstStates and ulStateCount, the devices
+//Outputs	: pstStates, the devices found, with their details
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Only the records of the named serials are read
+//******************************************************************************
+static bool txnLoad(const uint8 *pucFileName, const SHARD_LAYOUT *pstLayout,
+					TXN_STATE *pstStates, uint32 ulStateCount)
+{
+	bool blReturn = true;
+	INDEX stIndex = {INDEX_INVALID_FD, {0}};
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+	uint32 ulIndex = 0;
+	uint32 ulSlot = 0;
+	int32 lFd = -1;
+
+	for(ulShard = 0; ulShard < pstLayout->ulShardCount && blReturn == true;
+		ulShard++)
+	{
+		blReturn = shardGetPath(pucFileName, pstLayout, ulShard, pucPath);
+		if(blReturn != true || fileExists(pucPath) != true)
+		{
+			continue;
+		}
+
+		lFd = open((char *)pucPath, O_RDONLY);
+		blReturn = (lFd >= 0 && indexOpen(pucPath, &stIndex) == true);
+		for(ulIndex = 0; ulIndex < ulStateCount && blReturn == true;
+			ulIndex++)
+		{
+			if(shardRoute(pstStates[ulIndex].ulSerial,
+						  pstLayout->ulShardCount) == ulShard &&
+			   indexFind(&stIndex, pstStates[ulIndex].ulSerial,
+						 &ulSlot) == true)
+			{
+				blReturn = (pread(lFd, &pstStates[ulIndex].stBefore,
+								  sizeof(DEVICE_DETAILS),
+								  (off_t)ulSlot * sizeof(DEVICE_DETAILS)) ==
+							sizeof(DEVICE_DETAILS));
+				pstStates[ulIndex].blBefore = true;
+			}
+		}
+		indexClose(&stIndex);
+		if(lFd >= 0)
+		{
+			close(lFd);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To replay the operations on the devices they name
+//Inputs	: pstOperations and ulCount, the operations
+//Inputs	: pstSerials, the state of each serial
+//Inputs	: pstStates, the devices
+//Outputs	: pstStates, the devices after the transaction
+//Outputs	: pstReport, the operations by kind, or the failed one
+//Return	: True, when every operation applies
+//Return	: False, otherwise
+//Notes		:
+//******************************************************************************
+static bool txnReplay(const TXN_OPERATION *pstOperations, uint32 ulCount,
+					  const HASH_TABLE *pstSerials, TXN_STATE *pstStates,
+					  TXN_REPORT *pstReport)
+{
+	bool blReturn = true;
+	TXN_STATE *pstState = NULL;
+	uint32 ulIndex = 0;
+
+	for(ulIndex = 0; ulIndex < ulCount && blReturn == true; ulIndex++)
+	{
+		pstState = &pstStates[*hashLookup(pstSerials,
+								pstOperations[ulIndex].stUpdate.stValues.
+								ulDeviceSerial)];
+		if(pstOperations[ulIndex].ulOperation == TXN_ADD &&
+		   pstState->blAfter != true)
+		{
+			memset(&pstState->stAfter, 0, sizeof(DEVICE_DETAILS));
+			pstState->stAfter.ulDeviceSerial = pstState->ulSerial;
+			deviceApplyUpdate(&pstOperations[ulIndex].stUpdate,
+							  &pstState->stAfter);
+			pstState->blAfter = true;
+			pstReport->ulAddedCount++;
+		}
+		else if(pstOperations[ulIndex].ulOperation == TXN_REMOVE &&
+				pstState->blAfter == true)
+		{
+			pstState->blAfter = false;
+			pstReport->ulRemovedCount++;
+		}
+		else if(pstOperations[ulIndex].ulOperation == TXN_UPDATE &&
+				pstState->blAfter == true)
+		{
+			deviceApplyUpdate(&pstOperations[ulIndex].stUpdate,
+							  &pstState->stAfter);
+			pstReport->ulUpdatedCount++;
+		}
+		else
+		{
+			pstReport->ulFailed = ulIndex;
+			printf("\nUnable to commit the transaction : Operation %lu, "
+				   "serial %lu %s\n", ulIndex + 1, pstState->ulSerial,
+				   pstState->blAfter == true ? "already in use" :
+				   "not found");
+			blReturn = false;
+		}
+	}
+
+	for(ulIndex = 0; ulIndex < pstSerials->ulCount && blReturn == true;
+		ulIndex++)
+	{
+		if(pstStates[ulIndex].blAfter == true)
+		{
+			deviceSealRecord(&pstStates[ulIndex].stAfter);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To write the new version of a shard
+//Inputs	: pucPath, name of the shard
+//Inputs	: ulShard and pstLayout, the shard and the layout
+//Inputs	: pstSerials and pstStates, the devices of the transaction
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Written to "<shard>.txn", the devices added are appended
+//******************************************************************************
+static bool txnRewrite(const uint8 *pucPath, uint32 ulShard,
+					   const SHARD_LAYOUT *pstLayout,
+					   const HASH_TABLE *pstSerials,
+					   const TXN_STATE *pstStates)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	FILE *pstTemporaryFile = NULL;
+	DEVICE_DETAILS *pstRecords = NULL;
+	const TXN_STATE *pstState = NULL;
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 *pulState = NULL;
+	uint32 ulRead = 0;
+	uint32 ulIndex = 0;
+
+	pstRecords = malloc(TXN_BATCH_RECORDS * sizeof(DEVICE_DETAILS));
+	if(pstRecords != NULL &&
+	   fileBuildPath(pucTemporaryPath, pucPath, TXN_TEMPORARY_SUFFIX) == true)
+	{
+		pstTemporaryFile = fopen((char *)pucTemporaryPath, FILE_WRITE_MODE);
+		pstFile = fopen((char *)pucPath, FILE_READ_MODE);
+		blReturn = (pstTemporaryFile != NULL);
+	}
+
+	ulRead = (pstFile != NULL) ? TXN_BATCH_RECORDS : 0;
+	while(blReturn == true && ulRead == TXN_BATCH_RECORDS)
+	{
+		ulRead = fread(pstRecords, sizeof(DEVICE_DETAILS), TXN_BATCH_RECORDS,
+					   pstFile);
+		for(ulIndex = 0; ulIndex < ulRead && blReturn == true; ulIndex++)
+		{
+			pulState = hashLookup(pstSerials,
+								  pstRecords[ulIndex].ulDeviceSerial);
+			if(pulState == NULL)
+			{
+				blReturn = (fwrite(&pstRecords[ulIndex],
+								   sizeof(DEVICE_DETAILS), WRITE_COUNT,
+								   pstTemporaryFile) == WRITE_COUNT);
+			}
+			else if(pstStates[*pulState].blAfter == true)
+			{
+				blReturn = (fwrite(&pstStates[*pulState].stAfter,
+								   sizeof(DEVICE_DETAILS), WRITE_COUNT,
+								   pstTemporaryFile) == WRITE_COUNT);
+			}
+		}
+	}
+
+	for(ulIndex = 0; ulIndex < pstSerials->ulCount && blReturn == true;
+		ulIndex++)
+	{
+		pstState = &pstStates[ulIndex];
+		if(pstState->blBefore != true && pstState->blAfter == true &&
+		   shardRoute(pstState->ulSerial, pstLayout->ulShardCount) == ulShard)
+		{
+			blReturn = (fwrite(&pstState->stAfter, sizeof(DEVICE_DETAILS),
+							   WRITE_COUNT, pstTemporaryFile) == WRITE_COUNT);
+		}
+	}
+
+	if(pstFile != NULL)
+	{
+		blReturn = (ferror(pstFile) == 0 && blReturn == true);
+		fclose(pstFile);
+	}
+	if(pstTemporaryFile != NULL)
+	{
+		blReturn = (txnSync(pstTemporaryFile) == true && blReturn == true);
+		blReturn = (fclose(pstTemporaryFile) == 0 && blReturn == true);
+	}
+	free(pstRecords);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To remove the new versions of the shards of a journal
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstJournal, the journal
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void txnDiscard(const uint8 *pucFileName,
+					   const TXN_JOURNAL *pstJournal)
+{
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+
+	for(ulShard = 0; ulShard < pstJournal->stLayout.ulShardCount; ulShard++)
+	{
+		if(pstJournal->pblRewritten[ulShard] == true &&
+		   shardGetPath(pucFileName, &pstJournal->stLayout, ulShard,
+						pucPath) == true &&
+		   fileBuildPath(pucTemporaryPath, pucPath,
+						 TXN_TEMPORARY_SUFFIX) == true)
+		{
+			remove((char *)pucTemporaryPath);
+		}
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To publish the new versions of the shards of a journal
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstWriter, the writer state
+//Inputs	: pstJournal, the journal
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Versions already renamed by an interrupted commit are skipped.
+//			  The journal is removed once all of them are in place.
+//******************************************************************************
+static bool txnPublish(const uint8 *pucFileName, SNAPSHOT_WRITER *pstWriter,
+					   const TXN_JOURNAL *pstJournal)
+{
+	bool blReturn = false;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+
+	blReturn = snapshotCommitBegin(pstWriter);
+	for(ulShard = 0; ulShard < pstJournal->stLayout.ulShardCount &&
+		blReturn == true; ulShard++)
+	{
+		if(pstJournal->pblRewritten[ulShard] == true)
+		{
+			blReturn = (shardGetPath(pucFileName, &pstJournal->stLayout,
+									 ulShard, pucPath) == true &&
+						fileBuildPath(pucTemporaryPath, pucPath,
+									  TXN_TEMPORARY_SUFFIX) == true);
+			if(blReturn == true && fileExists(pucTemporaryPath) == true)
+			{
+				blReturn = (rename((char *)pucTemporaryPath,
+								   (char *)pucPath) == 0);
+			}
+		}
+	}
+	if(snapshotCommitEnd(pstWriter) != true)
+	{
+		blReturn = false;
+	}
+
+	if(blReturn == true &&
+	   fileBuildPath(pucPath, pucFileName, TXN_JOURNAL_SUFFIX) == true)
+	{
+		remove((char *)pucPath);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To finish or to drop a transaction left by an interruption
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstWriter, the writer state
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A whole journal of the current generation is rolled forward,
+//			  any other one only tells which files to remove
+//******************************************************************************
+static bool txnRecoverLocked(const uint8 *pucFileName,
+							 SNAPSHOT_WRITER *pstWriter)
+{
+	bool blReturn = true;
+	bool blWhole = false;
+	FILE *pstFile = NULL;
+	TXN_JOURNAL stJournal;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(fileBuildPath(pucPath, pucFileName, TXN_JOURNAL_SUFFIX) != true)
+	{
+		return false;
+	}
+
+	pstFile = fopen((char *)pucPath, FILE_READ_MODE);
+	if(pstFile != NULL)
+	{
+		blWhole = (fread(&stJournal, sizeof(TXN_JOURNAL), READ_COUNT,
+						 pstFile) == READ_COUNT &&
+				   stJournal.ulMagic == TXN_MAGIC &&
+				   stJournal.ulChecksum ==
+				   crc32c(CRC_INITIAL, &stJournal,
+						  offsetof(TXN_JOURNAL, ulChecksum)) &&
+				   stJournal.stLayout.ulShardCount <= SHARD_MAX_COUNT);
+		fclose(pstFile);
+
+		if(blWhole == true &&
+		   stJournal.ulGeneration == pstWriter->ulGeneration)
+		{
+			blReturn = txnPublish(pucFileName, pstWriter, &stJournal);
+			printf(blReturn == true ? "Committed an interrupted transaction\n"
+				   : "\nUnable to commit an interrupted transaction\n");
+		}
+		else
+		{
+			if(blWhole == true)
+			{
+				txnDiscard(pucFileName, &stJournal);
+			}
+			remove((char *)pucPath);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To log the changes of a committed transaction
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulFromGeneration and ulToGeneration, the generations
+//Inputs	: pstStates and ulStateCount, the devices
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Removals, updates and additions are fed and logged apart,
+//			  each device once with its final details
+//******************************************************************************
+static bool txnLog(const uint8 *pucFileName, uint32 ulFromGeneration,
+				   uint32 ulToGeneration, const TXN_STATE *pstStates,
+				   uint32 ulStateCount)
+{
+	DEVICE_DETAILS *pstOld = NULL;
+	DEVICE_DETAILS *pstNew = NULL;
+	uint32 ulRemoved = 0;
+	uint32 ulUpdated = 0;
+	uint32 ulAdded = 0;
+	uint32 ulIndex = 0;
+
+	// Old versions are the removed devices then the updated ones, new
+	// versions the updated devices then the added ones
+	pstOld = malloc((ulStateCount + 1) * sizeof(DEVICE_DETAILS));
+	pstNew = malloc((ulStateCount + 1) * sizeof(DEVICE_DETAILS));
+	if(pstOld == NULL || pstNew == NULL)
+	{
+		free(pstOld);
+		free(pstNew);
+		return false;
+	}
+
+	for(ulIndex = 0; ulIndex < ulStateCount; ulIndex++)
+	{
+		if(pstStates[ulIndex].blBefore == true &&
+		   pstStates[ulIndex].blAfter != true)
+		{
+			pstOld[ulRemoved++] = pstStates[ulIndex].stBefore;
+		}
+	}
+	for(ulIndex = 0; ulIndex < ulStateCount; ulIndex++)
+	{
+		if(pstStates[ulIndex].blBefore == true &&
+		   pstStates[ulIndex].blAfter == true &&
+		   txnChanged(&pstStates[ulIndex]) == true)
+		{
+			pstOld[ulRemoved + ulUpdated] = pstStates[ulIndex].stBefore;
+			pstNew[ulUpdated++] = pstStates[ulIndex].stAfter;
+		}
+	}
+	for(ulIndex = 0; ulIndex < ulStateCount; ulIndex++)
+	{
+		if(pstStates[ulIndex].blBefore != true &&
+		   pstStates[ulIndex].blAfter == true)
+		{
+			pstNew[ulUpdated + ulAdded++] = pstStates[ulIndex].stAfter;
+		}
+	}
+
+	statsUpdate(pucFileName, ulFromGeneration, ulToGeneration, pstOld,
+				ulRemoved + ulUpdated, pstNew, ulUpdated + ulAdded);
+	if(ulRemoved > 0)
+	{
+		feedAppend(pucFileName, FEED_REMOVE, pstOld, ulRemoved);
+		historyAppend(pucFileName, pstOld, NULL, ulRemoved);
+	}
+	if(ulUpdated > 0)
+	{
+		feedAppend(pucFileName, FEED_UPDATE, pstNew, ulUpdated);
+		historyAppend(pucFileName, pstOld + ulRemoved, pstNew, ulUpdated);
+	}
+	if(ulAdded > 0)
+	{
+		feedAppend(pucFileName, FEED_ADD, pstNew + ulUpdated, ulAdded);
+		historyAppend(pucFileName, NULL, pstNew + ulUpdated, ulAdded);
+	}
+	free(pstOld);
+	free(pstNew);
+
+	return true;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To apply a transaction to the device data
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pstOperations and ulCount, the operations, in order
+//Outputs	: pstReport, the operations by kind and the shards rewritten,
+//			  or the index of the operation failing the transaction
+//Return	: True, when the transaction is committed
+//Return	: False, when nothing was changed
+//Notes		: An addition needs its serial free, a removal or an update
+//			  its device present, after the operations before it. Readers
+//			  see all the changes or none of them.
+//******************************************************************************
+bool txnCommit(const uint8 *pucFileName, const TXN_OPERATION *pstOperations,
+			   uint32 ulCount, TXN_REPORT *pstReport)
+{
+	bool blReturn = false;
+	bool blJournal = false;
+	FILE *pstFile = NULL;
+	HASH_TABLE stSerials = {0};
+	TXN_STATE *pstStates = NULL;
+	TXN_JOURNAL stJournal;
+	SNAPSHOT_WRITER stWriter;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulSerial = 0;
+	uint32 ulIndex = 0;
+	uint32 ulShard = 0;
+
+	if(pucFileName == NULL || (pstOperations == NULL && ulCount > 0) ||
+	   pstReport == NULL)
+	{
+		printf("\nUnable to commit the transaction : Invalid parameters");
+		return false;
+	}
+
+	memset(pstReport, 0, sizeof(TXN_REPORT));
+	memset(&stJournal, 0, sizeof(TXN_JOURNAL));
+	pstStates = calloc(ulCount + 1, sizeof(TXN_STATE));
+	if(pstStates == NULL || hashCreate(&stSerials, ulCount) != true)
+	{
+		printf("\nUnable to commit the transaction : Out of memory");
+		free(pstStates);
+		return false;
+	}
+
+	if(snapshotWriterBegin(pucFileName, &stWriter) == true)
+	{
+		blReturn = (txnRecoverLocked(pucFileName, &stWriter) == true &&
+					shardGetLayout(pucFileName, &stJournal.stLayout) == true);
+		for(ulIndex = 0; ulIndex < ulCount && blReturn == true; ulIndex++)
+		{
+			ulSerial = pstOperations[ulIndex].stUpdate.stValues.ulDeviceSerial;
+			if(hashLookup(&stSerials, ulSerial) == NULL)
+			{
+				pstStates[stSerials.ulCount].ulSerial = ulSerial;
+				blReturn = hashInsert(&stSerials, ulSerial,
+									  stSerials.ulCount);
+			}
+		}
+
+		blReturn = (blReturn == true &&
+					txnLoad(pucFileName, &stJournal.stLayout, pstStates,
+							stSerials.ulCount) == true);
+		for(ulIndex = 0; ulIndex < stSerials.ulCount && blReturn == true;
+			ulIndex++)
+		{
+			pstStates[ulIndex].blAfter = pstStates[ulIndex].blBefore;
+			pstStates[ulIndex].stAfter = pstStates[ulIndex].stBefore;
+		}
+		blReturn = (blReturn == true &&
+					txnReplay(pstOperations, ulCount, &stSerials, pstStates,
+							  pstReport) == true);
+
+		for(ulIndex = 0; ulIndex < stSerials.ulCount && blReturn == true;
+			ulIndex++)
+		{
+			if(txnChanged(&pstStates[ulIndex]) == true)
+			{
+				stJournal.pblRewritten[shardRoute(pstStates[ulIndex].ulSerial,
+										stJournal.stLayout.ulShardCount)] =
+					true;
+			}
+		}
+		for(ulShard = 0; ulShard < stJournal.stLayout.ulShardCount &&
+			blReturn == true; ulShard++)
+		{
+			if(stJournal.pblRewritten[ulShard] == true)
+			{
+				blReturn = (shardGetPath(pucFileName, &stJournal.stLayout,
+										 ulShard, pucPath) == true &&
+							txnRewrite(pucPath, ulShard, &stJournal.stLayout,
+									   &stSerials, pstStates) == true);
+				pstReport->ulShardCount++;
+			}
+		}
+
+		// The transaction commits once its journal is on the disk
+		if(blReturn == true && pstReport->ulShardCount > 0)
+		{
+			stJournal.ulMagic = TXN_MAGIC;
+			stJournal.ulGeneration = stWriter.ulGeneration;
+			stJournal.ulChecksum = crc32c(CRC_INITIAL, &stJournal,
+										  offsetof(TXN_JOURNAL, ulChecksum));
+			blReturn = fileBuildPath(pucPath, pucFileName, TXN_JOURNAL_SUFFIX);
+			if(blReturn == true)
+			{
+				pstFile = fopen((char *)pucPath, FILE_WRITE_MODE);
+				blReturn = (pstFile != NULL &&
+							fwrite(&stJournal, sizeof(TXN_JOURNAL), WRITE_COUNT,
+								   pstFile) == WRITE_COUNT &&
+							txnSync(pstFile) == true);
+			}
+			if(pstFile != NULL)
+			{
+				blReturn = (fclose(pstFile) == 0 && blReturn == true);
+			}
+			blJournal = blReturn;
+			blReturn = (blReturn == true &&
+						txnPublish(pucFileName, &stWriter, &stJournal) == true);
+		}
+
+		if(blJournal == true && blReturn == true)
+		{
+			txnLog(pucFileName, stJournal.ulGeneration, stWriter.ulGeneration,
+				   pstStates, stSerials.ulCount);
+		}
+		else if(blJournal != true)
+		{
+			txnDiscard(pucFileName, &stJournal);
+			if(pstFile != NULL)
+			{
+				remove((char *)pucPath);
+			}
+		}
+		snapshotWriterEnd(&stWriter);
+	}
+
+	hashDestroy(&stSerials);
+	free(pstStates);
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To finish or to drop a transaction left by an interruption
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Called before the data is used, the next transaction does it
+//			  as well
+//******************************************************************************
+bool txnRecover(const uint8 *pucFileName)
+{
+	bool blReturn = true;
+	SNAPSHOT_WRITER stWriter;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(pucFileName == NULL ||
+	   fileBuildPath(pucPath, pucFileName, TXN_JOURNAL_SUFFIX) != true)
+	{
+		return false;
+	}
+
+	if(fileExists(pucPath) == true)
+	{
+		blReturn = (snapshotWriterBegin(pucFileName, &stWriter) == true &&
+					txnRecoverLocked(pucFileName, &stWriter) == true);
+		snapshotWriterEnd(&stWriter);
+	}
+
+	return blReturn;
+}
+// EOF
@@ -0,0 +1,67 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Atomic transactions of additions, removals and updates
+// Note		: A transaction is checked as a whole against the data, then
+//			  each shard it changes is rewritten once and the new shards are
+//			  published together through a journal
+//
+//******************************************************************************
+
+#ifndef _TXN_H_
+#define _TXN_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "shard.h"
+
+//******************************* Global Types *********************************
+// An addition carries the whole device, a removal only the serial
+typedef struct _TXN_OPERATION_
+{
+	uint32 ulOperation;
+	DEVICE_UPDATE stUpdate;
+} TXN_OPERATION;
+
+typedef struct _TXN_REPORT_
+{
+	uint32 ulAddedCount;
+	uint32 ulRemovedCount;
+	uint32 ulUpdatedCount;
+	uint32 ulShardCount;
+	uint32 ulFailed;
+} TXN_REPORT;
+
+// Shards rewritten by a transaction, renamed into place when it commits
+typedef struct _TXN_JOURNAL_
+{
+	uint32 ulMagic;
+	uint32 ulGeneration;
+	SHARD_LAYOUT stLayout;
+	bool pblRewritten[SHARD_MAX_COUNT];
+	uint32 ulChecksum;
+} TXN_JOURNAL;
+
+//***************************** Global Constants *******************************
+#define TXN_JOURNAL_SUFFIX		(".journal")
+#define TXN_TEMPORARY_SUFFIX	(".txn")
+#define TXN_MAGIC				(0x4E584354UL)
+
+#define TXN_ADD					(1)
+#define TXN_REMOVE				(2)
+#define TXN_UPDATE				(3)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool txnCommit(const uint8 *pucFileName, const TXN_OPERATION *pstOperations,
+			   uint32 ulCount, TXN_REPORT *pstReport);
+bool txnRecover(const uint8 *pucFileName);
+
+#endif // _TXN_H_
+// EOF
@@ -0,0 +1,593 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: verify.c
+// Summary	: Checksum verification and salvage of device data files
+// Note		: The records of a file are split into one contiguous slice per
+//			  processor and each slice is checked by a pool task with
+//			  large sequential reads. A corrupted range is a run of records
+//			  failing their checksum, or a trailing partial record. Salvage
+//			  copies the intact slices as they are and scans the corrupted
+//			  ranges byte by byte for records shifted by a torn write.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "crc.h"
+#include "shard.h"
+#include "pool.h"
+#include "snapshot.h"
+#include "verify.h"
+
+//******************************* Local Types **********************************
+typedef struct _VERIFY_TASK_
+{
+	int32 lFd;
+	uint32 ulFirst;
+	uint32 ulLast;
+	VERIFY_REPORT stReport;
+	bool blStatus;
+} VERIFY_TASK;
+
+//***************************** Local Constants ********************************
+#define WRITE_COUNT					(1)
+#define VERIFY_BLOCK_RECORDS		(8192)
+#define VERIFY_MIN_SLICE_RECORDS	(65536)
+#define VERIFY_MIN_RANGES			(16)
+#define VERIFY_SCAN_SIZE			(1048576)
+#define VERIFY_NANOSECONDS			(1e9)
+#define MEGABYTE					(1048576.0)
+
+//***************************** Local Variables ********************************
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To add a corrupted byte range to a report
+//Inputs	: pstReport, the report
+//Inputs	: ulStart and ulEnd, the byte range
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A range following the last one directly is merged into it
+//******************************************************************************
+static bool verifyAddRange(VERIFY_REPORT *pstReport, uint32 ulStart,
+						   uint32 ulEnd)
+{
+	bool blReturn = true;
+	VERIFY_RANGE *pstRanges = NULL;
+	uint32 ulCapacity = 0;
+
+	if(pstReport->ulRangeCount > 0 &&
+	   pstReport->pstRanges[pstReport->ulRangeCount - 1].ulEnd == ulStart)
+	{
+		pstReport->pstRanges[pstReport->ulRangeCount - 1].ulEnd = ulEnd;
+		return true;
+	}
+
+	if(pstReport->ulRangeCount == pstReport->ulRangeCapacity)
+	{
+		ulCapacity = pstReport->ulRangeCapacity * 2;
+		if(ulCapacity < VERIFY_MIN_RANGES)
+		{
+			ulCapacity = VERIFY_MIN_RANGES;
+		}
+		pstRanges = realloc(pstReport->pstRanges,
+							ulCapacity * sizeof(VERIFY_RANGE));
+		if(pstRanges != NULL)
+		{
+			pstReport->pstRanges = pstRanges;
+			pstReport->ulRangeCapacity = ulCapacity;
+		}
+		else
+		{
+			printf("\nUnable to store the corrupted range : Out of memory");
+			blReturn = false;
+		}
+	}
+
+	if(blReturn == true)
+	{
+		pstReport->pstRanges[pstReport->ulRangeCount].ulStart = ulStart;
+		pstReport->pstRanges[pstReport->ulRangeCount].ulEnd = ulEnd;
+		pstReport->ulRangeCount++;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To check the records of one slice of a file
+//Inputs	: pvTask, VERIFY_TASK with the file and the slice
+//Outputs	: stReport of the task holds the corrupted ranges of the slice
+//Return	: NULL
+//Notes		: Runs as a pool task
+//******************************************************************************
+static void *verifySlice(void *pvTask)
+{
+	VERIFY_TASK *pstTask = pvTask;
+	DEVICE_DETAILS *pstBlock = NULL;
+	uint32 ulSlot = pstTask->ulFirst;
+	uint32 ulCount = 0;
+	uint32 ulIndex = 0;
+	uint32 ulBadStart = 0;
+	bool blInRange = false;
+	ssize_t lRead = 0;
+
+	memset(&pstTask->stReport, 0, sizeof(VERIFY_REPORT));
+	pstBlock = malloc(VERIFY_BLOCK_RECORDS * sizeof(DEVICE_DETAILS));
+	pstTask->blStatus = (pstBlock != NULL);
+
+	while(pstTask->blStatus == true && ulSlot < pstTask->ulLast)
+	{
+		ulCount = pstTask->ulLast - ulSlot;
+		if(ulCount > VERIFY_BLOCK_RECORDS)
+		{
+			ulCount = VERIFY_BLOCK_RECORDS;
+		}
+		lRead = pread(pstTask->lFd, pstBlock, ulCount * sizeof(DEVICE_DETAILS),
+					  (off_t)ulSlot * sizeof(DEVICE_DETAILS));
+		pstTask->blStatus = (lRead == (ssize_t)(ulCount *
+												sizeof(DEVICE_DETAILS)));
+
+		for(ulIndex = 0; ulIndex < ulCount && pstTask->blStatus == true;
+			ulIndex++)
+		{
+			if(deviceCheckRecord(&pstBlock[ulIndex]) != true)
+			{
+				pstTask->stReport.ulCorruptCount++;
+				if(blInRange != true)
+				{
+					ulBadStart = ulSlot + ulIndex;
+					blInRange = true;
+				}
+			}
+			else if(blInRange == true)
+			{
+				pstTask->blStatus = verifyAddRange(&pstTask->stReport,
+								ulBadStart * sizeof(DEVICE_DETAILS),
+								(ulSlot + ulIndex) * sizeof(DEVICE_DETAILS));
+				blInRange = false;
+			}
+		}
+		ulSlot += ulCount;
+	}
+
+	if(pstTask->blStatus == true && blInRange == true)
+	{
+		pstTask->blStatus = verifyAddRange(&pstTask->stReport,
+										   ulBadStart * sizeof(DEVICE_DETAILS),
+										   ulSlot * sizeof(DEVICE_DETAILS));
+	}
+	free(pstBlock);
+
+	return NULL;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To copy a byte range known to hold intact records
+//Inputs	: lFd, the data file
+//Inputs	: ulStart and ulEnd, the byte range
+//Inputs	: pstOutput, the salvage file
+//Inputs	: pucBuffer, a VERIFY_SCAN_SIZE buffer
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+static bool verifyCopyRange(int32 lFd, uint32 ulStart, uint32 ulEnd,
+							FILE *pstOutput, uint8 *pucBuffer)
+{
+	bool blReturn = true;
+	uint32 ulSize = 0;
+
+	while(blReturn == true && ulStart < ulEnd)
+	{
+		ulSize = ulEnd - ulStart;
+		if(ulSize > VERIFY_SCAN_SIZE)
+		{
+			ulSize = VERIFY_SCAN_SIZE;
+		}
+		blReturn = (pread(lFd, pucBuffer, ulSize, ulStart) ==
+					(ssize_t)ulSize &&
+					fileWrite(pucBuffer, ulSize, WRITE_COUNT, pstOutput) ==
+					true);
+		ulStart += ulSize;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To recover the intact records of a corrupted byte range
+//Inputs	: lFd, the data file
+//Inputs	: ulStart and ulEnd, the corrupted byte range
+//Inputs	: pstOutput, the salvage file
+//Inputs	: pucBuffer, a VERIFY_SCAN_SIZE buffer
+//Outputs	: pulSalvaged, incremented for every recovered record
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Moves one record ahead after an intact record and one byte
+//			  ahead otherwise, so records shifted by a torn write are found
+//******************************************************************************
+static bool verifyScanRange(int32 lFd, uint32 ulStart, uint32 ulEnd,
+							FILE *pstOutput, uint8 *pucBuffer,
+							uint32 *pulSalvaged)
+{
+	bool blReturn = true;
+	DEVICE_DETAILS DeviceData = {0};
+	uint32 ulFill = 0;
+	uint32 ulPosition = 0;
+	uint32 ulSize = 0;
+
+	while(blReturn == true)
+	{
+		if(ulFill - ulPosition < sizeof(DeviceData))
+		{
+			memmove(pucBuffer, pucBuffer + ulPosition, ulFill - ulPosition);
+			ulFill -= ulPosition;
+			ulPosition = 0;
+			ulSize = ulEnd - ulStart;
+			if(ulSize > VERIFY_SCAN_SIZE - ulFill)
+			{
+				ulSize = VERIFY_SCAN_SIZE - ulFill;
+			}
+			blReturn = (pread(lFd, pucBuffer + ulFill, ulSize, ulStart) ==
+						(ssize_t)ulSize);
+			ulFill += ulSize;
+			ulStart += ulSize;
+			if(ulFill < sizeof(DeviceData))
+			{
+				break;
+			}
+		}
+
+		memcpy(&DeviceData, pucBuffer + ulPosition, sizeof(DeviceData));
+		if(blReturn == true && deviceCheckRecord(&DeviceData) == true)
+		{
+			blReturn = fileWrite(&DeviceData, sizeof(DeviceData), WRITE_COUNT,
+								 pstOutput);
+			(*pulSalvaged)++;
+			ulPosition += sizeof(DeviceData);
+		}
+		else
+		{
+			ulPosition++;
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the report of a file
+//Inputs	: pucPath, name of the file
+//Inputs	: pstReport, the report
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void verifyPrint(const uint8 *pucPath, const VERIFY_REPORT *pstReport)
+{
+	uint32 ulRange = 0;
+	const VERIFY_RANGE *pstRange = NULL;
+
+	printf("%s\t%lu record(s), %lu corrupted, %lu corrupted range(s)\n",
+		   (char *)pucPath, pstReport->ulRecordCount,
+		   pstReport->ulCorruptCount, pstReport->ulRangeCount);
+	for(ulRange = 0; ulRange < pstReport->ulRangeCount; ulRange++)
+	{
+		pstRange = &pstReport->pstRanges[ulRange];
+		printf("\tbytes %lu-%lu, records %lu-%lu%s\n", pstRange->ulStart,
+			   pstRange->ulEnd, pstRange->ulStart / sizeof(DEVICE_DETAILS),
+			   (pstRange->ulEnd - 1) / sizeof(DEVICE_DETAILS),
+			   pstRange->ulEnd % sizeof(DEVICE_DETAILS) != 0 ?
+			   " (partial record at the end)" : "");
+	}
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To find the corrupted ranges of a data file
+//Inputs	: pucPath, name of the data or shard file
+//Outputs	: pstReport, the corrupted ranges in file order, to be released
+//			  with verifyReportFree()
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: A missing file is reported as empty
+//******************************************************************************
+bool verifyFile(const uint8 *pucPath, VERIFY_REPORT *pstReport)
+{
+	bool blReturn = false;
+	VERIFY_TASK *pstTasks = NULL;
+	FILE_IDENTITY stIdentity = {0};
+	int32 lFd = -1;
+	uint32 ulTaskCount = 0;
+	uint32 ulSlice = 0;
+	uint32 ulTask = 0;
+	uint32 ulRange = 0;
+	long lProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if(pucPath != NULL && pstReport != NULL)
+	{
+		memset(pstReport, 0, sizeof(VERIFY_REPORT));
+		fileGetIdentity(pucPath, &stIdentity);
+		pstReport->ulSize = stIdentity.ulSize;
+		pstReport->ulRecordCount = stIdentity.ulSize / sizeof(DEVICE_DETAILS);
+		blReturn = true;
+		if(pstReport->ulSize > 0)
+		{
+			lFd = open((char *)pucPath, O_RDONLY);
+			pstTasks = calloc(VERIFY_MAX_THREADS, sizeof(VERIFY_TASK));
+			blReturn = (lFd >= 0 && pstTasks != NULL);
+		}
+
+		if(blReturn == true && pstReport->ulRecordCount > 0)
+		{
+			posix_fadvise(lFd, 0, 0, POSIX_FADV_SEQUENTIAL);
+			ulTaskCount = pstReport->ulRecordCount / VERIFY_MIN_SLICE_RECORDS +
+						  1;
+			if(lProcessors > 0 && ulTaskCount > (uint32)lProcessors)
+			{
+				ulTaskCount = lProcessors;
+			}
+			if(ulTaskCount > VERIFY_MAX_THREADS)
+			{
+				ulTaskCount = VERIFY_MAX_THREADS;
+			}
+			ulSlice = (pstReport->ulRecordCount + ulTaskCount - 1) /
+					  ulTaskCount;
+
+			for(ulTask = 0; ulTask < ulTaskCount; ulTask++)
+			{
+				pstTasks[ulTask].lFd = lFd;
+				pstTasks[ulTask].ulFirst = ulTask * ulSlice;
+				pstTasks[ulTask].ulLast = (ulTask + 1) * ulSlice;
+				if(pstTasks[ulTask].ulFirst > pstReport->ulRecordCount)
+				{
+					pstTasks[ulTask].ulFirst = pstReport->ulRecordCount;
+				}
+				if(pstTasks[ulTask].ulLast > pstReport->ulRecordCount)
+				{
+					pstTasks[ulTask].ulLast = pstReport->ulRecordCount;
+				}
+			}
+			poolRun(verifySlice, pstTasks, sizeof(VERIFY_TASK), ulTaskCount);
+
+			// The slices are in file order, so are their ranges
+			for(ulTask = 0; ulTask < ulTaskCount; ulTask++)
+			{
+				blReturn = (blReturn == true &&
+							pstTasks[ulTask].blStatus == true);
+				pstReport->ulCorruptCount +=
+					pstTasks[ulTask].stReport.ulCorruptCount;
+				for(ulRange = 0; ulRange <
+					pstTasks[ulTask].stReport.ulRangeCount &&
+					blReturn == true; ulRange++)
+				{
+					blReturn = verifyAddRange(pstReport,
+						pstTasks[ulTask].stReport.pstRanges[ulRange].ulStart,
+						pstTasks[ulTask].stReport.pstRanges[ulRange].ulEnd);
+				}
+				verifyReportFree(&pstTasks[ulTask].stReport);
+			}
+		}
+
+		// A partial record at the end, left by a torn append
+		if(blReturn == true &&
+		   pstReport->ulSize % sizeof(DEVICE_DETAILS) != 0)
+		{
+			blReturn = verifyAddRange(pstReport, pstReport->ulRecordCount *
+									  sizeof(DEVICE_DETAILS),
+									  pstReport->ulSize);
+		}
+
+		if(lFd >= 0)
+		{
+			close(lFd);
+		}
+		free(pstTasks);
+
+		if(blReturn != true)
+		{
+			verifyReportFree(pstReport);
+			printf("\nUnable to verify the file %s", (char *)pucPath);
+		}
+	}
+	else
+	{
+		printf("\nUnable to verify the file : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To copy the intact records of a data file to a fresh file
+//Inputs	: pucPath, name of the data or shard file
+//Inputs	: pstReport, the report of verifyFile() for the file
+//Inputs	: pucOutputPath, name of the fresh file
+//Outputs	: pulSalvaged, number of records written to the fresh file
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The data file is left unchanged
+//******************************************************************************
+bool verifySalvage(const uint8 *pucPath, const VERIFY_REPORT *pstReport,
+				   const uint8 *pucOutputPath, uint32 *pulSalvaged)
+{
+	bool blReturn = false;
+	FILE *pstOutput = NULL;
+	uint8 *pucBuffer = NULL;
+	int32 lFd = -1;
+	uint32 ulPosition = 0;
+	uint32 ulRange = 0;
+	const VERIFY_RANGE *pstRange = NULL;
+
+	if(pucPath != NULL && pstReport != NULL && pucOutputPath != NULL &&
+	   pulSalvaged != NULL)
+	{
+		*pulSalvaged = 0;
+		lFd = open((char *)pucPath, O_RDONLY);
+		pstOutput = fileOpen(pucOutputPath, FILE_WRITE_MODE);
+		pucBuffer = malloc(VERIFY_SCAN_SIZE);
+		blReturn = (lFd >= 0 && pstOutput != NULL && pucBuffer != NULL);
+
+		for(ulRange = 0; ulRange < pstReport->ulRangeCount && blReturn == true;
+			ulRange++)
+		{
+			pstRange = &pstReport->pstRanges[ulRange];
+			blReturn = (verifyCopyRange(lFd, ulPosition, pstRange->ulStart,
+										pstOutput, pucBuffer) == true &&
+						verifyScanRange(lFd, pstRange->ulStart,
+										pstRange->ulEnd, pstOutput, pucBuffer,
+										pulSalvaged) == true);
+			*pulSalvaged += (pstRange->ulStart - ulPosition) /
+							sizeof(DEVICE_DETAILS);
+			ulPosition = pstRange->ulEnd;
+		}
+
+		if(blReturn == true && ulPosition < pstReport->ulSize)
+		{
+			blReturn = verifyCopyRange(lFd, ulPosition, pstReport->ulSize,
+									   pstOutput, pucBuffer);
+			*pulSalvaged += (pstReport->ulSize - ulPosition) /
+							sizeof(DEVICE_DETAILS);
+		}
+
+		if(pstOutput != NULL && fileClose(pstOutput) != true)
+		{
+			blReturn = false;
+		}
+		if(lFd >= 0)
+		{
+			close(lFd);
+		}
+		free(pucBuffer);
+
+		if(blReturn != true)
+		{
+			remove((char *)pucOutputPath);
+			printf("\nUnable to salvage the file %s", (char *)pucPath);
+		}
+	}
+	else
+	{
+		printf("\nUnable to salvage the file : Invalid parameters");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To verify all the files of the device data
+//Inputs	: pucFileName, name of the data file
+//Inputs	: blSalvage, whether the intact records of a corrupted file are
+//			  copied to "<file>.salvage"
+//Outputs	: None
+//Return	: True, if every file is intact
+//Return	: False, if a file is corrupted or in case of an error
+//Notes		: Runs as the only writer, readers are not blocked
+//******************************************************************************
+bool verifyRun(const uint8 *pucFileName, bool blSalvage)
+{
+	bool blReturn = false;
+	bool blIntact = true;
+	VERIFY_REPORT stReport = {0};
+	SHARD_LAYOUT stLayout = {0};
+	SNAPSHOT_WRITER stWriter;
+	struct timespec stStart;
+	struct timespec stEnd;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucOutputPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+	uint32 ulSalvaged = 0;
+	uint32 ulBytes = 0;
+	double dSeconds = 0;
+
+	if(pucFileName != NULL &&
+	   snapshotWriterBegin(pucFileName, &stWriter) == true)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &stStart);
+		printf("Verifying the CRC32C of the records (%s)\n",
+			   crcHardware() == true ? "SSE4.2" : "table");
+		blReturn = shardGetLayout(pucFileName, &stLayout);
+		for(ulShard = 0; ulShard < stLayout.ulShardCount && blReturn == true;
+			ulShard++)
+		{
+			blReturn = (shardGetPath(pucFileName, &stLayout, ulShard,
+									 pucPath) == true &&
+						verifyFile(pucPath, &stReport) == true);
+			if(blReturn == true)
+			{
+				verifyPrint(pucPath, &stReport);
+				ulBytes += stReport.ulSize;
+				blIntact = (blIntact == true && stReport.ulRangeCount == 0);
+			}
+
+			if(blReturn == true && blSalvage == true &&
+			   stReport.ulRangeCount > 0)
+			{
+				blReturn = (fileBuildPath(pucOutputPath, pucPath,
+										  VERIFY_SALVAGE_SUFFIX) == true &&
+							verifySalvage(pucPath, &stReport, pucOutputPath,
+										  &ulSalvaged) == true);
+				if(blReturn == true)
+				{
+					printf("\tsalvaged %lu intact record(s) into %s\n",
+						   ulSalvaged, (char *)pucOutputPath);
+				}
+			}
+			verifyReportFree(&stReport);
+		}
+		snapshotWriterEnd(&stWriter);
+
+		clock_gettime(CLOCK_MONOTONIC, &stEnd);
+		dSeconds = (stEnd.tv_sec - stStart.tv_sec) +
+				   (stEnd.tv_nsec - stStart.tv_nsec) / VERIFY_NANOSECONDS;
+		printf("Checked %.1f MB in %.3f s\n", ulBytes / MEGABYTE, dSeconds);
+		blReturn = (blReturn == true && blIntact == true);
+	}
+	else
+	{
+		printf("\nUnable to verify the device data : Lock failed");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To release a report
+//Inputs	: pstReport, the report
+//Outputs	: None
+//Return	: None
+//Notes		:
+//******************************************************************************
+void verifyReportFree(VERIFY_REPORT *pstReport)
+{
+	if(pstReport != NULL)
+	{
+		free(pstReport->pstRanges);
+		pstReport->pstRanges = NULL;
+		pstReport->ulRangeCount = 0;
+		pstReport->ulRangeCapacity = 0;
+	}
+}
+// EOF
@@ -0,0 +1,51 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Checksum verification and salvage of device data files
+// Note		: Finds the corrupted byte ranges of a data file in parallel and
+//			  copies the intact records to a fresh file
+//
+//******************************************************************************
+
+#ifndef _VERIFY_H_
+#define _VERIFY_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include "customTypes.h"
+#include "constants.h"
+
+//******************************* Global Types *********************************
+typedef struct _VERIFY_RANGE_
+{
+	uint32 ulStart;
+	uint32 ulEnd;
+} VERIFY_RANGE;
+
+typedef struct _VERIFY_REPORT_
+{
+	uint32 ulSize;
+	uint32 ulRecordCount;
+	uint32 ulCorruptCount;
+	VERIFY_RANGE *pstRanges;
+	uint32 ulRangeCount;
+	uint32 ulRangeCapacity;
+} VERIFY_REPORT;
+
+//***************************** Global Constants *******************************
+#define VERIFY_SALVAGE_SUFFIX	(".salvage")
+#define VERIFY_MAX_THREADS		(64)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool verifyFile(const uint8 *pucPath, VERIFY_REPORT *pstReport);
+bool verifySalvage(const uint8 *pucPath, const VERIFY_REPORT *pstReport,
+				   const uint8 *pucOutputPath, uint32 *pulSalvaged);
+bool verifyRun(const uint8 *pucFileName, bool blSalvage);
+void verifyReportFree(VERIFY_REPORT *pstReport);
+
+#endif // _VERIFY_H_
+// EOF
@@ -0,0 +1,807 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// File		: workload.c
+// Summary	: Recording and replay of the operations run on the device data
+// Note		: While "<data file>.record" names a trace file, the menu and
+//			  the batch commands append every operation with its arguments
+//			  and start time to the trace, the commands of a batch file
+//			  marked with WORKLOAD_FROM_BATCH and a transaction once it is
+//			  committed. Recording starts with a copy of
+//			  the device data in "<trace>.base". A replay copies the base,
+//			  or the current data when there is no base, runs the
+//			  operations on the copy at their recorded pace or as fast as
+//			  possible, and reports the latency distribution of every
+//			  operation type. The output of the operations is discarded.
+// Author	: Francis V D
+// Date		: 19-October-2026
+//
+//******************************************************************************
+
+//******************************* Include Files ********************************
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include "customTypes.h"
+#include "constants.h"
+#include "device.h"
+#include "file.h"
+#include "crc.h"
+#include "shard.h"
+#include "snapshot.h"
+#include "stats.h"
+#include "txn.h"
+#include "workload.h"
+
+//******************************* Local Types **********************************
+typedef struct _WORKLOAD_LATENCIES_
+{
+	uint32 *pulNanoseconds;
+	uint32 ulCount;
+	uint32 ulCapacity;
+} WORKLOAD_LATENCIES;
+
+//***************************** Local Constants ********************************
+#define READ_COUNT				(1)
+#define WRITE_COUNT				(1)
+#define FILE_PERMISSIONS		(0644)
+#define WORKLOAD_BASE_SUFFIX	(".base")
+#define WORKLOAD_MIN_LATENCIES	(64)
+#define WORKLOAD_NANOSECONDS	(1000000000UL)
+#define WORKLOAD_MICROSECONDS	(1e3)
+#define PERCENT					(100)
+
+//***************************** Local Variables ********************************
+static const char *ppcOperationNames[WORKLOAD_OPERATIONS] =
+{
+	"add", "list", "search", "remove", "remove-serial", "remove-list",
+	"update", "update-batch", "stats", "transaction"
+};
+
+//****************************** Local Functions *******************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the name of the trace being recorded
+//Inputs	: pucFileName, name of the data file
+//Outputs	: pucTracePath, name of the trace, FILE_PATH_MAX_SIZE bytes
+//Return	: True, if the operations are recorded
+//Return	: False, if they are not
+//Notes		:
+//******************************************************************************
+static bool workloadGetTracePath(const uint8 *pucFileName, uint8 *pucTracePath)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(fileBuildPath(pucPath, pucFileName, WORKLOAD_RECORD_SUFFIX) == true)
+	{
+		pstFile = fopen((char *)pucPath, "r");
+	}
+
+	if(pstFile != NULL)
+	{
+		if(fgets((char *)pucTracePath, FILE_PATH_MAX_SIZE, pstFile) != NULL)
+		{
+			pucTracePath[strcspn((char *)pucTracePath, "\n")] = '\0';
+			blReturn = (pucTracePath[0] != '\0');
+		}
+		fclose(pstFile);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To compute the checksum of a trace entry
+//Inputs	: pstEntry, the entry
+//Inputs	: pvArguments, the arguments following the entry
+//Outputs	: None
+//Return	: The checksum of the entry fields before ulChecksum and of the
+//			  arguments
+//Notes		:
+//******************************************************************************
+static uint32 workloadChecksum(const WORKLOAD_ENTRY *pstEntry,
+							   const void *pvArguments)
+{
+	uint32 ulCrc = 0;
+
+	ulCrc = crc32c(CRC_INITIAL, pstEntry, offsetof(WORKLOAD_ENTRY, ulChecksum));
+
+	return crc32c(ulCrc, pvArguments, pstEntry->ulSize);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To copy the device data into a single data file
+//Inputs	: pucSource, name of the data file to be copied
+//Inputs	: pucTarget, name of the copy
+//Outputs	: pulCount, number of copied devices
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Copies a snapshot while holding the writer lock of the source,
+//			  so no operation is half in the copy. An existing copy is
+//			  replaced.
+//******************************************************************************
+static bool workloadCopyData(const uint8 *pucSource, const uint8 *pucTarget,
+							 uint32 *pulCount)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	DEVICE_DETAILS DeviceData = {0};
+	SNAPSHOT stSnapshot;
+	SNAPSHOT_WRITER stWriter;
+	SHARD_LAYOUT stLayout = {0};
+	uint8 pucTemporaryPath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulShard = 0;
+
+	*pulCount = 0;
+	if(fileBuildPath(pucTemporaryPath, pucTarget,
+					 SNAPSHOT_TEMPORARY_SUFFIX) == true &&
+	   snapshotWriterBegin(pucSource, &stWriter) == true)
+	{
+		pstFile = fopen((char *)pucTemporaryPath, "wb");
+		if(pstFile != NULL &&
+		   shardAcquireSnapshot(pucSource, &stSnapshot, &stLayout) == true)
+		{
+			blReturn = true;
+			for(ulShard = 0; ulShard < stSnapshot.ulFileCount; ulShard++)
+			{
+				while(blReturn == true &&
+					  snapshotRead(&stSnapshot, ulShard, &DeviceData) == true)
+				{
+					blReturn = (fwrite(&DeviceData, sizeof(DEVICE_DETAILS),
+									   WRITE_COUNT, pstFile) == WRITE_COUNT);
+					(*pulCount)++;
+				}
+			}
+			snapshotRelease(&stSnapshot);
+		}
+
+		if(pstFile != NULL)
+		{
+			blReturn = (fclose(pstFile) == 0 && blReturn == true &&
+						rename((char *)pucTemporaryPath,
+							   (char *)pucTarget) == 0);
+		}
+		snapshotWriterEnd(&stWriter);
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to copy the device data to %s", (char *)pucTarget);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To prepare the copy of the device data a trace is replayed on
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pucTracePath, name of the trace
+//Inputs	: pucCopyName, name of the copy
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, if the copy already exists or in case of an error
+//Notes		: The copy is spread over as many shards as the data file
+//******************************************************************************
+static bool workloadPrepareCopy(const uint8 *pucFileName,
+								const uint8 *pucTracePath,
+								const uint8 *pucCopyName)
+{
+	bool blReturn = false;
+	SHARD_LAYOUT stLayout = {0};
+	uint8 pucBasePath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucLayoutPath[FILE_PATH_MAX_SIZE] = "";
+	const uint8 *pucSource = pucFileName;
+	uint32 ulCount = 0;
+
+	if(fileBuildPath(pucLayoutPath, pucCopyName, SHARD_LAYOUT_SUFFIX) == true &&
+	   fileBuildPath(pucBasePath, pucTracePath, WORKLOAD_BASE_SUFFIX) == true)
+	{
+		if(fileExists(pucCopyName) == true ||
+		   fileExists(pucLayoutPath) == true)
+		{
+			printf("\nUnable to replay : %s already exists",
+				   (char *)pucCopyName);
+		}
+		else
+		{
+			if(fileExists(pucBasePath) == true)
+			{
+				pucSource = pucBasePath;
+			}
+			blReturn = (shardGetLayout(pucFileName, &stLayout) == true &&
+						workloadCopyData(pucSource, pucCopyName,
+										 &ulCount) == true);
+		}
+	}
+
+	if(blReturn == true && stLayout.blSharded == true)
+	{
+		blReturn = shardReshard(pucCopyName, stLayout.ulShardCount);
+	}
+
+	if(blReturn == true)
+	{
+		printf("Replaying on %s, a copy of %s with %lu device(s)\n",
+			   (char *)pucCopyName, (char *)pucSource, ulCount);
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To run one recorded operation
+//Inputs	: pucCopyName, name of the data file the operation runs on
+//Inputs	: pstEntry, the entry of the operation
+//Inputs	: pvArguments, its arguments
+//Outputs	: None
+//Return	: True, if the operation has been run
+//Return	: False, if the entry does not describe a valid operation
+//Notes		: The outcome of the operation itself is not checked, a search
+//			  without match or a removal of a missing device are part of
+//			  the workload
+//******************************************************************************
+static bool workloadRun(const uint8 *pucCopyName, const WORKLOAD_ENTRY *pstEntry,
+						void *pvArguments)
+{
+	bool blReturn = true;
+	bool blRemoved = false;
+	bool *pblUpdated = NULL;
+	TXN_REPORT stReport = {0};
+	uint32 ulRemoved = 0;
+	uint32 ulSize = pstEntry->ulSize;
+
+	switch(pstEntry->ulOperation & ~WORKLOAD_FROM_BATCH)
+	{
+		case WORKLOAD_ADD:
+			blReturn = (ulSize == sizeof(DEVICE_DETAILS));
+			if(blReturn == true)
+			{
+				deviceAddRecord(pucCopyName, pvArguments);
+			}
+			break;
+
+		case WORKLOAD_LIST:
+			deviceList(pucCopyName);
+			break;
+
+		case WORKLOAD_SEARCH:
+			blReturn = (ulSize == sizeof(DEVICE_CRITERIA));
+			if(blReturn == true)
+			{
+				deviceSearchCriteria(pucCopyName, pvArguments);
+			}
+			break;
+
+		case WORKLOAD_REMOVE:
+			blReturn = (ulSize == sizeof(DEVICE_CRITERIA));
+			if(blReturn == true)
+			{
+				deviceRemoveCriteria(pucCopyName, pvArguments, &ulRemoved);
+			}
+			break;
+
+		case WORKLOAD_REMOVE_SERIAL:
+			blReturn = (ulSize == sizeof(uint32));
+			if(blReturn == true)
+			{
+				deviceRemoveSerial(pucCopyName, *(uint32 *)pvArguments,
+								   &blRemoved);
+			}
+			break;
+
+		case WORKLOAD_REMOVE_LIST:
+			blReturn = (ulSize % sizeof(uint32) == 0);
+			if(blReturn == true)
+			{
+				deviceRemoveSerials(pucCopyName, pvArguments,
+									ulSize / sizeof(uint32));
+			}
+			break;
+
+		case WORKLOAD_UPDATE:
+		case WORKLOAD_UPDATE_BATCH:
+			blReturn = (ulSize % sizeof(DEVICE_UPDATE) == 0);
+			if(blReturn == true && ulSize > 0)
+			{
+				pblUpdated = malloc(ulSize / sizeof(DEVICE_UPDATE) *
+									sizeof(bool));
+				blReturn = (pblUpdated != NULL);
+			}
+			if(pblUpdated != NULL)
+			{
+				deviceUpdateRecords(pucCopyName, pvArguments,
+									ulSize / sizeof(DEVICE_UPDATE),
+									pblUpdated);
+				free(pblUpdated);
+			}
+			break;
+
+		case WORKLOAD_STATS:
+			statsShow(pucCopyName);
+			break;
+
+		case WORKLOAD_TRANSACTION:
+			blReturn = (ulSize % sizeof(TXN_OPERATION) == 0);
+			if(blReturn == true)
+			{
+				txnCommit(pucCopyName, pvArguments,
+						  ulSize / sizeof(TXN_OPERATION), &stReport);
+			}
+			break;
+
+		default:
+			blReturn = false;
+			break;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To add a latency to the latencies of an operation type
+//Inputs	: pstLatencies, the latencies
+//Inputs	: ulNanoseconds, the latency
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, if out of memory
+//Notes		: The array grows by doubling
+//******************************************************************************
+static bool workloadAddLatency(WORKLOAD_LATENCIES *pstLatencies,
+							   uint32 ulNanoseconds)
+{
+	bool blReturn = true;
+	uint32 *pulGrown = NULL;
+	uint32 ulCapacity = 0;
+
+	if(pstLatencies->ulCount == pstLatencies->ulCapacity)
+	{
+		ulCapacity = pstLatencies->ulCapacity * 2;
+		if(ulCapacity < WORKLOAD_MIN_LATENCIES)
+		{
+			ulCapacity = WORKLOAD_MIN_LATENCIES;
+		}
+
+		pulGrown = realloc(pstLatencies->pulNanoseconds,
+						   ulCapacity * sizeof(uint32));
+		blReturn = (pulGrown != NULL);
+		if(blReturn == true)
+		{
+			pstLatencies->pulNanoseconds = pulGrown;
+			pstLatencies->ulCapacity = ulCapacity;
+		}
+	}
+
+	if(blReturn == true)
+	{
+		pstLatencies->pulNanoseconds[pstLatencies->ulCount++] = ulNanoseconds;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To order two latencies for qsort()
+//Inputs	: pvFirst and pvSecond, the latencies
+//Outputs	: None
+//Return	: Negative, zero or positive as the first is lower, equal or
+//			  higher
+//Notes		:
+//******************************************************************************
+static int workloadCompareLatency(const void *pvFirst, const void *pvSecond)
+{
+	uint32 ulFirst = *(const uint32 *)pvFirst;
+	uint32 ulSecond = *(const uint32 *)pvSecond;
+
+	return (ulFirst > ulSecond) - (ulFirst < ulSecond);
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To pick a percentile of sorted latencies
+//Inputs	: pstLatencies, the sorted latencies, at least one
+//Inputs	: ulPercent, the percentile
+//Outputs	: None
+//Return	: The latency in microseconds
+//Notes		: Nearest rank
+//******************************************************************************
+static double workloadPercentile(const WORKLOAD_LATENCIES *pstLatencies,
+								 uint32 ulPercent)
+{
+	uint32 ulRank = 0;
+
+	ulRank = (pstLatencies->ulCount * ulPercent + PERCENT - 1) / PERCENT;
+	if(ulRank == 0)
+	{
+		ulRank = 1;
+	}
+
+	return pstLatencies->pulNanoseconds[ulRank - 1] / WORKLOAD_MICROSECONDS;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print the latency distribution of every operation type
+//Inputs	: pstLatencies, the latencies of every operation type
+//Outputs	: pstLatencies, the latencies sorted
+//Return	: None
+//Notes		:
+//******************************************************************************
+static void workloadPrintLatencies(WORKLOAD_LATENCIES *pstLatencies)
+{
+	WORKLOAD_LATENCIES *pstType = NULL;
+	uint32 ulOperation = 0;
+	uint32 ulIndex = 0;
+	double dTotal = 0;
+
+	printf("%-14s %8s %10s %10s %10s %10s %10s  (us)\n", "Operation",
+		   "Count", "Mean", "p50", "p90", "p99", "Max");
+	for(ulOperation = 0; ulOperation < WORKLOAD_OPERATIONS; ulOperation++)
+	{
+		pstType = &pstLatencies[ulOperation];
+		if(pstType->ulCount > 0)
+		{
+			qsort(pstType->pulNanoseconds, pstType->ulCount, sizeof(uint32),
+				  workloadCompareLatency);
+			dTotal = 0;
+			for(ulIndex = 0; ulIndex < pstType->ulCount; ulIndex++)
+			{
+				dTotal += pstType->pulNanoseconds[ulIndex];
+			}
+			printf("%-14s %8lu %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+				   ppcOperationNames[ulOperation], pstType->ulCount,
+				   dTotal / pstType->ulCount / WORKLOAD_MICROSECONDS,
+				   workloadPercentile(pstType, 50),
+				   workloadPercentile(pstType, 90),
+				   workloadPercentile(pstType, 99),
+				   workloadPercentile(pstType, PERCENT));
+		}
+	}
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To read the time of a clock in nanoseconds
+//Inputs	: lClock, the clock
+//Outputs	: None
+//Return	: The time
+//Notes		:
+//******************************************************************************
+static uint32 workloadNow(clockid_t lClock)
+{
+	struct timespec stNow;
+
+	clock_gettime(lClock, &stNow);
+
+	return stNow.tv_sec * WORKLOAD_NANOSECONDS + stNow.tv_nsec;
+}
+
+//******************************************************************************
+//****************************** Global Functions ******************************
+//******************************************************************************
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To record an operation about to run on the device data
+//Inputs	: pucFileName, name of the data file
+//Inputs	: ulOperation, one of the WORKLOAD_ operations, with
+//			  WORKLOAD_FROM_BATCH for a command of a batch file
+//Inputs	: pvArguments and ulSize, the arguments of the operation
+//Outputs	: None
+//Return	: True, if recorded or not recording
+//Return	: False, in case of an error
+//Notes		: The entry is appended with one write, so operations of
+//			  concurrent processes are never interleaved
+//******************************************************************************
+bool workloadRecord(const uint8 *pucFileName, uint32 ulOperation,
+					const void *pvArguments, size_t ulSize)
+{
+	bool blReturn = true;
+	WORKLOAD_ENTRY *pstEntry = NULL;
+	uint8 pucTracePath[FILE_PATH_MAX_SIZE] = "";
+	int32 lFd = -1;
+	size_t ulEntrySize = sizeof(WORKLOAD_ENTRY) + ulSize;
+
+	if(pucFileName != NULL &&
+	   workloadGetTracePath(pucFileName, pucTracePath) == true)
+	{
+		pstEntry = malloc(ulEntrySize);
+		lFd = open((char *)pucTracePath, O_WRONLY | O_CREAT | O_APPEND,
+				   FILE_PERMISSIONS);
+		blReturn = (pstEntry != NULL && lFd >= 0);
+		if(blReturn == true)
+		{
+			pstEntry->ulOperation = ulOperation;
+			pstEntry->ulTimestamp = workloadNow(CLOCK_REALTIME);
+			pstEntry->ulSize = ulSize;
+			if(ulSize > 0)
+			{
+				memcpy(pstEntry + 1, pvArguments, ulSize);
+			}
+			pstEntry->ulChecksum = workloadChecksum(pstEntry, pstEntry + 1);
+			blReturn = (write(lFd, pstEntry, ulEntrySize) ==
+						(ssize_t)ulEntrySize);
+		}
+
+		if(lFd >= 0)
+		{
+			close(lFd);
+		}
+		free(pstEntry);
+
+		if(blReturn != true)
+		{
+			printf("\nUnable to record the operation to %s",
+				   (char *)pucTracePath);
+		}
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To start recording the operations to a trace
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pucTracePath, name of the trace
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The trace is emptied and the device data copied to
+//			  "<trace>.base", under the writer lock so that every later
+//			  change is recorded
+//******************************************************************************
+bool workloadStart(const uint8 *pucFileName, const uint8 *pucTracePath)
+{
+	bool blReturn = false;
+	FILE *pstFile = NULL;
+	SNAPSHOT_WRITER stWriter;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+	uint8 pucBasePath[FILE_PATH_MAX_SIZE] = "";
+	uint32 ulCount = 0;
+
+	if(pucFileName != NULL && pucTracePath != NULL &&
+	   strlen((char *)pucTracePath) < FILE_PATH_MAX_SIZE &&
+	   fileBuildPath(pucPath, pucFileName, WORKLOAD_RECORD_SUFFIX) == true &&
+	   fileBuildPath(pucBasePath, pucTracePath, WORKLOAD_BASE_SUFFIX) == true)
+	{
+		blReturn = (workloadCopyData(pucFileName, pucBasePath,
+									 &ulCount) == true &&
+					snapshotWriterBegin(pucFileName, &stWriter) == true);
+		if(blReturn == true)
+		{
+			pstFile = fopen((char *)pucTracePath, "wb");
+			blReturn = (pstFile != NULL && fclose(pstFile) == 0);
+
+			pstFile = NULL;
+			if(blReturn == true)
+			{
+				pstFile = fopen((char *)pucPath, "w");
+			}
+			blReturn = (pstFile != NULL &&
+						fprintf(pstFile, "%s\n", (char *)pucTracePath) > 0);
+			blReturn = (pstFile != NULL && fclose(pstFile) == 0 &&
+						blReturn == true);
+			snapshotWriterEnd(&stWriter);
+		}
+	}
+
+	if(blReturn == true)
+	{
+		printf("Recording to %s, from %lu device(s) copied to %s\n",
+			   (char *)pucTracePath, ulCount, (char *)pucBasePath);
+	}
+	else
+	{
+		printf("\nUnable to start recording the operations\n");
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To stop recording the operations
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: The trace and its base are kept for replays
+//******************************************************************************
+bool workloadStop(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	uint8 pucPath[FILE_PATH_MAX_SIZE] = "";
+
+	if(pucFileName != NULL &&
+	   fileBuildPath(pucPath, pucFileName, WORKLOAD_RECORD_SUFFIX) == true)
+	{
+		blReturn = (unlink((char *)pucPath) == 0 ||
+					fileExists(pucPath) != true);
+	}
+	printf(blReturn == true ? "Recording stopped\n"
+			: "\nUnable to stop recording the operations\n");
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To print whether the operations are recorded
+//Inputs	: pucFileName, name of the data file
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		:
+//******************************************************************************
+bool workloadShow(const uint8 *pucFileName)
+{
+	bool blReturn = false;
+	uint8 pucTracePath[FILE_PATH_MAX_SIZE] = "";
+
+	if(pucFileName != NULL)
+	{
+		if(workloadGetTracePath(pucFileName, pucTracePath) == true)
+		{
+			printf("Recording to %s\n", (char *)pucTracePath);
+		}
+		else
+		{
+			printf("Not recording\n");
+		}
+		blReturn = true;
+	}
+
+	return blReturn;
+}
+
+//******************************.FUNCTION_HEADER.*******************************
+//Purpose	: To replay a trace and report the latency of the operations
+//Inputs	: pucFileName, name of the data file
+//Inputs	: pucTracePath, name of the trace
+//Inputs	: pucCopyName, name of the copy the operations run on, which
+//			  must not exist
+//Inputs	: blMaxSpeed, true to run the operations back to back, false to
+//			  keep the recorded time between their starts
+//Outputs	: None
+//Return	: True, at time of successful execution
+//Return	: False, in case of an error
+//Notes		: Stops at the first incomplete or corrupt entry
+//******************************************************************************
+bool workloadReplay(const uint8 *pucFileName, const uint8 *pucTracePath,
+					const uint8 *pucCopyName, bool blMaxSpeed)
+{
+	bool blReturn = false;
+	FILE *pstTrace = NULL;
+	WORKLOAD_ENTRY stEntry = {0};
+	WORKLOAD_LATENCIES pstLatencies[WORKLOAD_OPERATIONS];
+	struct timespec stWait;
+	void *pvArguments = NULL;
+	void *pvGrown = NULL;
+	int32 lOutputFd = -1;
+	int32 lNullFd = -1;
+	uint32 ulCapacity = 0;
+	uint32 ulFirst = 0;
+	uint32 ulReplayStart = 0;
+	uint32 ulStart = 0;
+	uint32 ulReplayed = 0;
+	uint32 ulBatched = 0;
+	uint32 ulSkipped = 0;
+	uint32 ulOperation = 0;
+
+	if(pucFileName == NULL || pucTracePath == NULL || pucCopyName == NULL)
+	{
+		printf("\nUnable to replay : Invalid parameters");
+		return false;
+	}
+
+	memset(pstLatencies, 0, sizeof(pstLatencies));
+	pstTrace = fopen((char *)pucTracePath, "rb");
+	if(pstTrace != NULL &&
+	   workloadPrepareCopy(pucFileName, pucTracePath, pucCopyName) == true)
+	{
+		fflush(stdout);
+		lOutputFd = dup(STDOUT_FILENO);
+		lNullFd = open("/dev/null", O_WRONLY);
+		blReturn = (lOutputFd >= 0 && lNullFd >= 0 &&
+					dup2(lNullFd, STDOUT_FILENO) >= 0);
+
+		ulReplayStart = workloadNow(CLOCK_MONOTONIC);
+		while(blReturn == true &&
+			  fread(&stEntry, sizeof(stEntry), READ_COUNT,
+					pstTrace) == READ_COUNT)
+		{
+			// A torn entry may claim any size
+			if(stEntry.ulSize > ulCapacity)
+			{
+				pvGrown = realloc(pvArguments, stEntry.ulSize);
+				if(pvGrown == NULL)
+				{
+					break;
+				}
+				pvArguments = pvGrown;
+				ulCapacity = stEntry.ulSize;
+			}
+			if((stEntry.ulSize > 0 &&
+				fread(pvArguments, stEntry.ulSize, READ_COUNT,
+					  pstTrace) != READ_COUNT) ||
+			   workloadChecksum(&stEntry, pvArguments) != stEntry.ulChecksum)
+			{
+				break;
+			}
+
+			if(ulReplayed + ulSkipped == 0)
+			{
+				ulFirst = stEntry.ulTimestamp;
+			}
+			if(blMaxSpeed != true && stEntry.ulTimestamp > ulFirst)
+			{
+				ulStart = ulReplayStart + (stEntry.ulTimestamp - ulFirst);
+				stWait.tv_sec = ulStart / WORKLOAD_NANOSECONDS;
+				stWait.tv_nsec = ulStart % WORKLOAD_NANOSECONDS;
+				clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &stWait, NULL);
+			}
+
+			ulStart = workloadNow(CLOCK_MONOTONIC);
+			if(workloadRun(pucCopyName, &stEntry, pvArguments) == true)
+			{
+				blReturn = workloadAddLatency(
+								&pstLatencies[stEntry.ulOperation &
+											  ~WORKLOAD_FROM_BATCH],
+								workloadNow(CLOCK_MONOTONIC) - ulStart);
+				ulBatched += ((stEntry.ulOperation & WORKLOAD_FROM_BATCH) != 0);
+				ulReplayed++;
+			}
+			else
+			{
+				ulSkipped++;
+			}
+		}
+
+		fflush(stdout);
+		if(lOutputFd >= 0)
+		{
+			dup2(lOutputFd, STDOUT_FILENO);
+			close(lOutputFd);
+		}
+		if(lNullFd >= 0)
+		{
+			close(lNullFd);
+		}
+
+		if(blReturn == true)
+		{
+			printf("Replayed %lu operation(s) in %.3f s at %s speed",
+				   ulReplayed,
+				   (double)(workloadNow(CLOCK_MONOTONIC) - ulReplayStart) /
+				   WORKLOAD_NANOSECONDS,
+				   blMaxSpeed == true ? "maximum" : "recorded");
+			printf(ulBatched > 0 ? ", %lu from batch files" : "", ulBatched);
+			printf(ulSkipped > 0 ? ", %lu invalid entry(s) skipped\n" : "\n",
+				   ulSkipped);
+			workloadPrintLatencies(pstLatencies);
+		}
+	}
+
+	if(pstTrace != NULL)
+	{
+		fclose(pstTrace);
+	}
+	else
+	{
+		printf("\nUnable to replay : Failed to open %s", (char *)pucTracePath);
+	}
+	free(pvArguments);
+	for(ulOperation = 0; ulOperation < WORKLOAD_OPERATIONS; ulOperation++)
+	{
+		free(pstLatencies[ulOperation].pulNanoseconds);
+	}
+
+	if(blReturn != true)
+	{
+		printf("\nUnable to replay %s\n", (char *)pucTracePath);
+	}
+
+	return blReturn;
+}
+// EOF
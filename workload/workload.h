@@ -0,0 +1,62 @@
+//************************** DEVICE MANAGEMENT SYSTEM **************************
+//  Copyright (c) 2025 Trenser Technology Solutions
+//  All Rights Reserved
+//******************************************************************************
+//
+// Summary	: Recording and replay of the operations run on the device data
+// Note		: A recorded trace is replayed against a copy of the device
+//			  data to measure the latency of every operation type
+//
+//******************************************************************************
+
+#ifndef _WORKLOAD_H_
+#define _WORKLOAD_H_
+
+//******************************* Include Files ********************************
+#include <stdbool.h>
+#include <stddef.h>
+#include "customTypes.h"
+#include "constants.h"
+
+//******************************* Global Types *********************************
+// Followed by ulSize bytes of arguments of the operation
+typedef struct _WORKLOAD_ENTRY_
+{
+	uint32 ulOperation;
+	uint32 ulTimestamp;
+	uint32 ulSize;
+	uint32 ulChecksum;
+} WORKLOAD_ENTRY;
+
+//***************************** Global Constants *******************************
+#define WORKLOAD_RECORD_SUFFIX	(".record")
+
+// Operations and their arguments
+#define WORKLOAD_ADD			(0)		// DEVICE_DETAILS
+#define WORKLOAD_LIST			(1)		// None
+#define WORKLOAD_SEARCH			(2)		// DEVICE_CRITERIA
+#define WORKLOAD_REMOVE			(3)		// DEVICE_CRITERIA
+#define WORKLOAD_REMOVE_SERIAL	(4)		// Serial
+#define WORKLOAD_REMOVE_LIST	(5)		// Serials
+#define WORKLOAD_UPDATE			(6)		// DEVICE_UPDATE
+#define WORKLOAD_UPDATE_BATCH	(7)		// DEVICE_UPDATEs
+#define WORKLOAD_STATS			(8)		// None
+#define WORKLOAD_TRANSACTION	(9)		// TXN_OPERATIONs
+#define WORKLOAD_OPERATIONS		(10)
+
+// Set in the operation of an entry run by a batch file
+#define WORKLOAD_FROM_BATCH		(0x100)
+
+//***************************** Global Variables *******************************
+
+//**************************** Forward Declarations ****************************
+bool workloadRecord(const uint8 *pucFileName, uint32 ulOperation,
+					const void *pvArguments, size_t ulSize);
+bool workloadStart(const uint8 *pucFileName, const uint8 *pucTracePath);
+bool workloadStop(const uint8 *pucFileName);
+bool workloadShow(const uint8 *pucFileName);
+bool workloadReplay(const uint8 *pucFileName, const uint8 *pucTracePath,
+					const uint8 *pucCopyName, bool blMaxSpeed);
+
+#endif // _WORKLOAD_H_
+// EOF